@@ -6,6 +6,9 @@ dnl Function to detect if libfsapfs dependencies are available
 AC_DEFUN([AX_LIBFSAPFS_CHECK_LOCAL],
   [dnl Check for internationalization functions in libfsapfs/libfsapfs_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Check for io_uring support in libfsapfs/libfsapfs_io_uring.c
+  AC_CHECK_HEADERS([linux/io_uring.h sys/mman.h sys/syscall.h])
 ])
 
 dnl Function to detect if fsapfstools dependencies are available
@@ -3657,14 +3657,13 @@ int info_handle_file_entries_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error )
 {
-	libfsapfs_file_entry_t *file_entry  = NULL;
-	libfsapfs_volume_t *volume          = NULL;
-	static char *function               = "info_handle_file_entries_fprint";
-	uint64_t file_system_identifier     = 0;
-	uint64_t next_file_entry_identifier = 0;
-	int number_of_volumes               = 0;
-	int result                          = 0;
-	int volume_index                    = 0;
+	libfsapfs_file_entry_iterator_t *file_entry_iterator = NULL;
+	libfsapfs_file_entry_t *file_entry                   = NULL;
+	libfsapfs_volume_t *volume                           = NULL;
+	static char *function                                = "info_handle_file_entries_fprint";
+	int number_of_volumes                                = 0;
+	int result                                           = 0;
+	int volume_index                                     = 0;
 
 	if( info_handle == NULL )
 	{
@@ -3728,16 +3727,19 @@ int info_handle_file_entries_fprint(
 
 		goto on_error;
 	}
-	if( libfsapfs_volume_get_next_file_entry_identifier(
+	/* The file entries are read in a single pass over the file system B-tree
+	 * instead of looking up every identifier up to the next file entry identifier
+	 */
+	if( libfsapfs_volume_get_file_entry_iterator(
 	     volume,
-	     &next_file_entry_identifier,
+	     &file_entry_iterator,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve next file entry identifier.",
+		 "%s: unable to retrieve file entry iterator.",
 		 function );
 
 		goto on_error;
@@ -3746,13 +3748,10 @@ int info_handle_file_entries_fprint(
 	 info_handle->notify_stream,
 	 "Apple File System (APFS) information:\n\n" );
 
-	for( file_system_identifier = 0;
-	     file_system_identifier < next_file_entry_identifier;
-	     file_system_identifier++ )
+	do
 	{
-		result = libfsapfs_volume_get_file_entry_by_identifier(
-		          volume,
-		          file_system_identifier,
+		result = libfsapfs_file_entry_iterator_get_next_file_entry(
+		          file_entry_iterator,
 		          &file_entry,
 		          error );
 
@@ -3761,10 +3760,9 @@ int info_handle_file_entries_fprint(
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to retrieve file entry: %" PRIu64 ".",
-			 function,
-			 file_system_identifier );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next file entry.",
+			 function );
 
 			goto on_error;
 		}
@@ -3787,9 +3785,8 @@ int info_handle_file_entries_fprint(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print file entry: %" PRIu64 " information.",
-				 function,
-				 file_system_identifier );
+				 "%s: unable to print file entry information.",
+				 function );
 
 				goto on_error;
 			}
@@ -3814,6 +3811,21 @@ int info_handle_file_entries_fprint(
 			}
 		}
 	}
+	while( result != 0 );
+
+	if( libfsapfs_file_entry_iterator_free(
+	     &file_entry_iterator,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfsapfs_volume_free(
 	     &volume,
 	     error ) != 1 )
@@ -3836,6 +3848,12 @@ on_error:
 		 &file_entry,
 		 NULL );
 	}
+	if( file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
 	if( volume != NULL )
 	{
 		libfsapfs_volume_free(
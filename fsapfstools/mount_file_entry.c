@@ -1019,6 +1019,167 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves a sub file entry iterator
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_sub_file_entry_iterator(
+     mount_file_entry_t *file_entry,
+     libfsapfs_file_entry_iterator_t **sub_file_entry_iterator,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_sub_file_entry_iterator";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_sub_file_entry_iterator(
+	     file_entry->fsapfs_file_entry,
+	     sub_file_entry_iterator,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the next sub file entry from a sub file entry iterator
+ * Returns 1 if successful, 0 if no more sub file entries or -1 on error
+ */
+int mount_file_entry_get_next_sub_file_entry(
+     mount_file_entry_t *file_entry,
+     libfsapfs_file_entry_iterator_t *sub_file_entry_iterator,
+     mount_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_entry_t *sub_fsapfs_file_entry = NULL;
+	system_character_t *filename                  = NULL;
+	static char *function                         = "mount_file_entry_get_next_sub_file_entry";
+	size_t filename_size                          = 0;
+	int result                                    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sub file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsapfs_file_entry_iterator_get_next_file_entry(
+	          sub_file_entry_iterator,
+	          &sub_fsapfs_file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next sub file entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( mount_file_system_get_filename_from_file_entry(
+	     file_entry->file_system,
+	     sub_fsapfs_file_entry,
+	     &filename,
+	     &filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename of sub file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_initialize(
+	     sub_file_entry,
+	     file_entry->file_system,
+	     filename,
+	     filename_size - 1,
+	     sub_fsapfs_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize sub file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( sub_fsapfs_file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &sub_fsapfs_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads data at a specific offset
  * Returns the number of bytes read or -1 on error
  */
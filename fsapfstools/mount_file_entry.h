@@ -124,6 +124,17 @@ int mount_file_entry_get_sub_file_entry_by_index(
      mount_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+int mount_file_entry_get_sub_file_entry_iterator(
+     mount_file_entry_t *file_entry,
+     libfsapfs_file_entry_iterator_t **sub_file_entry_iterator,
+     libcerror_error_t **error );
+
+int mount_file_entry_get_next_sub_file_entry(
+     mount_file_entry_t *file_entry,
+     libfsapfs_file_entry_iterator_t *sub_file_entry_iterator,
+     mount_file_entry_t **sub_file_entry,
+     libcerror_error_t **error );
+
 ssize_t mount_file_entry_read_buffer_at_offset(
          mount_file_entry_t *file_entry,
          void *buffer,
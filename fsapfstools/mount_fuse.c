@@ -1145,16 +1145,16 @@ int mount_fuse_readdir(
      off_t offset FSAPFSTOOLS_ATTRIBUTE_UNUSED,
      struct fuse_file_info *file_info FSAPFSTOOLS_ATTRIBUTE_UNUSED )
 {
-	struct stat *stat_info                = NULL;
-	libcerror_error_t *error              = NULL;
-	mount_file_entry_t *parent_file_entry = NULL;
-	mount_file_entry_t *sub_file_entry    = NULL;
-	static char *function                 = "mount_fuse_readdir";
-	char *name                            = NULL;
-	size_t name_size                      = 0;
-	int number_of_sub_file_entries        = 0;
-	int result                            = 0;
-	int sub_file_entry_index              = 0;
+	struct stat *stat_info                                   = NULL;
+	libcerror_error_t *error                                 = NULL;
+	libfsapfs_file_entry_iterator_t *sub_file_entry_iterator = NULL;
+	mount_file_entry_t *parent_file_entry                    = NULL;
+	mount_file_entry_t *sub_file_entry                       = NULL;
+	static char *function                                    = "mount_fuse_readdir";
+	char *name                                               = NULL;
+	size_t name_size                                         = 0;
+	int result                                               = 0;
+	int sub_file_entry_index                                 = 0;
 
 	FSAPFSTOOLS_UNREFERENCED_PARAMETER( offset )
 
@@ -1293,31 +1293,34 @@ int mount_fuse_readdir(
 
 		goto on_error;
 	}
-	if( mount_file_entry_get_number_of_sub_file_entries(
+	if( mount_file_entry_get_sub_file_entry_iterator(
 	     (mount_file_entry_t *) file_info->fh,
-	     &number_of_sub_file_entries,
+	     &sub_file_entry_iterator,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
+		 "%s: unable to retrieve sub file entry iterator.",
 		 function );
 
 		result = -EIO;
 
 		goto on_error;
 	}
-	for( sub_file_entry_index = 0;
-	     sub_file_entry_index < number_of_sub_file_entries;
-	     sub_file_entry_index++ )
+	/* The sub file entries are passed to the filler as they are read
+	 * instead of reading all the directory entries first
+	 */
+	do
 	{
-		if( mount_file_entry_get_sub_file_entry_by_index(
-		     (mount_file_entry_t *) file_info->fh,
-		     sub_file_entry_index,
-		     &sub_file_entry,
-		     &error ) != 1 )
+		result = mount_file_entry_get_next_sub_file_entry(
+		          (mount_file_entry_t *) file_info->fh,
+		          sub_file_entry_iterator,
+		          &sub_file_entry,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
@@ -1331,98 +1334,119 @@ int mount_fuse_readdir(
 
 			goto on_error;
 		}
-		if( mount_file_entry_get_name_size(
-		     sub_file_entry,
-		     &name_size,
-		     &error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d name size.",
-			 function,
-			 sub_file_entry_index );
+			if( mount_file_entry_get_name_size(
+			     sub_file_entry,
+			     &name_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub file entry: %d name size.",
+				 function,
+				 sub_file_entry_index );
 
-			result = -EIO;
+				result = -EIO;
 
-			goto on_error;
-		}
-		name = narrow_string_allocate(
-		        name_size );
+				goto on_error;
+			}
+			name = narrow_string_allocate(
+			        name_size );
 
-		if( name == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create sub file entry: %d name.",
-			 function );
+			if( name == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create sub file entry: %d name.",
+				 function );
 
-			result = -EIO;
+				result = -EIO;
 
-			goto on_error;
-		}
-		if( mount_file_entry_get_name(
-		     sub_file_entry,
-		     name,
-		     name_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d name.",
-			 function,
-			 sub_file_entry_index );
+				goto on_error;
+			}
+			if( mount_file_entry_get_name(
+			     sub_file_entry,
+			     name,
+			     name_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub file entry: %d name.",
+				 function,
+				 sub_file_entry_index );
 
-			result = -EIO;
+				result = -EIO;
 
-			goto on_error;
-		}
-		if( mount_fuse_filldir(
-		     buffer,
-		     filler,
-		     name,
-		     stat_info,
-		     sub_file_entry,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set directory entry.",
-			 function );
+				goto on_error;
+			}
+			if( mount_fuse_filldir(
+			     buffer,
+			     filler,
+			     name,
+			     stat_info,
+			     sub_file_entry,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set directory entry.",
+				 function );
 
-			result = -EIO;
+				result = -EIO;
 
-			goto on_error;
-		}
-		memory_free(
-		 name );
+				goto on_error;
+			}
+			memory_free(
+			 name );
 
-		name = NULL;
+			name = NULL;
 
-		if( mount_file_entry_free(
-		     &sub_file_entry,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+			if( mount_file_entry_free(
+			     &sub_file_entry,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub file entry: %d.",
+				 function,
+				 sub_file_entry_index );
 
-			result = -EIO;
+				result = -EIO;
 
-			goto on_error;
+				goto on_error;
+			}
+			sub_file_entry_index++;
 		}
 	}
+	while( result != 0 );
+
+	if( libfsapfs_file_entry_iterator_free(
+	     &sub_file_entry_iterator,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sub file entry iterator.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
 	memory_free(
 	 stat_info );
 
@@ -1447,6 +1471,12 @@ on_error:
 		 &sub_file_entry,
 		 NULL );
 	}
+	if( sub_file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &sub_file_entry_iterator,
+		 NULL );
+	}
 	if( parent_file_entry != NULL )
 	{
 		mount_file_entry_free(
@@ -0,0 +1,1289 @@
+/*
+ * AES-XTS context functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_aes_xts_context.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libcerror.h"
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define HAVE_LIBFSAPFS_AES_NI
+
+#if ( defined( __clang__ ) && ( __clang_major__ >= 6 ) ) || ( !defined( __clang__ ) && ( __GNUC__ >= 8 ) )
+#define HAVE_LIBFSAPFS_VAES
+#endif
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#elif ( defined( __GNUC__ ) || defined( __clang__ ) ) && defined( __aarch64__ ) && defined( __ARM_FEATURE_CRYPTO ) && !defined( __ARM_BIG_ENDIAN )
+#define HAVE_LIBFSAPFS_ARMV8_CRYPTO
+
+#include <arm_neon.h>
+
+#endif
+
+#if defined( HAVE_LIBFSAPFS_AES_NI )
+
+#define libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, round_key_index, round_constant ) \
+	round_keys[ round_key_index ] = libfsapfs_aes_xts_aes_ni_expand_key_128_step( \
+	                                 round_keys[ round_key_index - 1 ], \
+	                                 _mm_aeskeygenassist_si128( round_keys[ round_key_index - 1 ], round_constant ) )
+
+/* Determines the next AES-128 round key
+ * Returns the round key
+ */
+__attribute__((target("aes,sse2")))
+static inline __m128i libfsapfs_aes_xts_aes_ni_expand_key_128_step(
+                       __m128i round_key,
+                       __m128i key_generation_value )
+{
+	key_generation_value = _mm_shuffle_epi32(
+	                        key_generation_value,
+	                        0xff );
+
+	round_key = _mm_xor_si128(
+	             round_key,
+	             _mm_slli_si128(
+	              round_key,
+	              4 ) );
+	round_key = _mm_xor_si128(
+	             round_key,
+	             _mm_slli_si128(
+	              round_key,
+	              4 ) );
+	round_key = _mm_xor_si128(
+	             round_key,
+	             _mm_slli_si128(
+	              round_key,
+	              4 ) );
+
+	return( _mm_xor_si128(
+	         round_key,
+	         key_generation_value ) );
+}
+
+/* Multiplies a tweak value by the primitive element of GF(2^128)
+ * Returns the tweak value
+ */
+__attribute__((target("aes,sse2")))
+static inline __m128i libfsapfs_aes_xts_aes_ni_multiply_tweak(
+                       __m128i tweak_value )
+{
+	__m128i carry_value = _mm_shuffle_epi32(
+	                       _mm_srai_epi32(
+	                        tweak_value,
+	                        31 ),
+	                       0x93 );
+
+	carry_value = _mm_and_si128(
+	               carry_value,
+	               _mm_set_epi32(
+	                1,
+	                1,
+	                1,
+	                0x87 ) );
+
+	return( _mm_xor_si128(
+	         _mm_slli_epi32(
+	          tweak_value,
+	          1 ),
+	         carry_value ) );
+}
+
+/* Expands the AES-128 key and tweak key into round keys
+ */
+__attribute__((target("aes,sse2")))
+static void libfsapfs_aes_xts_aes_ni_set_keys_128(
+             libfsapfs_aes_xts_context_t *context,
+             const uint8_t *key,
+             const uint8_t *tweak_key )
+{
+	__m128i round_keys[ 11 ];
+
+	int round_key_index = 0;
+
+	round_keys[ 0 ] = _mm_loadu_si128(
+	                   (const __m128i *) key );
+
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 1, 0x01 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 2, 0x02 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 3, 0x04 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 4, 0x08 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 5, 0x10 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 6, 0x20 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 7, 0x40 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 8, 0x80 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 9, 0x1b );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 10, 0x36 );
+
+	/* The decryption round keys are the encryption round keys in reverse order
+	 * where the inner round keys are transformed by the inverse mix columns
+	 */
+	_mm_storeu_si128(
+	 (__m128i *) context->decryption_round_keys,
+	 round_keys[ 10 ] );
+
+	for( round_key_index = 1;
+	     round_key_index < 10;
+	     round_key_index++ )
+	{
+		_mm_storeu_si128(
+		 (__m128i *) &( context->decryption_round_keys[ round_key_index * 16 ] ),
+		 _mm_aesimc_si128(
+		  round_keys[ 10 - round_key_index ] ) );
+	}
+	_mm_storeu_si128(
+	 (__m128i *) &( context->decryption_round_keys[ 10 * 16 ] ),
+	 round_keys[ 0 ] );
+
+	round_keys[ 0 ] = _mm_loadu_si128(
+	                   (const __m128i *) tweak_key );
+
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 1, 0x01 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 2, 0x02 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 3, 0x04 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 4, 0x08 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 5, 0x10 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 6, 0x20 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 7, 0x40 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 8, 0x80 );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 9, 0x1b );
+	libfsapfs_aes_xts_aes_ni_expand_key_128( round_keys, 10, 0x36 );
+
+	for( round_key_index = 0;
+	     round_key_index < 11;
+	     round_key_index++ )
+	{
+		_mm_storeu_si128(
+		 (__m128i *) &( context->tweak_encryption_round_keys[ round_key_index * 16 ] ),
+		 round_keys[ round_key_index ] );
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m128i ) * 11 );
+}
+
+/* Determines the initial tweak value of a sector by encrypting the sector number with the tweak key
+ * Returns the tweak value
+ */
+__attribute__((target("aes,sse2")))
+static inline __m128i libfsapfs_aes_xts_aes_ni_get_sector_tweak(
+                       libfsapfs_aes_xts_context_t *context,
+                       uint64_t sector_number )
+{
+	__m128i tweak_value = _mm_set_epi64x(
+	                       0,
+	                       (int64_t) sector_number );
+
+	int round_key_index = 0;
+
+	tweak_value = _mm_xor_si128(
+	               tweak_value,
+	               _mm_loadu_si128(
+	                (const __m128i *) context->tweak_encryption_round_keys ) );
+
+	for( round_key_index = 1;
+	     round_key_index < 10;
+	     round_key_index++ )
+	{
+		tweak_value = _mm_aesenc_si128(
+		               tweak_value,
+		               _mm_loadu_si128(
+		                (const __m128i *) &( context->tweak_encryption_round_keys[ round_key_index * 16 ] ) ) );
+	}
+	return( _mm_aesenclast_si128(
+	         tweak_value,
+	         _mm_loadu_si128(
+	          (const __m128i *) &( context->tweak_encryption_round_keys[ 10 * 16 ] ) ) ) );
+}
+
+/* Decrypts blocks of 16 bytes with AES-NI, 8 blocks at a time
+ * Returns the tweak value of the block following the decrypted blocks
+ */
+__attribute__((target("aes,sse2")))
+static __m128i libfsapfs_aes_xts_aes_ni_decrypt_blocks(
+                const __m128i *round_keys,
+                const uint8_t *input_data,
+                uint8_t *output_data,
+                size_t number_of_blocks,
+                __m128i tweak_value )
+{
+	__m128i block_values[ 8 ];
+	__m128i tweak_values[ 8 ];
+
+	size_t block_index  = 0;
+	int round_key_index = 0;
+	int value_index     = 0;
+
+	while( number_of_blocks >= 8 )
+	{
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			tweak_values[ value_index ] = tweak_value;
+			tweak_value                 = libfsapfs_aes_xts_aes_ni_multiply_tweak(
+			                               tweak_value );
+
+			block_values[ value_index ] = _mm_xor_si128(
+			                               _mm_loadu_si128(
+			                                (const __m128i *) &( input_data[ ( block_index + value_index ) * 16 ] ) ),
+			                               tweak_values[ value_index ] );
+			block_values[ value_index ] = _mm_xor_si128(
+			                               block_values[ value_index ],
+			                               round_keys[ 0 ] );
+		}
+		for( round_key_index = 1;
+		     round_key_index < 10;
+		     round_key_index++ )
+		{
+			for( value_index = 0;
+			     value_index < 8;
+			     value_index++ )
+			{
+				block_values[ value_index ] = _mm_aesdec_si128(
+				                               block_values[ value_index ],
+				                               round_keys[ round_key_index ] );
+			}
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			block_values[ value_index ] = _mm_aesdeclast_si128(
+			                               block_values[ value_index ],
+			                               round_keys[ 10 ] );
+
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ ( block_index + value_index ) * 16 ] ),
+			 _mm_xor_si128(
+			  block_values[ value_index ],
+			  tweak_values[ value_index ] ) );
+		}
+		block_index      += 8;
+		number_of_blocks -= 8;
+	}
+	while( number_of_blocks > 0 )
+	{
+		block_values[ 0 ] = _mm_xor_si128(
+		                     _mm_loadu_si128(
+		                      (const __m128i *) &( input_data[ block_index * 16 ] ) ),
+		                     tweak_value );
+		block_values[ 0 ] = _mm_xor_si128(
+		                     block_values[ 0 ],
+		                     round_keys[ 0 ] );
+
+		for( round_key_index = 1;
+		     round_key_index < 10;
+		     round_key_index++ )
+		{
+			block_values[ 0 ] = _mm_aesdec_si128(
+			                     block_values[ 0 ],
+			                     round_keys[ round_key_index ] );
+		}
+		block_values[ 0 ] = _mm_aesdeclast_si128(
+		                     block_values[ 0 ],
+		                     round_keys[ 10 ] );
+
+		_mm_storeu_si128(
+		 (__m128i *) &( output_data[ block_index * 16 ] ),
+		 _mm_xor_si128(
+		  block_values[ 0 ],
+		  tweak_value ) );
+
+		tweak_value = libfsapfs_aes_xts_aes_ni_multiply_tweak(
+		               tweak_value );
+
+		block_index      += 1;
+		number_of_blocks -= 1;
+	}
+	return( tweak_value );
+}
+
+/* Decrypts sectors with AES-NI
+ */
+__attribute__((target("aes,sse2")))
+static void libfsapfs_aes_xts_aes_ni_decrypt(
+             libfsapfs_aes_xts_context_t *context,
+             const uint8_t *input_data,
+             size_t input_data_size,
+             uint8_t *output_data,
+             uint64_t sector_number,
+             uint16_t bytes_per_sector )
+{
+	__m128i round_keys[ 11 ];
+
+	size_t data_offset  = 0;
+	int round_key_index = 0;
+
+	for( round_key_index = 0;
+	     round_key_index < 11;
+	     round_key_index++ )
+	{
+		round_keys[ round_key_index ] = _mm_loadu_si128(
+		                                 (const __m128i *) &( context->decryption_round_keys[ round_key_index * 16 ] ) );
+	}
+	for( data_offset = 0;
+	     data_offset < input_data_size;
+	     data_offset += bytes_per_sector )
+	{
+		libfsapfs_aes_xts_aes_ni_decrypt_blocks(
+		 round_keys,
+		 &( input_data[ data_offset ] ),
+		 &( output_data[ data_offset ] ),
+		 bytes_per_sector / 16,
+		 libfsapfs_aes_xts_aes_ni_get_sector_tweak(
+		  context,
+		  sector_number ) );
+
+		sector_number += 1;
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m128i ) * 11 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI ) */
+
+#if defined( HAVE_LIBFSAPFS_VAES )
+
+/* Decrypts sectors with VAES and AVX-512, 16 blocks at a time
+ */
+__attribute__((target("aes,sse2,vaes,avx512f")))
+static void libfsapfs_aes_xts_vaes_decrypt(
+             libfsapfs_aes_xts_context_t *context,
+             const uint8_t *input_data,
+             size_t input_data_size,
+             uint8_t *output_data,
+             uint64_t sector_number,
+             uint16_t bytes_per_sector )
+{
+	__m128i round_keys[ 11 ];
+	__m128i tweak_values[ 16 ];
+	__m512i wide_round_keys[ 11 ];
+	__m512i block_values[ 4 ];
+	__m512i wide_tweak_values[ 4 ];
+
+	const uint8_t *sector_input_data = NULL;
+	uint8_t *sector_output_data      = NULL;
+	__m128i tweak_value;
+	size_t block_index               = 0;
+	size_t data_offset               = 0;
+	size_t number_of_blocks          = 0;
+	int round_key_index              = 0;
+	int value_index                  = 0;
+
+	for( round_key_index = 0;
+	     round_key_index < 11;
+	     round_key_index++ )
+	{
+		round_keys[ round_key_index ] = _mm_loadu_si128(
+		                                 (const __m128i *) &( context->decryption_round_keys[ round_key_index * 16 ] ) );
+
+		wide_round_keys[ round_key_index ] = _mm512_broadcast_i32x4(
+		                                      round_keys[ round_key_index ] );
+	}
+	for( data_offset = 0;
+	     data_offset < input_data_size;
+	     data_offset += bytes_per_sector )
+	{
+		sector_input_data  = &( input_data[ data_offset ] );
+		sector_output_data = &( output_data[ data_offset ] );
+		number_of_blocks   = bytes_per_sector / 16;
+		block_index        = 0;
+
+		tweak_value = libfsapfs_aes_xts_aes_ni_get_sector_tweak(
+		               context,
+		               sector_number );
+
+		while( number_of_blocks >= 16 )
+		{
+			for( value_index = 0;
+			     value_index < 16;
+			     value_index++ )
+			{
+				tweak_values[ value_index ] = tweak_value;
+				tweak_value                 = libfsapfs_aes_xts_aes_ni_multiply_tweak(
+				                               tweak_value );
+			}
+			for( value_index = 0;
+			     value_index < 4;
+			     value_index++ )
+			{
+				wide_tweak_values[ value_index ] = _mm512_loadu_si512(
+				                                    (const void *) &( tweak_values[ value_index * 4 ] ) );
+
+				block_values[ value_index ] = _mm512_xor_si512(
+				                               _mm512_loadu_si512(
+				                                (const void *) &( sector_input_data[ ( block_index + ( value_index * 4 ) ) * 16 ] ) ),
+				                               wide_tweak_values[ value_index ] );
+				block_values[ value_index ] = _mm512_xor_si512(
+				                               block_values[ value_index ],
+				                               wide_round_keys[ 0 ] );
+			}
+			for( round_key_index = 1;
+			     round_key_index < 10;
+			     round_key_index++ )
+			{
+				for( value_index = 0;
+				     value_index < 4;
+				     value_index++ )
+				{
+					block_values[ value_index ] = _mm512_aesdec_epi128(
+					                               block_values[ value_index ],
+					                               wide_round_keys[ round_key_index ] );
+				}
+			}
+			for( value_index = 0;
+			     value_index < 4;
+			     value_index++ )
+			{
+				block_values[ value_index ] = _mm512_aesdeclast_epi128(
+				                               block_values[ value_index ],
+				                               wide_round_keys[ 10 ] );
+
+				_mm512_storeu_si512(
+				 (void *) &( sector_output_data[ ( block_index + ( value_index * 4 ) ) * 16 ] ),
+				 _mm512_xor_si512(
+				  block_values[ value_index ],
+				  wide_tweak_values[ value_index ] ) );
+			}
+			block_index      += 16;
+			number_of_blocks -= 16;
+		}
+		if( number_of_blocks > 0 )
+		{
+			libfsapfs_aes_xts_aes_ni_decrypt_blocks(
+			 round_keys,
+			 &( sector_input_data[ block_index * 16 ] ),
+			 &( sector_output_data[ block_index * 16 ] ),
+			 number_of_blocks,
+			 tweak_value );
+		}
+		sector_number += 1;
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( __m128i ) * 11 );
+
+	memory_set(
+	 wide_round_keys,
+	 0,
+	 sizeof( __m512i ) * 11 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_VAES ) */
+
+#if defined( HAVE_LIBFSAPFS_ARMV8_CRYPTO )
+
+/* Substitutes the bytes of a 32-bit word with the AES S-box
+ * Since all columns of the state are the same, the shift rows of AESE has no effect
+ * Returns the substituted word
+ */
+static inline uint32_t libfsapfs_aes_xts_armv8_substitute_word(
+                        uint32_t value )
+{
+	uint8x16_t block_value = vaeseq_u8(
+	                          vreinterpretq_u8_u32(
+	                           vdupq_n_u32(
+	                            value ) ),
+	                          vdupq_n_u8(
+	                           0 ) );
+
+	return( vgetq_lane_u32(
+	         vreinterpretq_u32_u8(
+	          block_value ),
+	         0 ) );
+}
+
+/* Expands an AES-128 key into round keys
+ */
+static void libfsapfs_aes_xts_armv8_expand_key_128(
+             const uint8_t *key,
+             uint8x16_t *round_keys )
+{
+	uint32_t round_key_words[ 44 ];
+
+	uint32_t round_constant = 0x01;
+	uint32_t word_value     = 0;
+	int round_key_index     = 0;
+	int word_index          = 0;
+
+	memory_copy(
+	 round_key_words,
+	 key,
+	 16 );
+
+	for( word_index = 4;
+	     word_index < 44;
+	     word_index++ )
+	{
+		word_value = round_key_words[ word_index - 1 ];
+
+		if( ( word_index % 4 ) == 0 )
+		{
+			word_value = libfsapfs_aes_xts_armv8_substitute_word(
+			              word_value );
+
+			/* The words are stored little-endian hence rotating the word is a right rotation of 8 bits
+			 */
+			word_value = ( ( word_value >> 8 ) | ( word_value << 24 ) ) ^ round_constant;
+
+			round_constant <<= 1;
+
+			if( round_constant > 0x80 )
+			{
+				round_constant ^= 0x11b;
+			}
+		}
+		round_key_words[ word_index ] = round_key_words[ word_index - 4 ] ^ word_value;
+	}
+	for( round_key_index = 0;
+	     round_key_index < 11;
+	     round_key_index++ )
+	{
+		round_keys[ round_key_index ] = vreinterpretq_u8_u32(
+		                                 vld1q_u32(
+		                                  &( round_key_words[ round_key_index * 4 ] ) ) );
+	}
+	memory_set(
+	 round_key_words,
+	 0,
+	 sizeof( uint32_t ) * 44 );
+}
+
+/* Multiplies a tweak value by the primitive element of GF(2^128)
+ * Returns the tweak value
+ */
+static inline uint8x16_t libfsapfs_aes_xts_armv8_multiply_tweak(
+                          uint8x16_t tweak_value )
+{
+	uint64x2_t value_64bit = vreinterpretq_u64_u8(
+	                          tweak_value );
+
+	/* The carry of the lower 64 bits moves into the upper 64 bits
+	 * and the carry of the upper 64 bits is reduced into the lower 64 bits
+	 */
+	int64x2_t carry_value = vshrq_n_s64(
+	                         vreinterpretq_s64_u64(
+	                          value_64bit ),
+	                         63 );
+
+	carry_value = vextq_s64(
+	               carry_value,
+	               carry_value,
+	               1 );
+
+	carry_value = vandq_s64(
+	               carry_value,
+	               vcombine_s64(
+	                vcreate_s64(
+	                 0x87 ),
+	                vcreate_s64(
+	                 1 ) ) );
+
+	return( vreinterpretq_u8_u64(
+	         veorq_u64(
+	          vshlq_n_u64(
+	           value_64bit,
+	           1 ),
+	          vreinterpretq_u64_s64(
+	           carry_value ) ) ) );
+}
+
+/* Expands the AES-128 key and tweak key into round keys
+ */
+static void libfsapfs_aes_xts_armv8_set_keys_128(
+             libfsapfs_aes_xts_context_t *context,
+             const uint8_t *key,
+             const uint8_t *tweak_key )
+{
+	uint8x16_t round_keys[ 11 ];
+
+	int round_key_index = 0;
+
+	libfsapfs_aes_xts_armv8_expand_key_128(
+	 key,
+	 round_keys );
+
+	/* The decryption round keys are stored in the same layout as those of AES-NI
+	 */
+	vst1q_u8(
+	 context->decryption_round_keys,
+	 round_keys[ 10 ] );
+
+	for( round_key_index = 1;
+	     round_key_index < 10;
+	     round_key_index++ )
+	{
+		vst1q_u8(
+		 &( context->decryption_round_keys[ round_key_index * 16 ] ),
+		 vaesimcq_u8(
+		  round_keys[ 10 - round_key_index ] ) );
+	}
+	vst1q_u8(
+	 &( context->decryption_round_keys[ 10 * 16 ] ),
+	 round_keys[ 0 ] );
+
+	libfsapfs_aes_xts_armv8_expand_key_128(
+	 tweak_key,
+	 round_keys );
+
+	for( round_key_index = 0;
+	     round_key_index < 11;
+	     round_key_index++ )
+	{
+		vst1q_u8(
+		 &( context->tweak_encryption_round_keys[ round_key_index * 16 ] ),
+		 round_keys[ round_key_index ] );
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( uint8x16_t ) * 11 );
+}
+
+/* Determines the initial tweak value of a sector by encrypting the sector number with the tweak key
+ * Returns the tweak value
+ */
+static inline uint8x16_t libfsapfs_aes_xts_armv8_get_sector_tweak(
+                          libfsapfs_aes_xts_context_t *context,
+                          uint64_t sector_number )
+{
+	uint8x16_t tweak_value = vreinterpretq_u8_u64(
+	                          vcombine_u64(
+	                           vcreate_u64(
+	                            sector_number ),
+	                           vcreate_u64(
+	                            0 ) ) );
+
+	int round_key_index    = 0;
+
+	/* AESE adds the round key before the substitution hence
+	 * the last round key is added separately
+	 */
+	for( round_key_index = 0;
+	     round_key_index < 9;
+	     round_key_index++ )
+	{
+		tweak_value = vaesmcq_u8(
+		               vaeseq_u8(
+		                tweak_value,
+		                vld1q_u8(
+		                 &( context->tweak_encryption_round_keys[ round_key_index * 16 ] ) ) ) );
+	}
+	tweak_value = vaeseq_u8(
+	               tweak_value,
+	               vld1q_u8(
+	                &( context->tweak_encryption_round_keys[ 9 * 16 ] ) ) );
+
+	return( veorq_u8(
+	         tweak_value,
+	         vld1q_u8(
+	          &( context->tweak_encryption_round_keys[ 10 * 16 ] ) ) ) );
+}
+
+/* Decrypts blocks of 16 bytes with the ARMv8 cryptography extension, 8 blocks at a time
+ */
+static void libfsapfs_aes_xts_armv8_decrypt_blocks(
+             const uint8x16_t *round_keys,
+             const uint8_t *input_data,
+             uint8_t *output_data,
+             size_t number_of_blocks,
+             uint8x16_t tweak_value )
+{
+	uint8x16_t block_values[ 8 ];
+	uint8x16_t tweak_values[ 8 ];
+
+	size_t block_index  = 0;
+	int round_key_index = 0;
+	int value_index     = 0;
+
+	/* AESD adds the round key before the inverse substitution hence
+	 * the last round key is added separately
+	 */
+	while( number_of_blocks >= 8 )
+	{
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			tweak_values[ value_index ] = tweak_value;
+			tweak_value                 = libfsapfs_aes_xts_armv8_multiply_tweak(
+			                               tweak_value );
+
+			block_values[ value_index ] = veorq_u8(
+			                               vld1q_u8(
+			                                &( input_data[ ( block_index + value_index ) * 16 ] ) ),
+			                               tweak_values[ value_index ] );
+		}
+		for( round_key_index = 0;
+		     round_key_index < 9;
+		     round_key_index++ )
+		{
+			for( value_index = 0;
+			     value_index < 8;
+			     value_index++ )
+			{
+				block_values[ value_index ] = vaesimcq_u8(
+				                               vaesdq_u8(
+				                                block_values[ value_index ],
+				                                round_keys[ round_key_index ] ) );
+			}
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			block_values[ value_index ] = vaesdq_u8(
+			                               block_values[ value_index ],
+			                               round_keys[ 9 ] );
+
+			vst1q_u8(
+			 &( output_data[ ( block_index + value_index ) * 16 ] ),
+			 veorq_u8(
+			  veorq_u8(
+			   block_values[ value_index ],
+			   round_keys[ 10 ] ),
+			  tweak_values[ value_index ] ) );
+		}
+		block_index      += 8;
+		number_of_blocks -= 8;
+	}
+	while( number_of_blocks > 0 )
+	{
+		block_values[ 0 ] = veorq_u8(
+		                     vld1q_u8(
+		                      &( input_data[ block_index * 16 ] ) ),
+		                     tweak_value );
+
+		for( round_key_index = 0;
+		     round_key_index < 9;
+		     round_key_index++ )
+		{
+			block_values[ 0 ] = vaesimcq_u8(
+			                     vaesdq_u8(
+			                      block_values[ 0 ],
+			                      round_keys[ round_key_index ] ) );
+		}
+		block_values[ 0 ] = vaesdq_u8(
+		                     block_values[ 0 ],
+		                     round_keys[ 9 ] );
+
+		vst1q_u8(
+		 &( output_data[ block_index * 16 ] ),
+		 veorq_u8(
+		  veorq_u8(
+		   block_values[ 0 ],
+		   round_keys[ 10 ] ),
+		  tweak_value ) );
+
+		tweak_value = libfsapfs_aes_xts_armv8_multiply_tweak(
+		               tweak_value );
+
+		block_index      += 1;
+		number_of_blocks -= 1;
+	}
+}
+
+/* Decrypts sectors with the ARMv8 cryptography extension
+ */
+static void libfsapfs_aes_xts_armv8_decrypt(
+             libfsapfs_aes_xts_context_t *context,
+             const uint8_t *input_data,
+             size_t input_data_size,
+             uint8_t *output_data,
+             uint64_t sector_number,
+             uint16_t bytes_per_sector )
+{
+	uint8x16_t round_keys[ 11 ];
+
+	size_t data_offset  = 0;
+	int round_key_index = 0;
+
+	for( round_key_index = 0;
+	     round_key_index < 11;
+	     round_key_index++ )
+	{
+		round_keys[ round_key_index ] = vld1q_u8(
+		                                 &( context->decryption_round_keys[ round_key_index * 16 ] ) );
+	}
+	for( data_offset = 0;
+	     data_offset < input_data_size;
+	     data_offset += bytes_per_sector )
+	{
+		libfsapfs_aes_xts_armv8_decrypt_blocks(
+		 round_keys,
+		 &( input_data[ data_offset ] ),
+		 &( output_data[ data_offset ] ),
+		 bytes_per_sector / 16,
+		 libfsapfs_aes_xts_armv8_get_sector_tweak(
+		  context,
+		  sector_number ) );
+
+		sector_number += 1;
+	}
+	memory_set(
+	 round_keys,
+	 0,
+	 sizeof( uint8x16_t ) * 11 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_ARMV8_CRYPTO ) */
+
+/* Determines the best AES-XTS backend supported by the CPU
+ * Returns the backend, which is LIBFSAPFS_AES_XTS_BACKEND_NONE if no backend is supported
+ */
+int libfsapfs_aes_xts_context_get_supported_backend(
+     void )
+{
+#if defined( HAVE_LIBFSAPFS_AES_NI )
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+#if defined( HAVE_LIBFSAPFS_VAES )
+	unsigned int extended_control_register_eax = 0;
+	unsigned int extended_control_register_edx = 0;
+#endif
+
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( LIBFSAPFS_AES_XTS_BACKEND_NONE );
+	}
+	/* CPUID leaf 1 ECX bit 25 indicates AES-NI support
+	 */
+	if( ( ecx & 0x02000000UL ) == 0 )
+	{
+		return( LIBFSAPFS_AES_XTS_BACKEND_NONE );
+	}
+#if defined( HAVE_LIBFSAPFS_VAES )
+	/* CPUID leaf 1 ECX bit 27 indicates the operating system uses XSAVE
+	 * and XCR0 indicates that it preserves the AVX-512 register state
+	 */
+	if( ( ecx & 0x08000000UL ) != 0 )
+	{
+		__asm__ __volatile__ (
+		 "xgetbv"
+		 : "=a" ( extended_control_register_eax ), "=d" ( extended_control_register_edx )
+		 : "c" ( 0 ) );
+
+		if( ( ( extended_control_register_eax & 0xe6 ) == 0xe6 )
+		 && ( __get_cpuid_count(
+		       7,
+		       0,
+		       &eax,
+		       &ebx,
+		       &ecx,
+		       &edx ) != 0 ) )
+		{
+			/* CPUID leaf 7 EBX bit 16 indicates AVX-512F and ECX bit 9 VAES support
+			 */
+			if( ( ( ebx & 0x00010000UL ) != 0 )
+			 && ( ( ecx & 0x00000200UL ) != 0 ) )
+			{
+				return( LIBFSAPFS_AES_XTS_BACKEND_VAES );
+			}
+		}
+	}
+#endif /* defined( HAVE_LIBFSAPFS_VAES ) */
+
+	return( LIBFSAPFS_AES_XTS_BACKEND_AES_NI );
+
+#elif defined( HAVE_LIBFSAPFS_ARMV8_CRYPTO )
+	return( LIBFSAPFS_AES_XTS_BACKEND_ARMV8_CRYPTO );
+#else
+	return( LIBFSAPFS_AES_XTS_BACKEND_NONE );
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI ) */
+}
+
+/* Determines the next slower AES-XTS backend of a backend
+ * Returns the backend, which is LIBFSAPFS_AES_XTS_BACKEND_NONE if there is no slower backend
+ */
+int libfsapfs_aes_xts_context_get_fallback_backend(
+     int backend )
+{
+	if( backend == LIBFSAPFS_AES_XTS_BACKEND_VAES )
+	{
+		return( LIBFSAPFS_AES_XTS_BACKEND_AES_NI );
+	}
+	return( LIBFSAPFS_AES_XTS_BACKEND_NONE );
+}
+
+/* Creates an AES-XTS context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_aes_xts_context_initialize(
+     libfsapfs_aes_xts_context_t **context,
+     int backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_aes_xts_context_initialize";
+	int supported_backend = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* The backend must be the supported backend or one of its fallback backends
+	 */
+	supported_backend = libfsapfs_aes_xts_context_get_supported_backend();
+
+	while( ( supported_backend != LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	    && ( supported_backend != backend ) )
+	{
+		supported_backend = libfsapfs_aes_xts_context_get_fallback_backend(
+		                     supported_backend );
+	}
+	if( ( backend == LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	 || ( supported_backend != backend ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported backend.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            libfsapfs_aes_xts_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( libfsapfs_aes_xts_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+	( *context )->backend = backend;
+
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an AES-XTS context
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_aes_xts_context_free(
+     libfsapfs_aes_xts_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_aes_xts_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		memory_set(
+		 *context,
+		 0,
+		 sizeof( libfsapfs_aes_xts_context_t ) );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the key and tweak key
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_aes_xts_context_set_keys(
+     libfsapfs_aes_xts_context_t *context,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_aes_xts_context_set_keys";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_bit_size != 128 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+	switch( context->backend )
+	{
+#if defined( HAVE_LIBFSAPFS_AES_NI )
+		case LIBFSAPFS_AES_XTS_BACKEND_AES_NI:
+		case LIBFSAPFS_AES_XTS_BACKEND_VAES:
+			libfsapfs_aes_xts_aes_ni_set_keys_128(
+			 context,
+			 key,
+			 tweak_key );
+			break;
+#endif
+
+#if defined( HAVE_LIBFSAPFS_ARMV8_CRYPTO )
+		case LIBFSAPFS_AES_XTS_BACKEND_ARMV8_CRYPTO:
+			libfsapfs_aes_xts_armv8_set_keys_128(
+			 context,
+			 key,
+			 tweak_key );
+			break;
+#endif
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid context - unsupported backend.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts consecutive sectors of data
+ * The number of bytes per sector must be a multiple of 16
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_aes_xts_context_decrypt(
+     libfsapfs_aes_xts_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_aes_xts_context_decrypt";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size % bytes_per_sector ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	switch( context->backend )
+	{
+#if defined( HAVE_LIBFSAPFS_VAES )
+		case LIBFSAPFS_AES_XTS_BACKEND_VAES:
+			libfsapfs_aes_xts_vaes_decrypt(
+			 context,
+			 input_data,
+			 input_data_size,
+			 output_data,
+			 sector_number,
+			 bytes_per_sector );
+			break;
+#endif
+
+#if defined( HAVE_LIBFSAPFS_AES_NI )
+		case LIBFSAPFS_AES_XTS_BACKEND_AES_NI:
+			libfsapfs_aes_xts_aes_ni_decrypt(
+			 context,
+			 input_data,
+			 input_data_size,
+			 output_data,
+			 sector_number,
+			 bytes_per_sector );
+			break;
+#endif
+
+#if defined( HAVE_LIBFSAPFS_ARMV8_CRYPTO )
+		case LIBFSAPFS_AES_XTS_BACKEND_ARMV8_CRYPTO:
+			libfsapfs_aes_xts_armv8_decrypt(
+			 context,
+			 input_data,
+			 input_data_size,
+			 output_data,
+			 sector_number,
+			 bytes_per_sector );
+			break;
+#endif
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid context - unsupported backend.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
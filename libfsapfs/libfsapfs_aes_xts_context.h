@@ -0,0 +1,87 @@
+/*
+ * AES-XTS context functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_AES_XTS_CONTEXT_H )
+#define _LIBFSAPFS_AES_XTS_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_aes_xts_context libfsapfs_aes_xts_context_t;
+
+struct libfsapfs_aes_xts_context
+{
+	/* The backend
+	 */
+	int backend;
+
+	/* The decryption round keys of the key
+	 */
+	uint8_t decryption_round_keys[ 11 * 16 ];
+
+	/* The encryption round keys of the tweak key
+	 */
+	uint8_t tweak_encryption_round_keys[ 11 * 16 ];
+};
+
+int libfsapfs_aes_xts_context_get_supported_backend(
+     void );
+
+int libfsapfs_aes_xts_context_get_fallback_backend(
+     int backend );
+
+int libfsapfs_aes_xts_context_initialize(
+     libfsapfs_aes_xts_context_t **context,
+     int backend,
+     libcerror_error_t **error );
+
+int libfsapfs_aes_xts_context_free(
+     libfsapfs_aes_xts_context_t **context,
+     libcerror_error_t **error );
+
+int libfsapfs_aes_xts_context_set_keys(
+     libfsapfs_aes_xts_context_t *context,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libfsapfs_aes_xts_context_decrypt(
+     libfsapfs_aes_xts_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_AES_XTS_CONTEXT_H ) */
+
@@ -25,14 +25,14 @@
 #include <common.h>
 #include <types.h>
 
-#include "libfsapfs_libcerror.h"
-
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
 typedef struct libfsapfs_btree_entry libfsapfs_btree_entry_t;
 
+/* The key and value data reference the data of the B-tree node that contains the entry
+ */
 struct libfsapfs_btree_entry
 {
 	/* The key data
@@ -52,26 +52,6 @@ struct libfsapfs_btree_entry
 	size_t value_data_size;
 };
 
-int libfsapfs_btree_entry_initialize(
-     libfsapfs_btree_entry_t **btree_entry,
-     libcerror_error_t **error );
-
-int libfsapfs_btree_entry_free(
-     libfsapfs_btree_entry_t **btree_entry,
-     libcerror_error_t **error );
-
-int libfsapfs_btree_entry_set_key_data(
-     libfsapfs_btree_entry_t *btree_entry,
-     const uint8_t *key_data,
-     size_t key_data_size,
-     libcerror_error_t **error );
-
-int libfsapfs_btree_entry_set_value_data(
-     libfsapfs_btree_entry_t *btree_entry,
-     const uint8_t *value_data,
-     size_t value_data_size,
-     libcerror_error_t **error );
-
 #if defined( __cplusplus )
 }
 #endif
@@ -28,7 +28,6 @@
 #include "libfsapfs_btree_footer.h"
 #include "libfsapfs_btree_node_header.h"
 #include "libfsapfs_btree_node.h"
-#include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
 
@@ -101,20 +100,6 @@ int libfsapfs_btree_node_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( ( *btree_node )->entries_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create entries array.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -183,19 +168,15 @@ int libfsapfs_btree_node_free(
 				result = -1;
 			}
 		}
-		if( libcdata_array_free(
-		     &( ( *btree_node )->entries_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_entry_free,
-		     error ) != 1 )
+		if( ( *btree_node )->entries != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free entries array.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 ( *btree_node )->entries );
+		}
+		if( ( *btree_node )->data != NULL )
+		{
+			memory_free(
+			 ( *btree_node )->data );
 		}
 		memory_free(
 		 *btree_node );
@@ -228,7 +209,6 @@ int libfsapfs_btree_node_read_data(
 	uint16_t map_entry_index             = 0;
 	uint16_t value_data_offset           = 0;
 	uint16_t value_data_size             = 0;
-	int entry_index                      = 0;
 
 	if( btree_node == NULL )
 	{
@@ -445,6 +425,56 @@ int libfsapfs_btree_node_read_data(
 
 		goto on_error;
 	}
+	/* The node data is copied so that the keys and values of the entries
+	 * remain available independent of the data block they were read from
+	 */
+	btree_node->data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * data_size );
+
+	if( btree_node->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     btree_node->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		goto on_error;
+	}
+	btree_node->data_size = data_size;
+
+	if( btree_node->node_header->number_of_keys > 0 )
+	{
+		btree_node->entries = (libfsapfs_btree_entry_t *) memory_allocate(
+		                                                   sizeof( libfsapfs_btree_entry_t ) * btree_node->node_header->number_of_keys );
+
+		if( btree_node->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	data_offset += btree_node->node_header->entries_data_offset;
 
 	entries_data_offset = btree_node->node_header->entries_data_offset + (uint16_t) ( sizeof( fsapfs_object_t ) + sizeof( fsapfs_btree_node_header_t ) );
@@ -596,76 +626,34 @@ int libfsapfs_btree_node_read_data(
 			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 		}
 #endif
-		if( libfsapfs_btree_entry_initialize(
-		     &btree_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree entry.",
-			 function );
+		btree_entry = &( btree_node->entries[ map_entry_index ] );
 
-			goto on_error;
-		}
-		if( libfsapfs_btree_entry_set_key_data(
-		     btree_entry,
-		     &( data[ key_data_offset ] ),
-		     (size_t) key_data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set key data in B-tree entry.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_entry_set_value_data(
-		     btree_entry,
-		     &( data[ value_data_offset ] ),
-		     (size_t) value_data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value data in B-tree entry.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_array_append_entry(
-		     btree_node->entries_array,
-		     &entry_index,
-		     (intptr_t *) btree_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append B-tree entry: %" PRIu32 " to array.",
-			 function,
-			 map_entry_index );
-
-			goto on_error;
-		}
-		btree_entry = NULL;
+		btree_entry->key_data        = &( btree_node->data[ key_data_offset ] );
+		btree_entry->key_data_size   = (size_t) key_data_size;
+		btree_entry->value_data      = &( btree_node->data[ value_data_offset ] );
+		btree_entry->value_data_size = (size_t) value_data_size;
 	}
+	btree_node->number_of_entries = (int) btree_node->node_header->number_of_keys;
+
 	return( 1 );
 
 on_error:
-	if( btree_entry != NULL )
+	if( btree_node->entries != NULL )
 	{
-		libfsapfs_btree_entry_free(
-		 &btree_entry,
-		 NULL );
+		memory_free(
+		 btree_node->entries );
+
+		btree_node->entries = NULL;
+	}
+	if( btree_node->data != NULL )
+	{
+		memory_free(
+		 btree_node->data );
+
+		btree_node->data = NULL;
 	}
+	btree_node->data_size = 0;
+
 	if( btree_node->footer != NULL )
 	{
 		libfsapfs_btree_footer_free(
@@ -867,20 +855,19 @@ int libfsapfs_btree_node_get_number_of_entries(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     btree_node->entries_array,
-	     number_of_entries,
-	     error ) != 1 )
+	if( number_of_entries == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
 		 function );
 
 		return( -1 );
 	}
+	*number_of_entries = btree_node->number_of_entries;
+
 	return( 1 );
 }
 
@@ -906,22 +893,31 @@ int libfsapfs_btree_node_get_entry_by_index(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     btree_node->entries_array,
-	     entry_index,
-	     (intptr_t **) btree_entry,
-	     error ) != 1 )
+	if( ( entry_index < 0 )
+	 || ( entry_index >= btree_node->number_of_entries ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from array.",
-		 function,
-		 entry_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree entry.",
+		 function );
 
 		return( -1 );
 	}
+	*btree_entry = &( btree_node->entries[ entry_index ] );
+
 	return( 1 );
 }
 
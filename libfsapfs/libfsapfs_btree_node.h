@@ -28,7 +28,6 @@
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_footer.h"
 #include "libfsapfs_btree_node_header.h"
-#include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 
 #if defined( __cplusplus )
@@ -55,9 +54,21 @@ struct libfsapfs_btree_node
 	 */
 	libfsapfs_btree_footer_t *footer;
 
-	/* The B-tree entries array
+	/* The node data
 	 */
-	libcdata_array_t *entries_array;
+	uint8_t *data;
+
+	/* The node data size
+	 */
+	size_t data_size;
+
+	/* The B-tree entries
+	 */
+	libfsapfs_btree_entry_t *entries;
+
+	/* The number of B-tree entries
+	 */
+	int number_of_entries;
 };
 
 int libfsapfs_btree_node_initialize(
@@ -0,0 +1,1464 @@
+/*
+ * The B-tree node cache functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_btree_node_cache.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+/* Determines the hash of a block number
+ */
+#define libfsapfs_btree_node_cache_get_hash( block_number ) \
+	(uint32_t) ( ( (uint64_t) ( block_number ) * 0x9e3779b97f4a7c15UL ) >> 32 )
+
+/* The number of accesses and the access epoch are updated with atomic operations
+ * when available, otherwise the retired nodes mutex is used
+ */
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS
+
+#define libfsapfs_btree_node_cache_atomic_load( value ) \
+	__atomic_load_n( &( value ), __ATOMIC_SEQ_CST )
+
+#define libfsapfs_btree_node_cache_atomic_store( value, new_value ) \
+	__atomic_store_n( &( value ), new_value, __ATOMIC_SEQ_CST )
+
+#define libfsapfs_btree_node_cache_atomic_add( value, addend ) \
+	__atomic_add_fetch( &( value ), addend, __ATOMIC_SEQ_CST )
+
+#define LIBFSAPFS_BTREE_NODE_CACHE_THREAD_LOCAL \
+	__thread
+
+#elif defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) && defined( _MSC_VER )
+#define LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS
+
+#define libfsapfs_btree_node_cache_atomic_load( value ) \
+	(int) InterlockedCompareExchange( (LONG volatile *) &( value ), 0, 0 )
+
+#define libfsapfs_btree_node_cache_atomic_store( value, new_value ) \
+	InterlockedExchange( (LONG volatile *) &( value ), (LONG) ( new_value ) )
+
+#define libfsapfs_btree_node_cache_atomic_add( value, addend ) \
+	( (int) InterlockedExchangeAdd( (LONG volatile *) &( value ), (LONG) ( addend ) ) + ( addend ) )
+
+#define LIBFSAPFS_BTREE_NODE_CACHE_THREAD_LOCAL \
+	__declspec( thread )
+
+#else
+#define libfsapfs_btree_node_cache_atomic_load( value ) \
+	( value )
+
+#define libfsapfs_btree_node_cache_atomic_store( value, new_value ) \
+	( value ) = ( new_value )
+
+#define libfsapfs_btree_node_cache_atomic_add( value, addend ) \
+	( ( value ) += ( addend ) )
+
+#endif
+
+#if defined( LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS )
+
+/* The shard assigned to the current thread, or -1 if not assigned yet
+ */
+static LIBFSAPFS_BTREE_NODE_CACHE_THREAD_LOCAL int libfsapfs_btree_node_cache_thread_shard_index = -1;
+
+/* The number of threads that were assigned a shard
+ */
+static int libfsapfs_btree_node_cache_number_of_threads = 0;
+
+#endif
+
+/* Creates a B-tree node cache
+ * Make sure the value node_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_initialize(
+     libfsapfs_btree_node_cache_t **node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_btree_node_cache_initialize";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int shard_index       = 0;
+#endif
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid B-tree node cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_nodes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of nodes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*node_cache = memory_allocate_structure(
+	               libfsapfs_btree_node_cache_t );
+
+	if( *node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create B-tree node cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *node_cache,
+	     0,
+	     sizeof( libfsapfs_btree_node_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear B-tree node cache.",
+		 function );
+
+		memory_free(
+		 *node_cache );
+
+		*node_cache = NULL;
+
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_cache_allocate_entries(
+	     *node_cache,
+	     maximum_number_of_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *node_cache )->retired_nodes[ 0 ] ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create retired nodes array: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *node_cache )->retired_nodes[ 1 ] ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create retired nodes array: 1.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		if( libcthreads_read_write_lock_initialize(
+		     &( ( *node_cache )->shards[ shard_index ].read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read/write lock of shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *node_cache )->retired_nodes_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize retired nodes mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *node_cache != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		for( shard_index = 0;
+		     shard_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			if( ( *node_cache )->shards[ shard_index ].read_write_lock != NULL )
+			{
+				libcthreads_read_write_lock_free(
+				 &( ( *node_cache )->shards[ shard_index ].read_write_lock ),
+				 NULL );
+			}
+		}
+#endif
+		if( ( *node_cache )->retired_nodes[ 1 ] != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *node_cache )->retired_nodes[ 1 ] ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *node_cache )->retired_nodes[ 0 ] != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *node_cache )->retired_nodes[ 0 ] ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *node_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *node_cache )->entries );
+		}
+		memory_free(
+		 *node_cache );
+
+		*node_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a B-tree node cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_free(
+     libfsapfs_btree_node_cache_t **node_cache,
+     libcerror_error_t **error )
+{
+	static char *function      = "libfsapfs_btree_node_cache_free";
+	uint32_t entry_index       = 0;
+	uint32_t number_of_entries = 0;
+	int result                 = 1;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int shard_index            = 0;
+#endif
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node_cache != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *node_cache )->retired_nodes_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retired nodes mutex.",
+			 function );
+
+			result = -1;
+		}
+		for( shard_index = 0;
+		     shard_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			if( libcthreads_read_write_lock_free(
+			     &( ( *node_cache )->shards[ shard_index ].read_write_lock ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read/write lock of shard: %d.",
+				 function,
+				 shard_index );
+
+				result = -1;
+			}
+		}
+#endif
+		if( libcdata_array_free(
+		     &( ( *node_cache )->retired_nodes[ 1 ] ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retired nodes array: 1.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *node_cache )->retired_nodes[ 0 ] ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retired nodes array: 0.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *node_cache )->entries != NULL )
+		{
+			number_of_entries = ( *node_cache )->number_of_sets * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS;
+
+			for( entry_index = 0;
+			     entry_index < number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *node_cache )->entries[ entry_index ].node != NULL )
+				{
+					if( libfsapfs_btree_node_free(
+					     &( ( *node_cache )->entries[ entry_index ].node ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free node: %" PRIu32 ".",
+						 function,
+						 entry_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *node_cache )->entries );
+		}
+		memory_free(
+		 *node_cache );
+
+		*node_cache = NULL;
+	}
+	return( result );
+}
+
+/* Allocates the entries of the B-tree node cache
+ * The number of sets is the largest power of 2 for which the number of entries does not
+ * exceed the maximum number of nodes, with a minimum of 1 set per shard
+ * The nodes of previously cached entries are retired
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_allocate_entries(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_cache_entry_t *entries = NULL;
+	static char *function                       = "libfsapfs_btree_node_cache_allocate_entries";
+	size_t entries_size                         = 0;
+	uint32_t entry_index                        = 0;
+	uint32_t number_of_entries                  = 0;
+	uint32_t number_of_sets                     = LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_nodes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of nodes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( number_of_sets < ( (uint32_t) INT32_MAX / ( 2 * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS ) ) )
+	    && ( ( number_of_sets * 2 * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS ) <= (uint32_t) maximum_number_of_nodes ) )
+	{
+		number_of_sets *= 2;
+	}
+	entries_size = (size_t) number_of_sets * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS * sizeof( libfsapfs_btree_node_cache_entry_t );
+
+	if( ( entries_size == 0 )
+	 || ( entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entries size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries = (libfsapfs_btree_node_cache_entry_t *) memory_allocate(
+	                                                  entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 entries );
+
+		return( -1 );
+	}
+	if( node_cache->entries != NULL )
+	{
+		/* The nodes can still be used by other readers
+		 */
+		number_of_entries = node_cache->number_of_sets * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS;
+
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( node_cache->entries[ entry_index ].node == NULL )
+			{
+				continue;
+			}
+			if( libfsapfs_btree_node_cache_retire_node(
+			     node_cache,
+			     node_cache->entries[ entry_index ].node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retire node: %" PRIu32 ".",
+				 function,
+				 entry_index );
+
+				memory_free(
+				 entries );
+
+				return( -1 );
+			}
+			node_cache->entries[ entry_index ].node = NULL;
+		}
+		memory_free(
+		 node_cache->entries );
+	}
+	node_cache->entries        = entries;
+	node_cache->number_of_sets = number_of_sets;
+
+	return( 1 );
+}
+
+/* Resizes the B-tree node cache
+ * The nodes of the cached entries are retired
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_resize(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_btree_node_cache_resize";
+	int result            = 1;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int number_of_locks   = 0;
+	int shard_index       = 0;
+#endif
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_nodes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of nodes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The locks of all the shards are grabbed in order of their index
+	 */
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		if( libcthreads_read_write_lock_grab_for_write(
+		     node_cache->shards[ shard_index ].read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock of shard: %d for writing.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_locks++;
+	}
+	if( result == 1 )
+#endif
+	{
+		if( libfsapfs_btree_node_cache_allocate_entries(
+		     node_cache,
+		     maximum_number_of_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to allocate entries.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	while( number_of_locks > 0 )
+	{
+		number_of_locks--;
+
+		if( libcthreads_read_write_lock_release_for_write(
+		     node_cache->shards[ number_of_locks ].read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock of shard: %d for writing.",
+			 function,
+			 number_of_locks );
+
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the index of the shard assigned to the current thread
+ * The accesses of a thread are counted in the shard assigned to it
+ * Returns the shard index
+ */
+int libfsapfs_btree_node_cache_get_thread_shard_index(
+     void )
+{
+#if defined( LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS )
+	if( libfsapfs_btree_node_cache_thread_shard_index == -1 )
+	{
+		libfsapfs_btree_node_cache_thread_shard_index = ( libfsapfs_btree_node_cache_atomic_add(
+		                                                   libfsapfs_btree_node_cache_number_of_threads,
+		                                                   1 ) - 1 ) & ( LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS - 1 );
+	}
+	return( libfsapfs_btree_node_cache_thread_shard_index );
+#else
+	return( 0 );
+#endif
+}
+
+/* Begins an access of the B-tree node cache
+ * The nodes retrieved from the cache remain valid until the access is ended,
+ * even when they are replaced in the meantime. The access must be ended by the
+ * thread that began it
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_begin_access(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int *access_epoch,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_btree_node_cache_begin_access";
+	int current_epoch                         = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( access_epoch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access epoch.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( node_cache->shards[ libfsapfs_btree_node_cache_get_thread_shard_index() ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) && !defined( LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS )
+	if( libcthreads_mutex_grab(
+	     node_cache->retired_nodes_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab retired nodes mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The access is counted before the access epoch is checked again, hence if the
+	 * access epoch was changed in the meantime the access is counted in the new one
+	 */
+	do
+	{
+		current_epoch = libfsapfs_btree_node_cache_atomic_load(
+		                 node_cache->access_epoch );
+
+		libfsapfs_btree_node_cache_atomic_add(
+		 shard->number_of_accesses[ current_epoch ],
+		 1 );
+
+		if( libfsapfs_btree_node_cache_atomic_load(
+		     node_cache->access_epoch ) == current_epoch )
+		{
+			break;
+		}
+		libfsapfs_btree_node_cache_atomic_add(
+		 shard->number_of_accesses[ current_epoch ],
+		 -1 );
+	}
+	while( 1 );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) && !defined( LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS )
+	if( libcthreads_mutex_release(
+	     node_cache->retired_nodes_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release retired nodes mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*access_epoch = current_epoch;
+
+	return( 1 );
+}
+
+/* Ends an access of the B-tree node cache
+ * The nodes retrieved from the cache during the access can no longer be used
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_end_access(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int access_epoch,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_btree_node_cache_end_access";
+	int result                                = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_epoch != 0 )
+	 && ( access_epoch != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access epoch.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( node_cache->shards[ libfsapfs_btree_node_cache_get_thread_shard_index() ] );
+
+#if defined( LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS )
+	if( libfsapfs_btree_node_cache_atomic_add(
+	     shard->number_of_accesses[ access_epoch ],
+	     -1 ) < 0 )
+	{
+		libfsapfs_btree_node_cache_atomic_add(
+		 shard->number_of_accesses[ access_epoch ],
+		 1 );
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid B-tree node cache - number of accesses value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The retired nodes mutex is only needed when there are retired nodes to free
+	 */
+	if( libfsapfs_btree_node_cache_atomic_load(
+	     node_cache->number_of_retired_nodes ) == 0 )
+	{
+		return( 1 );
+	}
+#endif
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     node_cache->retired_nodes_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab retired nodes mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if !defined( LIBFSAPFS_BTREE_NODE_CACHE_HAVE_ATOMICS )
+	if( shard->number_of_accesses[ access_epoch ] <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid B-tree node cache - number of accesses value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		shard->number_of_accesses[ access_epoch ] -= 1;
+	}
+	if( result == 1 )
+#endif
+	{
+		if( libfsapfs_btree_node_cache_free_retired_nodes(
+		     node_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retired nodes.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     node_cache->retired_nodes_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release retired nodes mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retires a node that was replaced in the B-tree node cache
+ * The node is freed once the accesses that could have retrieved it have ended
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_retire_node(
+     libfsapfs_btree_node_cache_t *node_cache,
+     libfsapfs_btree_node_t *node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_btree_node_cache_retire_node";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     node_cache->retired_nodes_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab retired nodes mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_append_entry(
+	     node_cache->retired_nodes[ node_cache->access_epoch ],
+	     &entry_index,
+	     (intptr_t *) node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append node to retired nodes array.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		libfsapfs_btree_node_cache_atomic_add(
+		 node_cache->number_of_retired_nodes,
+		 1 );
+
+		if( libfsapfs_btree_node_cache_free_retired_nodes(
+		     node_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retired nodes.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     node_cache->retired_nodes_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release retired nodes mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Frees the retired nodes of an access epoch
+ * This function expects the retired nodes mutex to be grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_empty_retired_nodes(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int access_epoch,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_btree_node_cache_empty_retired_nodes";
+	int number_of_entries = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     node_cache->retired_nodes[ access_epoch ],
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from retired nodes array: %d.",
+		 function,
+		 access_epoch );
+
+		return( -1 );
+	}
+	if( number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_empty(
+	     node_cache->retired_nodes[ access_epoch ],
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty retired nodes array: %d.",
+		 function,
+		 access_epoch );
+
+		return( -1 );
+	}
+	libfsapfs_btree_node_cache_atomic_add(
+	 node_cache->number_of_retired_nodes,
+	 -number_of_entries );
+
+	return( 1 );
+}
+
+/* Frees the retired nodes that can no longer be in use
+ * The nodes retired in the previous access epoch are freed once all the accesses
+ * of that epoch have ended, after which a new access epoch is started when nodes
+ * were retired in the current one. This function expects the retired nodes mutex to be grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_free_retired_nodes(
+     libfsapfs_btree_node_cache_t *node_cache,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsapfs_btree_node_cache_free_retired_nodes";
+	int current_epoch               = 0;
+	int number_of_current_accesses  = 0;
+	int number_of_entries           = 0;
+	int number_of_previous_accesses = 0;
+	int previous_epoch              = 0;
+	int shard_index                 = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	current_epoch  = node_cache->access_epoch;
+	previous_epoch = 1 - current_epoch;
+
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		number_of_previous_accesses += libfsapfs_btree_node_cache_atomic_load(
+		                                node_cache->shards[ shard_index ].number_of_accesses[ previous_epoch ] );
+	}
+	if( number_of_previous_accesses != 0 )
+	{
+		return( 1 );
+	}
+	if( libfsapfs_btree_node_cache_empty_retired_nodes(
+	     node_cache,
+	     previous_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty retired nodes: %d.",
+		 function,
+		 previous_epoch );
+
+		return( -1 );
+	}
+	/* The nodes retired in the current epoch were replaced before they were retired,
+	 * hence an access that is counted after this point cannot retrieve them
+	 */
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		number_of_current_accesses += libfsapfs_btree_node_cache_atomic_load(
+		                               node_cache->shards[ shard_index ].number_of_accesses[ current_epoch ] );
+	}
+	if( number_of_current_accesses == 0 )
+	{
+		if( libfsapfs_btree_node_cache_empty_retired_nodes(
+		     node_cache,
+		     current_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty retired nodes: %d.",
+			 function,
+			 current_epoch );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     node_cache->retired_nodes[ current_epoch ],
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from retired nodes array: %d.",
+		 function,
+		 current_epoch );
+
+		return( -1 );
+	}
+	/* Accesses that begin after this point cannot retrieve the nodes retired so far
+	 */
+	if( number_of_entries > 0 )
+	{
+		libfsapfs_btree_node_cache_atomic_store(
+		 node_cache->access_epoch,
+		 previous_epoch );
+	}
+	return( 1 );
+}
+
+/* Retrieves the node of a specific block number
+ * The node remains valid until the access of the cache is ended
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_btree_node_cache_get_node(
+     libfsapfs_btree_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_cache_entry_t *entry = NULL;
+	static char *function                     = "libfsapfs_btree_node_cache_get_node";
+	uint32_t entry_index                      = 0;
+	uint32_t hash                             = 0;
+	uint32_t set_index                        = 0;
+	int result                                = 0;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	uint32_t shard_index                      = 0;
+#endif
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	hash = libfsapfs_btree_node_cache_get_hash(
+	        block_number );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* Since the number of sets is a multiple of the number of shards
+	 * all the blocks that map onto the same set map onto the same shard
+	 */
+	shard_index = hash & ( LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS - 1 );
+
+	if( libcthreads_read_write_lock_grab_for_read(
+	     node_cache->shards[ shard_index ].read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set_index = hash & ( node_cache->number_of_sets - 1 );
+
+	entry = &( node_cache->entries[ set_index * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		if( ( entry[ entry_index ].node != NULL )
+		 && ( entry[ entry_index ].block_number == block_number ) )
+		{
+			*node = entry[ entry_index ].node;
+
+			result = 1;
+
+			break;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     node_cache->shards[ shard_index ].read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the node of a specific block number
+ * The cache takes over the ownership of the node. If another reader already set
+ * a node for the block number, the node is freed and replaced by the cached node
+ * The oldest entry of the set is replaced if the set is full
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_btree_node_cache_set_node(
+     libfsapfs_btree_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_cache_entry_t *entry        = NULL;
+	libfsapfs_btree_node_cache_shard_t *shard        = NULL;
+	libfsapfs_btree_node_cache_entry_t *victim_entry = NULL;
+	static char *function                            = "libfsapfs_btree_node_cache_set_node";
+	uint32_t entry_index                             = 0;
+	uint32_t hash                                    = 0;
+	uint32_t set_index                               = 0;
+	int result                                       = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing node.",
+		 function );
+
+		return( -1 );
+	}
+	hash = libfsapfs_btree_node_cache_get_hash(
+	        block_number );
+
+	shard = &( node_cache->shards[ hash & ( LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS - 1 ) ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set_index = hash & ( node_cache->number_of_sets - 1 );
+
+	entry = &( node_cache->entries[ set_index * LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		if( entry[ entry_index ].node == NULL )
+		{
+			if( ( victim_entry == NULL )
+			 || ( victim_entry->node != NULL ) )
+			{
+				victim_entry = &( entry[ entry_index ] );
+			}
+		}
+		else if( entry[ entry_index ].block_number == block_number )
+		{
+			break;
+		}
+		else if( ( victim_entry == NULL )
+		      || ( ( victim_entry->node != NULL )
+		       &&  ( entry[ entry_index ].set_time < victim_entry->set_time ) ) )
+		{
+			victim_entry = &( entry[ entry_index ] );
+		}
+	}
+	if( entry_index < LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS )
+	{
+		/* Another reader has set the node in the meantime
+		 */
+		if( libfsapfs_btree_node_free(
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free node.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			*node = entry[ entry_index ].node;
+		}
+	}
+	else
+	{
+		if( victim_entry->node != NULL )
+		{
+			if( libfsapfs_btree_node_cache_retire_node(
+			     node_cache,
+			     victim_entry->node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retire node.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				victim_entry->node = NULL;
+			}
+		}
+		if( result == 1 )
+		{
+			shard->current_time += 1;
+
+			victim_entry->node         = *node;
+			victim_entry->block_number = block_number;
+			victim_entry->set_time     = shard->current_time;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
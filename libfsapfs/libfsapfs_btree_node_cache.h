@@ -0,0 +1,194 @@
+/*
+ * The B-tree node cache functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_BTREE_NODE_CACHE_H )
+#define _LIBFSAPFS_BTREE_NODE_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of entries per set of the B-tree node cache
+ */
+#define LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS	4
+
+/* The number of shards of the B-tree node cache, where every shard has its own lock
+ * This value must be a power of 2
+ */
+#define LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS	16
+
+typedef struct libfsapfs_btree_node_cache_entry libfsapfs_btree_node_cache_entry_t;
+
+struct libfsapfs_btree_node_cache_entry
+{
+	/* The B-tree node
+	 */
+	libfsapfs_btree_node_t *node;
+
+	/* The block number of the B-tree node
+	 */
+	uint64_t block_number;
+
+	/* The time the entry was set
+	 */
+	uint64_t set_time;
+};
+
+typedef struct libfsapfs_btree_node_cache_shard libfsapfs_btree_node_cache_shard_t;
+
+struct libfsapfs_btree_node_cache_shard
+{
+	/* The current time
+	 */
+	uint64_t current_time;
+
+	/* The number of accesses per access epoch of the threads assigned to the shard
+	 */
+	int number_of_accesses[ 2 ];
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+typedef struct libfsapfs_btree_node_cache libfsapfs_btree_node_cache_t;
+
+/* The B-tree node cache maps block numbers onto B-tree nodes. The entries are stored
+ * in a set associative hash table where the oldest entry of a set is replaced when
+ * the set is full. The sets are divided over shards so that readers only contend
+ * on the lock of a single shard and a cache hit only requires a read lock.
+ *
+ * The cache hands out references to the nodes it contains, hence a replaced node
+ * is retired instead of freed. Users of the nodes enclose their use in an access
+ * of the cache and a retired node is only freed once all the accesses that started
+ * before it was retired have ended. The accesses are counted per shard, where every
+ * thread is assigned a shard, so that beginning and ending an access only requires
+ * an atomic operation on the counter of that shard.
+ */
+struct libfsapfs_btree_node_cache
+{
+	/* The entries
+	 */
+	libfsapfs_btree_node_cache_entry_t *entries;
+
+	/* The number of sets
+	 * This value is always a power of 2
+	 */
+	uint32_t number_of_sets;
+
+	/* The shards
+	 */
+	libfsapfs_btree_node_cache_shard_t shards[ LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS ];
+
+	/* The current access epoch
+	 */
+	int access_epoch;
+
+	/* The nodes retired per access epoch
+	 */
+	libcdata_array_t *retired_nodes[ 2 ];
+
+	/* The number of retired nodes that have not been freed
+	 */
+	int number_of_retired_nodes;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The retired nodes mutex
+	 * When atomic operations are not available the mutex also protects the number of accesses
+	 */
+	libcthreads_mutex_t *retired_nodes_mutex;
+#endif
+};
+
+int libfsapfs_btree_node_cache_initialize(
+     libfsapfs_btree_node_cache_t **node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_free(
+     libfsapfs_btree_node_cache_t **node_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_allocate_entries(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_resize(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_get_thread_shard_index(
+     void );
+
+int libfsapfs_btree_node_cache_begin_access(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int *access_epoch,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_end_access(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int access_epoch,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_retire_node(
+     libfsapfs_btree_node_cache_t *node_cache,
+     libfsapfs_btree_node_t *node,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_empty_retired_nodes(
+     libfsapfs_btree_node_cache_t *node_cache,
+     int access_epoch,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_free_retired_nodes(
+     libfsapfs_btree_node_cache_t *node_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_get_node(
+     libfsapfs_btree_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_btree_node_cache_set_node(
+     libfsapfs_btree_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_BTREE_NODE_CACHE_H ) */
+
@@ -0,0 +1,761 @@
+/*
+ * Change iterator functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_btree_node_cache.h"
+#include "libfsapfs_change_iterator.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_btree_cursor.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_types.h"
+
+#include "fsapfs_file_system.h"
+
+/* Creates a change iterator
+ * Make sure the value change_iterator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_change_iterator_initialize(
+     libfsapfs_change_iterator_t **change_iterator,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_file_system_btree_t *first_file_system_btree,
+     libfsapfs_file_system_btree_t *second_file_system_btree,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_change_iterator_t *internal_change_iterator = NULL;
+	static char *function                                          = "libfsapfs_change_iterator_initialize";
+
+	if( change_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *change_iterator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid change iterator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_change_iterator = memory_allocate_structure(
+	                            libfsapfs_internal_change_iterator_t );
+
+	if( internal_change_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create change iterator.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_change_iterator,
+	     0,
+	     sizeof( libfsapfs_internal_change_iterator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear change iterator.",
+		 function );
+
+		memory_free(
+		 internal_change_iterator );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &( internal_change_iterator->first_cursor ),
+	     first_file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create first file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &( internal_change_iterator->second_cursor ),
+	     second_file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create second file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_change_iterator->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_change_iterator->file_io_handle = file_io_handle;
+
+	*change_iterator = (libfsapfs_change_iterator_t *) internal_change_iterator;
+
+	return( 1 );
+
+on_error:
+	if( internal_change_iterator != NULL )
+	{
+		if( internal_change_iterator->second_cursor != NULL )
+		{
+			libfsapfs_file_system_btree_cursor_free(
+			 &( internal_change_iterator->second_cursor ),
+			 NULL );
+		}
+		if( internal_change_iterator->first_cursor != NULL )
+		{
+			libfsapfs_file_system_btree_cursor_free(
+			 &( internal_change_iterator->first_cursor ),
+			 NULL );
+		}
+		memory_free(
+		 internal_change_iterator );
+	}
+	return( -1 );
+}
+
+/* Frees a change iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_change_iterator_free(
+     libfsapfs_change_iterator_t **change_iterator,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_change_iterator_t *internal_change_iterator = NULL;
+	static char *function                                          = "libfsapfs_change_iterator_free";
+	int result                                                     = 1;
+
+	if( change_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *change_iterator != NULL )
+	{
+		internal_change_iterator = (libfsapfs_internal_change_iterator_t *) *change_iterator;
+		*change_iterator         = NULL;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_change_iterator->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		/* The file_io_handle reference is freed elsewhere
+		 */
+		if( libfsapfs_file_system_btree_cursor_free(
+		     &( internal_change_iterator->first_cursor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free first file system B-tree cursor.",
+			 function );
+
+			result = -1;
+		}
+		if( libfsapfs_file_system_btree_cursor_free(
+		     &( internal_change_iterator->second_cursor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free second file system B-tree cursor.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_change_iterator );
+	}
+	return( result );
+}
+
+/* Retrieves the next change
+ * The identifier is the identifier of the inode or, for a file extent, of the data stream
+ * Returns 1 if successful, 0 if no more changes or -1 on error
+ */
+int libfsapfs_internal_change_iterator_get_next_change(
+     libfsapfs_internal_change_iterator_t *internal_change_iterator,
+     uint64_t *identifier,
+     uint8_t *record_type,
+     uint8_t *change_type,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_system_btree_cursor_t *changed_cursor = NULL;
+	libfsapfs_file_system_btree_cursor_t *first_cursor   = NULL;
+	libfsapfs_file_system_btree_cursor_t *second_cursor  = NULL;
+	static char *function                                = "libfsapfs_internal_change_iterator_get_next_change";
+	uint64_t key_identifier                              = 0;
+	uint16_t first_node_level                            = 0;
+	uint16_t second_node_level                           = 0;
+	uint8_t data_type                                    = 0;
+	uint8_t safe_change_type                             = 0;
+	int compare_result                                   = 0;
+	int first_result                                     = 0;
+	int second_result                                    = 0;
+
+	if( internal_change_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_change_iterator->first_cursor == NULL )
+	 || ( internal_change_iterator->second_cursor == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid change iterator - missing file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record type.",
+		 function );
+
+		return( -1 );
+	}
+	if( change_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change type.",
+		 function );
+
+		return( -1 );
+	}
+	first_cursor  = internal_change_iterator->first_cursor;
+	second_cursor = internal_change_iterator->second_cursor;
+
+	while( internal_change_iterator->is_finished == 0 )
+	{
+		first_result = libfsapfs_file_system_btree_cursor_read_entry(
+		                first_cursor,
+		                internal_change_iterator->file_io_handle,
+		                error );
+
+		if( first_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read entry from first file system B-tree.",
+			 function );
+
+			return( -1 );
+		}
+		second_result = libfsapfs_file_system_btree_cursor_read_entry(
+		                 second_cursor,
+		                 internal_change_iterator->file_io_handle,
+		                 error );
+
+		if( second_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read entry from second file system B-tree.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( first_result == 0 )
+		 && ( second_result == 0 ) )
+		{
+			internal_change_iterator->is_finished = 1;
+
+			break;
+		}
+		else if( first_result == 0 )
+		{
+			compare_result = LIBCDATA_COMPARE_GREATER;
+		}
+		else if( second_result == 0 )
+		{
+			compare_result = LIBCDATA_COMPARE_LESS;
+		}
+		else
+		{
+			/* The sub nodes of the file system B-tree are referenced by their virtual object
+			 * identifier, hence an unchanged branch node can reference changed sub nodes.
+			 * Only a leaf node that is stored in the same physical block in both versions
+			 * is known to be unchanged
+			 */
+			if( ( first_cursor->node_level == 1 )
+			 && ( second_cursor->node_level == 1 )
+			 && ( first_cursor->sub_node_block_number == second_cursor->sub_node_block_number ) )
+			{
+				if( libfsapfs_file_system_btree_cursor_skip(
+				     first_cursor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to skip sub node in first file system B-tree.",
+					 function );
+
+					return( -1 );
+				}
+				if( libfsapfs_file_system_btree_cursor_skip(
+				     second_cursor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to skip sub node in second file system B-tree.",
+					 function );
+
+					return( -1 );
+				}
+				continue;
+			}
+			compare_result = libfsapfs_file_system_btree_cursor_compare_key_data(
+			                  first_cursor->entry_data,
+			                  first_cursor->key_data_size,
+			                  second_cursor->entry_data,
+			                  second_cursor->key_data_size,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare key data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		first_node_level  = first_cursor->node_level;
+		second_node_level = second_cursor->node_level;
+		changed_cursor    = NULL;
+
+		/* The key of a branch node entry is the lower bound of the keys in its sub tree
+		 * hence a record with a smaller key is not stored in the other version
+		 */
+		if( compare_result == LIBCDATA_COMPARE_LESS )
+		{
+			if( first_node_level == 0 )
+			{
+				changed_cursor   = first_cursor;
+				safe_change_type = LIBFSAPFS_CHANGE_TYPE_REMOVED;
+			}
+		}
+		else if( compare_result == LIBCDATA_COMPARE_GREATER )
+		{
+			if( second_node_level == 0 )
+			{
+				changed_cursor   = second_cursor;
+				safe_change_type = LIBFSAPFS_CHANGE_TYPE_ADDED;
+			}
+		}
+		else if( ( first_node_level == 0 )
+		      && ( second_node_level == 0 ) )
+		{
+			if( ( first_cursor->value_data_size != second_cursor->value_data_size )
+			 || ( memory_compare(
+			       &( first_cursor->entry_data[ first_cursor->key_data_size ] ),
+			       &( second_cursor->entry_data[ second_cursor->key_data_size ] ),
+			       first_cursor->value_data_size ) != 0 ) )
+			{
+				changed_cursor   = second_cursor;
+				safe_change_type = LIBFSAPFS_CHANGE_TYPE_MODIFIED;
+			}
+			if( libfsapfs_file_system_btree_cursor_skip(
+			     first_cursor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to skip entry in first file system B-tree.",
+				 function );
+
+				return( -1 );
+			}
+			if( changed_cursor == NULL )
+			{
+				if( libfsapfs_file_system_btree_cursor_skip(
+				     second_cursor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to skip entry in second file system B-tree.",
+					 function );
+
+					return( -1 );
+				}
+				continue;
+			}
+		}
+		if( changed_cursor == NULL )
+		{
+			/* Descend into the sub node with the smallest key or, if the keys are equal,
+			 * into the sub node at the highest level, so that sub trees at the same
+			 * level can be compared by block number
+			 */
+			if( ( first_node_level != 0 )
+			 && ( ( compare_result == LIBCDATA_COMPARE_LESS )
+			  || ( ( compare_result == LIBCDATA_COMPARE_EQUAL )
+			   && ( first_node_level >= second_node_level ) ) ) )
+			{
+				if( libfsapfs_file_system_btree_cursor_descend(
+				     first_cursor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to descend into sub node in first file system B-tree.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( ( second_node_level != 0 )
+			 && ( ( compare_result == LIBCDATA_COMPARE_GREATER )
+			  || ( ( compare_result == LIBCDATA_COMPARE_EQUAL )
+			   && ( second_node_level >= first_node_level ) ) ) )
+			{
+				if( libfsapfs_file_system_btree_cursor_descend(
+				     second_cursor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to descend into sub node in second file system B-tree.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			continue;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsapfs_file_system_btree_key_common_t *) changed_cursor->entry_data )->file_system_identifier,
+		 key_identifier );
+
+		if( libfsapfs_file_system_btree_cursor_skip(
+		     changed_cursor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip entry in file system B-tree.",
+			 function );
+
+			return( -1 );
+		}
+		data_type = (uint8_t) ( key_identifier >> 60 );
+
+		if( ( data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE )
+		 || ( data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE )
+		 || ( data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT ) )
+		{
+			*identifier  = key_identifier & 0x0fffffffffffffffUL;
+			*record_type = data_type;
+			*change_type = safe_change_type;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the next change
+ * The identifier is the identifier of the inode or, for a file extent, of the data stream
+ * Returns 1 if successful, 0 if no more changes or -1 on error
+ */
+int libfsapfs_change_iterator_get_next_change(
+     libfsapfs_change_iterator_t *change_iterator,
+     uint64_t *identifier,
+     uint8_t *record_type,
+     uint8_t *change_type,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_change_iterator_t *internal_change_iterator = NULL;
+	libfsapfs_btree_node_cache_t *first_node_cache                 = NULL;
+	libfsapfs_btree_node_cache_t *second_node_cache                = NULL;
+	static char *function                                          = "libfsapfs_change_iterator_get_next_change";
+	int first_access_epoch                                         = 0;
+	int second_access_epoch                                        = 0;
+	int result                                                     = 0;
+
+	if( change_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_change_iterator = (libfsapfs_internal_change_iterator_t *) change_iterator;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_change_iterator->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	first_node_cache  = internal_change_iterator->first_cursor->file_system_btree->node_cache;
+	second_node_cache = internal_change_iterator->second_cursor->file_system_btree->node_cache;
+
+	/* The B-tree nodes are referenced from the node caches until the accesses have ended
+	 */
+	result = libfsapfs_btree_node_cache_begin_access(
+	          first_node_cache,
+	          &first_access_epoch,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin first node cache access.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libfsapfs_btree_node_cache_begin_access(
+		          second_node_cache,
+		          &second_access_epoch,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to begin second node cache access.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			result = libfsapfs_internal_change_iterator_get_next_change(
+			          internal_change_iterator,
+			          identifier,
+			          record_type,
+			          change_type,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next change.",
+				 function );
+			}
+			if( libfsapfs_btree_node_cache_end_access(
+			     second_node_cache,
+			     second_access_epoch,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to end second node cache access.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libfsapfs_btree_node_cache_end_access(
+		     first_node_cache,
+		     first_access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end first node cache access.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_change_iterator->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,104 @@
+/*
+ * Change iterator functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_CHANGE_ITERATOR_H )
+#define _LIBFSAPFS_CHANGE_ITERATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_extern.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_btree_cursor.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_internal_change_iterator libfsapfs_internal_change_iterator_t;
+
+/* The change iterator walks the file system B-trees of two versions of a volume
+ * side by side and returns the records that were added, removed or modified.
+ * Sub trees that consist of the same leaf node in both versions are skipped
+ * without being read
+ */
+struct libfsapfs_internal_change_iterator
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The cursor of the file system B-tree of the older version
+	 */
+	libfsapfs_file_system_btree_cursor_t *first_cursor;
+
+	/* The cursor of the file system B-tree of the newer version
+	 */
+	libfsapfs_file_system_btree_cursor_t *second_cursor;
+
+	/* Value to indicate the iterator has no more changes
+	 */
+	uint8_t is_finished;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfsapfs_change_iterator_initialize(
+     libfsapfs_change_iterator_t **change_iterator,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_file_system_btree_t *first_file_system_btree,
+     libfsapfs_file_system_btree_t *second_file_system_btree,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_change_iterator_free(
+     libfsapfs_change_iterator_t **change_iterator,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_change_iterator_get_next_change(
+     libfsapfs_internal_change_iterator_t *internal_change_iterator,
+     uint64_t *identifier,
+     uint8_t *record_type,
+     uint8_t *change_type,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_change_iterator_get_next_change(
+     libfsapfs_change_iterator_t *change_iterator,
+     uint64_t *identifier,
+     uint8_t *record_type,
+     uint8_t *change_type,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_CHANGE_ITERATOR_H ) */
+
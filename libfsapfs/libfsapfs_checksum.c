@@ -21,20 +21,69 @@
 
 #include <common.h>
 #include <byte_stream.h>
+#include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_definitions.h"
 #include "libfsapfs_libcerror.h"
 
-/* Table of CRC-32 values of 8-bit values
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define HAVE_LIBFSAPFS_SSE4_2_CRC32
+
+#if ( defined( __clang__ ) && ( __clang_major__ >= 4 ) ) || ( !defined( __clang__ ) && ( __GNUC__ >= 5 ) )
+#define HAVE_LIBFSAPFS_AVX2_FLETCHER64
+#endif
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#elif defined( __GNUC__ ) && defined( __aarch64__ )
+
+#if defined( __ARM_FEATURE_CRC32 )
+#define HAVE_LIBFSAPFS_ARM_CRC32
+
+#include <arm_acle.h>
+#endif
+
+#if !defined( __ARM_BIG_ENDIAN )
+#define HAVE_LIBFSAPFS_NEON_FLETCHER64
+
+#include <arm_neon.h>
+#endif
+
+#endif
+
+/* The maximum number of bytes of which the Fletcher-64 sums are calculated
+ * before they are reduced, which prevents the 64-bit sums from overflowing
+ */
+#define LIBFSAPFS_CHECKSUM_FLETCHER64_MAXIMUM_CHUNK_SIZE	( 128 * 1024 )
+
+/* Tables of CRC-32 values of 8-bit values, used for slicing-by-8
+ * The first table contains the CRC-32 value of every 8-bit value,
+ * the other tables that of the 8-bit value followed by 1 to 7 zero bytes
  */
-uint32_t libfsapfs_checksum_crc32_table[ 256 ];
+uint32_t libfsapfs_checksum_crc32_table[ 8 ][ 256 ];
 
 /* Value to indicate the CRC-32 table been computed
  */
 int libfsapfs_checksum_crc32_table_computed = 0;
 
+/* The CRC-32 backend
+ */
+int libfsapfs_checksum_crc32_backend = LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SLICING_BY_8;
+
+/* The Fletcher-64 backend
+ */
+int libfsapfs_checksum_fletcher64_backend = LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_SCALAR;
+
+/* Value to indicate the Fletcher-64 backend has been determined
+ */
+int libfsapfs_checksum_fletcher64_backend_initialized = 0;
+
 /* Initializes the internal CRC-32 table
  * The table speeds up the CRC-32 calculation
+ * If the polynomial is that of CRC-32C and the CPU supports CRC-32C instructions
+ * these are used instead
  */
 void libfsapfs_checksum_initialize_crc32_table(
       uint32_t polynomial )
@@ -42,6 +91,14 @@ void libfsapfs_checksum_initialize_crc32_table(
 	uint32_t checksum    = 0;
 	uint32_t table_index = 0;
 	uint8_t bit_iterator = 0;
+	uint8_t slice_index  = 0;
+
+#if defined( HAVE_LIBFSAPFS_SSE4_2_CRC32 )
+	unsigned int eax     = 0;
+	unsigned int ebx     = 0;
+	unsigned int ecx     = 0;
+	unsigned int edx     = 0;
+#endif
 
 	for( table_index = 0;
 	     table_index < 256;
@@ -62,11 +119,226 @@ void libfsapfs_checksum_initialize_crc32_table(
 				checksum = checksum >> 1;
 			}
 		}
-		libfsapfs_checksum_crc32_table[ table_index ] = checksum;
+		libfsapfs_checksum_crc32_table[ 0 ][ table_index ] = checksum;
+	}
+	for( table_index = 0;
+	     table_index < 256;
+	     table_index++ )
+	{
+		checksum = libfsapfs_checksum_crc32_table[ 0 ][ table_index ];
+
+		for( slice_index = 1;
+		     slice_index < 8;
+		     slice_index++ )
+		{
+			checksum = libfsapfs_checksum_crc32_table[ 0 ][ checksum & 0x000000ffUL ] ^ ( checksum >> 8 );
+
+			libfsapfs_checksum_crc32_table[ slice_index ][ table_index ] = checksum;
+		}
+	}
+	libfsapfs_checksum_crc32_backend = LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SLICING_BY_8;
+
+	if( polynomial == 0x82f63b78UL )
+	{
+#if defined( HAVE_LIBFSAPFS_SSE4_2_CRC32 )
+		if( __get_cpuid(
+		     1,
+		     &eax,
+		     &ebx,
+		     &ecx,
+		     &edx ) != 0 )
+		{
+			if( ( ecx & bit_SSE4_2 ) != 0 )
+			{
+				libfsapfs_checksum_crc32_backend = LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SSE4_2;
+			}
+		}
+#elif defined( HAVE_LIBFSAPFS_ARM_CRC32 )
+		libfsapfs_checksum_crc32_backend = LIBFSAPFS_CHECKSUM_CRC32_BACKEND_ARM;
+#endif
 	}
 	libfsapfs_checksum_crc32_table_computed = 1;
 }
 
+/* Updates a CRC-32 checksum with a buffer of data using slicing-by-8
+ * Returns the updated checksum
+ */
+uint32_t libfsapfs_checksum_update_crc32_slicing_by_8(
+          uint32_t checksum,
+          const uint8_t *buffer,
+          size_t size )
+{
+	uint32_t value_32bit = 0;
+
+	while( size >= 8 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 buffer,
+		 value_32bit );
+
+		checksum ^= value_32bit;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( buffer[ 4 ] ),
+		 value_32bit );
+
+		checksum = libfsapfs_checksum_crc32_table[ 7 ][ checksum & 0x000000ffUL ]
+		         ^ libfsapfs_checksum_crc32_table[ 6 ][ ( checksum >> 8 ) & 0x000000ffUL ]
+		         ^ libfsapfs_checksum_crc32_table[ 5 ][ ( checksum >> 16 ) & 0x000000ffUL ]
+		         ^ libfsapfs_checksum_crc32_table[ 4 ][ checksum >> 24 ]
+		         ^ libfsapfs_checksum_crc32_table[ 3 ][ value_32bit & 0x000000ffUL ]
+		         ^ libfsapfs_checksum_crc32_table[ 2 ][ ( value_32bit >> 8 ) & 0x000000ffUL ]
+		         ^ libfsapfs_checksum_crc32_table[ 1 ][ ( value_32bit >> 16 ) & 0x000000ffUL ]
+		         ^ libfsapfs_checksum_crc32_table[ 0 ][ value_32bit >> 24 ];
+
+		buffer += 8;
+		size   -= 8;
+	}
+	while( size > 0 )
+	{
+		checksum = libfsapfs_checksum_crc32_table[ 0 ][ ( checksum ^ *buffer ) & 0x000000ffUL ] ^ ( checksum >> 8 );
+
+		buffer += 1;
+		size   -= 1;
+	}
+	return( checksum );
+}
+
+#if defined( HAVE_LIBFSAPFS_SSE4_2_CRC32 )
+
+/* Updates a CRC-32C checksum with a buffer of data using the SSE4.2 CRC32 instruction
+ * Returns the updated checksum
+ */
+__attribute__((target("sse4.2")))
+static uint32_t libfsapfs_checksum_update_crc32c_sse4_2(
+                 uint32_t checksum,
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	uint32_t value_32bit = 0;
+
+#if defined( __x86_64__ )
+	uint64_t checksum_64bit = checksum;
+	uint64_t value_64bit    = 0;
+
+	while( size >= 8 )
+	{
+		memory_copy(
+		 &value_64bit,
+		 buffer,
+		 8 );
+
+		checksum_64bit = _mm_crc32_u64(
+		                  checksum_64bit,
+		                  value_64bit );
+
+		buffer += 8;
+		size   -= 8;
+	}
+	checksum = (uint32_t) checksum_64bit;
+
+#endif /* defined( __x86_64__ ) */
+
+	while( size >= 4 )
+	{
+		memory_copy(
+		 &value_32bit,
+		 buffer,
+		 4 );
+
+		checksum = _mm_crc32_u32(
+		            checksum,
+		            value_32bit );
+
+		buffer += 4;
+		size   -= 4;
+	}
+	while( size > 0 )
+	{
+		checksum = _mm_crc32_u8(
+		            checksum,
+		            *buffer );
+
+		buffer += 1;
+		size   -= 1;
+	}
+	return( checksum );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_SSE4_2_CRC32 ) */
+
+#if defined( HAVE_LIBFSAPFS_ARM_CRC32 )
+
+/* Updates a CRC-32C checksum with a buffer of data using the ARMv8 CRC32C instructions
+ * Returns the updated checksum
+ */
+static uint32_t libfsapfs_checksum_update_crc32c_arm(
+                 uint32_t checksum,
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	uint64_t value_64bit = 0;
+
+	while( size >= 8 )
+	{
+		memory_copy(
+		 &value_64bit,
+		 buffer,
+		 8 );
+
+		checksum = __crc32cd(
+		            checksum,
+		            value_64bit );
+
+		buffer += 8;
+		size   -= 8;
+	}
+	while( size > 0 )
+	{
+		checksum = __crc32cb(
+		            checksum,
+		            *buffer );
+
+		buffer += 1;
+		size   -= 1;
+	}
+	return( checksum );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_ARM_CRC32 ) */
+
+/* Updates a CRC-32 checksum with a buffer of data
+ * The CRC-32 table must have been initialized
+ * Returns the updated checksum
+ */
+uint32_t libfsapfs_checksum_update_crc32(
+          uint32_t checksum,
+          const uint8_t *buffer,
+          size_t size )
+{
+#if defined( HAVE_LIBFSAPFS_SSE4_2_CRC32 )
+	if( libfsapfs_checksum_crc32_backend == LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SSE4_2 )
+	{
+		return( libfsapfs_checksum_update_crc32c_sse4_2(
+		         checksum,
+		         buffer,
+		         size ) );
+	}
+#elif defined( HAVE_LIBFSAPFS_ARM_CRC32 )
+	if( libfsapfs_checksum_crc32_backend == LIBFSAPFS_CHECKSUM_CRC32_BACKEND_ARM )
+	{
+		return( libfsapfs_checksum_update_crc32c_arm(
+		         checksum,
+		         buffer,
+		         size ) );
+	}
+#endif
+	return( libfsapfs_checksum_update_crc32_slicing_by_8(
+	         checksum,
+	         buffer,
+	         size ) );
+}
+
 /* Calculates the weak CRC-32 checksum of a buffer of data
  * Returns 1 if successful or -1 on error
  */
@@ -77,10 +349,7 @@ int libfsapfs_checksum_calculate_weak_crc32(
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function  = "libfsapfs_checkcum_calculate_weak_crc32";
-	size_t buffer_offset   = 0;
-	uint32_t safe_checksum = 0;
-	uint32_t table_index   = 0;
+	static char *function = "libfsapfs_checkcum_calculate_weak_crc32";
 
 	if( checksum == NULL )
 	{
@@ -120,21 +389,233 @@ int libfsapfs_checksum_calculate_weak_crc32(
 		libfsapfs_checksum_initialize_crc32_table(
 		 0x82f63b78UL );
 	}
-	safe_checksum = initial_value;
+	*checksum = libfsapfs_checksum_update_crc32(
+	             initial_value,
+	             buffer,
+	             size );
+
+	return( 1 );
+}
+
+/* Determines the Fletcher-64 backend supported by the CPU
+ */
+void libfsapfs_checksum_initialize_fletcher64_backend(
+      void )
+{
+#if defined( HAVE_LIBFSAPFS_AVX2_FLETCHER64 )
+	unsigned int eax                           = 0;
+	unsigned int ebx                           = 0;
+	unsigned int ecx                           = 0;
+	unsigned int edx                           = 0;
+	unsigned int extended_control_register_eax = 0;
+	unsigned int extended_control_register_edx = 0;
+#endif
+
+	libfsapfs_checksum_fletcher64_backend = LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_SCALAR;
 
-        for( buffer_offset = 0;
-	     buffer_offset < size;
-	     buffer_offset++ )
+#if defined( HAVE_LIBFSAPFS_AVX2_FLETCHER64 )
+	/* CPUID leaf 1 ECX bit 27 indicates the operating system uses XSAVE
+	 * and XCR0 indicates that it preserves the AVX register state
+	 */
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) != 0 )
 	{
-		table_index = ( safe_checksum ^ buffer[ buffer_offset ] ) & 0x000000ffUL;
+		if( ( ecx & 0x08000000UL ) != 0 )
+		{
+			__asm__ __volatile__ (
+			 "xgetbv"
+			 : "=a" ( extended_control_register_eax ), "=d" ( extended_control_register_edx )
+			 : "c" ( 0 ) );
 
-		safe_checksum = libfsapfs_checksum_crc32_table[ table_index ] ^ ( safe_checksum >> 8 );
-        }
-	*checksum = safe_checksum;
+			if( ( ( extended_control_register_eax & 0x06 ) == 0x06 )
+			 && ( __get_cpuid_count(
+			       7,
+			       0,
+			       &eax,
+			       &ebx,
+			       &ecx,
+			       &edx ) != 0 ) )
+			{
+				/* CPUID leaf 7 EBX bit 5 indicates AVX2 support
+				 */
+				if( ( ebx & 0x00000020UL ) != 0 )
+				{
+					libfsapfs_checksum_fletcher64_backend = LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_AVX2;
+				}
+			}
+		}
+	}
+#elif defined( HAVE_LIBFSAPFS_NEON_FLETCHER64 )
+	libfsapfs_checksum_fletcher64_backend = LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_NEON;
+#endif
+	libfsapfs_checksum_fletcher64_backend_initialized = 1;
+}
 
-	return( 1 );
+/* Folds the per-lane sums of a vectorized Fletcher-64 calculation into the lower and upper sums
+ * The values were processed in blocks of number of lanes values, where lane j of the lower sums
+ * contains the sum of the j-th value of every block and lane j of the upper sums the sum of
+ * lane j of the lower sums after every block
+ * The lower and upper sums must have been reduced modulo 0xffffffff
+ */
+void libfsapfs_checksum_fletcher64_fold_lanes(
+      const uint64_t *lane_lower_sums,
+      const uint64_t *lane_upper_sums,
+      int number_of_lanes,
+      uint64_t number_of_values,
+      uint64_t *lower_32bit,
+      uint64_t *upper_32bit )
+{
+	uint64_t lower_sum          = 0;
+	uint64_t upper_sum          = 0;
+	uint64_t weighted_lower_sum = 0;
+	int lane_index              = 0;
+
+	for( lane_index = 0;
+	     lane_index < number_of_lanes;
+	     lane_index++ )
+	{
+		lower_sum          += lane_lower_sums[ lane_index ];
+		upper_sum          += lane_upper_sums[ lane_index ];
+		weighted_lower_sum += lane_lower_sums[ lane_index ] * (uint64_t) lane_index;
+	}
+	/* Value j of a block is added to the upper sum one time less than value j - 1
+	 */
+	upper_sum = ( upper_sum * (uint64_t) number_of_lanes ) - weighted_lower_sum;
+
+	*upper_32bit = ( *upper_32bit + ( ( number_of_values * *lower_32bit ) % 0xffffffffUL ) + ( upper_sum % 0xffffffffUL ) ) % 0xffffffffUL;
+	*lower_32bit = ( *lower_32bit + ( lower_sum % 0xffffffffUL ) ) % 0xffffffffUL;
+}
+
+#if defined( HAVE_LIBFSAPFS_AVX2_FLETCHER64 )
+
+/* Calculates the per-lane Fletcher-64 sums of blocks of 8 32-bit values using AVX2
+ */
+__attribute__((target("avx2")))
+static void libfsapfs_checksum_fletcher64_calculate_lanes_avx2(
+             const uint8_t *buffer,
+             size_t number_of_blocks,
+             uint64_t *lane_lower_sums,
+             uint64_t *lane_upper_sums )
+{
+	__m256i lower_sums_high = _mm256_setzero_si256();
+	__m256i lower_sums_low  = _mm256_setzero_si256();
+	__m256i upper_sums_high = _mm256_setzero_si256();
+	__m256i upper_sums_low  = _mm256_setzero_si256();
+	__m256i values          = _mm256_setzero_si256();
+
+	while( number_of_blocks > 0 )
+	{
+		values = _mm256_loadu_si256(
+		          (const __m256i *) buffer );
+
+		lower_sums_low = _mm256_add_epi64(
+		                  lower_sums_low,
+		                  _mm256_cvtepu32_epi64(
+		                   _mm256_castsi256_si128(
+		                    values ) ) );
+
+		lower_sums_high = _mm256_add_epi64(
+		                   lower_sums_high,
+		                   _mm256_cvtepu32_epi64(
+		                    _mm256_extracti128_si256(
+		                     values,
+		                     1 ) ) );
+
+		upper_sums_low = _mm256_add_epi64(
+		                  upper_sums_low,
+		                  lower_sums_low );
+
+		upper_sums_high = _mm256_add_epi64(
+		                   upper_sums_high,
+		                   lower_sums_high );
+
+		buffer           += 32;
+		number_of_blocks -= 1;
+	}
+	_mm256_storeu_si256(
+	 (__m256i *) lane_lower_sums,
+	 lower_sums_low );
+
+	_mm256_storeu_si256(
+	 (__m256i *) &( lane_lower_sums[ 4 ] ),
+	 lower_sums_high );
+
+	_mm256_storeu_si256(
+	 (__m256i *) lane_upper_sums,
+	 upper_sums_low );
+
+	_mm256_storeu_si256(
+	 (__m256i *) &( lane_upper_sums[ 4 ] ),
+	 upper_sums_high );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_AVX2_FLETCHER64 ) */
+
+#if defined( HAVE_LIBFSAPFS_NEON_FLETCHER64 )
+
+/* Calculates the per-lane Fletcher-64 sums of blocks of 4 32-bit values using NEON
+ */
+static void libfsapfs_checksum_fletcher64_calculate_lanes_neon(
+             const uint8_t *buffer,
+             size_t number_of_blocks,
+             uint64_t *lane_lower_sums,
+             uint64_t *lane_upper_sums )
+{
+	uint64x2_t lower_sums_high = vdupq_n_u64( 0 );
+	uint64x2_t lower_sums_low  = vdupq_n_u64( 0 );
+	uint64x2_t upper_sums_high = vdupq_n_u64( 0 );
+	uint64x2_t upper_sums_low  = vdupq_n_u64( 0 );
+	uint32x4_t values          = vdupq_n_u32( 0 );
+
+	while( number_of_blocks > 0 )
+	{
+		values = vreinterpretq_u32_u8(
+		          vld1q_u8(
+		           buffer ) );
+
+		lower_sums_low = vaddw_u32(
+		                  lower_sums_low,
+		                  vget_low_u32(
+		                   values ) );
+
+		lower_sums_high = vaddw_high_u32(
+		                   lower_sums_high,
+		                   values );
+
+		upper_sums_low = vaddq_u64(
+		                  upper_sums_low,
+		                  lower_sums_low );
+
+		upper_sums_high = vaddq_u64(
+		                   upper_sums_high,
+		                   lower_sums_high );
+
+		buffer           += 16;
+		number_of_blocks -= 1;
+	}
+	vst1q_u64(
+	 lane_lower_sums,
+	 lower_sums_low );
+
+	vst1q_u64(
+	 &( lane_lower_sums[ 2 ] ),
+	 lower_sums_high );
+
+	vst1q_u64(
+	 lane_upper_sums,
+	 upper_sums_low );
+
+	vst1q_u64(
+	 &( lane_upper_sums[ 2 ] ),
+	 upper_sums_high );
 }
 
+#endif /* defined( HAVE_LIBFSAPFS_NEON_FLETCHER64 ) */
+
 /* Calculates the Fletcher-64 of a buffer of data
  * Returns 1 if successful or -1 on error
  */
@@ -145,11 +626,20 @@ int libfsapfs_checksum_calculate_fletcher64(
      uint64_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_checksum_calculate_fletcher64";
-	size_t buffer_offset  = 0;
-	uint64_t lower_32bit  = 0;
-	uint64_t upper_32bit  = 0;
-	uint32_t value_32bit  = 0;
+	static char *function   = "libfsapfs_checksum_calculate_fletcher64";
+	size_t buffer_offset    = 0;
+	size_t chunk_end_offset = 0;
+	size_t chunk_size       = 0;
+	uint64_t lower_32bit    = 0;
+	uint64_t upper_32bit    = 0;
+	uint32_t value_32bit    = 0;
+
+#if defined( HAVE_LIBFSAPFS_AVX2_FLETCHER64 ) || defined( HAVE_LIBFSAPFS_NEON_FLETCHER64 )
+	uint64_t lane_lower_sums[ 8 ];
+	uint64_t lane_upper_sums[ 8 ];
+
+	size_t number_of_blocks = 0;
+#endif
 
 	if( buffer == NULL )
 	{
@@ -198,16 +688,78 @@ int libfsapfs_checksum_calculate_fletcher64(
 	lower_32bit = initial_value & 0xffffffffUL;
 	upper_32bit = ( initial_value >> 32 ) & 0xffffffffUL;
 
-        for( buffer_offset = 0;
-	     buffer_offset < size;
-	     buffer_offset += 4 )
+	if( libfsapfs_checksum_fletcher64_backend_initialized == 0 )
 	{
-		byte_stream_copy_to_uint32_little_endian(
-		 &( buffer[ buffer_offset ] ),
-		 value_32bit );
+		libfsapfs_checksum_initialize_fletcher64_backend();
+	}
+	while( buffer_offset < size )
+	{
+		chunk_size = size - buffer_offset;
+
+		if( chunk_size > LIBFSAPFS_CHECKSUM_FLETCHER64_MAXIMUM_CHUNK_SIZE )
+		{
+			chunk_size = LIBFSAPFS_CHECKSUM_FLETCHER64_MAXIMUM_CHUNK_SIZE;
+		}
+		chunk_end_offset = buffer_offset + chunk_size;
+
+#if defined( HAVE_LIBFSAPFS_AVX2_FLETCHER64 )
+		if( ( libfsapfs_checksum_fletcher64_backend == LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_AVX2 )
+		 && ( chunk_size >= 32 ) )
+		{
+			number_of_blocks = chunk_size / 32;
+
+			libfsapfs_checksum_fletcher64_calculate_lanes_avx2(
+			 &( buffer[ buffer_offset ] ),
+			 number_of_blocks,
+			 lane_lower_sums,
+			 lane_upper_sums );
+
+			libfsapfs_checksum_fletcher64_fold_lanes(
+			 lane_lower_sums,
+			 lane_upper_sums,
+			 8,
+			 (uint64_t) number_of_blocks * 8,
+			 &lower_32bit,
+			 &upper_32bit );
 
-		lower_32bit += value_32bit;
-		upper_32bit += lower_32bit;
+			buffer_offset += number_of_blocks * 32;
+		}
+#elif defined( HAVE_LIBFSAPFS_NEON_FLETCHER64 )
+		if( ( libfsapfs_checksum_fletcher64_backend == LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_NEON )
+		 && ( chunk_size >= 16 ) )
+		{
+			number_of_blocks = chunk_size / 16;
+
+			libfsapfs_checksum_fletcher64_calculate_lanes_neon(
+			 &( buffer[ buffer_offset ] ),
+			 number_of_blocks,
+			 lane_lower_sums,
+			 lane_upper_sums );
+
+			libfsapfs_checksum_fletcher64_fold_lanes(
+			 lane_lower_sums,
+			 lane_upper_sums,
+			 4,
+			 (uint64_t) number_of_blocks * 4,
+			 &lower_32bit,
+			 &upper_32bit );
+
+			buffer_offset += number_of_blocks * 16;
+		}
+#endif
+		while( buffer_offset < chunk_end_offset )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( buffer[ buffer_offset ] ),
+			 value_32bit );
+
+			lower_32bit += value_32bit;
+			upper_32bit += lower_32bit;
+
+			buffer_offset += 4;
+		}
+		lower_32bit %= 0xffffffffUL;
+		upper_32bit %= 0xffffffffUL;
 	}
 	lower_32bit %= 0xffffffffUL;
 	upper_32bit %= 0xffffffffUL;
@@ -33,14 +33,33 @@ extern "C" {
 #endif
 
 LIBFSAPFS_EXTERN_VARIABLE \
-uint32_t libfsapfs_checksum_crc32_table[ 256 ];
+uint32_t libfsapfs_checksum_crc32_table[ 8 ][ 256 ];
 
 LIBFSAPFS_EXTERN_VARIABLE \
 int libfsapfs_checksum_crc32_table_computed;
 
+LIBFSAPFS_EXTERN_VARIABLE \
+int libfsapfs_checksum_crc32_backend;
+
+LIBFSAPFS_EXTERN_VARIABLE \
+int libfsapfs_checksum_fletcher64_backend;
+
+LIBFSAPFS_EXTERN_VARIABLE \
+int libfsapfs_checksum_fletcher64_backend_initialized;
+
 void libfsapfs_checksum_initialize_crc32_table(
       uint32_t polynomial );
 
+uint32_t libfsapfs_checksum_update_crc32_slicing_by_8(
+          uint32_t checksum,
+          const uint8_t *buffer,
+          size_t size );
+
+uint32_t libfsapfs_checksum_update_crc32(
+          uint32_t checksum,
+          const uint8_t *buffer,
+          size_t size );
+
 int libfsapfs_checksum_calculate_weak_crc32(
      uint32_t *checksum,
      const uint8_t *buffer,
@@ -48,6 +67,17 @@ int libfsapfs_checksum_calculate_weak_crc32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
+void libfsapfs_checksum_initialize_fletcher64_backend(
+      void );
+
+void libfsapfs_checksum_fletcher64_fold_lanes(
+      const uint64_t *lane_lower_sums,
+      const uint64_t *lane_upper_sums,
+      int number_of_lanes,
+      uint64_t number_of_values,
+      uint64_t *lower_32bit,
+      uint64_t *upper_32bit );
+
 int libfsapfs_checksum_calculate_fletcher64(
      uint64_t *checksum,
      const uint8_t *buffer,
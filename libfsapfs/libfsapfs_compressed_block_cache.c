@@ -0,0 +1,968 @@
+/*
+ * The compressed block cache functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_compressed_block_cache.h"
+#include "libfsapfs_data_block.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+/* Creates a compressed block cache
+ * Make sure the value compressed_block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_block_cache_initialize(
+     libfsapfs_compressed_block_cache_t **compressed_block_cache,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_compressed_block_cache_initialize";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int shard_index       = 0;
+#endif
+
+	if( compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compressed block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*compressed_block_cache = memory_allocate_structure(
+	                           libfsapfs_compressed_block_cache_t );
+
+	if( *compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compressed_block_cache,
+	     0,
+	     sizeof( libfsapfs_compressed_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compressed block cache.",
+		 function );
+
+		memory_free(
+		 *compressed_block_cache );
+
+		*compressed_block_cache = NULL;
+
+		return( -1 );
+	}
+	if( libfsapfs_compressed_block_cache_allocate_entries(
+	     *compressed_block_cache,
+	     maximum_number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *compressed_block_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *compressed_block_cache )->shards[ shard_index ].mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex of shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *compressed_block_cache != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		for( shard_index = 0;
+		     shard_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			if( ( *compressed_block_cache )->shards[ shard_index ].mutex != NULL )
+			{
+				libcthreads_mutex_free(
+				 &( ( *compressed_block_cache )->shards[ shard_index ].mutex ),
+				 NULL );
+			}
+		}
+		if( ( *compressed_block_cache )->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *compressed_block_cache )->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( ( *compressed_block_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *compressed_block_cache )->entries );
+		}
+		memory_free(
+		 *compressed_block_cache );
+
+		*compressed_block_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees the data blocks of the entries of a compressed block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_block_cache_free_entries(
+     libfsapfs_compressed_block_cache_entry_t *entries,
+     uint32_t number_of_sets,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_compressed_block_cache_free_entries";
+	uint32_t entry_index  = 0;
+	uint32_t entry_count  = 0;
+	int result            = 1;
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries.",
+		 function );
+
+		return( -1 );
+	}
+	entry_count = number_of_sets * LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS;
+
+	for( entry_index = 0;
+	     entry_index < entry_count;
+	     entry_index++ )
+	{
+		if( entries[ entry_index ].data_block != NULL )
+		{
+			if( libfsapfs_data_block_free(
+			     &( entries[ entry_index ].data_block ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data block of entry: %" PRIu32 ".",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+	}
+	return( result );
+}
+
+/* Frees a compressed block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_block_cache_free(
+     libfsapfs_compressed_block_cache_t **compressed_block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_compressed_block_cache_free";
+	int result            = 1;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int shard_index       = 0;
+#endif
+
+	if( compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_block_cache != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		for( shard_index = 0;
+		     shard_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *compressed_block_cache )->shards[ shard_index ].mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex of shard: %d.",
+				 function,
+				 shard_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( ( *compressed_block_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *compressed_block_cache )->entries != NULL )
+		{
+			if( libfsapfs_compressed_block_cache_free_entries(
+			     ( *compressed_block_cache )->entries,
+			     ( *compressed_block_cache )->number_of_sets,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free entries.",
+				 function );
+
+				result = -1;
+			}
+			memory_free(
+			 ( *compressed_block_cache )->entries );
+		}
+		memory_free(
+		 *compressed_block_cache );
+
+		*compressed_block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Allocates the entries of the compressed block cache
+ * The number of sets is the largest power of 2 for which the number of entries
+ * does not exceed the maximum number of blocks, with a minimum of 1 set
+ * Any previously cached blocks are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_block_cache_allocate_entries(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	libfsapfs_compressed_block_cache_entry_t *entries = NULL;
+	static char *function                             = "libfsapfs_compressed_block_cache_allocate_entries";
+	size_t entries_size                               = 0;
+	uint32_t number_of_sets                           = 1;
+	int result                                        = 1;
+	int shard_index                                   = 0;
+
+	if( compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( number_of_sets < ( (uint32_t) INT32_MAX / ( 2 * LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS ) ) )
+	    && ( ( number_of_sets * 2 * LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS ) <= (uint32_t) maximum_number_of_blocks ) )
+	{
+		number_of_sets *= 2;
+	}
+	entries_size = (size_t) number_of_sets * LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS * sizeof( libfsapfs_compressed_block_cache_entry_t );
+
+	if( ( entries_size == 0 )
+	 || ( entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entries size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries = (libfsapfs_compressed_block_cache_entry_t *) memory_allocate(
+	                                                        entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 entries );
+
+		return( -1 );
+	}
+	if( compressed_block_cache->entries != NULL )
+	{
+		if( libfsapfs_compressed_block_cache_free_entries(
+		     compressed_block_cache->entries,
+		     compressed_block_cache->number_of_sets,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 compressed_block_cache->entries );
+	}
+	compressed_block_cache->entries        = entries;
+	compressed_block_cache->number_of_sets = number_of_sets;
+
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		compressed_block_cache->shards[ shard_index ].current_time = 0;
+	}
+	return( result );
+}
+
+/* Resizes the compressed block cache
+ * The cached blocks are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_block_cache_resize(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_compressed_block_cache_resize";
+	int result            = 1;
+
+	if( compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     compressed_block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_compressed_block_cache_allocate_entries(
+	     compressed_block_cache,
+	     maximum_number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     compressed_block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the uncompressed data of a specific compressed block of a file
+ * The data is copied since the cache entry can be replaced by another
+ * reader once the lock is released
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_compressed_block_cache_get_block_data(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     uint32_t block_index,
+     uint8_t *block_data,
+     size_t block_data_size,
+     size_t *uncompressed_block_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_compressed_block_cache_entry_t *entry = NULL;
+	libfsapfs_compressed_block_cache_shard_t *shard = NULL;
+	libfsapfs_data_block_t *data_block              = NULL;
+	static char *function                           = "libfsapfs_compressed_block_cache_get_block_data";
+	uint32_t entry_index                            = 0;
+	uint32_t set_index                              = 0;
+	int result                                      = 0;
+
+	if( compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid identifier value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed block size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     compressed_block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set_index = (uint32_t) ( ( ( identifier ^ ( (uint64_t) block_index << 32 ) ^ block_index ) * 0x9e3779b97f4a7c15UL ) >> 32 ) & ( compressed_block_cache->number_of_sets - 1 );
+
+	shard = &( compressed_block_cache->shards[ set_index & ( LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS - 1 ) ] );
+
+	/* The mutex of the shard is needed since the last used time is updated
+	 * and the data block can be replaced by another reader
+	 */
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex of shard.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 compressed_block_cache->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	entry = &( compressed_block_cache->entries[ set_index * LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		if( ( entry[ entry_index ].data_block != NULL )
+		 && ( entry[ entry_index ].identifier == identifier )
+		 && ( entry[ entry_index ].block_index == block_index ) )
+		{
+			data_block = entry[ entry_index ].data_block;
+
+			if( data_block->data_size > block_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid block data size value too small.",
+				 function );
+
+				result = -1;
+			}
+			else if( memory_copy(
+			          block_data,
+			          data_block->data,
+			          data_block->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block data.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				shard->current_time += 1;
+
+				entry[ entry_index ].last_used_time = shard->current_time;
+
+				*uncompressed_block_size = data_block->data_size;
+
+				result = 1;
+			}
+			break;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     ( result != -1 ) ? error : NULL ) != 1 )
+	{
+		if( result != -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex of shard.",
+			 function );
+		}
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     compressed_block_cache->read_write_lock,
+	     ( result != -1 ) ? error : NULL ) != 1 )
+	{
+		if( result != -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+		}
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Stores the uncompressed data of a specific compressed block of a file
+ * The least recently used entry of the set is replaced if the set is full
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_block_cache_set_block_data(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     uint32_t block_index,
+     const uint8_t *block_data,
+     size_t block_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_compressed_block_cache_entry_t *entry = NULL;
+	libfsapfs_compressed_block_cache_shard_t *shard = NULL;
+	libfsapfs_data_block_t *data_block              = NULL;
+	libfsapfs_data_block_t *replaced_data_block     = NULL;
+	static char *function                           = "libfsapfs_compressed_block_cache_set_block_data";
+	uint32_t entry_index                            = 0;
+	uint32_t replace_entry_index                    = 0;
+	uint32_t set_index                              = 0;
+	int result                                      = 1;
+
+	if( compressed_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid identifier value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_data_size == 0 )
+	 || ( block_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data block is created outside the lock to keep the time the lock is held short
+	 */
+	if( libfsapfs_data_block_initialize(
+	     &data_block,
+	     block_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     data_block->data,
+	     block_data,
+	     block_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     compressed_block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	set_index = (uint32_t) ( ( ( identifier ^ ( (uint64_t) block_index << 32 ) ^ block_index ) * 0x9e3779b97f4a7c15UL ) >> 32 ) & ( compressed_block_cache->number_of_sets - 1 );
+
+	shard = &( compressed_block_cache->shards[ set_index & ( LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS - 1 ) ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex of shard.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 compressed_block_cache->read_write_lock,
+		 NULL );
+
+		goto on_error;
+	}
+#endif
+	entry = &( compressed_block_cache->entries[ set_index * LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		/* Reuse the entry of the same file identifier and block index or an unused entry
+		 */
+		if( ( entry[ entry_index ].data_block == NULL )
+		 || ( ( entry[ entry_index ].identifier == identifier )
+		  &&  ( entry[ entry_index ].block_index == block_index ) ) )
+		{
+			replace_entry_index = entry_index;
+
+			break;
+		}
+		if( entry[ entry_index ].last_used_time < entry[ replace_entry_index ].last_used_time )
+		{
+			replace_entry_index = entry_index;
+		}
+	}
+	shard->current_time += 1;
+
+	replaced_data_block = entry[ replace_entry_index ].data_block;
+
+	entry[ replace_entry_index ].data_block     = data_block;
+	entry[ replace_entry_index ].identifier     = identifier;
+	entry[ replace_entry_index ].block_index    = block_index;
+	entry[ replace_entry_index ].last_used_time = shard->current_time;
+
+	data_block = NULL;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex of shard.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     compressed_block_cache->read_write_lock,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+		}
+		result = -1;
+	}
+#endif
+	/* The replaced data block is freed outside the lock
+	 */
+	if( replaced_data_block != NULL )
+	{
+		if( libfsapfs_data_block_free(
+		     &replaced_data_block,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free replaced data block.",
+				 function );
+			}
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+	if( data_block != NULL )
+	{
+		libfsapfs_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( -1 );
+}
@@ -0,0 +1,159 @@
+/*
+ * The compressed block cache functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_COMPRESSED_BLOCK_CACHE_H )
+#define _LIBFSAPFS_COMPRESSED_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_data_block.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of entries per set of the compressed block cache
+ */
+#define LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS		4
+
+/* The number of shards of the compressed block cache, where every shard has its own lock
+ * This value must be a power of 2
+ */
+#define LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS	16
+
+typedef struct libfsapfs_compressed_block_cache_entry libfsapfs_compressed_block_cache_entry_t;
+
+struct libfsapfs_compressed_block_cache_entry
+{
+	/* The data block that contains the uncompressed data
+	 */
+	libfsapfs_data_block_t *data_block;
+
+	/* The file identifier
+	 */
+	uint64_t identifier;
+
+	/* The compressed block index
+	 */
+	uint32_t block_index;
+
+	/* The last time the entry was used
+	 */
+	uint64_t last_used_time;
+};
+
+typedef struct libfsapfs_compressed_block_cache_shard libfsapfs_compressed_block_cache_shard_t;
+
+struct libfsapfs_compressed_block_cache_shard
+{
+	/* The current time
+	 */
+	uint64_t current_time;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+typedef struct libfsapfs_compressed_block_cache libfsapfs_compressed_block_cache_t;
+
+/* The compressed block cache contains the uncompressed data of compressed blocks
+ * of the files in a volume and is shared by the file entries of the volume.
+ * The entries are stored in a set associative hash table of file identifier and
+ * block index, where the least recently used entry of a set is replaced when the
+ * set is full. The sets are divided over shards so that lookups of different sets
+ * do not contend on the same lock.
+ */
+struct libfsapfs_compressed_block_cache
+{
+	/* The entries
+	 */
+	libfsapfs_compressed_block_cache_entry_t *entries;
+
+	/* The number of sets
+	 * This value is always a power of 2
+	 */
+	uint32_t number_of_sets;
+
+	/* The shards
+	 */
+	libfsapfs_compressed_block_cache_shard_t shards[ LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_SHARDS ];
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 * The lock is grabbed for reading by lookups and for writing when the entries are reallocated
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfsapfs_compressed_block_cache_initialize(
+     libfsapfs_compressed_block_cache_t **compressed_block_cache,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_block_cache_free(
+     libfsapfs_compressed_block_cache_t **compressed_block_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_block_cache_free_entries(
+     libfsapfs_compressed_block_cache_entry_t *entries,
+     uint32_t number_of_sets,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_block_cache_allocate_entries(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_block_cache_resize(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_block_cache_get_block_data(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     uint32_t block_index,
+     uint8_t *block_data,
+     size_t block_data_size,
+     size_t *uncompressed_block_size,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_block_cache_set_block_data(
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     uint32_t block_index,
+     const uint8_t *block_data,
+     size_t block_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_COMPRESSED_BLOCK_CACHE_H ) */
+
@@ -24,15 +24,30 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_compressed_block_cache.h"
 #include "libfsapfs_compressed_data_handle.h"
 #include "libfsapfs_compression.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_unused.h"
+#include "libfsapfs_worker_pool.h"
 
-#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE	65536
+#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE			LIBFSAPFS_COMPRESSED_BLOCK_SIZE
+
+/* The maximum number of compressed blocks that is read ahead on sequential reads
+ */
+#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_READ_AHEAD_BLOCKS	32
+
+/* The minimum number of compressed blocks for which the decompression is spread across the worker threads
+ */
+#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_MINIMUM_PARALLEL_BLOCKS	4
+
+/* The maximum number of compressed blocks that is decompressed in parallel at once
+ */
+#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_PARALLEL_BLOCKS	64
 
 /* Creates compressed data handle
  * Make sure the value data_handle is referencing, is set to NULL
@@ -82,6 +97,7 @@ int libfsapfs_compressed_data_handle_initialize(
 	}
 	if( ( compression_method != LIBFSAPFS_COMPRESSION_METHOD_DEFLATE )
 	 && ( compression_method != LIBFSAPFS_COMPRESSION_METHOD_LZVN )
+	 && ( compression_method != LIBFSAPFS_COMPRESSION_METHOD_LZFSE )
 	 && ( compression_method != LIBFSAPFS_COMPRESSION_METHOD_UNKNOWN5 ) )
 	{
 		libcerror_error_set(
@@ -161,6 +177,8 @@ int libfsapfs_compressed_data_handle_initialize(
 	( *data_handle )->current_compressed_block_index = (uint32_t) -1;
 	( *data_handle )->uncompressed_data_size         = uncompressed_data_size;
 	( *data_handle )->compression_method             = compression_method;
+	( *data_handle )->read_ahead_number_of_blocks    = 1;
+	( *data_handle )->number_of_threads              = 1;
 
 	return( 1 );
 
@@ -222,6 +240,11 @@ int libfsapfs_compressed_data_handle_free(
 			memory_free(
 			 ( *data_handle )->compressed_block_offsets );
 		}
+		if( ( *data_handle )->read_ahead_data != NULL )
+		{
+			memory_free(
+			 ( *data_handle )->read_ahead_data );
+		}
 		memory_free(
 		 *data_handle );
 
@@ -230,6 +253,84 @@ int libfsapfs_compressed_data_handle_free(
 	return( 1 );
 }
 
+/* Sets the compressed block cache
+ * The cache is shared with other data handles and is not managed by the data handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_set_compressed_block_cache(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_compressed_data_handle_set_compressed_block_cache";
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	data_handle->compressed_block_cache = compressed_block_cache;
+	data_handle->identifier             = identifier;
+
+	return( 1 );
+}
+
+/* Sets the number of threads used to decompress data
+ * Reads that cover multiple whole compressed blocks are spread across the threads,
+ * where the calling thread is one of them and the others are worker threads of the worker pool
+ * Without multi-threading support or a worker pool the data is always decompressed by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_set_number_of_threads(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_compressed_data_handle_set_number_of_threads";
+
+#if !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	LIBFSAPFS_UNREFERENCED_PARAMETER( worker_pool )
+#endif
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	data_handle->worker_pool = worker_pool;
+#endif
+	data_handle->number_of_threads = number_of_threads;
+
+	return( 1 );
+}
+
 /* Determines the compressed block offsets
  * Returns 1 if successful or -1 on error
  */
@@ -459,7 +560,8 @@ int libfsapfs_compressed_data_handle_get_compressed_block_offsets(
 		compressed_descriptors_offset   += 4;
 		compressed_block_descriptor_size = 8;
 	}
-	else if( data_handle->compression_method == LIBFSAPFS_COMPRESSION_METHOD_LZVN )
+	else if( ( data_handle->compression_method == LIBFSAPFS_COMPRESSION_METHOD_LZVN )
+	      || ( data_handle->compression_method == LIBFSAPFS_COMPRESSION_METHOD_LZFSE ) )
 	{
 		segment_data_offset = 0;
 
@@ -800,6 +902,598 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the data of a specific compressed block
+ * On sequential reads the data of the subsequent compressed blocks is read ahead
+ * into the read-ahead data, where the read-ahead window doubles on every read up
+ * to LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_READ_AHEAD_BLOCKS
+ * The compressed block data references either the compressed segment data or the read-ahead data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_read_compressed_block(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint8_t **compressed_block_data,
+     size_t *compressed_block_size,
+     libcerror_error_t **error )
+{
+	uint8_t *read_ahead_data             = NULL;
+	static char *function                = "libfsapfs_compressed_data_handle_read_compressed_block";
+	size_t read_size                     = 0;
+	ssize_t read_count                   = 0;
+	off64_t data_stream_offset           = 0;
+	uint32_t last_compressed_block_index = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->compressed_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing compressed block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_index >= data_handle->number_of_compressed_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block size.",
+		 function );
+
+		return( -1 );
+	}
+	data_stream_offset = data_handle->compressed_block_offsets[ compressed_block_index ];
+	read_size          = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + 1 ] - data_stream_offset );
+
+	if( ( data_handle->read_ahead_data != NULL )
+	 && ( data_stream_offset >= data_handle->read_ahead_data_offset )
+	 && ( (size64_t) ( data_stream_offset + read_size ) <= (size64_t) ( data_handle->read_ahead_data_offset + data_handle->read_ahead_data_size ) ) )
+	{
+		*compressed_block_data = &( data_handle->read_ahead_data[ data_stream_offset - data_handle->read_ahead_data_offset ] );
+		*compressed_block_size = read_size;
+
+		return( 1 );
+	}
+	if( compressed_block_index == ( data_handle->current_compressed_block_index + 1 ) )
+	{
+		if( data_handle->read_ahead_number_of_blocks < LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_READ_AHEAD_BLOCKS )
+		{
+			data_handle->read_ahead_number_of_blocks *= 2;
+		}
+	}
+	else
+	{
+		data_handle->read_ahead_number_of_blocks = 1;
+	}
+	if( data_handle->read_ahead_number_of_blocks <= 1 )
+	{
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              data_handle->compressed_data_stream,
+		              (intptr_t *) file_io_handle,
+		              data_handle->compressed_segment_data,
+		              read_size,
+		              data_stream_offset,
+		              0,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x08%" PRIx64 ") from data stream.",
+			 function,
+			 data_stream_offset,
+			 data_stream_offset );
+
+			return( -1 );
+		}
+		*compressed_block_data = data_handle->compressed_segment_data;
+		*compressed_block_size = read_size;
+
+		return( 1 );
+	}
+	last_compressed_block_index = compressed_block_index + data_handle->read_ahead_number_of_blocks;
+
+	if( last_compressed_block_index > data_handle->number_of_compressed_blocks )
+	{
+		last_compressed_block_index = data_handle->number_of_compressed_blocks;
+	}
+	/* The size of a compressed block is at most LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1
+	 * hence the read size is bounded by the maximum number of read-ahead blocks
+	 */
+	read_size = (size_t) ( data_handle->compressed_block_offsets[ last_compressed_block_index ] - data_stream_offset );
+
+	if( read_size > data_handle->read_ahead_data_allocated_size )
+	{
+		read_ahead_data = (uint8_t *) memory_reallocate(
+		                               data_handle->read_ahead_data,
+		                               sizeof( uint8_t ) * read_size );
+
+		if( read_ahead_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize read-ahead data.",
+			 function );
+
+			return( -1 );
+		}
+		data_handle->read_ahead_data                = read_ahead_data;
+		data_handle->read_ahead_data_allocated_size = read_size;
+	}
+	data_handle->read_ahead_data_size = 0;
+
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              data_handle->compressed_data_stream,
+	              (intptr_t *) file_io_handle,
+	              data_handle->read_ahead_data,
+	              read_size,
+	              data_stream_offset,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x08%" PRIx64 ") from data stream.",
+		 function,
+		 data_stream_offset,
+		 data_stream_offset );
+
+		return( -1 );
+	}
+	data_handle->read_ahead_data_offset = data_stream_offset;
+	data_handle->read_ahead_data_size   = read_size;
+
+	*compressed_block_data = data_handle->read_ahead_data;
+	*compressed_block_size = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + 1 ] - data_stream_offset );
+
+	return( 1 );
+}
+
+/* Decompresses consecutive compressed blocks that each contain LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE bytes of uncompressed data
+ * The compressed block offsets contain number_of_compressed_blocks + 1 entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_decompress_blocks(
+     const uint8_t *compressed_data,
+     uint32_t compressed_data_offset,
+     const uint32_t *compressed_block_offsets,
+     uint32_t number_of_compressed_blocks,
+     int compression_method,
+     uint8_t *uncompressed_data,
+     libcerror_error_t **error )
+{
+	static char *function          = "libfsapfs_compressed_data_handle_decompress_blocks";
+	size_t compressed_block_size   = 0;
+	size_t uncompressed_block_size = 0;
+	uint32_t block_index           = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < number_of_compressed_blocks;
+	     block_index++ )
+	{
+		if( ( compressed_block_offsets[ block_index ] < compressed_data_offset )
+		 || ( compressed_block_offsets[ block_index + 1 ] < compressed_block_offsets[ block_index ] ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid compressed block: %" PRIu32 " offset value out of bounds.",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		compressed_block_size   = (size_t) ( compressed_block_offsets[ block_index + 1 ] - compressed_block_offsets[ block_index ] );
+		uncompressed_block_size = LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+		if( libfsapfs_decompress_data(
+		     &( compressed_data[ compressed_block_offsets[ block_index ] - compressed_data_offset ] ),
+		     compressed_block_size,
+		     compression_method,
+		     &( uncompressed_data[ (size_t) block_index * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ] ),
+		     &uncompressed_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decompress block: %" PRIu32 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		if( uncompressed_block_size != LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid block: %" PRIu32 " uncompressed data size value out of bounds.",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+/* Decompresses the compressed blocks of a worker thread
+ * Callback for the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_decompress_thread_callback(
+     libfsapfs_compressed_data_handle_thread_values_t *thread_values )
+{
+	if( thread_values == NULL )
+	{
+		return( -1 );
+	}
+	/* The error cannot be passed between threads
+	 */
+	thread_values->result = libfsapfs_compressed_data_handle_decompress_blocks(
+	                         thread_values->compressed_data,
+	                         thread_values->compressed_data_offset,
+	                         thread_values->compressed_block_offsets,
+	                         thread_values->number_of_compressed_blocks,
+	                         thread_values->compression_method,
+	                         thread_values->uncompressed_data,
+	                         NULL );
+
+	return( thread_values->result );
+}
+
+/* Reads and decompresses consecutive whole compressed blocks by spreading them across
+ * the worker threads and the calling thread
+ * The worker threads of the worker pool must be grabbed by the calling thread
+ * The uncompressed data is written directly into the uncompressed data buffer, which must
+ * be able to contain number_of_compressed_blocks * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint32_t number_of_compressed_blocks,
+     uint8_t *uncompressed_data,
+     libcerror_error_t **error )
+{
+	libfsapfs_compressed_data_handle_thread_values_t thread_values[ LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS - 1 ];
+	libfsapfs_worker_pool_job_t jobs[ LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS - 1 ];
+
+	uint8_t *read_ahead_data          = NULL;
+	static char *function             = "libfsapfs_compressed_data_handle_read_compressed_blocks_parallel";
+	size_t read_size                  = 0;
+	ssize_t read_count                = 0;
+	off64_t data_stream_offset        = 0;
+	uint32_t first_block_index        = 0;
+	uint32_t thread_number_of_blocks  = 0;
+	int number_of_jobs                = 0;
+	int result                        = 1;
+	int thread_index                  = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->compressed_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing compressed block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_handle->number_of_threads < 1 )
+	 || ( data_handle->number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_compressed_blocks == 0 )
+	 || ( number_of_compressed_blocks > LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_PARALLEL_BLOCKS )
+	 || ( compressed_block_index >= data_handle->number_of_compressed_blocks )
+	 || ( number_of_compressed_blocks > ( data_handle->number_of_compressed_blocks - compressed_block_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of compressed blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The compressed blocks are stored consecutively hence they are read at once
+	 * The size of a compressed block is at most LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1
+	 * hence the read size is bounded by the maximum number of parallel blocks
+	 */
+	data_stream_offset = data_handle->compressed_block_offsets[ compressed_block_index ];
+	read_size          = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + number_of_compressed_blocks ] - data_stream_offset );
+
+	if( read_size > data_handle->read_ahead_data_allocated_size )
+	{
+		read_ahead_data = (uint8_t *) memory_reallocate(
+		                               data_handle->read_ahead_data,
+		                               sizeof( uint8_t ) * read_size );
+
+		if( read_ahead_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize read-ahead data.",
+			 function );
+
+			return( -1 );
+		}
+		data_handle->read_ahead_data                = read_ahead_data;
+		data_handle->read_ahead_data_allocated_size = read_size;
+	}
+	data_handle->read_ahead_data_size = 0;
+
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              data_handle->compressed_data_stream,
+	              (intptr_t *) file_io_handle,
+	              data_handle->read_ahead_data,
+	              read_size,
+	              data_stream_offset,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x08%" PRIx64 ") from data stream.",
+		 function,
+		 data_stream_offset,
+		 data_stream_offset );
+
+		return( -1 );
+	}
+	data_handle->read_ahead_data_offset = data_stream_offset;
+	data_handle->read_ahead_data_size   = read_size;
+
+	/* Every thread decompresses a contiguous range of compressed blocks,
+	 * where the calling thread decompresses the first range
+	 */
+	thread_number_of_blocks = ( number_of_compressed_blocks + data_handle->number_of_threads - 1 ) / data_handle->number_of_threads;
+
+	for( thread_index = 0;
+	     thread_index < ( data_handle->number_of_threads - 1 );
+	     thread_index++ )
+	{
+		first_block_index = thread_number_of_blocks * ( thread_index + 1 );
+
+		if( first_block_index >= number_of_compressed_blocks )
+		{
+			break;
+		}
+		thread_values[ thread_index ].compressed_data             = data_handle->read_ahead_data;
+		thread_values[ thread_index ].compressed_data_offset      = (uint32_t) data_stream_offset;
+		thread_values[ thread_index ].compressed_block_offsets    = &( data_handle->compressed_block_offsets[ compressed_block_index + first_block_index ] );
+		thread_values[ thread_index ].number_of_compressed_blocks = number_of_compressed_blocks - first_block_index;
+		thread_values[ thread_index ].compression_method          = data_handle->compression_method;
+		thread_values[ thread_index ].uncompressed_data           = &( uncompressed_data[ (size_t) first_block_index * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ] );
+		thread_values[ thread_index ].result                      = 0;
+
+		if( thread_values[ thread_index ].number_of_compressed_blocks > thread_number_of_blocks )
+		{
+			thread_values[ thread_index ].number_of_compressed_blocks = thread_number_of_blocks;
+		}
+		jobs[ thread_index ].function  = (int (*)(void *)) &libfsapfs_compressed_data_handle_decompress_thread_callback;
+		jobs[ thread_index ].arguments = (void *) &( thread_values[ thread_index ] );
+
+		if( libfsapfs_worker_pool_push_job(
+		     data_handle->worker_pool,
+		     &( jobs[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job: %d onto worker pool.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_jobs++;
+	}
+	if( result == 1 )
+	{
+		if( thread_number_of_blocks > number_of_compressed_blocks )
+		{
+			thread_number_of_blocks = number_of_compressed_blocks;
+		}
+		if( libfsapfs_compressed_data_handle_decompress_blocks(
+		     data_handle->read_ahead_data,
+		     (uint32_t) data_stream_offset,
+		     &( data_handle->compressed_block_offsets[ compressed_block_index ] ),
+		     thread_number_of_blocks,
+		     data_handle->compression_method,
+		     uncompressed_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decompress data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The jobs that were pushed are always waited for, since they reference the thread values
+	 */
+	if( libfsapfs_worker_pool_wait_for_jobs(
+	     data_handle->worker_pool,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for jobs.",
+			 function );
+		}
+		result = -1;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_jobs;
+	     thread_index++ )
+	{
+		if( ( result == 1 )
+		 && ( jobs[ thread_index ].result != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decompress data in job: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 /* Reads data from the current offset into a compressed
  * Callback for the data stream
  * Returns the number of bytes read or -1 on error
@@ -815,14 +1509,19 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
          uint8_t read_flags LIBFSAPFS_ATTRIBUTE_UNUSED,
          libcerror_error_t **error )
 {
+	uint8_t *compressed_block_data    = NULL;
 	static char *function             = "libfsapfs_compressed_data_handle_read_segment_data";
+	size_t compressed_block_size      = 0;
 	size_t data_offset                = 0;
 	size_t read_size                  = 0;
 	size_t segment_data_offset        = 0;
-	ssize_t read_count                = 0;
-	off64_t data_stream_offset        = 0;
 	off64_t uncompressed_block_offset = 0;
 	uint32_t compressed_block_index   = 0;
+	int result                        = 0;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	uint32_t number_of_blocks         = 0;
+#endif
 
 	LIBFSAPFS_UNREFERENCED_PARAMETER( file_io_handle )
 	LIBFSAPFS_UNREFERENCED_PARAMETER( segment_file_index )
@@ -939,30 +1638,145 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 
 			return( -1 );
 		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( data_handle->number_of_threads > 1 )
+		 && ( data_handle->worker_pool != NULL )
+		 && ( data_offset == 0 ) )
+		{
+			/* Only whole compressed blocks that are contained in the segment data
+			 * are decompressed in parallel, other blocks are read one at a time
+			 */
+			number_of_blocks = (uint32_t) ( segment_data_size / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE );
+
+			if( number_of_blocks > ( data_handle->number_of_compressed_blocks - compressed_block_index ) )
+			{
+				number_of_blocks = data_handle->number_of_compressed_blocks - compressed_block_index;
+			}
+			if( number_of_blocks > (uint32_t) ( ( data_handle->uncompressed_data_size / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) - compressed_block_index ) )
+			{
+				number_of_blocks = (uint32_t) ( ( data_handle->uncompressed_data_size / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) - compressed_block_index );
+			}
+			if( number_of_blocks > LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_PARALLEL_BLOCKS )
+			{
+				number_of_blocks = LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_PARALLEL_BLOCKS;
+			}
+			if( number_of_blocks >= LIBFSAPFS_COMPRESSED_DATA_HANDLE_MINIMUM_PARALLEL_BLOCKS )
+			{
+				/* If the worker threads are in use by another caller the compressed blocks are read one at a time
+				 */
+				result = libfsapfs_worker_pool_grab(
+				          data_handle->worker_pool,
+				          data_handle->number_of_threads - 1,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab worker pool.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					result = libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+					          data_handle,
+					          (libbfio_handle_t *) file_io_handle,
+					          compressed_block_index,
+					          number_of_blocks,
+					          &( segment_data[ segment_data_offset ] ),
+					          error );
+
+					if( result != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read compressed blocks: %" PRIu32 " - %" PRIu32 ".",
+						 function,
+						 compressed_block_index,
+						 compressed_block_index + number_of_blocks - 1 );
+
+						result = -1;
+					}
+					if( libfsapfs_worker_pool_release(
+					     data_handle->worker_pool,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to release worker pool.",
+						 function );
+
+						result = -1;
+					}
+					if( result != 1 )
+					{
+						return( -1 );
+					}
+					read_size = (size_t) number_of_blocks * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+					segment_data_size      -= read_size;
+					segment_data_offset    += read_size;
+					compressed_block_index += number_of_blocks;
+
+					continue;
+				}
+			}
+		}
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+		if( ( data_handle->current_compressed_block_index != compressed_block_index )
+		 && ( data_handle->compressed_block_cache != NULL ) )
+		{
+			result = libfsapfs_compressed_block_cache_get_block_data(
+			          data_handle->compressed_block_cache,
+			          data_handle->identifier,
+			          compressed_block_index,
+			          data_handle->segment_data,
+			          LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE,
+			          &( data_handle->segment_data_size ),
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve compressed block: %" PRIu32 " from cache.",
+				 function,
+				 compressed_block_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				data_handle->current_compressed_block_index = compressed_block_index;
+			}
+		}
 		if( data_handle->current_compressed_block_index != compressed_block_index )
 		{
-			data_stream_offset = data_handle->compressed_block_offsets[ compressed_block_index ];
-			read_size          = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + 1 ] - data_stream_offset );
-
-			read_count = libfdata_stream_read_buffer_at_offset(
-			              data_handle->compressed_data_stream,
-			              (intptr_t *) file_io_handle,
-			              (uint8_t *) data_handle->compressed_segment_data,
-			              read_size,
-			              data_stream_offset,
-			              0,
-			              error );
-
-			if( read_count != (ssize_t) read_size )
+			if( libfsapfs_compressed_data_handle_read_compressed_block(
+			     data_handle,
+			     (libbfio_handle_t *) file_io_handle,
+			     compressed_block_index,
+			     &compressed_block_data,
+			     &compressed_block_size,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read buffer at offset: %" PRIi64 " (0x08%" PRIx64 ") from data stream.",
+				 "%s: unable to read compressed block: %" PRIu32 ".",
 				 function,
-				 data_stream_offset,
-				 data_stream_offset );
+				 compressed_block_index );
 
 				return( -1 );
 			}
@@ -973,16 +1787,16 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 				 "%s: compressed block data:\n",
 				 function );
 				libcnotify_print_data(
-				 data_handle->compressed_segment_data,
-				 read_size,
+				 compressed_block_data,
+				 compressed_block_size,
 				 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 			}
 #endif
 			data_handle->segment_data_size = LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
 
 			if( libfsapfs_decompress_data(
-			     data_handle->compressed_segment_data,
-			     (size_t) read_count,
+			     compressed_block_data,
+			     compressed_block_size,
 			     data_handle->compression_method,
 			     data_handle->segment_data,
 			     &( data_handle->segment_data_size ),
@@ -1023,6 +1837,28 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 
 				return( -1 );
 			}
+			if( ( data_handle->compressed_block_cache != NULL )
+			 && ( data_handle->segment_data_size > 0 ) )
+			{
+				if( libfsapfs_compressed_block_cache_set_block_data(
+				     data_handle->compressed_block_cache,
+				     data_handle->identifier,
+				     compressed_block_index,
+				     data_handle->segment_data,
+				     data_handle->segment_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set compressed block: %" PRIu32 " in cache.",
+					 function,
+					 compressed_block_index );
+
+					return( -1 );
+				}
+			}
 			data_handle->current_compressed_block_index = compressed_block_index;
 		}
 		if( data_offset >= data_handle->segment_data_size )
@@ -25,9 +25,12 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_compressed_block_cache.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_worker_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -76,6 +79,78 @@ struct libfsapfs_compressed_data_handle
 	/* The compressed block offsets
 	 */
 	uint32_t *compressed_block_offsets;
+
+	/* The read-ahead data
+	 */
+	uint8_t *read_ahead_data;
+
+	/* The read-ahead data allocated size
+	 */
+	size_t read_ahead_data_allocated_size;
+
+	/* The read-ahead data size
+	 */
+	size_t read_ahead_data_size;
+
+	/* The offset of the read-ahead data in the compressed data stream
+	 */
+	off64_t read_ahead_data_offset;
+
+	/* The number of compressed blocks to read ahead
+	 */
+	uint32_t read_ahead_number_of_blocks;
+
+	/* The (volume) compressed block cache
+	 */
+	libfsapfs_compressed_block_cache_t *compressed_block_cache;
+
+	/* The file identifier used in the compressed block cache
+	 */
+	uint64_t identifier;
+
+	/* The number of threads used to decompress data
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The worker pool
+	 * The worker pool is not managed by the data handle
+	 */
+	libfsapfs_worker_pool_t *worker_pool;
+#endif
+};
+
+typedef struct libfsapfs_compressed_data_handle_thread_values libfsapfs_compressed_data_handle_thread_values_t;
+
+struct libfsapfs_compressed_data_handle_thread_values
+{
+	/* The compressed data
+	 */
+	const uint8_t *compressed_data;
+
+	/* The offset of the compressed data in the compressed data stream
+	 */
+	uint32_t compressed_data_offset;
+
+	/* The offsets of the compressed blocks in the compressed data stream
+	 */
+	const uint32_t *compressed_block_offsets;
+
+	/* The number of compressed blocks
+	 */
+	uint32_t number_of_compressed_blocks;
+
+	/* The compression method
+	 */
+	int compression_method;
+
+	/* The uncompressed data
+	 */
+	uint8_t *uncompressed_data;
+
+	/* The result
+	 */
+	int result;
 };
 
 int libfsapfs_compressed_data_handle_initialize(
@@ -89,11 +164,55 @@ int libfsapfs_compressed_data_handle_free(
      libfsapfs_compressed_data_handle_t **data_handle,
      libcerror_error_t **error );
 
+int libfsapfs_compressed_data_handle_set_compressed_block_cache(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_data_handle_set_number_of_threads(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 int libfsapfs_compressed_data_handle_get_compressed_block_offsets(
      libfsapfs_compressed_data_handle_t *data_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libfsapfs_compressed_data_handle_read_compressed_block(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint8_t **compressed_block_data,
+     size_t *compressed_block_size,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_data_handle_decompress_blocks(
+     const uint8_t *compressed_data,
+     uint32_t compressed_data_offset,
+     const uint32_t *compressed_block_offsets,
+     uint32_t number_of_compressed_blocks,
+     int compression_method,
+     uint8_t *uncompressed_data,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+int libfsapfs_compressed_data_handle_decompress_thread_callback(
+     libfsapfs_compressed_data_handle_thread_values_t *thread_values );
+
+int libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint32_t number_of_compressed_blocks,
+     uint8_t *uncompressed_data,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 ssize_t libfsapfs_compressed_data_handle_read_segment_data(
          libfsapfs_compressed_data_handle_t *data_handle,
          intptr_t *file_io_handle,
@@ -25,6 +25,7 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfsapfs_btree_node_cache.h"
 #include "libfsapfs_checkpoint_map.h"
 #include "libfsapfs_container.h"
 #include "libfsapfs_container_data_handle.h"
@@ -34,17 +35,21 @@
 #include "libfsapfs_container_superblock.h"
 #include "libfsapfs_debug.h"
 #include "libfsapfs_definitions.h"
+#include "libfsapfs_file_io_handle_pool.h"
 #include "libfsapfs_fusion_middle_tree.h"
 #include "libfsapfs_io_handle.h"
+#include "libfsapfs_io_uring.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
 #include "libfsapfs_libcthreads.h"
+#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_object.h"
 #include "libfsapfs_object_map.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_descriptor_cache.h"
 #include "libfsapfs_volume.h"
 
 /* Creates a container
@@ -275,10 +280,12 @@ int libfsapfs_container_open(
      int access_flags,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle                   = NULL;
-	libfsapfs_internal_container_t *internal_container = NULL;
-	static char *function                              = "libfsapfs_container_open";
-	size_t filename_length                             = 0;
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	libfsapfs_internal_container_t *internal_container   = NULL;
+	libfsapfs_io_uring_t *io_uring                       = NULL;
+	static char *function                                = "libfsapfs_container_open";
+	size_t filename_length                               = 0;
 
 	if( container == NULL )
 	{
@@ -390,6 +397,56 @@ int libfsapfs_container_open(
 
 		goto on_error;
 	}
+	/* Clones of a file IO handle that wraps another object, such as a file object,
+	 * share the offset of that object, hence the file IO handle pool is only used
+	 * when the container is opened by filename
+	 */
+	if( internal_container->io_handle->number_of_file_io_handles > 1 )
+	{
+		if( libfsapfs_file_io_handle_pool_initialize(
+		     &file_io_handle_pool,
+		     file_io_handle,
+		     internal_container->io_handle->number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle pool.",
+			 function );
+
+			libfsapfs_container_close(
+			 container,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	/* io_uring requires a file descriptor of its own, hence it is only used when the container is opened by filename
+	 */
+	if( internal_container->io_handle->io_uring_queue_depth > 0 )
+	{
+		if( libfsapfs_io_uring_initialize(
+		     &io_uring,
+		     filename,
+		     internal_container->io_handle->io_uring_queue_depth,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create io_uring.",
+			 function );
+
+			libfsapfs_container_close(
+			 container,
+			 NULL );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_container->read_write_lock,
@@ -406,6 +463,8 @@ int libfsapfs_container_open(
 	}
 #endif
 	internal_container->file_io_handle_created_in_library = 1;
+	internal_container->io_handle->file_io_handle_pool    = file_io_handle_pool;
+	internal_container->io_handle->io_uring               = io_uring;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -420,6 +479,8 @@ int libfsapfs_container_open(
 		 function );
 
 		internal_container->file_io_handle_created_in_library = 0;
+		internal_container->io_handle->file_io_handle_pool    = NULL;
+		internal_container->io_handle->io_uring               = NULL;
 
 		goto on_error;
 	}
@@ -427,6 +488,18 @@ int libfsapfs_container_open(
 	return( 1 );
 
 on_error:
+	if( io_uring != NULL )
+	{
+		libfsapfs_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libfsapfs_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -447,10 +520,11 @@ int libfsapfs_container_open_wide(
      int access_flags,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle                   = NULL;
-	libfsapfs_internal_container_t *internal_container = NULL;
-	static char *function                              = "libfsapfs_container_open_wide";
-	size_t filename_length                             = 0;
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	libfsapfs_internal_container_t *internal_container   = NULL;
+	static char *function                                = "libfsapfs_container_open_wide";
+	size_t filename_length                               = 0;
 
 	if( container == NULL )
 	{
@@ -562,6 +636,32 @@ int libfsapfs_container_open_wide(
 
 		goto on_error;
 	}
+	/* Clones of a file IO handle that wraps another object, such as a file object,
+	 * share the offset of that object, hence the file IO handle pool is only used
+	 * when the container is opened by filename
+	 */
+	if( internal_container->io_handle->number_of_file_io_handles > 1 )
+	{
+		if( libfsapfs_file_io_handle_pool_initialize(
+		     &file_io_handle_pool,
+		     file_io_handle,
+		     internal_container->io_handle->number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle pool.",
+			 function );
+
+			libfsapfs_container_close(
+			 container,
+			 NULL );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_container->read_write_lock,
@@ -578,6 +678,7 @@ int libfsapfs_container_open_wide(
 	}
 #endif
 	internal_container->file_io_handle_created_in_library = 1;
+	internal_container->io_handle->file_io_handle_pool    = file_io_handle_pool;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -592,6 +693,7 @@ int libfsapfs_container_open_wide(
 		 function );
 
 		internal_container->file_io_handle_created_in_library = 0;
+		internal_container->io_handle->file_io_handle_pool    = NULL;
 
 		goto on_error;
 	}
@@ -599,6 +701,12 @@ int libfsapfs_container_open_wide(
 	return( 1 );
 
 on_error:
+	if( file_io_handle_pool != NULL )
+	{
+		libfsapfs_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -854,6 +962,38 @@ int libfsapfs_container_close(
 		}
 	}
 #endif
+	if( internal_container->io_handle->io_uring != NULL )
+	{
+		if( libfsapfs_io_uring_free(
+		     &( internal_container->io_handle->io_uring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free io_uring.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_container->io_handle->file_io_handle_pool != NULL )
+	{
+		if( libfsapfs_file_io_handle_pool_free(
+		     &( internal_container->io_handle->file_io_handle_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_container->file_io_handle_opened_in_library != 0 )
 	{
 		if( libbfio_handle_close(
@@ -1023,24 +1163,18 @@ int libfsapfs_internal_container_open_read(
      off64_t file_offset,
      libcerror_error_t **error )
 {
-	libfsapfs_container_data_handle_t *container_data_handle    = NULL;
-	libfsapfs_container_superblock_t *container_superblock      = NULL;
-	libfsapfs_container_superblock_t *container_superblock_swap = NULL;
-	libfsapfs_object_t *object                                  = NULL;
-	libfsapfs_object_map_t *object_map                          = NULL;
-	static char *function                                       = "libfsapfs_internal_container_open_read";
-	uint64_t checkpoint_map_block_number                        = 0;
-	uint64_t checkpoint_map_transaction_identifier              = 0;
-	uint64_t metadata_block_index                               = 0;
-	int element_index                                           = 0;
-	int result                                                  = 0;
+	libfsapfs_container_data_handle_t *container_data_handle = NULL;
+	libfsapfs_object_map_t *object_map                       = NULL;
+	static char *function                                    = "libfsapfs_internal_container_open_read";
+	uint64_t checkpoint_map_block_number                     = 0;
+	int element_index                                        = 0;
+	int result                                               = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
-	libfsapfs_checkpoint_map_t *checkpoint_map                  = NULL;
-	libfsapfs_container_reaper_t *container_reaper              = NULL;
-	libfsapfs_space_manager_t *space_manager                    = NULL;
-	uint64_t reaper_block_number                                = 0;
-	uint64_t space_manager_block_number                         = 0;
+	libfsapfs_container_reaper_t *container_reaper           = NULL;
+	libfsapfs_space_manager_t *space_manager                 = NULL;
+	uint64_t reaper_block_number                             = 0;
+	uint64_t space_manager_block_number                      = 0;
 #endif
 
 	if( internal_container == NULL )
@@ -1184,183 +1318,17 @@ int libfsapfs_internal_container_open_read(
 		goto on_error;
 	}
 #endif
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Scanning checkpoint descriptor area:\n" );
-	}
-#endif
-	if( libfsapfs_object_initialize(
-	     &object,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create object.",
-		 function );
-
-		goto on_error;
-	}
-	file_offset = (off64_t) internal_container->superblock->checkpoint_descriptor_area_block_number * internal_container->io_handle->block_size;
-
-	for( metadata_block_index = 0;
-	     metadata_block_index <= internal_container->superblock->checkpoint_descriptor_area_number_of_blocks;
-	     metadata_block_index++ )
-	{
-		if( libfsapfs_object_read_file_io_handle(
-		     object,
-		     file_io_handle,
-		     file_offset,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read object at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 file_offset,
-			 file_offset );
-
-			goto on_error;
-		}
-		switch( object->type )
-		{
-			case 0x4000000c:
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "Reading checkpoint map:\n" );
-
-					if( libfsapfs_checkpoint_map_initialize(
-					     &checkpoint_map,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-						 "%s: unable to create backup checkpoint map.",
-						 function );
-
-						goto on_error;
-					}
-					if( libfsapfs_checkpoint_map_read_file_io_handle(
-					     checkpoint_map,
-					     file_io_handle,
-					     file_offset,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read backup checkpoint map at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-						 function,
-						 file_offset,
-						 file_offset );
-
-						goto on_error;
-					}
-					if( libfsapfs_checkpoint_map_free(
-					     &checkpoint_map,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-						 "%s: unable to free backup checkpoint map.",
-						 function );
-
-						goto on_error;
-					}
-				}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
-				if( object->transaction_identifier > checkpoint_map_transaction_identifier )
-				{
-					checkpoint_map_block_number           = internal_container->superblock->checkpoint_descriptor_area_block_number + metadata_block_index;
-					checkpoint_map_transaction_identifier = object->transaction_identifier;
-				}
-				break;
-
-			case 0x80000001:
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "Reading container superblock:\n" );
-				}
-#endif
-				if( libfsapfs_container_superblock_initialize(
-				     &container_superblock,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create backup container superblock.",
-					 function );
-
-					goto on_error;
-				}
-				if( libfsapfs_container_superblock_read_file_io_handle(
-				     container_superblock,
-				     file_io_handle,
-				     file_offset,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read backup container superblock at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 file_offset,
-					 file_offset );
-
-					goto on_error;
-				}
-				if( container_superblock->object_transaction_identifier > internal_container->superblock->object_transaction_identifier )
-				{
-					container_superblock_swap      = internal_container->superblock;
-					internal_container->superblock = container_superblock;
-					container_superblock           = container_superblock_swap;
-				}
-				if( libfsapfs_container_superblock_free(
-				     &container_superblock,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free backup container superblock.",
-					 function );
-
-					goto on_error;
-				}
-				break;
-
-			default:
-				break;
-		}
-		file_offset += internal_container->io_handle->block_size;
-	}
-	if( libfsapfs_object_free(
-	     &object,
+	if( libfsapfs_internal_container_read_checkpoint_descriptor_area(
+	     internal_container,
+	     file_io_handle,
+	     &checkpoint_map_block_number,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free object.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read checkpoint descriptor area.",
 		 function );
 
 		goto on_error;
@@ -1844,32 +1812,12 @@ on_error:
 		 &( internal_container->checkpoint_map ),
 		 NULL );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( checkpoint_map != NULL )
-	{
-		libfsapfs_checkpoint_map_free(
-		 &checkpoint_map,
-		 NULL );
-	}
-#endif
-	if( container_superblock != NULL )
-	{
-		libfsapfs_container_superblock_free(
-		 &container_superblock,
-		 NULL );
-	}
 	if( internal_container->fusion_middle_tree != NULL )
 	{
 		libfsapfs_fusion_middle_tree_free(
 		 &( internal_container->fusion_middle_tree ),
 		 NULL );
 	}
-	if( object != NULL )
-	{
-		libfsapfs_object_free(
-		 &object,
-		 NULL );
-	}
 	if( internal_container->superblock != NULL )
 	{
 		libfsapfs_container_superblock_free(
@@ -1879,18 +1827,37 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the size
+/* Scans the checkpoint descriptor area for the most recent checkpoint map and container superblock
+ * The container superblock is replaced if a more recent backup container superblock is found
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_container_get_size(
-     libfsapfs_container_t *container,
-     size64_t *size,
+int libfsapfs_internal_container_read_checkpoint_descriptor_area(
+     libfsapfs_internal_container_t *internal_container,
+     libbfio_handle_t *file_io_handle,
+     uint64_t *checkpoint_map_block_number,
      libcerror_error_t **error )
 {
-	libfsapfs_internal_container_t *internal_container = NULL;
-	static char *function                              = "libfsapfs_container_get_size";
+	libfsapfs_container_superblock_t *container_superblock      = NULL;
+	libfsapfs_container_superblock_t *container_superblock_swap = NULL;
+	libfsapfs_object_t *object                                  = NULL;
+	uint8_t *checkpoint_descriptor_area_data                    = NULL;
+	static char *function                                       = "libfsapfs_internal_container_read_checkpoint_descriptor_area";
+	size_t checkpoint_descriptor_area_data_offset               = 0;
+	size_t checkpoint_descriptor_area_data_size                 = 0;
+	size_t read_size                                            = 0;
+	ssize_t read_count                                          = 0;
+	off64_t file_offset                                         = 0;
+	uint64_t checkpoint_descriptor_area_block_number            = 0;
+	uint64_t checkpoint_map_transaction_identifier              = 0;
+	uint64_t maximum_number_of_metadata_blocks                  = 0;
+	uint64_t metadata_block_index                               = 0;
+	uint64_t number_of_metadata_blocks                          = 0;
 
-	if( container == NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+	libfsapfs_checkpoint_map_t *checkpoint_map                  = NULL;
+#endif
+
+	if( internal_container == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1901,8 +1868,6 @@ int libfsapfs_container_get_size(
 
 		return( -1 );
 	}
-	internal_container = (libfsapfs_internal_container_t *) container;
-
 	if( internal_container->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1914,6 +1879,17 @@ int libfsapfs_container_get_size(
 
 		return( -1 );
 	}
+	if( internal_container->io_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid container - invalid IO handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_container->superblock == NULL )
 	{
 		libcerror_error_set(
@@ -1925,50 +1901,405 @@ int libfsapfs_container_get_size(
 
 		return( -1 );
 	}
-	if( size == NULL )
+	if( checkpoint_map_block_number == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 "%s: invalid checkpoint map block number.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_container->read_write_lock,
+	*checkpoint_map_block_number = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Scanning checkpoint descriptor area:\n" );
+	}
+#endif
+	if( libfsapfs_object_initialize(
+	     &object,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create object.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*size = internal_container->io_handle->container_size;
+	/* The bounds of the checkpoint descriptor area are determined once from the superblock
+	 * the area was located with. A newer backup superblock found in the area replaces
+	 * the container superblock during the scan, but every superblock of a container
+	 * describes the same checkpoint descriptor area, since its location and size are
+	 * fixed when the container is created. Hence this scans the same blocks as
+	 * re-reading the bounds from the current superblock for every block.
+	 */
+	checkpoint_descriptor_area_block_number = internal_container->superblock->checkpoint_descriptor_area_block_number;
+	number_of_metadata_blocks               = (uint64_t) internal_container->superblock->checkpoint_descriptor_area_number_of_blocks + 1;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_container->read_write_lock,
-	     error ) != 1 )
+	/* The checkpoint descriptor area is read in bulk and the objects are parsed in place,
+	 * instead of reading each block of the area separately
+	 */
+
+	maximum_number_of_metadata_blocks = number_of_metadata_blocks;
+
+	if( maximum_number_of_metadata_blocks > LIBFSAPFS_MAXIMUM_CHECKPOINT_DESCRIPTOR_AREA_READ_NUMBER_OF_BLOCKS )
+	{
+		maximum_number_of_metadata_blocks = LIBFSAPFS_MAXIMUM_CHECKPOINT_DESCRIPTOR_AREA_READ_NUMBER_OF_BLOCKS;
+	}
+	checkpoint_descriptor_area_data_size = (size_t) maximum_number_of_metadata_blocks * internal_container->io_handle->block_size;
+
+	checkpoint_descriptor_area_data = (uint8_t *) memory_allocate(
+	                                               sizeof( uint8_t ) * checkpoint_descriptor_area_data_size );
+
+	if( checkpoint_descriptor_area_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create checkpoint descriptor area data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
+	file_offset = (off64_t) checkpoint_descriptor_area_block_number * internal_container->io_handle->block_size;
+
+	metadata_block_index = 0;
+
+	while( metadata_block_index < number_of_metadata_blocks )
+	{
+		read_size = checkpoint_descriptor_area_data_size;
+
+		if( (uint64_t) read_size > ( ( number_of_metadata_blocks - metadata_block_index ) * internal_container->io_handle->block_size ) )
+		{
+			read_size = (size_t) ( ( number_of_metadata_blocks - metadata_block_index ) * internal_container->io_handle->block_size );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading checkpoint descriptor area data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 file_offset,
+			 file_offset );
+		}
+#endif
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              checkpoint_descriptor_area_data,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read checkpoint descriptor area data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			goto on_error;
+		}
+		for( checkpoint_descriptor_area_data_offset = 0;
+		     checkpoint_descriptor_area_data_offset < read_size;
+		     checkpoint_descriptor_area_data_offset += internal_container->io_handle->block_size )
+		{
+			if( libfsapfs_object_read_data(
+			     object,
+			     &( checkpoint_descriptor_area_data[ checkpoint_descriptor_area_data_offset ] ),
+			     (size_t) internal_container->io_handle->block_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read object at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_offset,
+				 file_offset );
+
+				goto on_error;
+			}
+			switch( object->type )
+			{
+				case 0x4000000c:
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "Reading checkpoint map:\n" );
+
+						if( libfsapfs_checkpoint_map_initialize(
+						     &checkpoint_map,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+							 "%s: unable to create backup checkpoint map.",
+							 function );
+
+							goto on_error;
+						}
+						if( libfsapfs_checkpoint_map_read_data(
+						     checkpoint_map,
+						     &( checkpoint_descriptor_area_data[ checkpoint_descriptor_area_data_offset ] ),
+						     (size_t) internal_container->io_handle->block_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_IO,
+							 LIBCERROR_IO_ERROR_READ_FAILED,
+							 "%s: unable to read backup checkpoint map at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+							 function,
+							 file_offset,
+							 file_offset );
+
+							goto on_error;
+						}
+						if( libfsapfs_checkpoint_map_free(
+						     &checkpoint_map,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free backup checkpoint map.",
+							 function );
+
+							goto on_error;
+						}
+					}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+					if( object->transaction_identifier > checkpoint_map_transaction_identifier )
+					{
+						*checkpoint_map_block_number          = checkpoint_descriptor_area_block_number + metadata_block_index;
+						checkpoint_map_transaction_identifier = object->transaction_identifier;
+					}
+					break;
+
+				case 0x80000001:
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "Reading container superblock:\n" );
+					}
+#endif
+					if( libfsapfs_container_superblock_initialize(
+					     &container_superblock,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create backup container superblock.",
+						 function );
+
+						goto on_error;
+					}
+					if( libfsapfs_container_superblock_read_data(
+					     container_superblock,
+					     &( checkpoint_descriptor_area_data[ checkpoint_descriptor_area_data_offset ] ),
+					     (size_t) internal_container->io_handle->block_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read backup container superblock at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 file_offset,
+						 file_offset );
+
+						goto on_error;
+					}
+					if( container_superblock->object_transaction_identifier > internal_container->superblock->object_transaction_identifier )
+					{
+						container_superblock_swap      = internal_container->superblock;
+						internal_container->superblock = container_superblock;
+						container_superblock           = container_superblock_swap;
+					}
+					if( libfsapfs_container_superblock_free(
+					     &container_superblock,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free backup container superblock.",
+						 function );
+
+						goto on_error;
+					}
+					break;
+
+				default:
+					break;
+			}
+			file_offset += internal_container->io_handle->block_size;
+
+			metadata_block_index++;
+		}
+	}
+	memory_free(
+	 checkpoint_descriptor_area_data );
+
+	checkpoint_descriptor_area_data = NULL;
+
+	if( libfsapfs_object_free(
+	     &object,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free object.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( checkpoint_map != NULL )
+	{
+		libfsapfs_checkpoint_map_free(
+		 &checkpoint_map,
+		 NULL );
+	}
+#endif
+	if( container_superblock != NULL )
+	{
+		libfsapfs_container_superblock_free(
+		 &container_superblock,
+		 NULL );
+	}
+	if( object != NULL )
+	{
+		libfsapfs_object_free(
+		 &object,
+		 NULL );
+	}
+	if( checkpoint_descriptor_area_data != NULL )
+	{
+		memory_free(
+		 checkpoint_descriptor_area_data );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_size(
+     libfsapfs_container_t *container,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_size";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_container->superblock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing superblock.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_container->io_handle->container_size;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
 }
 
 /* Retrieves the identifier
@@ -2107,6 +2438,1177 @@ int libfsapfs_container_is_locked(
 	return( is_locked );
 }
 
+/* Retrieves the maximum size of a specific cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_maximum_cache_size(
+     libfsapfs_container_t *container,
+     int cache_type,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_maximum_cache_size";
+	int result                                         = 1;
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_io_handle_get_maximum_cache_size(
+	     internal_container->io_handle,
+	     cache_type,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum cache size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum size of a specific cache
+ * The setting is inherited by volumes that are retrieved afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_maximum_cache_size(
+     libfsapfs_container_t *container,
+     int cache_type,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_maximum_cache_size";
+	int result                                         = 1;
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_io_handle_set_maximum_cache_size(
+	     internal_container->io_handle,
+	     cache_type,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum cache size.",
+		 function );
+
+		result = -1;
+	}
+	/* The data block caches are resized on their next read
+	 */
+	if( cache_type == LIBFSAPFS_CACHE_TYPE_BTREE_NODES )
+	{
+		if( ( result == 1 )
+		 && ( internal_container->object_map_btree != NULL ) )
+		{
+			if( libfsapfs_btree_node_cache_resize(
+			     internal_container->object_map_btree->node_cache,
+			     internal_container->io_handle->maximum_number_of_cached_btree_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize object map B-tree node cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	else if( cache_type == LIBFSAPFS_CACHE_TYPE_OBJECT_MAP_DESCRIPTORS )
+	{
+		if( ( result == 1 )
+		 && ( internal_container->object_map_btree != NULL ) )
+		{
+			if( libfsapfs_object_map_descriptor_cache_resize(
+			     internal_container->object_map_btree->descriptor_cache,
+			     internal_container->io_handle->maximum_number_of_cached_object_map_descriptors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize object map descriptor cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of threads used to decrypt data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_number_of_decryption_threads(
+     libfsapfs_container_t *container,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_number_of_decryption_threads";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_threads = internal_container->io_handle->number_of_decryption_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of threads used to decrypt data
+ * The setting is inherited by volumes that are retrieved afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_number_of_decryption_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_number_of_decryption_threads";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_container->io_handle->number_of_decryption_threads = number_of_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of threads used to decompress data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_number_of_decompression_threads(
+     libfsapfs_container_t *container,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_number_of_decompression_threads";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_threads = internal_container->io_handle->number_of_decompression_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of threads used to decompress data
+ * The setting is inherited by volumes that are retrieved afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_number_of_decompression_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_number_of_decompression_threads";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_container->io_handle->number_of_decompression_threads = number_of_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of file IO handles used to read data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_number_of_file_io_handles(
+     libfsapfs_container_t *container,
+     int *number_of_handles,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_number_of_file_io_handles";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of handles.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_handles = internal_container->io_handle->number_of_file_io_handles;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of file IO handles used to read data
+ * The file IO handles are only used when the container is opened by filename
+ * The setting takes effect when the container is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_number_of_file_io_handles(
+     libfsapfs_container_t *container,
+     int number_of_handles,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_number_of_file_io_handles";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_handles < 1 )
+	 || ( number_of_handles > LIBFSAPFS_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_container->io_handle->number_of_file_io_handles = number_of_handles;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the io_uring queue depth used to read data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_io_uring_queue_depth(
+     libfsapfs_container_t *container,
+     int *queue_depth,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_io_uring_queue_depth";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue_depth == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue depth.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*queue_depth = internal_container->io_handle->io_uring_queue_depth;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the io_uring queue depth used to read data
+ * A queue depth of 0 disables io_uring
+ * io_uring is only used for reads of unencrypted file data that span multiple extents
+ * The setting takes effect when the container is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_io_uring_queue_depth(
+     libfsapfs_container_t *container,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_io_uring_queue_depth";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth < 0 )
+	 || ( queue_depth > LIBFSAPFS_MAXIMUM_IO_URING_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_container->io_handle->io_uring_queue_depth = queue_depth;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the value to indicate the checksum of metadata objects is verified when they are read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_verify_object_checksums(
+     libfsapfs_container_t *container,
+     uint8_t *verify_object_checksums,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_verify_object_checksums";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_object_checksums == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify object checksums.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*verify_object_checksums = internal_container->io_handle->verify_object_checksums;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the value to indicate the checksum of metadata objects should be verified when they are read
+ * A B-tree node with a checksum mismatch is then not parsed but results in an error
+ * The setting is inherited by volumes that are retrieved afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_verify_object_checksums(
+     libfsapfs_container_t *container,
+     uint8_t verify_object_checksums,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_verify_object_checksums";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( verify_object_checksums != 0 )
+	{
+		internal_container->io_handle->verify_object_checksums = 1;
+	}
+	else
+	{
+		internal_container->io_handle->verify_object_checksums = 0;
+	}
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the value to indicate volumes are opened lazily
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_lazy_volume_open(
+     libfsapfs_container_t *container,
+     uint8_t *lazy_volume_open,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_lazy_volume_open";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( lazy_volume_open == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lazy volume open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*lazy_volume_open = internal_container->io_handle->lazy_volume_open;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the value to indicate volumes should be opened lazily
+ * The setting is inherited by volumes that are retrieved afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_lazy_volume_open(
+     libfsapfs_container_t *container,
+     uint8_t lazy_volume_open,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_lazy_volume_open";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( lazy_volume_open != 0 )
+	{
+		internal_container->io_handle->lazy_volume_open = 1;
+	}
+	else
+	{
+		internal_container->io_handle->lazy_volume_open = 0;
+	}
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
 /* Retrieves the number of volumes
  * Returns 1 if successful or -1 on error
  */
@@ -2280,6 +3782,7 @@ int libfsapfs_container_get_volume_by_index(
 	     internal_container->object_map_btree,
 	     internal_container->file_io_handle,
 	     internal_container->superblock->volume_object_identifiers[ volume_index ],
+	     LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	     &object_map_descriptor,
 	     error ) != 1 )
 	{
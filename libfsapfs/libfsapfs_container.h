@@ -149,6 +149,12 @@ int libfsapfs_internal_container_open_read(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libfsapfs_internal_container_read_checkpoint_descriptor_area(
+     libfsapfs_internal_container_t *internal_container,
+     libbfio_handle_t *file_io_handle,
+     uint64_t *checkpoint_map_block_number,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_container_get_size(
      libfsapfs_container_t *container,
@@ -167,6 +173,92 @@ int libfsapfs_container_is_locked(
      libfsapfs_container_t *container,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_maximum_cache_size(
+     libfsapfs_container_t *container,
+     int cache_type,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_maximum_cache_size(
+     libfsapfs_container_t *container,
+     int cache_type,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_number_of_decryption_threads(
+     libfsapfs_container_t *container,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_number_of_decryption_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_number_of_decompression_threads(
+     libfsapfs_container_t *container,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_number_of_decompression_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_number_of_file_io_handles(
+     libfsapfs_container_t *container,
+     int *number_of_handles,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_number_of_file_io_handles(
+     libfsapfs_container_t *container,
+     int number_of_handles,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_io_uring_queue_depth(
+     libfsapfs_container_t *container,
+     int *queue_depth,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_io_uring_queue_depth(
+     libfsapfs_container_t *container,
+     int queue_depth,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_verify_object_checksums(
+     libfsapfs_container_t *container,
+     uint8_t *verify_object_checksums,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_verify_object_checksums(
+     libfsapfs_container_t *container,
+     uint8_t verify_object_checksums,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_lazy_volume_open(
+     libfsapfs_container_t *container,
+     uint8_t *lazy_volume_open,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_lazy_volume_open(
+     libfsapfs_container_t *container,
+     uint8_t lazy_volume_open,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_container_get_number_of_volumes(
      libfsapfs_container_t *container,
@@ -147,8 +147,9 @@ int libfsapfs_data_block_free(
      libfsapfs_data_block_t **data_block,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_data_block_free";
-	int result            = 1;
+	libfsapfs_data_block_run_t *data_block_run = NULL;
+	static char *function                      = "libfsapfs_data_block_free";
+	int result                                 = 1;
 
 	if( data_block == NULL )
 	{
@@ -163,6 +164,29 @@ int libfsapfs_data_block_free(
 	}
 	if( *data_block != NULL )
 	{
+		if( ( *data_block )->data_block_run != NULL )
+		{
+			/* The data block and its data are stored in the data block run
+			 */
+			data_block_run = ( *data_block )->data_block_run;
+
+			*data_block = NULL;
+
+			if( libfsapfs_data_block_run_release(
+			     &data_block_run,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release data block run.",
+				 function );
+
+				result = -1;
+			}
+			return( result );
+		}
 		if( ( *data_block )->data != NULL )
 		{
 			if( memory_set(
@@ -437,3 +461,529 @@ on_error:
 	return( -1 );
 }
 
+/* Creates data block run
+ * A data block run contains the data of multiple consecutive data blocks in a single buffer
+ * Make sure the value data_block_run is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_run_initialize(
+     libfsapfs_data_block_run_t **data_block_run,
+     size_t data_block_size,
+     int number_of_data_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_data_block_run_initialize";
+	size_t data_offset    = 0;
+	int data_block_index  = 0;
+
+	if( data_block_run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block run.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_block_run != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data block run value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_block_size == 0 )
+	 || ( data_block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_data_blocks <= 0 )
+	 || ( (size_t) number_of_data_blocks > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / data_block_size ) )
+	 || ( (size_t) number_of_data_blocks > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsapfs_data_block_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of data blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_block_run = memory_allocate_structure(
+	                   libfsapfs_data_block_run_t );
+
+	if( *data_block_run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data block run.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_block_run,
+	     0,
+	     sizeof( libfsapfs_data_block_run_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data block run.",
+		 function );
+
+		memory_free(
+		 *data_block_run );
+
+		*data_block_run = NULL;
+
+		return( -1 );
+	}
+	( *data_block_run )->data_size = data_block_size * number_of_data_blocks;
+
+	( *data_block_run )->data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * ( *data_block_run )->data_size );
+
+	if( ( *data_block_run )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	( *data_block_run )->data_blocks = (libfsapfs_data_block_t *) memory_allocate(
+	                                                                sizeof( libfsapfs_data_block_t ) * number_of_data_blocks );
+
+	if( ( *data_block_run )->data_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data blocks.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_block_index = 0;
+	     data_block_index < number_of_data_blocks;
+	     data_block_index++ )
+	{
+		( *data_block_run )->data_blocks[ data_block_index ].data           = &( ( ( *data_block_run )->data )[ data_offset ] );
+		( *data_block_run )->data_blocks[ data_block_index ].data_size      = data_block_size;
+		( *data_block_run )->data_blocks[ data_block_index ].data_block_run = *data_block_run;
+
+		data_offset += data_block_size;
+	}
+	( *data_block_run )->number_of_data_blocks = number_of_data_blocks;
+	( *data_block_run )->number_of_references  = 1;
+
+	return( 1 );
+
+on_error:
+	if( *data_block_run != NULL )
+	{
+		if( ( *data_block_run )->data != NULL )
+		{
+			memory_free(
+			 ( *data_block_run )->data );
+		}
+		memory_free(
+		 *data_block_run );
+
+		*data_block_run = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees data block run
+ * The data block run is only freed when all the data blocks retrieved from it have been freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_run_free(
+     libfsapfs_data_block_run_t **data_block_run,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_data_block_run_free";
+
+	if( data_block_run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block run.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_block_run != NULL )
+	{
+		if( libfsapfs_data_block_run_release(
+		     data_block_run,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release data block run.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a reference to a data block run
+ * The data blocks of a run are stored in the same cache, access to which is
+ * serialized by its owner, hence the reference count needs no separate lock
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_run_release(
+     libfsapfs_data_block_run_t **data_block_run,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_data_block_run_release";
+	int result            = 1;
+
+	if( data_block_run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block run.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_block_run == NULL )
+	{
+		return( 1 );
+	}
+	if( ( *data_block_run )->number_of_references <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block run - number of references value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	( *data_block_run )->number_of_references -= 1;
+
+	if( ( *data_block_run )->number_of_references == 0 )
+	{
+		if( ( *data_block_run )->data_blocks != NULL )
+		{
+			memory_free(
+			 ( *data_block_run )->data_blocks );
+		}
+		if( ( *data_block_run )->data != NULL )
+		{
+			if( memory_set(
+			     ( *data_block_run )->data,
+			     0,
+			     ( *data_block_run )->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear data.",
+				 function );
+
+				result = -1;
+			}
+			memory_free(
+			 ( *data_block_run )->data );
+		}
+		memory_free(
+		 *data_block_run );
+	}
+	*data_block_run = NULL;
+
+	return( result );
+}
+
+/* Retrieves a specific data block of a data block run
+ * The data block references the data of the run and must be freed with libfsapfs_data_block_free
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_run_get_data_block(
+     libfsapfs_data_block_run_t *data_block_run,
+     int data_block_index,
+     libfsapfs_data_block_t **data_block,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_data_block_run_get_data_block";
+
+	if( data_block_run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block run.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block_run->data_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block run - missing data blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block_run->number_of_references == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block run - number of references value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_block_index < 0 )
+	 || ( data_block_index >= data_block_run->number_of_data_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block.",
+		 function );
+
+		return( -1 );
+	}
+	*data_block = &( data_block_run->data_blocks[ data_block_index ] );
+
+	data_block_run->number_of_references += 1;
+
+	return( 1 );
+}
+
+/* Reads data block run
+ * The data blocks are read with a single read and, if encrypted, decrypted with a single call
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_run_read(
+     libfsapfs_data_block_run_t *data_block_run,
+     libfsapfs_io_handle_t *io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint64_t encryption_identifier,
+     libcerror_error_t **error )
+{
+	uint8_t *read_buffer  = NULL;
+	static char *function = "libfsapfs_data_block_run_read";
+	ssize_t read_count    = 0;
+
+	if( data_block_run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block run.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block_run->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block run - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_block_run->data_size == 0 )
+	 || ( data_block_run->data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block run - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block_run->data_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block run - missing data blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_context == NULL )
+	{
+		read_buffer = data_block_run->data;
+	}
+	else
+	{
+		read_buffer = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * data_block_run->data_size );
+
+		if( read_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %d data blocks at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 data_block_run->number_of_data_blocks,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              read_buffer,
+	              data_block_run->data_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) data_block_run->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data blocks at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	if( encryption_context != NULL )
+	{
+		/* The encryption identifiers of the data blocks in a run are consecutive
+		 * hence the sector numbers are as well
+		 */
+		encryption_identifier *= data_block_run->data_blocks[ 0 ].data_size;
+		encryption_identifier /= io_handle->bytes_per_sector;
+
+		if( libfsapfs_encryption_context_crypt(
+		     encryption_context,
+		     LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     read_buffer,
+		     data_block_run->data_size,
+		     data_block_run->data,
+		     data_block_run->data_size,
+		     encryption_identifier,
+		     io_handle->bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt data blocks.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 read_buffer );
+
+		read_buffer = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( ( read_buffer != NULL )
+	 && ( read_buffer != data_block_run->data ) )
+	{
+		memory_free(
+		 read_buffer );
+	}
+	return( -1 );
+}
+
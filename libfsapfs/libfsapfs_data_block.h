@@ -35,6 +35,7 @@ extern "C" {
 #endif
 
 typedef struct libfsapfs_data_block libfsapfs_data_block_t;
+typedef struct libfsapfs_data_block_run libfsapfs_data_block_run_t;
 
 struct libfsapfs_data_block
 {
@@ -45,6 +46,33 @@ struct libfsapfs_data_block
 	/* The data size
 	 */
 	size_t data_size;
+
+	/* The data block run that contains the data
+	 */
+	libfsapfs_data_block_run_t *data_block_run;
+};
+
+struct libfsapfs_data_block_run
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The data blocks
+	 */
+	libfsapfs_data_block_t *data_blocks;
+
+	/* The number of data blocks
+	 */
+	int number_of_data_blocks;
+
+	/* The number of references
+	 */
+	int number_of_references;
 };
 
 int libfsapfs_data_block_initialize(
@@ -69,6 +97,35 @@ int libfsapfs_data_block_read(
      uint64_t encryption_identifier,
      libcerror_error_t **error );
 
+int libfsapfs_data_block_run_initialize(
+     libfsapfs_data_block_run_t **data_block_run,
+     size_t data_block_size,
+     int number_of_data_blocks,
+     libcerror_error_t **error );
+
+int libfsapfs_data_block_run_free(
+     libfsapfs_data_block_run_t **data_block_run,
+     libcerror_error_t **error );
+
+int libfsapfs_data_block_run_release(
+     libfsapfs_data_block_run_t **data_block_run,
+     libcerror_error_t **error );
+
+int libfsapfs_data_block_run_get_data_block(
+     libfsapfs_data_block_run_t *data_block_run,
+     int data_block_index,
+     libfsapfs_data_block_t **data_block,
+     libcerror_error_t **error );
+
+int libfsapfs_data_block_run_read(
+     libfsapfs_data_block_run_t *data_block_run,
+     libfsapfs_io_handle_t *io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint64_t encryption_identifier,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
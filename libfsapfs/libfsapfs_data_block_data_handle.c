@@ -28,7 +28,9 @@
 #include "libfsapfs_data_block_vector.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_extent.h"
 #include "libfsapfs_file_system_data_handle.h"
+#include "libfsapfs_io_uring.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
@@ -48,7 +50,8 @@ int libfsapfs_data_block_data_handle_initialize(
      uint8_t is_sparse,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_data_block_data_handle_initialize";
+	static char *function       = "libfsapfs_data_block_data_handle_initialize";
+	int number_of_cache_entries = 0;
 
 	if( data_handle == NULL )
 	{
@@ -163,9 +166,44 @@ int libfsapfs_data_block_data_handle_initialize(
 
 		goto on_error;
 	}
+	( *data_handle )->maximum_number_of_cache_entries = LIBFSAPFS_MAXIMUM_ADAPTIVE_CACHE_ENTRIES_DATA_BLOCKS;
+
+	if( ( *data_handle )->maximum_number_of_cache_entries > io_handle->maximum_number_of_cached_data_blocks )
+	{
+		( *data_handle )->maximum_number_of_cache_entries = io_handle->maximum_number_of_cached_data_blocks;
+	}
+	if( ( *data_handle )->maximum_number_of_cache_entries < 1 )
+	{
+		( *data_handle )->maximum_number_of_cache_entries = 1;
+	}
+	number_of_cache_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS;
+
+	if( number_of_cache_entries > ( *data_handle )->maximum_number_of_cache_entries )
+	{
+		number_of_cache_entries = ( *data_handle )->maximum_number_of_cache_entries;
+	}
+	/* The cache entries are reserved from the data block cache budget shared by all data streams,
+	 * a data stream always gets at least 1 cache entry
+	 */
+	if( libfsapfs_io_handle_reserve_cached_data_blocks(
+	     io_handle,
+	     number_of_cache_entries,
+	     1,
+	     &( ( *data_handle )->number_of_cache_entries ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to reserve data block cache entries.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfcache_cache_initialize(
 	     &( ( *data_handle )->data_block_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS,
+	     ( *data_handle )->number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -177,11 +215,20 @@ int libfsapfs_data_block_data_handle_initialize(
 
 		goto on_error;
 	}
+	( *data_handle )->is_sparse = is_sparse;
+
 	return( 1 );
 
 on_error:
 	if( *data_handle != NULL )
 	{
+		if( ( *data_handle )->number_of_cache_entries > 0 )
+		{
+			libfsapfs_io_handle_release_cached_data_blocks(
+			 io_handle,
+			 ( *data_handle )->number_of_cache_entries,
+			 NULL );
+		}
 		if( ( *data_handle )->data_block_vector != NULL )
 		{
 			libfdata_vector_free(
@@ -238,6 +285,24 @@ int libfsapfs_data_block_data_handle_free(
 
 			result = -1;
 		}
+		if( ( ( *data_handle )->file_system_data_handle != NULL )
+		 && ( ( *data_handle )->number_of_cache_entries > 0 ) )
+		{
+			if( libfsapfs_io_handle_release_cached_data_blocks(
+			     ( *data_handle )->file_system_data_handle->io_handle,
+			     ( *data_handle )->number_of_cache_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release data block cache entries.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libfdata_vector_free(
 		     &( ( *data_handle )->data_block_vector ),
 		     error ) != 1 )
@@ -272,6 +337,636 @@ int libfsapfs_data_block_data_handle_free(
 	return( result );
 }
 
+/* Adjusts the number of data block cache entries to the read pattern
+ * The cache grows on sequential reads, up to the maximum number of cache entries
+ * and as long as the data block cache budget shared by all data streams allows,
+ * and shrinks to its initial number of entries on non-sequential reads
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_data_handle_adjust_cache_size(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     libcerror_error_t **error )
+{
+	libfsapfs_io_handle_t *io_handle     = NULL;
+	static char *function                = "libfsapfs_data_block_data_handle_adjust_cache_size";
+	int number_of_cache_entries          = 0;
+	int number_of_reserved_cache_entries = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle = data_handle->file_system_data_handle->io_handle;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - invalid file system data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_cache_entries = data_handle->number_of_cache_entries;
+
+	if( data_handle->current_offset == data_handle->sequential_read_offset )
+	{
+		/* Grow the cache once the data of all its entries has been read sequentially
+		 */
+		if( ( number_of_cache_entries < data_handle->maximum_number_of_cache_entries )
+		 && ( data_handle->sequential_read_size >= ( (size64_t) number_of_cache_entries * io_handle->block_size ) ) )
+		{
+			if( number_of_cache_entries > ( data_handle->maximum_number_of_cache_entries / 2 ) )
+			{
+				number_of_cache_entries = data_handle->maximum_number_of_cache_entries;
+			}
+			else
+			{
+				number_of_cache_entries *= 2;
+			}
+			if( libfsapfs_io_handle_reserve_cached_data_blocks(
+			     io_handle,
+			     number_of_cache_entries - data_handle->number_of_cache_entries,
+			     0,
+			     &number_of_reserved_cache_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to reserve data block cache entries.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_cache_entries = data_handle->number_of_cache_entries + number_of_reserved_cache_entries;
+		}
+	}
+	else
+	{
+		data_handle->sequential_read_offset = data_handle->current_offset;
+		data_handle->sequential_read_size   = 0;
+
+		if( number_of_cache_entries > LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS )
+		{
+			number_of_cache_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS;
+		}
+	}
+	if( number_of_cache_entries != data_handle->number_of_cache_entries )
+	{
+		if( libfcache_cache_resize(
+		     data_handle->data_block_cache,
+		     number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize data block cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_cache_entries < data_handle->number_of_cache_entries )
+		{
+			if( libfsapfs_io_handle_release_cached_data_blocks(
+			     io_handle,
+			     data_handle->number_of_cache_entries - number_of_cache_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release data block cache entries.",
+				 function );
+
+				data_handle->number_of_cache_entries = number_of_cache_entries;
+
+				return( -1 );
+			}
+		}
+		data_handle->number_of_cache_entries = number_of_cache_entries;
+	}
+	return( 1 );
+
+on_error:
+	if( number_of_reserved_cache_entries > 0 )
+	{
+		libfsapfs_io_handle_release_cached_data_blocks(
+		 io_handle,
+		 number_of_reserved_cache_entries,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Adjusts the number of data blocks to read ahead to the read pattern
+ * On a non-sequential read only the data blocks of the read are read,
+ * on sequential reads the read-ahead window doubles on every read
+ * up to the number of data block cache entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_data_handle_adjust_read_ahead(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsapfs_data_block_data_handle_adjust_read_ahead";
+	size64_t number_of_blocks       = 0;
+	uint32_t block_size             = 0;
+	int read_ahead_number_of_blocks = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - invalid file system data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	block_size = data_handle->file_system_data_handle->io_handle->block_size;
+
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - invalid file system data handle - invalid IO handle - missing block size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = ( (size64_t) ( data_handle->current_offset % block_size ) + read_size + block_size - 1 ) / block_size;
+
+	if( number_of_blocks > (size64_t) data_handle->number_of_cache_entries )
+	{
+		number_of_blocks = (size64_t) data_handle->number_of_cache_entries;
+	}
+	read_ahead_number_of_blocks = data_handle->file_system_data_handle->read_ahead_number_of_blocks;
+
+	/* The sequential read size is reset on a non-sequential read
+	 */
+	if( data_handle->sequential_read_size == 0 )
+	{
+		read_ahead_number_of_blocks = (int) number_of_blocks;
+	}
+	else if( read_ahead_number_of_blocks > ( data_handle->number_of_cache_entries / 2 ) )
+	{
+		read_ahead_number_of_blocks = data_handle->number_of_cache_entries;
+	}
+	else
+	{
+		read_ahead_number_of_blocks *= 2;
+	}
+	if( read_ahead_number_of_blocks < (int) number_of_blocks )
+	{
+		read_ahead_number_of_blocks = (int) number_of_blocks;
+	}
+	if( read_ahead_number_of_blocks < 1 )
+	{
+		read_ahead_number_of_blocks = 1;
+	}
+	data_handle->file_system_data_handle->read_ahead_number_of_blocks = read_ahead_number_of_blocks;
+
+	return( 1 );
+}
+
+/* Retrieves the file extent that contains a specific logical offset
+ * Returns 1 if successful, 0 if no such file extent or -1 on error
+ */
+int libfsapfs_data_block_data_handle_get_file_extent_at_offset(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     off64_t offset,
+     int *file_extent_index,
+     libfsapfs_file_extent_t **file_extent,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_extent_t *safe_file_extent = NULL;
+	static char *function                     = "libfsapfs_data_block_data_handle_get_file_extent_at_offset";
+	int extent_index                          = 0;
+	int lower_extent_index                    = 0;
+	int number_of_extents                     = 0;
+	int upper_extent_index                    = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle->file_extents == NULL )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     data_handle->file_system_data_handle->file_extents,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file extents.",
+		 function );
+
+		return( -1 );
+	}
+	/* Sequential reads typically continue in the most recently used or the next file extent
+	 */
+	extent_index       = data_handle->current_file_extent_index;
+	upper_extent_index = number_of_extents;
+
+	while( lower_extent_index < upper_extent_index )
+	{
+		if( ( extent_index < lower_extent_index )
+		 || ( extent_index >= upper_extent_index ) )
+		{
+			extent_index = lower_extent_index + ( ( upper_extent_index - lower_extent_index ) / 2 );
+		}
+		if( libcdata_array_get_entry_by_index(
+		     data_handle->file_system_data_handle->file_extents,
+		     extent_index,
+		     (intptr_t **) &safe_file_extent,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( safe_file_extent == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing file extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( (uint64_t) offset < safe_file_extent->logical_offset )
+		{
+			upper_extent_index = extent_index;
+			extent_index       = -1;
+		}
+		else if( ( (uint64_t) offset - safe_file_extent->logical_offset ) >= safe_file_extent->data_size )
+		{
+			lower_extent_index = extent_index + 1;
+
+			/* Try the next file extent first
+			 */
+			extent_index = lower_extent_index;
+
+			if( ( extent_index > data_handle->current_file_extent_index + 1 )
+			 || ( extent_index >= upper_extent_index ) )
+			{
+				extent_index = -1;
+			}
+		}
+		else
+		{
+			data_handle->current_file_extent_index = extent_index;
+
+			*file_extent_index = extent_index;
+			*file_extent       = safe_file_extent;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Reads data from the current offset directly into a buffer
+ * This bypasses the data block cache and is only supported for unencrypted data
+ * The extents are read using io_uring when available
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsapfs_data_block_data_handle_read_direct(
+         libfsapfs_data_block_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfsapfs_io_uring_read_t reads[ LIBFSAPFS_MAXIMUM_NUMBER_OF_BATCHED_READS ];
+
+	libfsapfs_file_extent_t *file_extent = NULL;
+	static char *function                = "libfsapfs_data_block_data_handle_read_direct";
+	size_t buffer_offset                 = 0;
+	size_t read_size                     = 0;
+	off64_t physical_offset              = 0;
+	off64_t read_offset                  = 0;
+	uint64_t file_extent_offset          = 0;
+	int file_extent_index                = 0;
+	int number_of_reads                  = 0;
+	int result                           = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - invalid file system data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle->encryption_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid data handle - unsupported encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The current offset is only advanced once the reads of the data before it have completed
+	 */
+	read_offset = data_handle->current_offset;
+
+	while( buffer_size > 0 )
+	{
+		if( (size64_t) read_offset >= data_handle->data_size )
+		{
+			break;
+		}
+		result = libfsapfs_data_block_data_handle_get_file_extent_at_offset(
+		          data_handle,
+		          read_offset,
+		          &file_extent_index,
+		          &file_extent,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			return( -1 );
+		}
+		file_extent_offset = (uint64_t) read_offset - file_extent->logical_offset;
+
+		read_size = buffer_size;
+
+		if( (uint64_t) read_size > ( file_extent->data_size - file_extent_offset ) )
+		{
+			read_size = (size_t) ( file_extent->data_size - file_extent_offset );
+		}
+		if( (size64_t) read_size > ( data_handle->data_size - read_offset ) )
+		{
+			read_size = (size_t) ( data_handle->data_size - read_offset );
+		}
+		if( ( data_handle->is_sparse != 0 )
+		 && ( file_extent->physical_block_number == 0 ) )
+		{
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			physical_offset = (off64_t) ( ( file_extent->physical_block_number * data_handle->file_system_data_handle->io_handle->block_size ) + file_extent_offset );
+
+			/* The reads of the extents are batched so that they can be in flight at the same time
+			 */
+			if( number_of_reads >= LIBFSAPFS_MAXIMUM_NUMBER_OF_BATCHED_READS )
+			{
+				if( libfsapfs_io_uring_read_buffers(
+				     data_handle->file_system_data_handle->io_handle->io_uring,
+				     file_io_handle,
+				     reads,
+				     number_of_reads,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read data.",
+					 function );
+
+					return( -1 );
+				}
+				number_of_reads = 0;
+
+				data_handle->current_offset = read_offset;
+			}
+			reads[ number_of_reads ].buffer      = &( buffer[ buffer_offset ] );
+			reads[ number_of_reads ].buffer_size = read_size;
+			reads[ number_of_reads ].file_offset = physical_offset;
+			reads[ number_of_reads ].read_count  = 0;
+
+			number_of_reads++;
+		}
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+		read_offset   += read_size;
+	}
+	if( number_of_reads > 0 )
+	{
+		if( libfsapfs_io_uring_read_buffers(
+		     data_handle->file_system_data_handle->io_handle->io_uring,
+		     file_io_handle,
+		     reads,
+		     number_of_reads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	data_handle->current_offset = read_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
 /* Reads data from the current offset into a buffer
  * Callback for the data stream
  * Returns the number of bytes read or -1 on error
@@ -291,6 +986,7 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
 	static char *function              = "libfsapfs_data_block_data_handle_read_segment_data";
 	size_t read_size                   = 0;
 	size_t segment_data_offset         = 0;
+	ssize_t read_count                 = 0;
 	off64_t data_block_offset          = 0;
 
 	LIBFSAPFS_UNREFERENCED_PARAMETER( segment_file_index )
@@ -356,6 +1052,96 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
 	{
 		return( 0 );
 	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - invalid file system data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reads of unencrypted data that span at least the maximum number of data block cache entries
+	 * are read directly into the segment data. The data block cache cannot retain such a read for
+	 * reuse and the read-ahead window, which is limited to the number of cache entries, cannot extend
+	 * beyond it. Smaller reads use the data block cache, so that they benefit from the contiguous run
+	 * reads, adaptive cache size and read-ahead. When the data block cache budget is limited to a
+	 * single entry every read of a block or more is read directly.
+	 */
+	if( ( data_handle->file_system_data_handle->encryption_context == NULL )
+	 && ( data_handle->file_system_data_handle->file_extents != NULL )
+	 && ( (size64_t) segment_data_size >= ( (size64_t) data_handle->maximum_number_of_cache_entries * data_handle->file_system_data_handle->io_handle->block_size ) ) )
+	{
+		read_count = libfsapfs_data_block_data_handle_read_direct(
+		              data_handle,
+		              file_io_handle,
+		              segment_data,
+		              segment_data_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data directly.",
+			 function );
+
+			return( -1 );
+		}
+		/* Keep track of the sequential read so that the data block cache
+		 * continues to adapt when the next read is smaller
+		 */
+		if( ( data_handle->current_offset - read_count ) != data_handle->sequential_read_offset )
+		{
+			data_handle->sequential_read_size = 0;
+		}
+		data_handle->sequential_read_offset = data_handle->current_offset;
+		data_handle->sequential_read_size  += read_count;
+
+		return( read_count );
+	}
+	if( libfsapfs_data_block_data_handle_adjust_cache_size(
+	     data_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to adjust data block cache size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_data_block_data_handle_adjust_read_ahead(
+	     data_handle,
+	     segment_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to adjust read-ahead.",
+		 function );
+
+		return( -1 );
+	}
 	while( segment_data_size > 0 )
 	{
 		if( libfdata_vector_get_element_value_at_offset(
@@ -443,6 +1229,9 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
 			break;
 		}
 	}
+	data_handle->sequential_read_offset = data_handle->current_offset;
+	data_handle->sequential_read_size  += segment_data_offset;
+
 	return( (ssize_t) segment_data_offset );
 }
 
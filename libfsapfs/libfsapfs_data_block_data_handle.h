@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_extent.h"
 #include "libfsapfs_file_system_data_handle.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
@@ -61,6 +62,30 @@ struct libfsapfs_data_block_data_handle
 	/* The data block cache
 	 */
 	libfcache_cache_t *data_block_cache;
+
+	/* The number of data block cache entries
+	 */
+	int number_of_cache_entries;
+
+	/* The maximum number of data block cache entries
+	 */
+	int maximum_number_of_cache_entries;
+
+	/* The offset at which a sequential read is expected to continue
+	 */
+	off64_t sequential_read_offset;
+
+	/* The number of bytes read sequentially
+	 */
+	size64_t sequential_read_size;
+
+	/* Value to indicate the file extents are sparse
+	 */
+	uint8_t is_sparse;
+
+	/* The index of the most recently used file extent
+	 */
+	int current_file_extent_index;
 };
 
 int libfsapfs_data_block_data_handle_initialize(
@@ -75,6 +100,29 @@ int libfsapfs_data_block_data_handle_free(
      libfsapfs_data_block_data_handle_t **data_handle,
      libcerror_error_t **error );
 
+int libfsapfs_data_block_data_handle_adjust_cache_size(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_data_block_data_handle_adjust_read_ahead(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libfsapfs_data_block_data_handle_get_file_extent_at_offset(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     off64_t offset,
+     int *file_extent_index,
+     libfsapfs_file_extent_t **file_extent,
+     libcerror_error_t **error );
+
+ssize_t libfsapfs_data_block_data_handle_read_direct(
+         libfsapfs_data_block_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 ssize_t libfsapfs_data_block_data_handle_read_segment_data(
          libfsapfs_data_block_data_handle_t *data_handle,
          libbfio_handle_t *file_io_handle,
@@ -253,6 +253,8 @@ on_error:
 }
 
 /* Creates data stream from a compressed data stream
+ * The compressed block cache is optional and shared with other data streams of the volume
+ * The worker pool and number of threads are used to decompress multiple compressed blocks in parallel
  * Make sure the value data_stream is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
@@ -261,6 +263,10 @@ int libfsapfs_data_stream_initialize_from_compressed_data_stream(
      libfdata_stream_t *compressed_data_stream,
      size64_t uncompressed_data_size,
      int compression_method,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libfdata_stream_t *safe_data_stream             = NULL;
@@ -295,6 +301,36 @@ int libfsapfs_data_stream_initialize_from_compressed_data_stream(
 
 		goto on_error;
 	}
+	if( libfsapfs_compressed_data_handle_set_compressed_block_cache(
+	     data_handle,
+	     compressed_block_cache,
+	     identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compressed block cache in compressed data handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_compressed_data_handle_set_number_of_threads(
+	     data_handle,
+	     worker_pool,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of threads in compressed data handle.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_stream_initialize(
 	     &safe_data_stream,
 	     (intptr_t *) data_handle,
@@ -25,11 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_compressed_block_cache.h"
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_worker_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -55,6 +57,10 @@ int libfsapfs_data_stream_initialize_from_compressed_data_stream(
      libfdata_stream_t *compressed_data_stream,
      size64_t uncompressed_data_size,
      int compression_method,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint64_t identifier,
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
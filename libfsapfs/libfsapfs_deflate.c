@@ -27,6 +27,42 @@
 #include "libfsapfs_deflate.h"
 #include "libfsapfs_libcerror.h"
 
+/* Flag to indicate a lookup table entry refers to a sub table
+ */
+#define LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE		0x00008000UL
+
+/* Refills a 64-bit bit buffer from a byte stream
+ * Whole bytes are added until the bit buffer contains more than 56 bits or the byte stream
+ * is exhausted. The bits above the bit buffer size remain 0.
+ */
+#define libfsapfs_deflate_bit_buffer_refill( byte_stream, byte_stream_size, byte_stream_offset, bit_buffer, bit_buffer_size, value_64bit, number_of_bytes ) \
+	if( bit_buffer_size <= 56 ) \
+	{ \
+		if( ( byte_stream_size - byte_stream_offset ) >= 8 ) \
+		{ \
+			byte_stream_copy_to_uint64_little_endian( \
+			 &( byte_stream[ byte_stream_offset ] ), \
+			 value_64bit ); \
+\
+			number_of_bytes = (uint8_t) ( ( 63 - bit_buffer_size ) >> 3 ); \
+\
+			value_64bit &= ( (uint64_t) 1 << ( number_of_bytes * 8 ) ) - 1; \
+\
+			bit_buffer         |= value_64bit << bit_buffer_size; \
+			bit_buffer_size    += number_of_bytes * 8; \
+			byte_stream_offset += number_of_bytes; \
+		} \
+		else \
+		{ \
+			while( ( bit_buffer_size <= 56 ) \
+			    && ( byte_stream_offset < byte_stream_size ) ) \
+			{ \
+				bit_buffer      |= (uint64_t) byte_stream[ byte_stream_offset++ ] << bit_buffer_size; \
+				bit_buffer_size += 8; \
+			} \
+		} \
+	}
+
 libfsapfs_deflate_huffman_table_t libfsapfs_deflate_fixed_huffman_distances_table;
 libfsapfs_deflate_huffman_table_t libfsapfs_deflate_fixed_huffman_literals_table;
 
@@ -309,6 +345,19 @@ int libfsapfs_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	if( libfsapfs_deflate_huffman_table_construct_lookup_table(
+	     table,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to construct lookup table.",
+		 function );
+
+		return( -1 );
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -325,6 +374,297 @@ int libfsapfs_deflate_huffman_table_construct(
 	return( 1 );
 }
 
+/* Constructs the lookup table of the Huffman table
+ * The Huffman table codes array and code counts array must have been constructed
+ * Codes of at most LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS are stored in the first level
+ * of the lookup table, larger codes are stored in a sub table that is referenced by
+ * the first level entry of their first LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS bits
+ * Returns 1 on success, 0 if the codes do not fit in the lookup table or -1 on error
+ */
+int libfsapfs_deflate_huffman_table_construct_lookup_table(
+     libfsapfs_deflate_huffman_table_t *table,
+     libcerror_error_t **error )
+{
+	uint8_t sub_table_bits[ 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ];
+
+	static char *function       = "libfsapfs_deflate_huffman_table_construct_lookup_table";
+	uint32_t huffman_code       = 0;
+	uint32_t lookup_index       = 0;
+	uint32_t lookup_value       = 0;
+	uint32_t reversed_code      = 0;
+	uint32_t sub_table_entry    = 0;
+	uint32_t sub_table_offset   = 0;
+	uint8_t bit_index           = 0;
+	uint8_t code_size           = 0;
+	uint8_t number_of_bits      = 0;
+	int code_index              = 0;
+	int code_size_count         = 0;
+	int pass_index              = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( table->maximum_number_of_bits > 15 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid table - number of bits values out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	table->has_lookup_table = 0;
+
+	if( memory_set(
+	     table->lookup_table,
+	     0,
+	     sizeof( uint32_t ) * LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     sub_table_bits,
+	     0,
+	     sizeof( uint8_t ) * ( 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sub table bits.",
+		 function );
+
+		return( -1 );
+	}
+	/* The first pass determines the size of the sub tables, the second pass fills the lookup table
+	 */
+	for( pass_index = 0;
+	     pass_index < 2;
+	     pass_index++ )
+	{
+		huffman_code = 0;
+		code_index   = 0;
+
+		for( code_size = 1;
+		     code_size <= table->maximum_number_of_bits;
+		     code_size++ )
+		{
+			for( code_size_count = table->code_counts_array[ code_size ];
+			     code_size_count > 0;
+			     code_size_count-- )
+			{
+				/* The Huffman codes are stored most significant bit first in the bit stream
+				 * hence the lookup table is indexed by the bit reversed code
+				 */
+				if( code_size <= LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS )
+				{
+					number_of_bits = code_size;
+					lookup_value   = huffman_code;
+				}
+				else
+				{
+					number_of_bits = LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS;
+					lookup_value   = huffman_code >> ( code_size - LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS );
+				}
+				reversed_code = 0;
+
+				for( bit_index = 0;
+				     bit_index < number_of_bits;
+				     bit_index++ )
+				{
+					reversed_code <<= 1;
+					reversed_code  |= lookup_value & 0x00000001UL;
+					lookup_value   >>= 1;
+				}
+				if( code_size > LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS )
+				{
+					if( pass_index == 0 )
+					{
+						if( sub_table_bits[ reversed_code ] < ( code_size - LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ) )
+						{
+							sub_table_bits[ reversed_code ] = code_size - LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS;
+						}
+					}
+					else
+					{
+						sub_table_entry  = table->lookup_table[ reversed_code ];
+						sub_table_offset = sub_table_entry >> 16;
+						number_of_bits   = code_size - LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS;
+						lookup_value     = huffman_code;
+						reversed_code    = 0;
+
+						for( bit_index = 0;
+						     bit_index < number_of_bits;
+						     bit_index++ )
+						{
+							reversed_code <<= 1;
+							reversed_code  |= lookup_value & 0x00000001UL;
+							lookup_value   >>= 1;
+						}
+						for( lookup_index = reversed_code;
+						     lookup_index < ( (uint32_t) 1 << ( sub_table_entry & 0x000000ffUL ) );
+						     lookup_index += (uint32_t) 1 << number_of_bits )
+						{
+							table->lookup_table[ sub_table_offset + lookup_index ] = ( (uint32_t) table->codes_array[ code_index ] << 16 ) | number_of_bits;
+						}
+					}
+				}
+				else if( pass_index == 1 )
+				{
+					for( lookup_index = reversed_code;
+					     lookup_index < ( (uint32_t) 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS );
+					     lookup_index += (uint32_t) 1 << code_size )
+					{
+						table->lookup_table[ lookup_index ] = ( (uint32_t) table->codes_array[ code_index ] << 16 ) | code_size;
+					}
+				}
+				huffman_code++;
+				code_index++;
+			}
+			huffman_code <<= 1;
+		}
+		if( pass_index == 0 )
+		{
+			/* Allocate the sub tables after the first level of the lookup table
+			 */
+			sub_table_offset = (uint32_t) 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS;
+
+			for( lookup_index = 0;
+			     lookup_index < ( (uint32_t) 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS );
+			     lookup_index++ )
+			{
+				number_of_bits = sub_table_bits[ lookup_index ];
+
+				if( number_of_bits == 0 )
+				{
+					continue;
+				}
+				if( ( sub_table_offset + ( (uint32_t) 1 << number_of_bits ) ) > LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE )
+				{
+					return( 0 );
+				}
+				table->lookup_table[ lookup_index ] = ( sub_table_offset << 16 )
+				                                    | LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE
+				                                    | number_of_bits;
+
+				sub_table_offset += (uint32_t) 1 << number_of_bits;
+			}
+		}
+	}
+	table->has_lookup_table = 1;
+
+	return( 1 );
+}
+
+/* Retrieves a Huffman encoded value from a bit buffer using the canonical Huffman codes
+ * This function is used when the codes do not fit in the lookup table
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_deflate_huffman_table_get_canonical_value(
+     libfsapfs_deflate_huffman_table_t *table,
+     uint64_t bit_buffer,
+     uint8_t bit_buffer_size,
+     uint32_t *value_32bit,
+     uint8_t *code_size,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfsapfs_deflate_huffman_table_get_canonical_value";
+	uint8_t bit_index      = 0;
+	uint8_t number_of_bits = 0;
+	int code_size_count    = 0;
+	int first_huffman_code = 0;
+	int first_index        = 0;
+	int huffman_code       = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_32bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid 32-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( code_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code size.",
+		 function );
+
+		return( -1 );
+	}
+	if( table->maximum_number_of_bits < bit_buffer_size )
+	{
+		number_of_bits = table->maximum_number_of_bits;
+	}
+	else
+	{
+		number_of_bits = bit_buffer_size;
+	}
+	for( bit_index = 1;
+	     bit_index <= number_of_bits;
+	     bit_index++ )
+	{
+		huffman_code <<= 1;
+		huffman_code  |= (int) bit_buffer & 0x00000001UL;
+		bit_buffer   >>= 1;
+
+		code_size_count = table->code_counts_array[ bit_index ];
+
+		if( ( huffman_code - code_size_count ) < first_huffman_code )
+		{
+			*value_32bit = (uint32_t) table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+			*code_size   = bit_index;
+
+			return( 1 );
+		}
+		first_huffman_code  += code_size_count;
+		first_huffman_code <<= 1;
+		first_index         += code_size_count;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid huffman encoded value.",
+	 function );
+
+	return( -1 );
+}
+
 /* Retrieves a Huffman encoded value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -335,15 +675,9 @@ int libfsapfs_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function     = "libfsapfs_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer       = 0;
+	uint32_t lookup_value     = 0;
 	uint32_t safe_value_32bit = 0;
-	uint8_t bit_index         = 0;
-	uint8_t number_of_bits    = 0;
-	int code_size_count       = 0;
-	int first_huffman_code    = 0;
-	int first_index           = 0;
-	int huffman_code          = 0;
-	int result                = 0;
+	uint8_t code_size         = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -392,54 +726,55 @@ int libfsapfs_deflate_bit_stream_get_huffman_encoded_value(
 		bit_stream->bit_buffer      |= safe_value_32bit;
 		bit_stream->bit_buffer_size += 8;
 	}
-	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
-	{
-		number_of_bits = table->maximum_number_of_bits;
-	}
-	else
-	{
-		number_of_bits = bit_stream->bit_buffer_size;
-	}
-	bit_buffer = bit_stream->bit_buffer;
-
-	for( bit_index = 1;
-	     bit_index <= number_of_bits;
-	     bit_index++ )
+	if( table->has_lookup_table != 0 )
 	{
-		huffman_code <<= 1;
-		huffman_code  |= (int) bit_buffer & 0x00000001UL;
-		bit_buffer   >>= 1;
-
-		code_size_count = table->code_counts_array[ bit_index ];
+		lookup_value = table->lookup_table[ bit_stream->bit_buffer & ( ( 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ) - 1 ) ];
+		code_size    = (uint8_t) ( lookup_value & 0x000000ffUL );
 
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
+		if( ( lookup_value & LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE ) != 0 )
 		{
-			safe_value_32bit = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+			lookup_value = table->lookup_table[ ( lookup_value >> 16 ) + ( ( bit_stream->bit_buffer >> LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ) & ( ( 1 << code_size ) - 1 ) ) ];
+			code_size    = (uint8_t) ( lookup_value & 0x000000ffUL );
 
-			result = 1;
+			if( code_size != 0 )
+			{
+				code_size += LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS;
+			}
+		}
+		if( ( code_size == 0 )
+		 || ( code_size > bit_stream->bit_buffer_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid huffman encoded value.",
+			 function );
 
-			break;
+			return( -1 );
 		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
-	}
-	if( result != 0 )
-	{
-		bit_stream->bit_buffer     >>= bit_index;
-		bit_stream->bit_buffer_size -= bit_index;
+		safe_value_32bit = lookup_value >> 16;
 	}
-	if( result != 1 )
+	else if( libfsapfs_deflate_huffman_table_get_canonical_value(
+	          table,
+	          (uint64_t) bit_stream->bit_buffer,
+	          bit_stream->bit_buffer_size,
+	          &safe_value_32bit,
+	          &code_size,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid huffman encoded value.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve canonical Huffman encoded value.",
 		 function );
 
 		return( -1 );
 	}
+	bit_stream->bit_buffer     >>= code_size;
+	bit_stream->bit_buffer_size -= code_size;
+
 	*value_32bit = safe_value_32bit;
 
 	return( 1 );
@@ -836,14 +1171,58 @@ int libfsapfs_deflate_decode_huffman(
 		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
 		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
 
-	static char *function         = "libfsapfs_deflate_decode_huffman";
-	size_t data_offset            = 0;
-	uint32_t code_value           = 0;
-	uint32_t extra_bits           = 0;
-	uint16_t compression_offset   = 0;
-	uint16_t compression_size     = 0;
-	uint16_t number_of_extra_bits = 0;
+	libfsapfs_deflate_huffman_table_t *table = NULL;
+	const uint8_t *byte_stream               = NULL;
+	static char *function                    = "libfsapfs_deflate_decode_huffman";
+	size_t byte_stream_offset                = 0;
+	size_t byte_stream_size                  = 0;
+	size_t data_offset                       = 0;
+	uint64_t bit_buffer                      = 0;
+	uint64_t value_64bit                     = 0;
+	uint32_t code_value                      = 0;
+	uint32_t extra_bits                      = 0;
+	uint32_t lookup_value                    = 0;
+	uint16_t compression_offset              = 0;
+	uint16_t compression_size                = 0;
+	uint16_t number_of_extra_bits            = 0;
+	uint8_t bit_buffer_size                  = 0;
+	uint8_t code_size                        = 0;
+	uint8_t number_of_bytes                  = 0;
+	int table_index                          = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( literals_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals table.",
+		 function );
 
+		return( -1 );
+	}
+	if( distances_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid distances table.",
+		 function );
+
+		return( -1 );
+	}
 	if( uncompressed_data == NULL )
 	{
 		libcerror_error_set(
@@ -879,95 +1258,194 @@ int libfsapfs_deflate_decode_huffman(
 	}
 	data_offset = *uncompressed_data_offset;
 
+	/* The bit stream is decoded using a local 64-bit bit buffer that is refilled
+	 * a 64-bit word at a time, so that a literal or a length and distance pair
+	 * can be decoded with a single refill
+	 */
+	byte_stream        = bit_stream->byte_stream;
+	byte_stream_size   = bit_stream->byte_stream_size;
+	byte_stream_offset = bit_stream->byte_stream_offset;
+	bit_buffer         = (uint64_t) bit_stream->bit_buffer;
+	bit_buffer_size    = bit_stream->bit_buffer_size;
+
+	if( ( bit_buffer_size > 32 )
+	 || ( byte_stream_offset > byte_stream_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bit stream value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	do
 	{
-		if( libfsapfs_deflate_bit_stream_get_huffman_encoded_value(
-		     bit_stream,
-		     literals_table,
-		     &code_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve literal value from bit stream.",
-			 function );
+		libfsapfs_deflate_bit_buffer_refill(
+		 byte_stream,
+		 byte_stream_size,
+		 byte_stream_offset,
+		 bit_buffer,
+		 bit_buffer_size,
+		 value_64bit,
+		 number_of_bytes );
 
-			return( -1 );
-		}
-		if( code_value < 256 )
+		/* The first iteration decodes the literal or length code, the second the distance code
+		 */
+		for( table_index = 0;
+		     table_index < 2;
+		     table_index++ )
 		{
-			if( data_offset >= uncompressed_data_size )
+			if( table_index == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: invalid uncompressed data value too small.",
-				 function );
-
-				return( -1 );
+				table = literals_table;
 			}
-			uncompressed_data[ data_offset++ ] = (uint8_t) code_value;
-		}
-		else if( ( code_value > 256 )
-		      && ( code_value < 286 ) )
-		{
-			code_value -= 257;
+			else
+			{
+				if( bit_buffer_size < 28 )
+				{
+					libfsapfs_deflate_bit_buffer_refill(
+					 byte_stream,
+					 byte_stream_size,
+					 byte_stream_offset,
+					 bit_buffer,
+					 bit_buffer_size,
+					 value_64bit,
+					 number_of_bytes );
+				}
+				table = distances_table;
+			}
+			if( table->has_lookup_table != 0 )
+			{
+				lookup_value = table->lookup_table[ bit_buffer & ( ( 1 << LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ) - 1 ) ];
+				code_size    = (uint8_t) ( lookup_value & 0x000000ffUL );
 
-			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
+				if( ( lookup_value & LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE ) != 0 )
+				{
+					lookup_value = table->lookup_table[ ( lookup_value >> 16 ) + ( ( bit_buffer >> LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS ) & ( ( 1 << code_size ) - 1 ) ) ];
+					code_size    = (uint8_t) ( lookup_value & 0x000000ffUL );
 
-			if( libfsapfs_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+					if( code_size != 0 )
+					{
+						code_size += LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS;
+					}
+				}
+				if( ( code_size == 0 )
+				 || ( code_size > bit_buffer_size ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid huffman encoded value.",
+					 function );
+
+					return( -1 );
+				}
+				code_value = lookup_value >> 16;
+			}
+			else if( libfsapfs_deflate_huffman_table_get_canonical_value(
+			          table,
+			          bit_buffer,
+			          bit_buffer_size,
+			          &code_value,
+			          &code_size,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve literal extra value from bit stream.",
-				 function );
+				 "%s: unable to retrieve %s value from bit stream.",
+				 function,
+				 ( table_index == 0 ) ? "literal" : "distance" );
 
 				return( -1 );
 			}
-			compression_size = literal_codes_base[ code_value ] + (uint16_t) extra_bits;
+			bit_buffer     >>= code_size;
+			bit_buffer_size -= code_size;
 
-			if( libfsapfs_deflate_bit_stream_get_huffman_encoded_value(
-			     bit_stream,
-			     distances_table,
-			     &code_value,
-			     error ) != 1 )
+			if( table_index == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve distance value from bit stream.",
-				 function );
+				if( code_value < 256 )
+				{
+					if( data_offset >= uncompressed_data_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+						 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+						 "%s: invalid uncompressed data value too small.",
+						 function );
+
+						return( -1 );
+					}
+					uncompressed_data[ data_offset++ ] = (uint8_t) code_value;
+
+					break;
+				}
+				else if( code_value == 256 )
+				{
+					break;
+				}
+				else if( code_value >= 286 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: invalid code value: %" PRIu32 ".",
+					 function,
+					 code_value );
 
-				return( -1 );
+					return( -1 );
+				}
+				code_value -= 257;
+
+				number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
+				compression_size     = literal_codes_base[ code_value ];
 			}
-			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
+			else
+			{
+				if( code_value >= 30 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: invalid distance code value: %" PRIu32 ".",
+					 function,
+					 code_value );
 
-			if( libfsapfs_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+					return( -1 );
+				}
+				number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
+				compression_offset   = distance_codes_base[ code_value ];
+			}
+			if( number_of_extra_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve distance extra value from bit stream.",
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid byte stream value to small.",
 				 function );
 
 				return( -1 );
 			}
-			compression_offset = distance_codes_base[ code_value ] + (uint16_t) extra_bits;
+			extra_bits = (uint32_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= (uint8_t) number_of_extra_bits;
+
+			if( table_index == 0 )
+			{
+				compression_size += (uint16_t) extra_bits;
+
+				continue;
+			}
+			compression_offset += (uint16_t) extra_bits;
 
 			if( compression_offset > data_offset )
 			{
@@ -991,6 +1469,32 @@ int libfsapfs_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			/* Back-references with a distance of at least 8 bytes are copied 8 bytes at a time
+			 * since the source and destination of every 8 bytes do not overlap
+			 */
+			if( compression_offset >= 8 )
+			{
+				while( compression_size >= 8 )
+				{
+					memory_copy(
+					 &( uncompressed_data[ data_offset ] ),
+					 &( uncompressed_data[ data_offset - compression_offset ] ),
+					 8 );
+
+					data_offset      += 8;
+					compression_size -= 8;
+				}
+			}
+			else if( compression_offset == 1 )
+			{
+				memory_set(
+				 &( uncompressed_data[ data_offset ] ),
+				 uncompressed_data[ data_offset - 1 ],
+				 compression_size );
+
+				data_offset     += compression_size;
+				compression_size = 0;
+			}
 			while( compression_size > 0 )
 			{
 				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
@@ -999,21 +1503,21 @@ int libfsapfs_deflate_decode_huffman(
 				compression_size--;
 			}
 		}
-		else if( code_value != 256 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: invalid code value: %" PRIu16 ".",
-			 function,
-			 code_value );
-
-			return( -1 );
-		}
 	}
 	while( code_value != 256 );
 
+	/* Return the whole bytes remaining in the bit buffer to the byte stream
+	 */
+	number_of_bytes = bit_buffer_size >> 3;
+
+	byte_stream_offset -= number_of_bytes;
+	bit_buffer_size    -= number_of_bytes * 8;
+	bit_buffer         &= ( (uint64_t) 1 << bit_buffer_size ) - 1;
+
+	bit_stream->byte_stream_offset = byte_stream_offset;
+	bit_stream->bit_buffer         = (uint32_t) bit_buffer;
+	bit_stream->bit_buffer_size    = bit_buffer_size;
+
 	*uncompressed_data_offset = data_offset;
 
 	return( 1 );
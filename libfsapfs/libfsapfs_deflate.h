@@ -31,6 +31,15 @@
 extern "C" {
 #endif
 
+/* The number of bits used to index the first level of the Huffman lookup table
+ */
+#define LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS		9
+
+/* The number of entries of the Huffman lookup table, which contains
+ * the first level and the second level (sub) tables
+ */
+#define LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE	2048
+
 /* The block types
  */
 enum LIBFSAPFS_DEFLATE_BLOCK_TYPES
@@ -86,6 +95,17 @@ struct libfsapfs_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The lookup table
+	 * An entry contains the symbol in the upper 16 bits and the code size in the lower 8 bits
+	 * or for codes larger than LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_BITS, the offset of a sub table
+	 * in the upper 16 bits and the number of bits used to index the sub table in the lower 8 bits
+	 */
+	uint32_t lookup_table[ LIBFSAPFS_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE ];
+
+	/* Value to indicate the lookup table can be used
+	 */
+	uint8_t has_lookup_table;
 };
 
 int libfsapfs_deflate_bit_stream_get_value(
@@ -100,6 +120,18 @@ int libfsapfs_deflate_huffman_table_construct(
      int number_of_code_sizes,
      libcerror_error_t **error );
 
+int libfsapfs_deflate_huffman_table_construct_lookup_table(
+     libfsapfs_deflate_huffman_table_t *table,
+     libcerror_error_t **error );
+
+int libfsapfs_deflate_huffman_table_get_canonical_value(
+     libfsapfs_deflate_huffman_table_t *table,
+     uint64_t bit_buffer,
+     uint8_t bit_buffer_size,
+     uint32_t *value_32bit,
+     uint8_t *code_size,
+     libcerror_error_t **error );
+
 int libfsapfs_deflate_bit_stream_get_huffman_encoded_value(
      libfsapfs_deflate_bit_stream_t *bit_stream,
      libfsapfs_deflate_huffman_table_t *table,
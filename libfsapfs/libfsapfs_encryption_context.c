@@ -24,11 +24,19 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_aes_xts_context.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_libcaes.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_unused.h"
+#include "libfsapfs_worker_pool.h"
+
+/* The minimum data size for which the decryption is spread across the worker threads
+ */
+#define LIBFSAPFS_ENCRYPTION_CONTEXT_MINIMUM_PARALLEL_DATA_SIZE	( 256 * 1024 )
 
 /* Creates an encryption context
  * Make sure the value encryption context is referencing, is set to NULL
@@ -40,6 +48,7 @@ int libfsapfs_encryption_context_initialize(
      libcerror_error_t **error )
 {
 	static char *function = "libfsapfs_encryption_context_initialize";
+	int backend           = 0;
 
 	if( context == NULL )
 	{
@@ -120,13 +129,39 @@ int libfsapfs_encryption_context_initialize(
 
 		goto on_error;
 	}
-	( *context )->method = method;
+	backend = libfsapfs_aes_xts_context_get_supported_backend();
+
+	if( backend != LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	{
+		if( libfsapfs_aes_xts_context_initialize(
+		     &( ( *context )->aes_xts_context ),
+		     backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize AES-XTS context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *context )->method            = method;
+	( *context )->number_of_threads = 1;
 
 	return( 1 );
 
 on_error:
 	if( *context != NULL )
 	{
+		if( ( *context )->aes_xts_context != NULL )
+		{
+			libfsapfs_aes_xts_context_free(
+			 &( ( *context )->aes_xts_context ),
+			 NULL );
+		}
 		if( ( *context )->decryption_context != NULL )
 		{
 			libcaes_tweaked_context_free(
@@ -151,6 +186,10 @@ int libfsapfs_encryption_context_free(
 	static char *function = "libfsapfs_encryption_context_free";
 	int result            = 1;
 
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int thread_index      = 0;
+#endif
+
 	if( context == NULL )
 	{
 		libcerror_error_set(
@@ -177,6 +216,55 @@ int libfsapfs_encryption_context_free(
 
 			result = -1;
 		}
+		if( ( *context )->aes_xts_context != NULL )
+		{
+			if( libfsapfs_aes_xts_context_free(
+			     &( ( *context )->aes_xts_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free AES-XTS context.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		for( thread_index = 0;
+		     thread_index < ( LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS - 1 );
+		     thread_index++ )
+		{
+			if( ( *context )->thread_decryption_contexts[ thread_index ] != NULL )
+			{
+				if( libcaes_tweaked_context_free(
+				     &( ( *context )->thread_decryption_contexts[ thread_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable free thread: %d decryption context.",
+					 function,
+					 thread_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_set(
+		 ( *context )->key,
+		 0,
+		 32 );
+
+		memory_set(
+		 ( *context )->tweak_key,
+		 0,
+		 32 );
+#endif
 		memory_free(
 		 *context );
 
@@ -200,6 +288,10 @@ int libfsapfs_encryption_context_set_keys(
 	size_t key_bit_size   = 0;
 	size_t key_byte_size  = 0;
 
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int thread_index      = 0;
+#endif
+
 	if( context == NULL )
 	{
 		libcerror_error_set(
@@ -301,9 +393,514 @@ int libfsapfs_encryption_context_set_keys(
 
 		return( -1 );
 	}
+	if( context->aes_xts_context != NULL )
+	{
+		if( libfsapfs_aes_xts_context_set_keys(
+		     context->aes_xts_context,
+		     key,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in AES-XTS context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( memory_copy(
+	     context->key,
+	     key,
+	     key_byte_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     context->tweak_key,
+	     tweak_key,
+	     key_byte_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy tweak key.",
+		 function );
+
+		return( -1 );
+	}
+	context->key_bit_size = key_bit_size;
+
+	for( thread_index = 0;
+	     thread_index < ( context->number_of_threads - 1 );
+	     thread_index++ )
+	{
+		if( libcaes_tweaked_context_set_keys(
+		     context->thread_decryption_contexts[ thread_index ],
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     key,
+		     key_bit_size,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in thread: %d decryption context.",
+			 function,
+			 thread_index );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of threads used to decrypt data
+ * The data of a single decrypt call is spread across the threads, where the calling
+ * thread is one of them and the others are worker threads of the worker pool, if it
+ * is at least 256 KiB in size
+ * Without multi-threading support or a worker pool the data is always decrypted by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_encryption_context_set_number_of_threads(
+     libfsapfs_encryption_context_t *context,
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_encryption_context_set_number_of_threads";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int thread_index      = 0;
+#endif
+
+#if !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	LIBFSAPFS_UNREFERENCED_PARAMETER( worker_pool )
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	context->worker_pool = worker_pool;
+
+	for( thread_index = context->number_of_threads - 1;
+	     thread_index < ( number_of_threads - 1 );
+	     thread_index++ )
+	{
+		if( libcaes_tweaked_context_initialize(
+		     &( context->thread_decryption_contexts[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize thread: %d decryption context.",
+			 function,
+			 thread_index );
+
+			return( -1 );
+		}
+		/* The number of threads reflects the initialized decryption contexts on error
+		 */
+		context->number_of_threads = thread_index + 2;
+
+		if( context->key_bit_size != 0 )
+		{
+			if( libcaes_tweaked_context_set_keys(
+			     context->thread_decryption_contexts[ thread_index ],
+			     LIBCAES_CRYPT_MODE_DECRYPT,
+			     context->key,
+			     context->key_bit_size,
+			     context->tweak_key,
+			     context->key_bit_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set keys in thread: %d decryption context.",
+				 function,
+				 thread_index );
+
+				return( -1 );
+			}
+		}
+	}
+	for( thread_index = number_of_threads - 1;
+	     thread_index < ( context->number_of_threads - 1 );
+	     thread_index++ )
+	{
+		if( libcaes_tweaked_context_free(
+		     &( context->thread_decryption_contexts[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable free thread: %d decryption context.",
+			 function,
+			 thread_index );
+
+			return( -1 );
+		}
+	}
+	context->number_of_threads = number_of_threads;
+#endif
 	return( 1 );
 }
 
+/* Decrypts consecutive sectors of data
+ * The AES-XTS context is used, if available, when the data consists of whole sectors
+ * that are a multiple of the AES block size, otherwise the libcaes decryption context
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_encryption_context_crypt_sectors(
+     libfsapfs_aes_xts_context_t *aes_xts_context,
+     libcaes_tweaked_context_t *decryption_context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	uint8_t tweak_value[ 16 ];
+
+	static char *function = "libfsapfs_encryption_context_crypt_sectors";
+	size_t data_offset    = 0;
+
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid bytes per sector value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( aes_xts_context != NULL )
+	 && ( ( bytes_per_sector % 16 ) == 0 )
+	 && ( ( input_data_size % bytes_per_sector ) == 0 ) )
+	{
+		if( libfsapfs_aes_xts_context_decrypt(
+		     aes_xts_context,
+		     input_data,
+		     input_data_size,
+		     output_data,
+		     sector_number,
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt data.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( memory_set(
+	     tweak_value,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear tweak value.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < input_data_size;
+	     data_offset += bytes_per_sector )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 tweak_value,
+		 sector_number );
+
+		if( libcaes_crypt_xts(
+		     decryption_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     tweak_value,
+		     16,
+		     &( input_data[ data_offset ] ),
+		     bytes_per_sector,
+		     &( output_data[ data_offset ] ),
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt data.",
+			 function );
+
+			goto on_error;
+		}
+		sector_number += 1;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 tweak_value,
+	 0,
+	 16 );
+
+	return( -1 );
+}
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+/* Decrypts the sectors of a worker thread
+ * Callback for the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_encryption_context_crypt_thread_callback(
+     libfsapfs_encryption_context_thread_values_t *thread_values )
+{
+	if( thread_values == NULL )
+	{
+		return( -1 );
+	}
+	/* The error cannot be passed between threads
+	 */
+	thread_values->result = libfsapfs_encryption_context_crypt_sectors(
+	                         thread_values->aes_xts_context,
+	                         thread_values->decryption_context,
+	                         thread_values->input_data,
+	                         thread_values->data_size,
+	                         thread_values->output_data,
+	                         thread_values->sector_number,
+	                         thread_values->bytes_per_sector,
+	                         NULL );
+
+	return( thread_values->result );
+}
+
+/* Decrypts data by spreading its sectors across the worker threads and the calling thread
+ * The worker threads of the worker pool must be grabbed by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_encryption_context_crypt_parallel(
+     libfsapfs_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	libfsapfs_encryption_context_thread_values_t thread_values[ LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS - 1 ];
+	libfsapfs_worker_pool_job_t jobs[ LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS - 1 ];
+
+	static char *function      = "libfsapfs_encryption_context_crypt_parallel";
+	size_t data_offset         = 0;
+	size_t thread_data_size    = 0;
+	uint64_t number_of_sectors = 0;
+	int number_of_jobs         = 0;
+	int result                 = 1;
+	int thread_index           = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid bytes per sector value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every thread decrypts a contiguous range of whole sectors,
+	 * where the calling thread decrypts the first range
+	 */
+	number_of_sectors = ( input_data_size + bytes_per_sector - 1 ) / bytes_per_sector;
+	thread_data_size  = (size_t) ( ( number_of_sectors + context->number_of_threads - 1 ) / context->number_of_threads ) * bytes_per_sector;
+
+	for( thread_index = 0;
+	     thread_index < ( context->number_of_threads - 1 );
+	     thread_index++ )
+	{
+		data_offset = thread_data_size * ( thread_index + 1 );
+
+		if( data_offset >= input_data_size )
+		{
+			break;
+		}
+		thread_values[ thread_index ].aes_xts_context    = context->aes_xts_context;
+		thread_values[ thread_index ].decryption_context = context->thread_decryption_contexts[ thread_index ];
+		thread_values[ thread_index ].input_data         = &( input_data[ data_offset ] );
+		thread_values[ thread_index ].output_data        = &( output_data[ data_offset ] );
+		thread_values[ thread_index ].data_size          = input_data_size - data_offset;
+		thread_values[ thread_index ].sector_number      = sector_number + ( data_offset / bytes_per_sector );
+		thread_values[ thread_index ].bytes_per_sector   = bytes_per_sector;
+		thread_values[ thread_index ].result             = 0;
+
+		if( thread_values[ thread_index ].data_size > thread_data_size )
+		{
+			thread_values[ thread_index ].data_size = thread_data_size;
+		}
+		jobs[ thread_index ].function  = (int (*)(void *)) &libfsapfs_encryption_context_crypt_thread_callback;
+		jobs[ thread_index ].arguments = (void *) &( thread_values[ thread_index ] );
+
+		if( libfsapfs_worker_pool_push_job(
+		     context->worker_pool,
+		     &( jobs[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job: %d onto worker pool.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_jobs++;
+	}
+	if( result == 1 )
+	{
+		if( thread_data_size > input_data_size )
+		{
+			thread_data_size = input_data_size;
+		}
+		if( libfsapfs_encryption_context_crypt_sectors(
+		     context->aes_xts_context,
+		     context->decryption_context,
+		     input_data,
+		     thread_data_size,
+		     output_data,
+		     sector_number,
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The jobs that were pushed are always waited for, since they reference the thread values
+	 */
+	if( libfsapfs_worker_pool_wait_for_jobs(
+	     context->worker_pool,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for jobs.",
+			 function );
+		}
+		result = -1;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_jobs;
+	     thread_index++ )
+	{
+		if( ( result == 1 )
+		 && ( jobs[ thread_index ].result != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt data in job: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 /* De- or encrypts a block of data
  * Returns 1 if successful or -1 on error
  */
@@ -318,10 +915,11 @@ int libfsapfs_encryption_context_crypt(
      uint16_t bytes_per_sector,
      libcerror_error_t **error )
 {
-	uint8_t tweak_value[ 16 ];
-
 	static char *function = "libfsapfs_encryption_context_crypt";
-	size_t data_offset    = 0;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int result            = 0;
+#endif
 
 	if( context == NULL )
 	{
@@ -400,59 +998,89 @@ int libfsapfs_encryption_context_crypt(
 
 		return( -1 );
 	}
-	if( memory_set(
-	     tweak_value,
-	     0,
-	     16 ) == NULL )
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( ( context->number_of_threads > 1 )
+	 && ( context->worker_pool != NULL )
+	 && ( input_data_size >= LIBFSAPFS_ENCRYPTION_CONTEXT_MINIMUM_PARALLEL_DATA_SIZE ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear tweak value.",
-		 function );
-
-		goto on_error;
-	}
-	for( data_offset = 0;
-	     data_offset < input_data_size;
-	     data_offset += bytes_per_sector )
-	{
-		byte_stream_copy_from_uint64_little_endian(
-		 tweak_value,
-		 sector_number );
-
-		if( libcaes_crypt_xts(
-		     context->decryption_context,
-		     LIBCAES_CRYPT_MODE_DECRYPT,
-		     tweak_value,
-		     16,
-		     &( input_data[ data_offset ] ),
-		     bytes_per_sector,
-		     &( output_data[ data_offset ] ),
-		     bytes_per_sector,
-		     error ) != 1 )
+		/* If the worker threads are in use by another caller the data is decrypted by the calling thread
+		 */
+		result = libfsapfs_worker_pool_grab(
+		          context->worker_pool,
+		          context->number_of_threads - 1,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
-			 "%s: unable to decrypt data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab worker pool.",
 			 function );
 
-			goto on_error;
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			result = libfsapfs_encryption_context_crypt_parallel(
+			          context,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          sector_number,
+			          bytes_per_sector,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt data.",
+				 function );
+
+				result = -1;
+			}
+			if( libfsapfs_worker_pool_release(
+			     context->worker_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release worker pool.",
+				 function );
+
+				result = -1;
+			}
+			return( result );
 		}
-		sector_number += 1;
 	}
-	return( 1 );
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
 
-on_error:
-	memory_set(
-	 tweak_value,
-	 0,
-	 16 );
+	if( libfsapfs_encryption_context_crypt_sectors(
+	     context->aes_xts_context,
+	     context->decryption_context,
+	     input_data,
+	     input_data_size,
+	     output_data,
+	     sector_number,
+	     bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt data.",
+		 function );
 
-	return( -1 );
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Unwrap data using AES Key Wrap (RFC3394)
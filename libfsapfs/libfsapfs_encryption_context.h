@@ -25,8 +25,12 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_aes_xts_context.h"
+#include "libfsapfs_definitions.h"
 #include "libfsapfs_libcaes.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_worker_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -43,6 +47,75 @@ struct libfsapfs_encryption_context
 	/* The AES-XTS decryption context
 	 */
 	libcaes_tweaked_context_t *decryption_context;
+
+	/* The hardware accelerated AES-XTS decryption context
+	 * This value is NULL if the CPU does not support AES instructions
+	 */
+	libfsapfs_aes_xts_context_t *aes_xts_context;
+
+	/* The number of threads used to decrypt data
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The AES-XTS decryption contexts of the worker threads
+	 */
+	libcaes_tweaked_context_t *thread_decryption_contexts[ LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS - 1 ];
+
+	/* The worker pool
+	 * The worker pool is not managed by the context
+	 */
+	libfsapfs_worker_pool_t *worker_pool;
+
+	/* The key, retained to set up the decryption contexts of the worker threads
+	 */
+	uint8_t key[ 32 ];
+
+	/* The tweak key, retained to set up the decryption contexts of the worker threads
+	 */
+	uint8_t tweak_key[ 32 ];
+
+	/* The key bit size, which is 0 if no keys were set
+	 */
+	size_t key_bit_size;
+#endif
+};
+
+typedef struct libfsapfs_encryption_context_thread_values libfsapfs_encryption_context_thread_values_t;
+
+struct libfsapfs_encryption_context_thread_values
+{
+	/* The AES-XTS decryption context
+	 */
+	libcaes_tweaked_context_t *decryption_context;
+
+	/* The hardware accelerated AES-XTS decryption context
+	 */
+	libfsapfs_aes_xts_context_t *aes_xts_context;
+
+	/* The input data
+	 */
+	const uint8_t *input_data;
+
+	/* The output data
+	 */
+	uint8_t *output_data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The sector number of the first sector
+	 */
+	uint64_t sector_number;
+
+	/* The number of bytes per sector
+	 */
+	uint16_t bytes_per_sector;
+
+	/* The result
+	 */
+	int result;
 };
 
 int libfsapfs_encryption_context_initialize(
@@ -62,6 +135,38 @@ int libfsapfs_encryption_context_set_keys(
      size_t tweak_key_size,
      libcerror_error_t **error );
 
+int libfsapfs_encryption_context_set_number_of_threads(
+     libfsapfs_encryption_context_t *context,
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsapfs_encryption_context_crypt_sectors(
+     libfsapfs_aes_xts_context_t *aes_xts_context,
+     libcaes_tweaked_context_t *decryption_context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+int libfsapfs_encryption_context_crypt_thread_callback(
+     libfsapfs_encryption_context_thread_values_t *thread_values );
+
+int libfsapfs_encryption_context_crypt_parallel(
+     libfsapfs_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 int libfsapfs_encryption_context_crypt(
      libfsapfs_encryption_context_t *context,
      int mode,
@@ -32,7 +32,9 @@
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_extended_attribute.h"
 #include "libfsapfs_file_entry.h"
+#include "libfsapfs_file_entry_iterator.h"
 #include "libfsapfs_file_extent.h"
+#include "libfsapfs_file_io_handle_pool.h"
 #include "libfsapfs_file_system_btree.h"
 #include "libfsapfs_inode.h"
 #include "libfsapfs_io_handle.h"
@@ -57,6 +59,7 @@ int libfsapfs_file_entry_initialize(
      libbfio_handle_t *file_io_handle,
      libfsapfs_encryption_context_t *encryption_context,
      libfsapfs_file_system_btree_t *file_system_btree,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
      libfsapfs_inode_t *inode,
      libfsapfs_directory_record_t *directory_record,
      libcerror_error_t **error )
@@ -117,13 +120,14 @@ int libfsapfs_file_entry_initialize(
 
 		return( -1 );
 	}
-	internal_file_entry->io_handle          = io_handle;
-	internal_file_entry->file_io_handle     = file_io_handle;
-	internal_file_entry->encryption_context = encryption_context;
-	internal_file_entry->file_system_btree  = file_system_btree;
-	internal_file_entry->inode              = inode;
-	internal_file_entry->directory_record   = directory_record;
-	internal_file_entry->data_size          = (size64_t) -1;
+	internal_file_entry->io_handle              = io_handle;
+	internal_file_entry->file_io_handle         = file_io_handle;
+	internal_file_entry->encryption_context     = encryption_context;
+	internal_file_entry->file_system_btree      = file_system_btree;
+	internal_file_entry->compressed_block_cache = compressed_block_cache;
+	internal_file_entry->inode                  = inode;
+	internal_file_entry->directory_record       = directory_record;
+	internal_file_entry->data_size              = (size64_t) -1;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBFSAPFS )
 	if( libcthreads_read_write_lock_initialize(
@@ -195,7 +199,7 @@ int libfsapfs_file_entry_free(
 			result = -1;
 		}
 #endif
-		/* The file_io_handle and file_system_btree references are freed elsewhere
+		/* The file_io_handle, file_system_btree and compressed_block_cache references are freed elsewhere
 		 */
 		if( internal_file_entry->inode != NULL )
 		{
@@ -323,6 +327,133 @@ int libfsapfs_file_entry_free(
 	return( result );
 }
 
+/* Sets the file system B-tree records of the file entry
+ * The file entry takes over management of the arrays that are set, the arrays
+ * that are NULL are retrieved from the file system B-tree when needed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_set_btree_records(
+     libfsapfs_file_entry_t *file_entry,
+     libcdata_array_t **extended_attributes_array,
+     libcdata_array_t **directory_entries,
+     libcdata_array_t **file_extents,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsapfs_file_entry_set_btree_records";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->extended_attributes_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry - extended attributes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->directory_entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry - directory entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->file_extents != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry - file extents value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( extended_attributes_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extended attributes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file extents.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extended_attributes_array != NULL )
+	{
+		internal_file_entry->extended_attributes_array = *extended_attributes_array;
+
+		if( libfsapfs_internal_file_entry_determine_special_extended_attributes(
+		     internal_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine special extended attributes.",
+			 function );
+
+			internal_file_entry->extended_attributes_array        = NULL;
+			internal_file_entry->compressed_data_attribute_values = NULL;
+			internal_file_entry->resource_fork_attribute_values   = NULL;
+			internal_file_entry->symbolic_link_attribute_values   = NULL;
+
+			return( -1 );
+		}
+		*extended_attributes_array = NULL;
+	}
+	internal_file_entry->directory_entries = *directory_entries;
+	*directory_entries                     = NULL;
+
+	internal_file_entry->file_extents = *file_extents;
+	*file_extents                     = NULL;
+
+	return( 1 );
+}
+
 /* Retrieves the identifier
  * This value is retrieved from the inode
  * Returns 1 if successful or -1 on error
@@ -586,6 +717,7 @@ int libfsapfs_file_entry_get_parent_file_entry(
 		     internal_file_entry->file_io_handle,
 		     internal_file_entry->encryption_context,
 		     internal_file_entry->file_system_btree,
+		     internal_file_entry->compressed_block_cache,
 		     inode,
 		     NULL,
 		     error ) != 1 )
@@ -1842,12 +1974,9 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_attribute_values_t *attribute_values = NULL;
-	static char *function                          = "libfsapfs_internal_file_entry_get_extended_attributes";
-	uint64_t file_system_identifier                = 0;
-	int attribute_index                            = 0;
-	int number_of_attributes                       = 0;
-	int result                                     = 0;
+	static char *function           = "libfsapfs_internal_file_entry_get_extended_attributes";
+	uint64_t file_system_identifier = 0;
+	int result                      = 0;
 
 	if( internal_file_entry == NULL )
 	{
@@ -1917,6 +2046,58 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 
 		goto on_error;
 	}
+	if( libfsapfs_internal_file_entry_determine_special_extended_attributes(
+	     internal_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine special extended attributes.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_file_entry->extended_attributes_array != NULL )
+	{
+		libcdata_array_free(
+		 &( internal_file_entry->extended_attributes_array ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_attribute_values_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines the special extended attributes
+ * The special extended attributes are the compressed data, resource fork
+ * and symbolic link extended attributes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_file_entry_determine_special_extended_attributes(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_attribute_values_t *attribute_values = NULL;
+	static char *function                          = "libfsapfs_internal_file_entry_determine_special_extended_attributes";
+	int attribute_index                            = 0;
+	int number_of_attributes                       = 0;
+	int result                                     = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_get_number_of_entries(
 	     internal_file_entry->extended_attributes_array,
 	     &number_of_attributes,
@@ -1929,7 +2110,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 		 "%s: unable to retrieve number of entries from extended attributes array.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	for( attribute_index = 0;
 	     attribute_index < number_of_attributes;
@@ -1949,7 +2130,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 function,
 			 attribute_index );
 
-			goto on_error;
+			return( -1 );
 		}
 		result = libfsapfs_attribute_values_compare_name_with_utf8_string(
 		          attribute_values,
@@ -1966,7 +2147,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 "%s: unable to compare UTF-8 string with name of extended attribute.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		else if( result == LIBUNA_COMPARE_EQUAL )
 		{
@@ -1989,7 +2170,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 "%s: unable to compare UTF-8 string with name of extended attribute.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		else if( result == LIBUNA_COMPARE_EQUAL )
 		{
@@ -2012,7 +2193,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 "%s: unable to compare UTF-8 string with name of extended attribute.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		else if( result == LIBUNA_COMPARE_EQUAL )
 		{
@@ -2022,16 +2203,6 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 		}
 	}
 	return( 1 );
-
-on_error:
-	if( internal_file_entry->extended_attributes_array != NULL )
-	{
-		libcdata_array_free(
-		 &( internal_file_entry->extended_attributes_array ),
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_attribute_values_free,
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Determines the symbolic link data
@@ -3777,6 +3948,7 @@ int libfsapfs_file_entry_get_sub_file_entry_by_index(
 	     internal_file_entry->file_io_handle,
 	     internal_file_entry->encryption_context,
 	     internal_file_entry->file_system_btree,
+	     internal_file_entry->compressed_block_cache,
 	     inode,
 	     directory_record_copy,
 	     error ) != 1 )
@@ -3945,6 +4117,7 @@ int libfsapfs_file_entry_get_sub_file_entry_by_utf8_name(
 		     internal_file_entry->file_io_handle,
 		     internal_file_entry->encryption_context,
 		     internal_file_entry->file_system_btree,
+		     internal_file_entry->compressed_block_cache,
 		     inode,
 		     directory_record,
 		     error ) != 1 )
@@ -4111,6 +4284,7 @@ int libfsapfs_file_entry_get_sub_file_entry_by_utf16_name(
 		     internal_file_entry->file_io_handle,
 		     internal_file_entry->encryption_context,
 		     internal_file_entry->file_system_btree,
+		     internal_file_entry->compressed_block_cache,
 		     inode,
 		     directory_record,
 		     error ) != 1 )
@@ -4167,6 +4341,103 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves a sub file entry iterator
+ * The iterator reads the directory records one at a time from the file system B-tree
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_get_sub_file_entry_iterator(
+     libfsapfs_file_entry_t *file_entry,
+     libfsapfs_file_entry_iterator_t **sub_file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsapfs_file_entry_get_sub_file_entry_iterator";
+	uint64_t file_system_identifier                      = 0;
+	int result                                           = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_inode_get_identifier(
+	     internal_file_entry->inode,
+	     &file_system_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		if( libfsapfs_file_entry_iterator_initialize(
+		     sub_file_entry_iterator,
+		     internal_file_entry->io_handle,
+		     internal_file_entry->file_io_handle,
+		     internal_file_entry->encryption_context,
+		     internal_file_entry->file_system_btree,
+		     internal_file_entry->compressed_block_cache,
+		     LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_DIRECTORY_RECORDS,
+		     file_system_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sub file entry iterator.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Determines the file extents
  * Returns 1 if successful or -1 on error
  */
@@ -4340,6 +4611,11 @@ int libfsapfs_internal_file_entry_get_data_stream(
 				compression_method = LIBFSAPFS_COMPRESSION_METHOD_LZVN;
 				break;
 
+			case 11:
+			case 12:
+				compression_method = LIBFSAPFS_COMPRESSION_METHOD_LZFSE;
+				break;
+
 			default:
 				libcerror_error_set(
 				 error,
@@ -4352,7 +4628,8 @@ int libfsapfs_internal_file_entry_get_data_stream(
 				goto on_error;
 		}
 		if( ( internal_file_entry->compressed_data_header->compression_method == 4 )
-		 || ( internal_file_entry->compressed_data_header->compression_method == 8 ) )
+		 || ( internal_file_entry->compressed_data_header->compression_method == 8 )
+		 || ( internal_file_entry->compressed_data_header->compression_method == 12 ) )
 		{
 			if( libfsapfs_attributes_get_data_stream(
 			     internal_file_entry->resource_fork_attribute_values,
@@ -4399,6 +4676,10 @@ int libfsapfs_internal_file_entry_get_data_stream(
 		     compressed_data_stream,
 		     internal_file_entry->data_size,
 		     compression_method,
+		     internal_file_entry->compressed_block_cache,
+		     internal_file_entry->inode->identifier,
+		     internal_file_entry->io_handle->worker_pool,
+		     internal_file_entry->io_handle->number_of_decompression_threads,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -4499,9 +4780,11 @@ ssize_t libfsapfs_file_entry_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle                     = NULL;
 	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsapfs_file_entry_read_buffer";
 	ssize_t read_count                                   = 0;
+	int file_io_handle_index                             = -1;
 
 	if( file_entry == NULL )
 	{
@@ -4548,10 +4831,33 @@ ssize_t libfsapfs_file_entry_read_buffer(
 		}
 	}
 	if( read_count != -1 )
+	{
+		file_io_handle = internal_file_entry->file_io_handle;
+
+		if( internal_file_entry->io_handle->file_io_handle_pool != NULL )
+		{
+			if( libfsapfs_file_io_handle_pool_grab_handle(
+			     internal_file_entry->io_handle->file_io_handle_pool,
+			     &file_io_handle,
+			     &file_io_handle_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab file IO handle from pool.",
+				 function );
+
+				read_count = -1;
+			}
+		}
+	}
+	if( read_count != -1 )
 	{
 		read_count = libfdata_stream_read_buffer(
 		              internal_file_entry->data_stream,
-		              (intptr_t *) internal_file_entry->file_io_handle,
+		              (intptr_t *) file_io_handle,
 		              (uint8_t *) buffer,
 		              buffer_size,
 		              0,
@@ -4569,6 +4875,23 @@ ssize_t libfsapfs_file_entry_read_buffer(
 			read_count = -1;
 		}
 	}
+	if( file_io_handle_index != -1 )
+	{
+		if( libfsapfs_file_io_handle_pool_release_handle(
+		     internal_file_entry->io_handle->file_io_handle_pool,
+		     file_io_handle_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle to pool.",
+			 function );
+
+			read_count = -1;
+		}
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_file_entry->read_write_lock,
@@ -4597,9 +4920,11 @@ ssize_t libfsapfs_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle                     = NULL;
 	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsapfs_file_entry_read_buffer_at_offset";
 	ssize_t read_count                                   = 0;
+	int file_io_handle_index                             = -1;
 
 	if( file_entry == NULL )
 	{
@@ -4646,10 +4971,33 @@ ssize_t libfsapfs_file_entry_read_buffer_at_offset(
 		}
 	}
 	if( read_count != -1 )
+	{
+		file_io_handle = internal_file_entry->file_io_handle;
+
+		if( internal_file_entry->io_handle->file_io_handle_pool != NULL )
+		{
+			if( libfsapfs_file_io_handle_pool_grab_handle(
+			     internal_file_entry->io_handle->file_io_handle_pool,
+			     &file_io_handle,
+			     &file_io_handle_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab file IO handle from pool.",
+				 function );
+
+				read_count = -1;
+			}
+		}
+	}
+	if( read_count != -1 )
 	{
 		read_count = libfdata_stream_read_buffer_at_offset(
 		              internal_file_entry->data_stream,
-		              (intptr_t *) internal_file_entry->file_io_handle,
+		              (intptr_t *) file_io_handle,
 		              (uint8_t *) buffer,
 		              buffer_size,
 		              offset,
@@ -4668,6 +5016,23 @@ ssize_t libfsapfs_file_entry_read_buffer_at_offset(
 			read_count = -1;
 		}
 	}
+	if( file_io_handle_index != -1 )
+	{
+		if( libfsapfs_file_io_handle_pool_release_handle(
+		     internal_file_entry->io_handle->file_io_handle_pool,
+		     file_io_handle_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle to pool.",
+			 function );
+
+			read_count = -1;
+		}
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_file_entry->read_write_lock,
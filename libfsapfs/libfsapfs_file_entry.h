@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libfsapfs_attribute_values.h"
+#include "libfsapfs_compressed_block_cache.h"
 #include "libfsapfs_compressed_data_header.h"
 #include "libfsapfs_directory_record.h"
 #include "libfsapfs_encryption_context.h"
@@ -63,6 +64,10 @@ struct libfsapfs_internal_file_entry
 	 */
 	libfsapfs_file_system_btree_t *file_system_btree;
 
+	/* The compressed block cache
+	 */
+	libfsapfs_compressed_block_cache_t *compressed_block_cache;
+
 	/* The inode
 	 */
 	libfsapfs_inode_t *inode;
@@ -128,6 +133,7 @@ int libfsapfs_file_entry_initialize(
      libbfio_handle_t *file_io_handle,
      libfsapfs_encryption_context_t *encryption_context,
      libfsapfs_file_system_btree_t *file_system_btree,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
      libfsapfs_inode_t *inode,
      libfsapfs_directory_record_t *directory_record,
      libcerror_error_t **error );
@@ -137,6 +143,13 @@ int libfsapfs_file_entry_free(
      libfsapfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+int libfsapfs_file_entry_set_btree_records(
+     libfsapfs_file_entry_t *file_entry,
+     libcdata_array_t **extended_attributes_array,
+     libcdata_array_t **directory_entries,
+     libcdata_array_t **file_extents,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_file_entry_get_identifier(
      libfsapfs_file_entry_t *file_entry,
@@ -252,6 +265,10 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
 
+int libfsapfs_internal_file_entry_determine_special_extended_attributes(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
 int libfsapfs_internal_file_entry_get_symbolic_link_data(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
@@ -372,6 +389,12 @@ int libfsapfs_file_entry_get_sub_file_entry_by_utf16_name(
      libfsapfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_file_entry_get_sub_file_entry_iterator(
+     libfsapfs_file_entry_t *file_entry,
+     libfsapfs_file_entry_iterator_t **sub_file_entry_iterator,
+     libcerror_error_t **error );
+
 int libfsapfs_internal_file_entry_get_file_extents(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
@@ -0,0 +1,1680 @@
+/*
+ * File entry iterator functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_attribute_values.h"
+#include "libfsapfs_btree_entry.h"
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_btree_node_cache.h"
+#include "libfsapfs_compressed_block_cache.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_directory_record.h"
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_entry.h"
+#include "libfsapfs_file_entry_iterator.h"
+#include "libfsapfs_file_extent.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_inode.h"
+#include "libfsapfs_io_handle.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_types.h"
+
+#include "fsapfs_file_system.h"
+
+/* Creates a file entry iterator
+ * Make sure the value file_entry_iterator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_iterator_initialize(
+     libfsapfs_file_entry_iterator_t **file_entry_iterator,
+     libfsapfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint8_t iterator_type,
+     uint64_t parent_identifier,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                                  = "libfsapfs_file_entry_iterator_initialize";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry_iterator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry iterator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( iterator_type != LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES )
+	 && ( iterator_type != LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_DIRECTORY_RECORDS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported iterator type.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = memory_allocate_structure(
+	                                libfsapfs_internal_file_entry_iterator_t );
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_file_entry_iterator,
+	     0,
+	     sizeof( libfsapfs_internal_file_entry_iterator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file entry iterator.",
+		 function );
+
+		memory_free(
+		 internal_file_entry_iterator );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_file_entry_iterator->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_file_entry_iterator->io_handle              = io_handle;
+	internal_file_entry_iterator->file_io_handle         = file_io_handle;
+	internal_file_entry_iterator->encryption_context     = encryption_context;
+	internal_file_entry_iterator->file_system_btree      = file_system_btree;
+	internal_file_entry_iterator->compressed_block_cache = compressed_block_cache;
+	internal_file_entry_iterator->iterator_type          = iterator_type;
+	internal_file_entry_iterator->parent_identifier      = parent_identifier;
+
+	*file_entry_iterator = (libfsapfs_file_entry_iterator_t *) internal_file_entry_iterator;
+
+	return( 1 );
+
+on_error:
+	if( internal_file_entry_iterator != NULL )
+	{
+		memory_free(
+		 internal_file_entry_iterator );
+	}
+	return( -1 );
+}
+
+/* Frees a file entry iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_iterator_free(
+     libfsapfs_file_entry_iterator_t **file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                                  = "libfsapfs_file_entry_iterator_free";
+	int result                                                             = 1;
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry_iterator != NULL )
+	{
+		internal_file_entry_iterator = (libfsapfs_internal_file_entry_iterator_t *) *file_entry_iterator;
+		*file_entry_iterator         = NULL;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_file_entry_iterator->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		/* The io_handle, file_io_handle, encryption_context, file_system_btree and compressed_block_cache references are freed elsewhere
+		 */
+		memory_free(
+		 internal_file_entry_iterator );
+	}
+	return( result );
+}
+
+/* Retrieves the B-tree node at a specific depth of the path to the current leaf node
+ * The node is retrieved from the node cache of the file system B-tree, which is
+ * why only the block numbers of the nodes are stored in the iterator
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_internal_file_entry_iterator_get_node(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     int node_depth,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_file_entry_iterator_get_node";
+	int result            = 0;
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry_iterator->file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry iterator - missing file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_depth < 0 )
+	 || ( node_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_depth == 0 )
+	{
+		result = libfsapfs_file_system_btree_get_root_node(
+		          internal_file_entry_iterator->file_system_btree,
+		          internal_file_entry_iterator->file_io_handle,
+		          internal_file_entry_iterator->file_system_btree->root_node_block_number,
+		          node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree root node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfsapfs_file_system_btree_get_sub_node(
+		     internal_file_entry_iterator->file_system_btree,
+		     internal_file_entry_iterator->file_io_handle,
+		     internal_file_entry_iterator->node_block_numbers[ node_depth ],
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
+			 function,
+			 internal_file_entry_iterator->node_block_numbers[ node_depth ] );
+
+			return( -1 );
+		}
+		result = 1;
+	}
+	return( result );
+}
+
+/* Positions the iterator before the first leaf node entry with a key equal to or greater than
+ * a specific identifier and data type
+ * Returns 1 if successful, 0 if the B-tree has no root node or -1 on error
+ */
+int libfsapfs_internal_file_entry_iterator_seek_key(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry       = NULL;
+	libfsapfs_btree_entry_t *lower_entry = NULL;
+	libfsapfs_btree_node_t *node         = NULL;
+	static char *function                = "libfsapfs_internal_file_entry_iterator_seek_key";
+	uint64_t file_system_identifier      = 0;
+	uint64_t file_system_sort_key        = 0;
+	uint64_t lookup_sort_key             = 0;
+	int btree_entry_index                = 0;
+	int is_leaf_node                     = 0;
+	int lower_entry_index                = 0;
+	int node_depth                       = 0;
+	int number_of_entries                = 0;
+	int result                           = 0;
+	int upper_entry_index                = 0;
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator->depth      = 0;
+	internal_file_entry_iterator->is_started = 1;
+
+	lookup_sort_key = ( identifier << 4 ) | data_type;
+
+	do
+	{
+		result = libfsapfs_internal_file_entry_iterator_get_node(
+		          internal_file_entry_iterator,
+		          node_depth,
+		          &node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node at depth: %d.",
+			 function,
+			 node_depth );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		is_leaf_node = libfsapfs_btree_node_is_leaf_node(
+		                node,
+		                error );
+
+		if( is_leaf_node == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if B-tree node is a leaf node.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_btree_node_get_number_of_entries(
+		     node,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from B-tree node.",
+			 function );
+
+			return( -1 );
+		}
+		/* Determine the first entry with a sort key equal to or greater than the lookup
+		 * sort key (upper entry) and the entry before it (lower entry).
+		 */
+		lower_entry       = NULL;
+		lower_entry_index = 0;
+		upper_entry_index = number_of_entries;
+
+		while( lower_entry_index < upper_entry_index )
+		{
+			btree_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+			if( libfsapfs_btree_node_get_entry_by_index(
+			     node,
+			     btree_entry_index,
+			     &entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve B-tree entry: %d.",
+				 function,
+				 btree_entry_index );
+
+				return( -1 );
+			}
+			if( ( entry == NULL )
+			 || ( entry->key_data == NULL )
+			 || ( entry->key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid B-tree entry: %d - key data size value out of bounds.",
+				 function,
+				 btree_entry_index );
+
+				return( -1 );
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (fsapfs_file_system_btree_key_common_t *) entry->key_data )->file_system_identifier,
+			 file_system_identifier );
+
+			file_system_sort_key = ( file_system_identifier << 4 ) | ( file_system_identifier >> 60 );
+
+			if( file_system_sort_key < lookup_sort_key )
+			{
+				lower_entry       = entry;
+				lower_entry_index = btree_entry_index + 1;
+			}
+			else
+			{
+				upper_entry_index = btree_entry_index;
+			}
+		}
+		if( is_leaf_node != 0 )
+		{
+			internal_file_entry_iterator->entry_indexes[ node_depth ] = lower_entry_index;
+			internal_file_entry_iterator->depth                       = node_depth + 1;
+
+			break;
+		}
+		/* In a branch node the entries with a smaller sort key than the lookup
+		 * sort key are skipped, the leaf node entries are skipped while iterating
+		 */
+		if( lower_entry == NULL )
+		{
+			if( number_of_entries == 0 )
+			{
+				internal_file_entry_iterator->entry_indexes[ node_depth ] = 0;
+				internal_file_entry_iterator->depth                       = node_depth + 1;
+
+				break;
+			}
+			if( libfsapfs_btree_node_get_entry_by_index(
+			     node,
+			     0,
+			     &lower_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve B-tree entry: 0.",
+				 function );
+
+				return( -1 );
+			}
+			lower_entry_index = 1;
+		}
+		if( node_depth >= LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node depth value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
+		     internal_file_entry_iterator->file_system_btree,
+		     internal_file_entry_iterator->file_io_handle,
+		     lower_entry,
+		     &( internal_file_entry_iterator->node_block_numbers[ node_depth + 1 ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sub node block number.",
+			 function );
+
+			return( -1 );
+		}
+		/* The entry index refers to the entry after the one of the sub node
+		 */
+		internal_file_entry_iterator->entry_indexes[ node_depth ] = lower_entry_index;
+
+		node_depth++;
+	}
+	while( is_leaf_node == 0 );
+
+	return( 1 );
+}
+
+/* Retrieves the next leaf node entry of the file system B-tree
+ * The B-tree entry references data of a cached B-tree node and should be
+ * used before the next B-tree node is retrieved
+ * Returns 1 if successful, 0 if no more entries or -1 on error
+ */
+int libfsapfs_internal_file_entry_iterator_get_next_btree_entry(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     libfsapfs_btree_entry_t **btree_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry = NULL;
+	libfsapfs_btree_node_t *node   = NULL;
+	static char *function          = "libfsapfs_internal_file_entry_iterator_get_next_btree_entry";
+	int entry_index                = 0;
+	int is_leaf_node               = 0;
+	int node_depth                 = 0;
+	int number_of_entries          = 0;
+	int result                     = 0;
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry_iterator->is_started == 0 )
+	{
+		internal_file_entry_iterator->entry_indexes[ 0 ] = 0;
+		internal_file_entry_iterator->depth              = 1;
+		internal_file_entry_iterator->is_started         = 1;
+	}
+	while( internal_file_entry_iterator->depth > 0 )
+	{
+		node_depth = internal_file_entry_iterator->depth - 1;
+
+		result = libfsapfs_internal_file_entry_iterator_get_node(
+		          internal_file_entry_iterator,
+		          node_depth,
+		          &node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node at depth: %d.",
+			 function,
+			 node_depth );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			internal_file_entry_iterator->depth = 0;
+
+			break;
+		}
+		is_leaf_node = libfsapfs_btree_node_is_leaf_node(
+		                node,
+		                error );
+
+		if( is_leaf_node == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if B-tree node is a leaf node.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_btree_node_get_number_of_entries(
+		     node,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from B-tree node.",
+			 function );
+
+			return( -1 );
+		}
+		entry_index = internal_file_entry_iterator->entry_indexes[ node_depth ];
+
+		if( entry_index >= number_of_entries )
+		{
+			/* Continue with the next entry of the parent node
+			 */
+			internal_file_entry_iterator->depth -= 1;
+
+			continue;
+		}
+		if( libfsapfs_btree_node_get_entry_by_index(
+		     node,
+		     entry_index,
+		     &entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		internal_file_entry_iterator->entry_indexes[ node_depth ] += 1;
+
+		if( is_leaf_node != 0 )
+		{
+			*btree_entry = entry;
+
+			return( 1 );
+		}
+		if( internal_file_entry_iterator->depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid depth value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
+		     internal_file_entry_iterator->file_system_btree,
+		     internal_file_entry_iterator->file_io_handle,
+		     entry,
+		     &( internal_file_entry_iterator->node_block_numbers[ internal_file_entry_iterator->depth ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sub node block number.",
+			 function );
+
+			return( -1 );
+		}
+		internal_file_entry_iterator->entry_indexes[ internal_file_entry_iterator->depth ] = 0;
+		internal_file_entry_iterator->depth                                                 += 1;
+	}
+	return( 0 );
+}
+
+/* Retrieves the next file entry
+ * The extended attributes, directory entries and file extents of the file entry
+ * are read from the leaf node entries that follow the inode
+ * Returns 1 if successful, 0 if no more file entries or -1 on error
+ */
+int libfsapfs_internal_file_entry_iterator_get_next_file_entry(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *directory_entries            = NULL;
+	libcdata_array_t *extended_attributes_array    = NULL;
+	libcdata_array_t *file_extents                 = NULL;
+	libfsapfs_attribute_values_t *attribute_values = NULL;
+	libfsapfs_btree_entry_t *btree_entry           = NULL;
+	libfsapfs_directory_record_t *directory_record = NULL;
+	libfsapfs_file_entry_t *safe_file_entry        = NULL;
+	libfsapfs_file_extent_t *file_extent           = NULL;
+	libfsapfs_inode_t *inode                       = NULL;
+	static char *function                          = "libfsapfs_internal_file_entry_iterator_get_next_file_entry";
+	uint64_t data_stream_identifier                = 0;
+	uint64_t file_system_identifier                = 0;
+	uint64_t inode_identifier                      = 0;
+	uint8_t file_system_data_type                  = 0;
+	int entry_index                                = 0;
+	int result                                     = 0;
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* Skip the B-tree entries up to the next inode
+	 */
+	do
+	{
+		result = libfsapfs_internal_file_entry_iterator_get_next_btree_entry(
+		          internal_file_entry_iterator,
+		          &btree_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next B-tree entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( ( btree_entry->key_data == NULL )
+		 || ( btree_entry->key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree entry - key data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
+		 file_system_identifier );
+
+		file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
+	}
+	while( file_system_data_type != LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE );
+
+	inode_identifier = file_system_identifier & 0x0fffffffffffffffUL;
+
+	if( libfsapfs_inode_initialize(
+	     &inode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create inode.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_inode_read_key_data(
+	     inode,
+	     btree_entry->key_data,
+	     (size_t) btree_entry->key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read inode key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_inode_read_value_data(
+	     inode,
+	     btree_entry->value_data,
+	     (size_t) btree_entry->value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read inode value data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading file entry: %" PRIu64 "\n",
+		 function,
+		 inode_identifier );
+	}
+#endif
+	if( libcdata_array_initialize(
+	     &extended_attributes_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extended attributes array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &directory_entries,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entries array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &file_extents,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file extents array.",
+		 function );
+
+		goto on_error;
+	}
+	/* The B-tree entries are sorted by identifier and data type, hence the extended
+	 * attributes, file extents and directory records of the inode follow the inode
+	 */
+	do
+	{
+		result = libfsapfs_internal_file_entry_iterator_get_next_btree_entry(
+		          internal_file_entry_iterator,
+		          &btree_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next B-tree entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( ( btree_entry->key_data == NULL )
+		 || ( btree_entry->key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree entry - key data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
+		 file_system_identifier );
+
+		file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
+
+		if( ( file_system_identifier & 0x0fffffffffffffffUL ) != inode_identifier )
+		{
+			/* Leave the B-tree entry of the next identifier for the next file entry,
+			 * the B-tree entry was retrieved from the current leaf node
+			 */
+			internal_file_entry_iterator->entry_indexes[ internal_file_entry_iterator->depth - 1 ] -= 1;
+
+			break;
+		}
+		switch( file_system_data_type )
+		{
+			case LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE:
+				if( libfsapfs_attribute_values_initialize(
+				     &attribute_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create attribute values.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsapfs_attribute_values_read_key_data(
+				     attribute_values,
+				     btree_entry->key_data,
+				     (size_t) btree_entry->key_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read attribute values key data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsapfs_attribute_values_read_value_data(
+				     attribute_values,
+				     btree_entry->value_data,
+				     (size_t) btree_entry->value_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read attribute values value data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libcdata_array_append_entry(
+				     extended_attributes_array,
+				     &entry_index,
+				     (intptr_t *) attribute_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append attribute values to array.",
+					 function );
+
+					goto on_error;
+				}
+				attribute_values = NULL;
+
+				break;
+
+			case LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT:
+				if( libfsapfs_file_extent_initialize(
+				     &file_extent,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create file extent.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsapfs_file_extent_read_key_data(
+				     file_extent,
+				     btree_entry->key_data,
+				     (size_t) btree_entry->key_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read file extent key data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsapfs_file_extent_read_value_data(
+				     file_extent,
+				     btree_entry->value_data,
+				     (size_t) btree_entry->value_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read file extent value data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libcdata_array_append_entry(
+				     file_extents,
+				     &entry_index,
+				     (intptr_t *) file_extent,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append file extent to array.",
+					 function );
+
+					goto on_error;
+				}
+				file_extent = NULL;
+
+				break;
+
+			case LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD:
+				if( libfsapfs_directory_record_initialize(
+				     &directory_record,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create directory record.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsapfs_directory_record_read_key_data(
+				     directory_record,
+				     btree_entry->key_data,
+				     (size_t) btree_entry->key_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read directory record key data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfsapfs_directory_record_read_value_data(
+				     directory_record,
+				     btree_entry->value_data,
+				     (size_t) btree_entry->value_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read directory record value data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libcdata_array_append_entry(
+				     directory_entries,
+				     &entry_index,
+				     (intptr_t *) directory_record,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append directory record to array.",
+					 function );
+
+					goto on_error;
+				}
+				directory_record = NULL;
+
+				break;
+
+			default:
+				break;
+		}
+	}
+	while( result != 0 );
+
+	if( libfsapfs_inode_get_data_stream_identifier(
+	     inode,
+	     &data_stream_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data stream identifier from inode.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file extents are stored with the data stream identifier, when this differs
+	 * from the inode identifier the file extents are retrieved when needed
+	 */
+	if( data_stream_identifier != inode_identifier )
+	{
+		if( libcdata_array_free(
+		     &file_extents,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file extents array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsapfs_file_entry_initialize(
+	     &safe_file_entry,
+	     internal_file_entry_iterator->io_handle,
+	     internal_file_entry_iterator->file_io_handle,
+	     internal_file_entry_iterator->encryption_context,
+	     internal_file_entry_iterator->file_system_btree,
+	     internal_file_entry_iterator->compressed_block_cache,
+	     inode,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file entry takes over management of the inode
+	 */
+	inode = NULL;
+
+	if( libfsapfs_file_entry_set_btree_records(
+	     safe_file_entry,
+	     &extended_attributes_array,
+	     &directory_entries,
+	     &file_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set B-tree records of file entry.",
+		 function );
+
+		goto on_error;
+	}
+	*file_entry = safe_file_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &safe_file_entry,
+		 NULL );
+	}
+	if( directory_record != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 &directory_record,
+		 NULL );
+	}
+	if( file_extent != NULL )
+	{
+		libfsapfs_file_extent_free(
+		 &file_extent,
+		 NULL );
+	}
+	if( attribute_values != NULL )
+	{
+		libfsapfs_attribute_values_free(
+		 &attribute_values,
+		 NULL );
+	}
+	if( file_extents != NULL )
+	{
+		libcdata_array_free(
+		 &file_extents,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
+		 NULL );
+	}
+	if( directory_entries != NULL )
+	{
+		libcdata_array_free(
+		 &directory_entries,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_directory_record_free,
+		 NULL );
+	}
+	if( extended_attributes_array != NULL )
+	{
+		libcdata_array_free(
+		 &extended_attributes_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_attribute_values_free,
+		 NULL );
+	}
+	if( inode != NULL )
+	{
+		libfsapfs_inode_free(
+		 &inode,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the next sub file entry
+ * The directory records are read from the leaf nodes one at a time, hence the
+ * directory records of the parent are not stored in memory all at once
+ * Returns 1 if successful, 0 if no more sub file entries or -1 on error
+ */
+int libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry           = NULL;
+	libfsapfs_directory_record_t *directory_record = NULL;
+	libfsapfs_inode_t *inode                       = NULL;
+	static char *function                          = "libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry";
+	uint64_t file_system_identifier                = 0;
+	uint64_t sub_file_entry_identifier             = 0;
+	uint8_t file_system_data_type                  = 0;
+	int result                                     = 0;
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry_iterator->is_started == 0 )
+	{
+		result = libfsapfs_internal_file_entry_iterator_seek_key(
+		          internal_file_entry_iterator,
+		          internal_file_entry_iterator->parent_identifier,
+		          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to seek directory records of: %" PRIu64 ".",
+			 function,
+			 internal_file_entry_iterator->parent_identifier );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	do
+	{
+		result = libfsapfs_internal_file_entry_iterator_get_next_btree_entry(
+		          internal_file_entry_iterator,
+		          &btree_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next B-tree entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( ( btree_entry->key_data == NULL )
+		 || ( btree_entry->key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree entry - key data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
+		 file_system_identifier );
+
+		file_system_data_type   = (uint8_t) ( file_system_identifier >> 60 );
+		file_system_identifier &= 0x0fffffffffffffffUL;
+
+		if( ( file_system_identifier > internal_file_entry_iterator->parent_identifier )
+		 || ( ( file_system_identifier == internal_file_entry_iterator->parent_identifier )
+		  &&  ( file_system_data_type > LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD ) ) )
+		{
+			/* Leave the B-tree entry so that subsequent calls stop at the same entry
+			 */
+			internal_file_entry_iterator->entry_indexes[ internal_file_entry_iterator->depth - 1 ] -= 1;
+
+			return( 0 );
+		}
+	}
+	while( ( file_system_identifier != internal_file_entry_iterator->parent_identifier )
+	    || ( file_system_data_type != LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD ) );
+
+	/* The directory record is read before the inode is retrieved since the inode
+	 * lookup can remove the leaf node of the B-tree entry from the cache
+	 */
+	if( libfsapfs_directory_record_initialize(
+	     &directory_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_read_key_data(
+	     directory_record,
+	     btree_entry->key_data,
+	     (size_t) btree_entry->key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory record key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_read_value_data(
+	     directory_record,
+	     btree_entry->value_data,
+	     (size_t) btree_entry->value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory record value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_get_identifier(
+	     directory_record,
+	     &sub_file_entry_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file system identifier from directory record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_get_inode_by_identifier(
+	     internal_file_entry_iterator->file_system_btree,
+	     internal_file_entry_iterator->file_io_handle,
+	     sub_file_entry_identifier,
+	     &inode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
+		 function,
+		 sub_file_entry_identifier );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_initialize(
+	     file_entry,
+	     internal_file_entry_iterator->io_handle,
+	     internal_file_entry_iterator->file_io_handle,
+	     internal_file_entry_iterator->encryption_context,
+	     internal_file_entry_iterator->file_system_btree,
+	     internal_file_entry_iterator->compressed_block_cache,
+	     inode,
+	     directory_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( directory_record != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 &directory_record,
+		 NULL );
+	}
+	if( inode != NULL )
+	{
+		libfsapfs_inode_free(
+		 &inode,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the next file entry
+ * The file entries are returned in order of their identifier or, for a directory,
+ * in order of the directory records
+ * Returns 1 if successful, 0 if no more file entries or -1 on error
+ */
+int libfsapfs_file_entry_iterator_get_next_file_entry(
+     libfsapfs_file_entry_iterator_t *file_entry_iterator,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                                  = "libfsapfs_file_entry_iterator_get_next_file_entry";
+	int access_epoch                                                       = 0;
+	int result                                                             = 0;
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libfsapfs_internal_file_entry_iterator_t *) file_entry_iterator;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry_iterator->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	result = libfsapfs_btree_node_cache_begin_access(
+	          internal_file_entry_iterator->file_system_btree->node_cache,
+	          &access_epoch,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		if( internal_file_entry_iterator->iterator_type == LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_DIRECTORY_RECORDS )
+		{
+			result = libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry(
+			          internal_file_entry_iterator,
+			          file_entry,
+			          error );
+		}
+		else
+		{
+			result = libfsapfs_internal_file_entry_iterator_get_next_file_entry(
+			          internal_file_entry_iterator,
+			          file_entry,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next file entry.",
+			 function );
+
+			result = -1;
+		}
+		if( libfsapfs_btree_node_cache_end_access(
+		     internal_file_entry_iterator->file_system_btree->node_cache,
+		     access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end node cache access.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry_iterator->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
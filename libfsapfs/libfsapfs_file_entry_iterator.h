@@ -0,0 +1,159 @@
+/*
+ * File entry iterator functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_FILE_ENTRY_ITERATOR_H )
+#define _LIBFSAPFS_FILE_ENTRY_ITERATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_btree_entry.h"
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_compressed_block_cache.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_extern.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_io_handle.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_internal_file_entry_iterator libfsapfs_internal_file_entry_iterator_t;
+
+/* The file entry iterator walks the leaf nodes of the file system B-tree
+ * in key order and returns a file entry for every inode or, for a directory,
+ * for every directory record it encounters
+ */
+struct libfsapfs_internal_file_entry_iterator
+{
+	/* The IO handle
+	 */
+	libfsapfs_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The encryption context
+	 */
+	libfsapfs_encryption_context_t *encryption_context;
+
+	/* The file system B-tree
+	 */
+	libfsapfs_file_system_btree_t *file_system_btree;
+
+	/* The compressed block cache
+	 */
+	libfsapfs_compressed_block_cache_t *compressed_block_cache;
+
+	/* The iterator type
+	 */
+	uint8_t iterator_type;
+
+	/* The parent identifier
+	 */
+	uint64_t parent_identifier;
+
+	/* The block numbers of the B-tree nodes on the path to the current leaf node
+	 * The block number of the root node is not stored
+	 */
+	uint64_t node_block_numbers[ LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH + 1 ];
+
+	/* The index of the next entry of the B-tree nodes on the path to the current leaf node
+	 */
+	int entry_indexes[ LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH + 1 ];
+
+	/* The number of B-tree nodes on the path to the current leaf node
+	 */
+	int depth;
+
+	/* Value to indicate the iterator has started
+	 */
+	uint8_t is_started;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfsapfs_file_entry_iterator_initialize(
+     libfsapfs_file_entry_iterator_t **file_entry_iterator,
+     libfsapfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libfsapfs_compressed_block_cache_t *compressed_block_cache,
+     uint8_t iterator_type,
+     uint64_t parent_identifier,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_file_entry_iterator_free(
+     libfsapfs_file_entry_iterator_t **file_entry_iterator,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_file_entry_iterator_get_node(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     int node_depth,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_file_entry_iterator_seek_key(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_file_entry_iterator_get_next_btree_entry(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     libfsapfs_btree_entry_t **btree_entry,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_file_entry_iterator_get_next_file_entry(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry(
+     libfsapfs_internal_file_entry_iterator_t *internal_file_entry_iterator,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_file_entry_iterator_get_next_file_entry(
+     libfsapfs_file_entry_iterator_t *file_entry_iterator,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_FILE_ENTRY_ITERATOR_H ) */
+
@@ -0,0 +1,579 @@
+/*
+ * The file IO handle pool functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_file_io_handle_pool.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+/* Creates a file IO handle pool
+ * Make sure the value file_io_handle_pool is referencing, is set to NULL
+ * The file IO handle is not managed by the pool, the clones of it are
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_io_handle_pool_initialize(
+     libfsapfs_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     int number_of_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_io_handle_pool_initialize";
+	int handle_index      = 0;
+	int result            = 0;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_handles < 1 )
+	 || ( number_of_handles > LIBFSAPFS_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle_pool = memory_allocate_structure(
+	                        libfsapfs_file_io_handle_pool_t );
+
+	if( *file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle_pool,
+	     0,
+	     sizeof( libfsapfs_file_io_handle_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle pool.",
+		 function );
+
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+
+		return( -1 );
+	}
+	( *file_io_handle_pool )->handles = (libbfio_handle_t **) memory_allocate(
+	                                                           sizeof( libbfio_handle_t * ) * number_of_handles );
+
+	if( ( *file_io_handle_pool )->handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *file_io_handle_pool )->handles,
+	     0,
+	     sizeof( libbfio_handle_t * ) * number_of_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle_pool )->number_of_readers = (int *) memory_allocate(
+	                                                       sizeof( int ) * number_of_handles );
+
+	if( ( *file_io_handle_pool )->number_of_readers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create number of readers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *file_io_handle_pool )->number_of_readers,
+	     0,
+	     sizeof( int ) * number_of_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear number of readers.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle_pool )->handles[ 0 ]      = file_io_handle;
+	( *file_io_handle_pool )->number_of_handles = 1;
+
+	for( handle_index = 1;
+	     handle_index < number_of_handles;
+	     handle_index++ )
+	{
+		if( libbfio_handle_clone(
+		     &( ( *file_io_handle_pool )->handles[ handle_index ] ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone file IO handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		( *file_io_handle_pool )->number_of_handles += 1;
+
+		result = libbfio_handle_is_open(
+		          ( *file_io_handle_pool )->handles[ handle_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle: %d is open.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     ( *file_io_handle_pool )->handles[ handle_index ],
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle: %d.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_io_handle_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *file_io_handle_pool != NULL )
+	{
+		libfsapfs_file_io_handle_pool_free(
+		 file_io_handle_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a file IO handle pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_io_handle_pool_free(
+     libfsapfs_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_io_handle_pool_free";
+	int handle_index      = 0;
+	int is_open           = 0;
+	int result            = 1;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle_pool != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( *file_io_handle_pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *file_io_handle_pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		/* The first file IO handle is not managed by the pool
+		 */
+		for( handle_index = 1;
+		     handle_index < ( *file_io_handle_pool )->number_of_handles;
+		     handle_index++ )
+		{
+			is_open = libbfio_handle_is_open(
+			           ( *file_io_handle_pool )->handles[ handle_index ],
+			           error );
+
+			if( is_open == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if file IO handle: %d is open.",
+				 function,
+				 handle_index );
+
+				result = -1;
+			}
+			else if( is_open != 0 )
+			{
+				if( libbfio_handle_close(
+				     ( *file_io_handle_pool )->handles[ handle_index ],
+				     error ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 "%s: unable to close file IO handle: %d.",
+					 function,
+					 handle_index );
+
+					result = -1;
+				}
+			}
+			if( libbfio_handle_free(
+			     &( ( *file_io_handle_pool )->handles[ handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle: %d.",
+				 function,
+				 handle_index );
+
+				result = -1;
+			}
+		}
+		if( ( *file_io_handle_pool )->number_of_readers != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle_pool )->number_of_readers );
+		}
+		if( ( *file_io_handle_pool )->handles != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle_pool )->handles );
+		}
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+	}
+	return( result );
+}
+
+/* Grabs a file IO handle from the pool
+ * The file IO handle with the fewest readers is handed out, where the search
+ * starts after the previously handed out file IO handle
+ * The file IO handle must be released with libfsapfs_file_io_handle_pool_release_handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_io_handle_pool_grab_handle(
+     libfsapfs_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     int *handle_index,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfsapfs_file_io_handle_pool_grab_handle";
+	int number_of_readers   = 0;
+	int safe_handle_index   = 0;
+	int search_handle_index = 0;
+	int search_index        = 0;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	safe_handle_index   = file_io_handle_pool->next_handle_index;
+	search_handle_index = safe_handle_index;
+	number_of_readers   = file_io_handle_pool->number_of_readers[ safe_handle_index ];
+
+	for( search_index = 1;
+	     ( number_of_readers > 0 ) && ( search_index < file_io_handle_pool->number_of_handles );
+	     search_index++ )
+	{
+		search_handle_index++;
+
+		if( search_handle_index >= file_io_handle_pool->number_of_handles )
+		{
+			search_handle_index = 0;
+		}
+		if( file_io_handle_pool->number_of_readers[ search_handle_index ] < number_of_readers )
+		{
+			safe_handle_index = search_handle_index;
+			number_of_readers = file_io_handle_pool->number_of_readers[ search_handle_index ];
+		}
+	}
+	file_io_handle_pool->number_of_readers[ safe_handle_index ] += 1;
+
+	file_io_handle_pool->next_handle_index = safe_handle_index + 1;
+
+	if( file_io_handle_pool->next_handle_index >= file_io_handle_pool->number_of_handles )
+	{
+		file_io_handle_pool->next_handle_index = 0;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*file_io_handle = file_io_handle_pool->handles[ safe_handle_index ];
+	*handle_index   = safe_handle_index;
+
+	return( 1 );
+}
+
+/* Releases a file IO handle grabbed from the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_io_handle_pool_release_handle(
+     libfsapfs_file_io_handle_pool_t *file_io_handle_pool,
+     int handle_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_io_handle_pool_release_handle";
+	int result            = 1;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( handle_index < 0 )
+	 || ( handle_index >= file_io_handle_pool->number_of_handles ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( file_io_handle_pool->number_of_readers[ handle_index ] <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO handle: %d - not grabbed.",
+		 function,
+		 handle_index );
+
+		result = -1;
+	}
+	else
+	{
+		file_io_handle_pool->number_of_readers[ handle_index ] -= 1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,94 @@
+/*
+ * The file IO handle pool functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_FILE_IO_HANDLE_POOL_H )
+#define _LIBFSAPFS_FILE_IO_HANDLE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_file_io_handle_pool libfsapfs_file_io_handle_pool_t;
+
+/* The file IO handle pool hands out clones of the file IO handle of a container,
+ * each with its own file descriptor and offset, so that reads of different file
+ * entries do not have to wait for each other on a single file IO handle
+ */
+struct libfsapfs_file_io_handle_pool
+{
+	/* The number of file IO handles
+	 */
+	int number_of_handles;
+
+	/* The file IO handles
+	 * The first file IO handle is the one of the container, the others are clones of it
+	 */
+	libbfio_handle_t **handles;
+
+	/* The number of readers per file IO handle
+	 */
+	int *number_of_readers;
+
+	/* The index of the file IO handle to hand out next
+	 */
+	int next_handle_index;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libfsapfs_file_io_handle_pool_initialize(
+     libfsapfs_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     int number_of_handles,
+     libcerror_error_t **error );
+
+int libfsapfs_file_io_handle_pool_free(
+     libfsapfs_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_file_io_handle_pool_grab_handle(
+     libfsapfs_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     int *handle_index,
+     libcerror_error_t **error );
+
+int libfsapfs_file_io_handle_pool_release_handle(
+     libfsapfs_file_io_handle_pool_t *file_io_handle_pool,
+     int handle_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_FILE_IO_HANDLE_POOL_H ) */
+
@@ -23,6 +23,8 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_compressed_block_cache.h"
+#include "libfsapfs_definitions.h"
 #include "libfsapfs_directory_record.h"
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_file_entry.h"
@@ -45,7 +47,8 @@ int libfsapfs_file_system_initialize(
      libfsapfs_file_system_btree_t *file_system_btree,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_file_system_initialize";
+	static char *function        = "libfsapfs_file_system_initialize";
+	int maximum_number_of_blocks = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_COMPRESSED_BLOCKS;
 
 	if( file_system == NULL )
 	{
@@ -102,6 +105,25 @@ int libfsapfs_file_system_initialize(
 
 		return( -1 );
 	}
+	if( ( io_handle != NULL )
+	 && ( io_handle->maximum_number_of_cached_compressed_blocks > 0 ) )
+	{
+		maximum_number_of_blocks = io_handle->maximum_number_of_cached_compressed_blocks;
+	}
+	if( libfsapfs_compressed_block_cache_initialize(
+	     &( ( *file_system )->compressed_block_cache ),
+	     maximum_number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compressed block cache.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBFSAPFS )
 	if( libcthreads_read_write_lock_initialize(
 	     &( ( *file_system )->read_write_lock ),
@@ -126,6 +148,12 @@ int libfsapfs_file_system_initialize(
 on_error:
 	if( *file_system != NULL )
 	{
+		if( ( *file_system )->compressed_block_cache != NULL )
+		{
+			libfsapfs_compressed_block_cache_free(
+			 &( ( *file_system )->compressed_block_cache ),
+			 NULL );
+		}
 		memory_free(
 		 *file_system );
 
@@ -173,6 +201,19 @@ int libfsapfs_file_system_free(
 				result = -1;
 			}
 		}
+		if( libfsapfs_compressed_block_cache_free(
+		     &( ( *file_system )->compressed_block_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed block cache.",
+			 function );
+
+			result = -1;
+		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBFSAPFS )
 		if( libcthreads_read_write_lock_free(
 		     &( ( *file_system )->read_write_lock ),
@@ -270,6 +311,7 @@ int libfsapfs_file_system_get_file_entry_by_identifier(
 		     file_io_handle,
 		     file_system->encryption_context,
 		     file_system->file_system_btree,
+		     file_system->compressed_block_cache,
 		     inode,
 		     NULL,
 		     error ) != 1 )
@@ -374,6 +416,7 @@ int libfsapfs_file_system_get_file_entry_by_utf8_path(
 		     file_io_handle,
 		     file_system->encryption_context,
 		     file_system->file_system_btree,
+		     file_system->compressed_block_cache,
 		     inode,
 		     directory_record,
 		     error ) != 1 )
@@ -486,6 +529,7 @@ int libfsapfs_file_system_get_file_entry_by_utf16_path(
 		     file_io_handle,
 		     file_system->encryption_context,
 		     file_system->file_system_btree,
+		     file_system->compressed_block_cache,
 		     inode,
 		     directory_record,
 		     error ) != 1 )
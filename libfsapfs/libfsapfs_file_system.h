@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_compressed_block_cache.h"
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_file_system_btree.h"
 #include "libfsapfs_io_handle.h"
@@ -53,6 +54,10 @@ struct libfsapfs_file_system
 	 */
 	libfsapfs_file_system_btree_t *file_system_btree;
 
+	/* The compressed block cache
+	 */
+	libfsapfs_compressed_block_cache_t *compressed_block_cache;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -27,6 +27,7 @@
 #include "libfsapfs_attribute_values.h"
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_node.h"
+#include "libfsapfs_btree_node_cache.h"
 #include "libfsapfs_data_block.h"
 #include "libfsapfs_debug.h"
 #include "libfsapfs_definitions.h"
@@ -40,10 +41,12 @@
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_libuna.h"
 #include "libfsapfs_name_hash.h"
+#include "libfsapfs_object.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_object_map_descriptor.h"
 
@@ -52,6 +55,7 @@
 
 /* Creates a file system B-tree
  * Make sure the value file_system_btree is referencing, is set to NULL
+ * If node_cache is NULL the B-tree creates and manages its own node cache
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_file_system_btree_initialize(
@@ -59,12 +63,15 @@ int libfsapfs_file_system_btree_initialize(
      libfsapfs_io_handle_t *io_handle,
      libfsapfs_encryption_context_t *encryption_context,
      libfdata_vector_t *data_block_vector,
+     libfsapfs_btree_node_cache_t *node_cache,
      libfsapfs_object_map_btree_t *object_map_btree,
      uint64_t root_node_block_number,
+     uint64_t transaction_identifier,
      uint8_t use_case_folding,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_file_system_btree_initialize";
+	static char *function               = "libfsapfs_file_system_btree_initialize";
+	int maximum_number_of_cache_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
 
 	if( file_system_btree == NULL )
 	{
@@ -135,25 +142,53 @@ int libfsapfs_file_system_btree_initialize(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *file_system_btree )->node_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES,
+	if( node_cache != NULL )
+	{
+		( *file_system_btree )->node_cache = node_cache;
+	}
+	else
+	{
+		if( io_handle != NULL )
+		{
+			maximum_number_of_cache_entries = io_handle->maximum_number_of_cached_btree_nodes;
+		}
+		if( libfsapfs_btree_node_cache_initialize(
+		     &( ( *file_system_btree )->node_cache ),
+		     maximum_number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create node cache.",
+			 function );
+
+			goto on_error;
+		}
+		( *file_system_btree )->node_cache_is_managed = 1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *file_system_btree )->read_write_lock ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create node cache.",
+		 "%s: unable to initialize read/write lock.",
 		 function );
 
 		goto on_error;
 	}
+#endif
 	( *file_system_btree )->io_handle              = io_handle;
 	( *file_system_btree )->encryption_context     = encryption_context;
 	( *file_system_btree )->data_block_vector      = data_block_vector;
 	( *file_system_btree )->object_map_btree       = object_map_btree;
 	( *file_system_btree )->root_node_block_number = root_node_block_number;
+	( *file_system_btree )->transaction_identifier = transaction_identifier;
 	( *file_system_btree )->use_case_folding       = use_case_folding;
 
 	return( 1 );
@@ -161,6 +196,19 @@ int libfsapfs_file_system_btree_initialize(
 on_error:
 	if( *file_system_btree != NULL )
 	{
+		if( ( ( *file_system_btree )->node_cache_is_managed != 0 )
+		 && ( ( *file_system_btree )->node_cache != NULL ) )
+		{
+			libfsapfs_btree_node_cache_free(
+			 &( ( *file_system_btree )->node_cache ),
+			 NULL );
+		}
+		if( ( *file_system_btree )->data_block_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *file_system_btree )->data_block_cache ),
+			 NULL );
+		}
 		memory_free(
 		 *file_system_btree );
 
@@ -193,20 +241,39 @@ int libfsapfs_file_system_btree_free(
 	if( *file_system_btree != NULL )
 	{
 		/* The io_handle, data_block_vector iand object_map_btree are referenced and freed elsewhere
+		 * The node cache is only freed if it is managed by the B-tree
 		 */
-		if( libfcache_cache_free(
-		     &( ( *file_system_btree )->node_cache ),
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *file_system_btree )->read_write_lock ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free node cache.",
+			 "%s: unable to free read/write lock.",
 			 function );
 
 			result = -1;
 		}
+#endif
+		if( ( *file_system_btree )->node_cache_is_managed != 0 )
+		{
+			if( libfsapfs_btree_node_cache_free(
+			     &( ( *file_system_btree )->node_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free node cache.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libfcache_cache_free(
 		     &( ( *file_system_btree )->data_block_cache ),
 		     error ) != 1 )
@@ -315,6 +382,7 @@ int libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
 	          file_system_btree->object_map_btree,
 	          file_io_handle,
 	          sub_node_object_identifier,
+	          file_system_btree->transaction_identifier,
 	          &object_map_descriptor,
 	          error );
 
@@ -380,6 +448,238 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a file system B-tree node
+ * The read/write lock is only held while the data block is retrieved, since the data block cache
+ * is shared by the readers of the B-tree. The node is read from a copy of the data block data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_read_node(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t node_block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *safe_node  = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	uint8_t *node_data                 = NULL;
+	static char *function              = "libfsapfs_file_system_btree_read_node";
+	size_t node_data_size              = 0;
+	int result                         = 1;
+
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_block_number > (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid node value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_initialize(
+	     &safe_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create B-tree node.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     file_system_btree->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		libfsapfs_btree_node_free(
+		 &safe_node,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_vector_get_element_value_by_index(
+	     file_system_btree->data_block_vector,
+	     (intptr_t *) file_io_handle,
+	     (libfdata_cache_t *) file_system_btree->data_block_cache,
+	     (int) node_block_number,
+	     (intptr_t **) &data_block,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data block: %" PRIu64 ".",
+		 function,
+		 node_block_number );
+
+		result = -1;
+	}
+	else if( data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block: %" PRIu64 ".",
+		 function,
+		 node_block_number );
+
+		result = -1;
+	}
+	/* The data block can be evicted from the data block cache once the read/write
+	 * lock is released, hence its data is copied while the lock is held
+	 */
+	if( result == 1 )
+	{
+		node_data_size = data_block->data_size;
+
+		node_data = (uint8_t *) memory_allocate(
+		                         sizeof( uint8_t ) * node_data_size );
+
+		if( node_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create node data.",
+			 function );
+
+			result = -1;
+		}
+		else if( memory_copy(
+		          node_data,
+		          data_block->data,
+		          node_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy node data.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     file_system_btree->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( ( result == 1 )
+	 && ( file_system_btree->io_handle != NULL )
+	 && ( file_system_btree->io_handle->verify_object_checksums != 0 ) )
+	{
+		if( libfsapfs_object_verify_checksum(
+		     node_data,
+		     node_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+			 "%s: unable to verify B-tree node checksum.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfsapfs_btree_node_read_data(
+		     safe_node,
+		     node_data,
+		     node_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( node_data != NULL )
+	{
+		memory_free(
+		 node_data );
+	}
+	if( result != 1 )
+	{
+		libfsapfs_btree_node_free(
+		 &safe_node,
+		 NULL );
+
+		return( -1 );
+	}
+	*node = safe_node;
+
+	return( 1 );
+}
+
 /* Retrieves the file system B-tree root node
  * Returns 1 if successful, 0 if not available or -1 on error
  */
@@ -390,14 +690,12 @@ int libfsapfs_file_system_btree_get_root_node(
      libfsapfs_btree_node_t **root_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_file_system_btree_get_root_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node     = NULL;
+	static char *function            = "libfsapfs_file_system_btree_get_root_node";
+	int result                       = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -464,12 +762,10 @@ int libfsapfs_file_system_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_btree_node_cache_get_node(
 	          file_system_btree->node_cache,
-	          0,
-	          (off64_t) root_node_block_number,
-	          0,
-	          &cache_value,
+	          root_node_block_number,
+	          root_node,
 	          error );
 
 	if( result == -1 )
@@ -478,69 +774,27 @@ int libfsapfs_file_system_btree_get_root_node(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value from cache.",
+		 "%s: unable to retrieve node from cache.",
 		 function );
 
 		goto on_error;
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
-		     file_system_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) file_system_btree->data_block_cache,
-		     (int) root_node_block_number,
-		     (intptr_t **) &data_block,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data block: %" PRIu64 ".",
-			 function,
-			 root_node_block_number );
-
-			goto on_error;
-		}
-		if( data_block == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid data block: %" PRIu64 ".",
-			 function,
-			 root_node_block_number );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_initialize(
+		if( libfsapfs_file_system_btree_read_node(
+		     file_system_btree,
+		     file_io_handle,
+		     root_node_block_number,
 		     &node,
 		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
-		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 "%s: unable to read B-tree node: %" PRIu64 ".",
+			 function,
+			 root_node_block_number );
 
 			goto on_error;
 		}
@@ -632,44 +886,23 @@ int libfsapfs_file_system_btree_get_root_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_btree_node_cache_set_node(
 		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     root_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*root_node = node;
 		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
-			 function );
-
-			goto on_error;
-		}
 	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
@@ -694,20 +927,6 @@ int libfsapfs_file_system_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve root node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -730,14 +949,12 @@ int libfsapfs_file_system_btree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_file_system_btree_get_sub_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node     = NULL;
+	static char *function            = "libfsapfs_file_system_btree_get_sub_node";
+	int result                       = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -804,12 +1021,10 @@ int libfsapfs_file_system_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_btree_node_cache_get_node(
 	          file_system_btree->node_cache,
-	          0,
-	          (off64_t) sub_node_block_number,
-	          0,
-	          &cache_value,
+	          sub_node_block_number,
+	          sub_node,
 	          error );
 
 	if( result == -1 )
@@ -818,69 +1033,27 @@ int libfsapfs_file_system_btree_get_sub_node(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value from cache.",
+		 "%s: unable to retrieve node from cache.",
 		 function );
 
 		goto on_error;
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
-		     file_system_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) file_system_btree->data_block_cache,
-		     (int) sub_node_block_number,
-		     (intptr_t **) &data_block,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data block: %" PRIu64 ".",
-			 function,
-			 sub_node_block_number );
-
-			goto on_error;
-		}
-		if( data_block == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid data block: %" PRIu64 ".",
-			 function,
-			 sub_node_block_number );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_initialize(
+		if( libfsapfs_file_system_btree_read_node(
+		     file_system_btree,
+		     file_io_handle,
+		     sub_node_block_number,
 		     &node,
 		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
-		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 "%s: unable to read B-tree node: %" PRIu64 ".",
+			 function,
+			 sub_node_block_number );
 
 			goto on_error;
 		}
@@ -922,44 +1095,23 @@ int libfsapfs_file_system_btree_get_sub_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_btree_node_cache_set_node(
 		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
-		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     &cache_value,
+		     sub_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*sub_node = node;
+		node = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
@@ -984,20 +1136,6 @@ int libfsapfs_file_system_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -1022,14 +1160,19 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
      libcerror_error_t **error )
 {
 	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
+	libfsapfs_btree_entry_t *lower_entry    = NULL;
+	libfsapfs_btree_entry_t *upper_entry    = NULL;
 	static char *function                   = "libfsapfs_file_system_btree_get_entry_from_node_by_identifier";
 	uint64_t file_system_identifier         = 0;
-	uint64_t lookup_identifier              = 0;
+	uint64_t file_system_sort_key           = 0;
+	uint64_t lookup_sort_key                = 0;
+	uint64_t upper_file_system_identifier   = 0;
 	uint8_t file_system_data_type           = 0;
 	int btree_entry_index                   = 0;
 	int is_leaf_node                        = 0;
+	int lower_entry_index                   = 0;
 	int number_of_entries                   = 0;
+	int upper_entry_index                   = 0;
 
 	if( file_system_btree == NULL )
 	{
@@ -1105,12 +1248,27 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
-	lookup_identifier = ( (uint64_t) data_type << 60 ) | identifier;
+	/* The entries are stored sorted by identifier and data type, a binary search
+	 * is used to determine the first entry with a sort key equal to or greater than
+	 * the lookup sort key (upper entry) and the entry before it (lower entry).
+	 * In a leaf node the sort key consists of the identifier and data type,
+	 * in a branch node only the identifier is used.
+	 */
+	if( is_leaf_node != 0 )
+	{
+		lookup_sort_key = ( identifier << 4 ) | data_type;
+	}
+	else
+	{
+		lookup_sort_key = identifier;
+	}
+	lower_entry_index = 0;
+	upper_entry_index = number_of_entries;
 
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
+	while( lower_entry_index < upper_entry_index )
 	{
+		btree_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
 		if( libfsapfs_btree_node_get_entry_by_index(
 		     node,
 		     btree_entry_index,
@@ -1183,39 +1341,54 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 #endif
 		if( is_leaf_node != 0 )
 		{
-			if( file_system_identifier == lookup_identifier )
-			{
-				*btree_entry = entry;
-
-				return( 1 );
-			}
+			file_system_sort_key = ( file_system_identifier << 4 ) | file_system_data_type;
+		}
+		else
+		{
+			file_system_sort_key = file_system_identifier & 0x0fffffffffffffffUL;
+		}
+		if( file_system_sort_key < lookup_sort_key )
+		{
+			lower_entry       = entry;
+			lower_entry_index = btree_entry_index + 1;
 		}
 		else
 		{
-			file_system_identifier &= 0x0fffffffffffffffUL;
+			upper_entry                  = entry;
+			upper_file_system_identifier = file_system_identifier;
+			upper_entry_index            = btree_entry_index;
+		}
+	}
+	file_system_data_type         = (uint8_t) ( upper_file_system_identifier >> 60 );
+	upper_file_system_identifier &= 0x0fffffffffffffffUL;
 
-			if( file_system_identifier >= identifier )
-			{
-				if( ( previous_entry == NULL )
-				 || ( ( file_system_identifier == identifier )
-				  &&  ( file_system_data_type <= data_type ) ) )
-				{
-					previous_entry = entry;
-				}
-				*btree_entry = previous_entry;
+	if( is_leaf_node != 0 )
+	{
+		if( ( upper_entry != NULL )
+		 && ( upper_file_system_identifier == identifier )
+		 && ( file_system_data_type == data_type ) )
+		{
+			*btree_entry = upper_entry;
 
-				return( 1 );
-			}
-			previous_entry = entry;
+			return( 1 );
 		}
+		return( 0 );
 	}
-	if( is_leaf_node == 0 )
+	/* In a branch node the upper entry is used when its identifier matches and
+	 * its data type is equal to or less than the lookup data type
+	 */
+	if( ( lower_entry == NULL )
+	 || ( ( upper_entry != NULL )
+	  &&  ( upper_file_system_identifier == identifier )
+	  &&  ( file_system_data_type <= data_type ) ) )
 	{
-		*btree_entry = previous_entry;
-
-		return( 1 );
+		*btree_entry = upper_entry;
 	}
-	return( 0 );
+	else
+	{
+		*btree_entry = lower_entry;
+	}
+	return( 1 );
 }
 
 /* Retrieves an entry for a specific identifier from the file system B-tree
@@ -3348,6 +3521,8 @@ int libfsapfs_file_system_btree_get_directory_entries(
 {
 	libfsapfs_btree_node_t *root_node = NULL;
 	static char *function             = "libfsapfs_file_system_btree_get_directory_entries";
+	int access_epoch                  = 0;
+	int access_started                = 0;
 	int is_leaf_node                  = 0;
 	int result                        = 0;
 
@@ -3395,6 +3570,24 @@ int libfsapfs_file_system_btree_get_directory_entries(
 		 parent_identifier );
 	}
 #endif
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     file_system_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_file_system_btree_get_root_node(
 	          file_system_btree,
 	          file_io_handle,
@@ -3415,6 +3608,22 @@ int libfsapfs_file_system_btree_get_directory_entries(
 	}
 	else if( result == 0 )
 	{
+		access_started = 0;
+
+		if( libfsapfs_btree_node_cache_end_access(
+		     file_system_btree->node_cache,
+		     access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end node cache access.",
+			 function );
+
+			goto on_error;
+		}
 		return( 0 );
 	}
 	if( root_node == NULL )
@@ -3498,9 +3707,32 @@ int libfsapfs_file_system_btree_get_directory_entries(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     file_system_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 file_system_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	libcdata_array_empty(
 	 directory_entries,
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_directory_record_free,
@@ -4157,6 +4389,8 @@ int libfsapfs_file_system_btree_get_attributes(
 {
 	libfsapfs_btree_node_t *root_node = NULL;
 	static char *function             = "libfsapfs_file_system_btree_get_attributes";
+	int access_epoch                  = 0;
+	int access_started                = 0;
 	int is_leaf_node                  = 0;
 	int result                        = 0;
 
@@ -4204,6 +4438,24 @@ int libfsapfs_file_system_btree_get_attributes(
 		 identifier );
 	}
 #endif
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     file_system_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_file_system_btree_get_root_node(
 	          file_system_btree,
 	          file_io_handle,
@@ -4224,6 +4476,22 @@ int libfsapfs_file_system_btree_get_attributes(
 	}
 	else if( result == 0 )
 	{
+		access_started = 0;
+
+		if( libfsapfs_btree_node_cache_end_access(
+		     file_system_btree->node_cache,
+		     access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end node cache access.",
+			 function );
+
+			goto on_error;
+		}
 		return( 0 );
 	}
 	if( root_node == NULL )
@@ -4307,9 +4575,32 @@ int libfsapfs_file_system_btree_get_attributes(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     file_system_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 file_system_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	libcdata_array_empty(
 	 extended_attributes_array,
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_attribute_values_free,
@@ -4982,6 +5273,8 @@ int libfsapfs_file_system_btree_get_file_extents(
 {
 	libfsapfs_btree_node_t *root_node = NULL;
 	static char *function             = "libfsapfs_file_system_btree_get_file_extents";
+	int access_epoch                  = 0;
+	int access_started                = 0;
 	int is_leaf_node                  = 0;
 	int result                        = 0;
 
@@ -5005,6 +5298,24 @@ int libfsapfs_file_system_btree_get_file_extents(
 		 identifier );
 	}
 #endif
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     file_system_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_file_system_btree_get_root_node(
 	          file_system_btree,
 	          file_io_handle,
@@ -5025,6 +5336,22 @@ int libfsapfs_file_system_btree_get_file_extents(
 	}
 	else if( result == 0 )
 	{
+		access_started = 0;
+
+		if( libfsapfs_btree_node_cache_end_access(
+		     file_system_btree->node_cache,
+		     access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end node cache access.",
+			 function );
+
+			goto on_error;
+		}
 		return( 0 );
 	}
 	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
@@ -5074,9 +5401,32 @@ int libfsapfs_file_system_btree_get_file_extents(
 
 		goto on_error;
 	}
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     file_system_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 file_system_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	libcdata_array_empty(
 	 file_extents,
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
@@ -5099,6 +5449,8 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 	libfsapfs_btree_node_t *btree_node   = NULL;
 	libfsapfs_inode_t *safe_inode        = NULL;
 	static char *function                = "libfsapfs_file_system_btree_get_inode_by_identifier";
+	int access_epoch                     = 0;
+	int access_started                   = 0;
 	int result                           = 0;
 
 #if defined( HAVE_PROFILER )
@@ -5167,6 +5519,24 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 		 identifier );
 	}
 #endif
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     file_system_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_file_system_btree_get_entry_by_identifier(
 	          file_system_btree,
 	          file_io_handle,
@@ -5281,9 +5651,32 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 
 	*inode = safe_inode;
 
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     file_system_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 file_system_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	if( safe_inode != NULL )
 	{
 		libfsapfs_inode_free(
@@ -5632,6 +6025,8 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_path(
 	size_t utf8_string_segment_length                   = 0;
 	uint64_t lookup_identifier                          = 0;
 	uint32_t name_hash                                  = 0;
+	int access_epoch                                    = 0;
+	int access_started                                  = 0;
 	int is_leaf_node                                    = 0;
 	int result                                          = 0;
 
@@ -5712,6 +6107,24 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_path(
 
 		return( -1 );
 	}
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     file_system_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_file_system_btree_get_root_node(
 	          file_system_btree,
 	          file_io_handle,
@@ -5732,6 +6145,22 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_path(
 	}
 	else if( result == 0 )
 	{
+		access_started = 0;
+
+		if( libfsapfs_btree_node_cache_end_access(
+		     file_system_btree->node_cache,
+		     access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end node cache access.",
+			 function );
+
+			goto on_error;
+		}
 		return( 0 );
 	}
 	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
@@ -5986,9 +6415,32 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_path(
 
 		*directory_record = safe_directory_record;
 	}
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     file_system_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 file_system_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	if( safe_directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -6343,6 +6795,8 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
 	size_t utf16_string_segment_length                  = 0;
 	uint64_t lookup_identifier                          = 0;
 	uint32_t name_hash                                  = 0;
+	int access_epoch                                    = 0;
+	int access_started                                  = 0;
 	int is_leaf_node                                    = 0;
 	int result                                          = 0;
 
@@ -6423,6 +6877,24 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
 
 		return( -1 );
 	}
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     file_system_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_file_system_btree_get_root_node(
 	          file_system_btree,
 	          file_io_handle,
@@ -6443,6 +6915,22 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
 	}
 	else if( result == 0 )
 	{
+		access_started = 0;
+
+		if( libfsapfs_btree_node_cache_end_access(
+		     file_system_btree->node_cache,
+		     access_epoch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end node cache access.",
+			 function );
+
+			goto on_error;
+		}
 		return( 0 );
 	}
 	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
@@ -6697,9 +7185,32 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
 
 		*directory_record = safe_directory_record;
 	}
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     file_system_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 file_system_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	if( safe_directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
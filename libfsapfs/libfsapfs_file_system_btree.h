@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libfsapfs_btree_node.h"
+#include "libfsapfs_btree_node_cache.h"
 #include "libfsapfs_directory_record.h"
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_inode.h"
@@ -33,6 +34,7 @@
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_object_map_btree.h"
@@ -62,8 +64,14 @@ struct libfsapfs_file_system_btree
 	libfcache_cache_t *data_block_cache;
 
 	/* The node cache
+	 * The nodes are cached by block number, which allows the cache to be shared
+	 * between the file system B-trees of a volume and its snapshots
 	 */
-	libfcache_cache_t *node_cache;
+	libfsapfs_btree_node_cache_t *node_cache;
+
+	/* Value to indicate the node cache is managed by the B-tree
+	 */
+	uint8_t node_cache_is_managed;
 
 	/* The volume object map B-tree
 	 */
@@ -73,9 +81,20 @@ struct libfsapfs_file_system_btree
 	 */
 	uint64_t root_node_block_number;
 
+	/* The transaction identifier used to look up the sub nodes in the object map B-tree
+	 */
+	uint64_t transaction_identifier;
+
 	/* Flag to indicate case folding should be used
 	 */
 	uint8_t use_case_folding;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 * The lock protects the data block cache, the node cache has its own locks
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libfsapfs_file_system_btree_initialize(
@@ -83,8 +102,10 @@ int libfsapfs_file_system_btree_initialize(
      libfsapfs_io_handle_t *io_handle,
      libfsapfs_encryption_context_t *encryption_context,
      libfdata_vector_t *data_block_vector,
+     libfsapfs_btree_node_cache_t *node_cache,
      libfsapfs_object_map_btree_t *object_map_btree,
      uint64_t root_node_block_number,
+     uint64_t transaction_identifier,
      uint8_t use_case_folding,
      libcerror_error_t **error );
 
@@ -99,6 +120,13 @@ int libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
      uint64_t *sub_node_block_number,
      libcerror_error_t **error );
 
+int libfsapfs_file_system_btree_read_node(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t node_block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
 int libfsapfs_file_system_btree_get_root_node(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
@@ -0,0 +1,804 @@
+/*
+ * The file system B-tree cursor functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_btree_entry.h"
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_btree_cursor.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+
+#include "fsapfs_file_system.h"
+
+/* Creates a file system B-tree cursor
+ * Make sure the value file_system_btree_cursor is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_initialize(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_initialize";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system_btree_cursor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system B-tree cursor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	*file_system_btree_cursor = memory_allocate_structure(
+	                             libfsapfs_file_system_btree_cursor_t );
+
+	if( *file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_system_btree_cursor,
+	     0,
+	     sizeof( libfsapfs_file_system_btree_cursor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_system_btree_cursor )->file_system_btree = file_system_btree;
+
+	return( 1 );
+
+on_error:
+	if( *file_system_btree_cursor != NULL )
+	{
+		memory_free(
+		 *file_system_btree_cursor );
+
+		*file_system_btree_cursor = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file system B-tree cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_free(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_free";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system_btree_cursor != NULL )
+	{
+		/* The file_system_btree reference is freed elsewhere
+		 */
+		if( ( *file_system_btree_cursor )->entry_data != NULL )
+		{
+			memory_free(
+			 ( *file_system_btree_cursor )->entry_data );
+		}
+		memory_free(
+		 *file_system_btree_cursor );
+
+		*file_system_btree_cursor = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the B-tree node at a specific depth of the path to the current entry
+ * The node is retrieved from the node cache of the file system B-tree, which is
+ * only valid until the next B-tree node is retrieved
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_get_node(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libbfio_handle_t *file_io_handle,
+     int node_depth,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_get_node";
+	int result            = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system B-tree cursor - missing file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_depth < 0 )
+	 || ( node_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_depth == 0 )
+	{
+		result = libfsapfs_file_system_btree_get_root_node(
+		          file_system_btree_cursor->file_system_btree,
+		          file_io_handle,
+		          file_system_btree_cursor->file_system_btree->root_node_block_number,
+		          node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree root node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfsapfs_file_system_btree_get_sub_node(
+		     file_system_btree_cursor->file_system_btree,
+		     file_io_handle,
+		     file_system_btree_cursor->node_block_numbers[ node_depth ],
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
+			 function,
+			 file_system_btree_cursor->node_block_numbers[ node_depth ] );
+
+			return( -1 );
+		}
+		result = 1;
+	}
+	return( result );
+}
+
+/* Reads the current entry of the file system B-tree
+ * For an entry of a branch node the block number of its sub node is determined
+ * Returns 1 if successful, 0 if no more entries or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_read_entry(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry = NULL;
+	libfsapfs_btree_node_t *node   = NULL;
+	uint8_t *entry_data            = NULL;
+	static char *function          = "libfsapfs_file_system_btree_cursor_read_entry";
+	size_t entry_data_size         = 0;
+	int entry_index                = 0;
+	int node_depth                 = 0;
+	int number_of_entries          = 0;
+	int result                     = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->entry_is_set != 0 )
+	{
+		return( 1 );
+	}
+	if( file_system_btree_cursor->is_started == 0 )
+	{
+		file_system_btree_cursor->entry_indexes[ 0 ] = 0;
+		file_system_btree_cursor->depth              = 1;
+		file_system_btree_cursor->is_started         = 1;
+	}
+	while( file_system_btree_cursor->depth > 0 )
+	{
+		node_depth = file_system_btree_cursor->depth - 1;
+
+		result = libfsapfs_file_system_btree_cursor_get_node(
+		          file_system_btree_cursor,
+		          file_io_handle,
+		          node_depth,
+		          &node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node at depth: %d.",
+			 function,
+			 node_depth );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			file_system_btree_cursor->depth = 0;
+
+			break;
+		}
+		if( node->node_header == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree node at depth: %d - missing node header.",
+			 function,
+			 node_depth );
+
+			return( -1 );
+		}
+		if( libfsapfs_btree_node_get_number_of_entries(
+		     node,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from B-tree node.",
+			 function );
+
+			return( -1 );
+		}
+		entry_index = file_system_btree_cursor->entry_indexes[ node_depth ];
+
+		if( entry_index >= number_of_entries )
+		{
+			/* Continue with the next entry of the parent node
+			 */
+			file_system_btree_cursor->depth -= 1;
+
+			if( file_system_btree_cursor->depth > 0 )
+			{
+				file_system_btree_cursor->entry_indexes[ node_depth - 1 ] += 1;
+			}
+			continue;
+		}
+		if( libfsapfs_btree_node_get_entry_by_index(
+		     node,
+		     entry_index,
+		     &entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( ( entry == NULL )
+		 || ( entry->key_data == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		file_system_btree_cursor->node_level            = node->node_header->level;
+		file_system_btree_cursor->sub_node_block_number = 0;
+
+		if( file_system_btree_cursor->node_level != 0 )
+		{
+			result = libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
+			          file_system_btree_cursor->file_system_btree,
+			          file_io_handle,
+			          entry,
+			          &( file_system_btree_cursor->sub_node_block_number ),
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine sub node block number.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		entry_data_size = entry->key_data_size + entry->value_data_size;
+
+		if( entry_data_size > file_system_btree_cursor->entry_data_allocated_size )
+		{
+			entry_data = (uint8_t *) memory_reallocate(
+			                          file_system_btree_cursor->entry_data,
+			                          sizeof( uint8_t ) * entry_data_size );
+
+			if( entry_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize entry data.",
+				 function );
+
+				return( -1 );
+			}
+			file_system_btree_cursor->entry_data                = entry_data;
+			file_system_btree_cursor->entry_data_allocated_size = entry_data_size;
+		}
+		if( memory_copy(
+		     file_system_btree_cursor->entry_data,
+		     entry->key_data,
+		     entry->key_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy key data.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( entry->value_data != NULL )
+		 && ( entry->value_data_size > 0 ) )
+		{
+			if( memory_copy(
+			     &( file_system_btree_cursor->entry_data[ entry->key_data_size ] ),
+			     entry->value_data,
+			     entry->value_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy value data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		file_system_btree_cursor->key_data_size   = entry->key_data_size;
+		file_system_btree_cursor->value_data_size = entry->value_data_size;
+		file_system_btree_cursor->entry_is_set    = 1;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Descends into the sub node of the current entry
+ * The cursor is positioned on the first entry of the sub node
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_descend(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_descend";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_system_btree_cursor->entry_is_set == 0 )
+	 || ( file_system_btree_cursor->node_level == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system B-tree cursor - missing current branch node entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_system_btree_cursor->node_block_numbers[ file_system_btree_cursor->depth ] = file_system_btree_cursor->sub_node_block_number;
+	file_system_btree_cursor->entry_indexes[ file_system_btree_cursor->depth ]      = 0;
+	file_system_btree_cursor->depth                                                 += 1;
+	file_system_btree_cursor->entry_is_set                                          = 0;
+
+	return( 1 );
+}
+
+/* Skips the current entry
+ * If the current entry is an entry of a branch node its entire sub tree is skipped
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_skip(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_skip";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->entry_is_set == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system B-tree cursor - missing current entry.",
+		 function );
+
+		return( -1 );
+	}
+	file_system_btree_cursor->entry_indexes[ file_system_btree_cursor->depth - 1 ] += 1;
+	file_system_btree_cursor->entry_is_set                                          = 0;
+
+	return( 1 );
+}
+
+/* Compares the name of file system B-tree key data
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER
+ */
+int libfsapfs_file_system_btree_cursor_compare_name(
+     const uint8_t *first_name,
+     size_t first_name_size,
+     const uint8_t *second_name,
+     size_t second_name_size )
+{
+	size_t name_index = 0;
+
+	for( name_index = 0;
+	     ( name_index < first_name_size ) && ( name_index < second_name_size );
+	     name_index++ )
+	{
+		if( first_name[ name_index ] < second_name[ name_index ] )
+		{
+			return( LIBCDATA_COMPARE_LESS );
+		}
+		else if( first_name[ name_index ] > second_name[ name_index ] )
+		{
+			return( LIBCDATA_COMPARE_GREATER );
+		}
+	}
+	if( first_name_size < second_name_size )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_name_size > second_name_size )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Compares file system B-tree key data
+ * The keys are ordered by identifier, data type and then by the data type specific part
+ * of the key, such as the name of an extended attribute or directory record and
+ * the logical address of a file extent
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_compare_key_data(
+     const uint8_t *first_key_data,
+     size_t first_key_data_size,
+     const uint8_t *second_key_data,
+     size_t second_key_data_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsapfs_file_system_btree_cursor_compare_key_data";
+	size_t first_data_offset    = 0;
+	size_t second_data_offset   = 0;
+	uint64_t first_value_64bit  = 0;
+	uint64_t second_value_64bit = 0;
+	uint32_t first_name_hash    = 0;
+	uint32_t second_name_hash   = 0;
+	uint16_t first_name_size    = 0;
+	uint16_t second_name_size   = 0;
+	uint8_t data_type           = 0;
+
+	if( first_key_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) )
+	 || ( first_key_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first key data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_key_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( second_key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) )
+	 || ( second_key_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid second key data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_file_system_btree_key_common_t *) first_key_data )->file_system_identifier,
+	 first_value_64bit );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_file_system_btree_key_common_t *) second_key_data )->file_system_identifier,
+	 second_value_64bit );
+
+	/* The sort key consists of the identifier followed by the data type
+	 */
+	first_value_64bit  = ( first_value_64bit << 4 ) | ( first_value_64bit >> 60 );
+	second_value_64bit = ( second_value_64bit << 4 ) | ( second_value_64bit >> 60 );
+
+	if( first_value_64bit < second_value_64bit )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_value_64bit > second_value_64bit )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	data_type          = (uint8_t) ( first_value_64bit & 0x0f );
+	first_data_offset  = sizeof( fsapfs_file_system_btree_key_common_t );
+	second_data_offset = sizeof( fsapfs_file_system_btree_key_common_t );
+
+	switch( data_type )
+	{
+		case LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE:
+			if( ( first_key_data_size < sizeof( fsapfs_file_system_btree_key_extended_attribute_t ) )
+			 || ( second_key_data_size < sizeof( fsapfs_file_system_btree_key_extended_attribute_t ) ) )
+			{
+				break;
+			}
+			first_data_offset  = sizeof( fsapfs_file_system_btree_key_extended_attribute_t );
+			second_data_offset = sizeof( fsapfs_file_system_btree_key_extended_attribute_t );
+
+			break;
+
+		case LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT:
+			if( ( first_key_data_size < sizeof( fsapfs_file_system_btree_key_file_extent_t ) )
+			 || ( second_key_data_size < sizeof( fsapfs_file_system_btree_key_file_extent_t ) ) )
+			{
+				break;
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (fsapfs_file_system_btree_key_file_extent_t *) first_key_data )->logical_address,
+			 first_value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (fsapfs_file_system_btree_key_file_extent_t *) second_key_data )->logical_address,
+			 second_value_64bit );
+
+			if( first_value_64bit < second_value_64bit )
+			{
+				return( LIBCDATA_COMPARE_LESS );
+			}
+			else if( first_value_64bit > second_value_64bit )
+			{
+				return( LIBCDATA_COMPARE_GREATER );
+			}
+			return( LIBCDATA_COMPARE_EQUAL );
+
+		case LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD:
+			if( ( first_key_data_size < sizeof( fsapfs_file_system_btree_key_directory_record_t ) )
+			 || ( second_key_data_size < sizeof( fsapfs_file_system_btree_key_directory_record_t ) ) )
+			{
+				break;
+			}
+			byte_stream_copy_to_uint16_little_endian(
+			 ( (fsapfs_file_system_btree_key_directory_record_t *) first_key_data )->name_size,
+			 first_name_size );
+
+			byte_stream_copy_to_uint16_little_endian(
+			 ( (fsapfs_file_system_btree_key_directory_record_t *) second_key_data )->name_size,
+			 second_name_size );
+
+			/* Determine if the directory record key data contains a name or a name and hash based on its size
+			 */
+			first_name_size  &= 0x03ff;
+			second_name_size &= 0x03ff;
+
+			if( ( (size_t) first_name_size < ( first_key_data_size - sizeof( fsapfs_file_system_btree_key_directory_record_t ) ) )
+			 && ( first_key_data_size >= sizeof( fsapfs_file_system_btree_key_directory_record_with_hash_t ) ) )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (fsapfs_file_system_btree_key_directory_record_with_hash_t *) first_key_data )->name_size_and_hash,
+				 first_name_hash );
+
+				first_name_hash   = ( first_name_hash & 0xfffffc00UL ) >> 10;
+				first_data_offset = sizeof( fsapfs_file_system_btree_key_directory_record_with_hash_t );
+			}
+			else
+			{
+				first_data_offset = sizeof( fsapfs_file_system_btree_key_directory_record_t );
+			}
+			if( ( (size_t) second_name_size < ( second_key_data_size - sizeof( fsapfs_file_system_btree_key_directory_record_t ) ) )
+			 && ( second_key_data_size >= sizeof( fsapfs_file_system_btree_key_directory_record_with_hash_t ) ) )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (fsapfs_file_system_btree_key_directory_record_with_hash_t *) second_key_data )->name_size_and_hash,
+				 second_name_hash );
+
+				second_name_hash   = ( second_name_hash & 0xfffffc00UL ) >> 10;
+				second_data_offset = sizeof( fsapfs_file_system_btree_key_directory_record_with_hash_t );
+			}
+			else
+			{
+				second_data_offset = sizeof( fsapfs_file_system_btree_key_directory_record_t );
+			}
+			if( first_name_hash < second_name_hash )
+			{
+				return( LIBCDATA_COMPARE_LESS );
+			}
+			else if( first_name_hash > second_name_hash )
+			{
+				return( LIBCDATA_COMPARE_GREATER );
+			}
+			break;
+
+		default:
+			break;
+	}
+	return( libfsapfs_file_system_btree_cursor_compare_name(
+	         &( first_key_data[ first_data_offset ] ),
+	         first_key_data_size - first_data_offset,
+	         &( second_key_data[ second_data_offset ] ),
+	         second_key_data_size - second_data_offset ) );
+}
+
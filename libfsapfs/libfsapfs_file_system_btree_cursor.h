@@ -0,0 +1,146 @@
+/*
+ * The file system B-tree cursor functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_FILE_SYSTEM_BTREE_CURSOR_H )
+#define _LIBFSAPFS_FILE_SYSTEM_BTREE_CURSOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_file_system_btree_cursor libfsapfs_file_system_btree_cursor_t;
+
+/* The file system B-tree cursor walks the entries of the file system B-tree
+ * in key order, where the caller decides per branch node entry to either
+ * descend into the sub node or to skip the entire sub tree
+ */
+struct libfsapfs_file_system_btree_cursor
+{
+	/* The file system B-tree
+	 */
+	libfsapfs_file_system_btree_t *file_system_btree;
+
+	/* The block numbers of the B-tree nodes on the path to the current entry
+	 * The block number of the root node is not stored
+	 */
+	uint64_t node_block_numbers[ LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH + 1 ];
+
+	/* The index of the current entry of the B-tree nodes on the path to the current entry
+	 */
+	int entry_indexes[ LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH + 1 ];
+
+	/* The number of B-tree nodes on the path to the current entry
+	 */
+	int depth;
+
+	/* Value to indicate the cursor has started
+	 */
+	uint8_t is_started;
+
+	/* Value to indicate the current entry has been read
+	 */
+	uint8_t entry_is_set;
+
+	/* The entry data
+	 * Contains a copy of the key data followed by the value data of the current entry,
+	 * since the B-tree node can be removed from the node cache by the other cursor
+	 */
+	uint8_t *entry_data;
+
+	/* The entry data allocated size
+	 */
+	size_t entry_data_allocated_size;
+
+	/* The key data size of the current entry
+	 */
+	size_t key_data_size;
+
+	/* The value data size of the current entry
+	 */
+	size_t value_data_size;
+
+	/* The level of the B-tree node that contains the current entry
+	 * A level of 0 represents a leaf node
+	 */
+	uint16_t node_level;
+
+	/* The block number of the sub node of the current entry of a branch node
+	 */
+	uint64_t sub_node_block_number;
+};
+
+int libfsapfs_file_system_btree_cursor_initialize(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_free(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_get_node(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libbfio_handle_t *file_io_handle,
+     int node_depth,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_read_entry(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_descend(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_skip(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_compare_name(
+     const uint8_t *first_name,
+     size_t first_name_size,
+     const uint8_t *second_name,
+     size_t second_name_size );
+
+int libfsapfs_file_system_btree_cursor_compare_key_data(
+     const uint8_t *first_key_data,
+     size_t first_key_data_size,
+     const uint8_t *second_key_data,
+     size_t second_key_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_FILE_SYSTEM_BTREE_CURSOR_H ) */
+
@@ -30,6 +30,7 @@
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcnotify.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_profiler.h"
@@ -157,8 +158,160 @@ int libfsapfs_file_system_data_handle_free(
 	return( 1 );
 }
 
+/* Reads a run of physically contiguous data blocks of a file extent
+ * The data blocks are read with a single read into a shared buffer and stored in the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_data_handle_read_data_block_run(
+     libfsapfs_file_system_data_handle_t *file_system_data_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfcache_cache_t *cache,
+     int element_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     int number_of_data_blocks,
+     uint64_t encryption_identifier,
+     libcerror_error_t **error )
+{
+	libfsapfs_data_block_t *data_block         = NULL;
+	libfsapfs_data_block_run_t *data_block_run = NULL;
+	static char *function                      = "libfsapfs_file_system_data_handle_read_data_block_run";
+	int data_block_index                       = 0;
+
+	if( file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_data_size == 0 )
+	 || ( element_data_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_data_block_run_initialize(
+	     &data_block_run,
+	     (size_t) element_data_size,
+	     number_of_data_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block run.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_data_block_run_read(
+	     data_block_run,
+	     file_system_data_handle->io_handle,
+	     file_system_data_handle->encryption_context,
+	     file_io_handle,
+	     element_data_offset,
+	     encryption_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block run.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_block_index = 0;
+	     data_block_index < number_of_data_blocks;
+	     data_block_index++ )
+	{
+		if( libfsapfs_data_block_run_get_data_block(
+		     data_block_run,
+		     data_block_index,
+		     &data_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data block: %d from run.",
+			 function,
+			 data_block_index );
+
+			goto on_error;
+		}
+		if( libfdata_vector_set_element_value_by_index(
+		     vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) cache,
+		     element_index + data_block_index,
+		     (intptr_t *) data_block,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_data_block_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data block: %d as element value.",
+			 function,
+			 data_block_index );
+
+			goto on_error;
+		}
+		data_block = NULL;
+	}
+	if( libfsapfs_data_block_run_free(
+	     &data_block_run,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data block run.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data_block != NULL )
+	{
+		libfsapfs_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	if( data_block_run != NULL )
+	{
+		libfsapfs_data_block_run_free(
+		 &data_block_run,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads a data block
  * Callback function for a data block vector
+ * If the data block is part of a file extent the physically contiguous data blocks
+ * that follow it are read as well, up to the number of cache entries
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_file_system_data_handle_read_data_block(
@@ -177,8 +330,11 @@ int libfsapfs_file_system_data_handle_read_data_block(
 	libfsapfs_data_block_t *data_block   = NULL;
 	libfsapfs_file_extent_t *file_extent = NULL;
 	static char *function                = "libfsapfs_file_system_data_handle_read_data_block";
+	off64_t file_extent_end_offset       = 0;
 	uint64_t encryption_identifier       = 0;
 	int64_t file_extent_offset           = 0;
+	int maximum_number_of_data_blocks    = 0;
+	int number_of_data_blocks            = 1;
 
 #if defined( HAVE_PROFILER )
 	int64_t profiler_start_timestamp     = 0;
@@ -208,31 +364,18 @@ int libfsapfs_file_system_data_handle_read_data_block(
 
 		return( -1 );
 	}
-	if( element_data_size > (size64_t) SSIZE_MAX )
+	if( ( element_data_size == 0 )
+	 || ( element_data_size > (size64_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfsapfs_data_block_initialize(
-	     &data_block,
-	     (size_t) element_data_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data block.",
-		 function );
-
-		goto on_error;
-	}
 #if defined( HAVE_PROFILER )
 	if( file_system_data_handle->io_handle->profiler != NULL )
 	{
@@ -253,8 +396,87 @@ int libfsapfs_file_system_data_handle_read_data_block(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
+	if( ( ( element_data_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 )
+	 && ( file_system_data_handle->file_extents != NULL ) )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     file_system_data_handle->file_extents,
+		     element_data_file_index,
+		     (intptr_t **) &file_extent,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file extent: %d.",
+			 function,
+			 element_data_file_index );
+
+			goto on_error;
+		}
+		if( file_extent == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing file extent: %d.",
+			 function,
+			 element_data_file_index );
+
+			goto on_error;
+		}
+		if( libfcache_cache_get_number_of_entries(
+		     cache,
+		     &maximum_number_of_data_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of cache entries.",
+			 function );
+
+			goto on_error;
+		}
+		file_extent_end_offset = (off64_t) ( ( file_extent->physical_block_number * file_system_data_handle->io_handle->block_size ) + file_extent->data_size );
+
+		if( element_data_offset < file_extent_end_offset )
+		{
+			number_of_data_blocks = (int) ( ( file_extent_end_offset - element_data_offset ) / element_data_size );
+		}
+		if( ( file_system_data_handle->read_ahead_number_of_blocks > 0 )
+		 && ( file_system_data_handle->read_ahead_number_of_blocks < maximum_number_of_data_blocks ) )
+		{
+			maximum_number_of_data_blocks = file_system_data_handle->read_ahead_number_of_blocks;
+		}
+		if( number_of_data_blocks > maximum_number_of_data_blocks )
+		{
+			number_of_data_blocks = maximum_number_of_data_blocks;
+		}
+		if( number_of_data_blocks < 1 )
+		{
+			number_of_data_blocks = 1;
+		}
+	}
 	if( ( element_data_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
 	{
+		if( libfsapfs_data_block_initialize(
+		     &data_block,
+		     (size_t) element_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data block.",
+			 function );
+
+			goto on_error;
+		}
 		if( libfsapfs_data_block_clear_data(
 		     data_block,
 		     error ) != 1 )
@@ -273,56 +495,69 @@ int libfsapfs_file_system_data_handle_read_data_block(
 	{
 		encryption_identifier = element_data_offset / element_data_size;
 
-		if( file_system_data_handle->file_extents != NULL )
+		if( file_extent != NULL )
+		{
+			file_extent_offset    = (int64_t) encryption_identifier - (int64_t) file_extent->physical_block_number;
+			encryption_identifier = file_extent->encryption_identifier + file_extent_offset;
+		}
+		if( number_of_data_blocks > 1 )
 		{
-			if( libcdata_array_get_entry_by_index(
-			     file_system_data_handle->file_extents,
-			     element_data_file_index,
-			     (intptr_t **) &file_extent,
+			if( libfsapfs_file_system_data_handle_read_data_block_run(
+			     file_system_data_handle,
+			     file_io_handle,
+			     vector,
+			     cache,
+			     element_index,
+			     element_data_offset,
+			     element_data_size,
+			     number_of_data_blocks,
+			     encryption_identifier,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve file extent: %d.",
-				 function,
-				 element_data_file_index );
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read run of data blocks.",
+				 function );
 
 				goto on_error;
 			}
-			if( file_extent == NULL )
+		}
+		else
+		{
+			if( libfsapfs_data_block_initialize(
+			     &data_block,
+			     (size_t) element_data_size,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing file extent: %d.",
-				 function,
-				 element_data_file_index );
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create data block.",
+				 function );
 
 				goto on_error;
 			}
-			file_extent_offset    = (int64_t) encryption_identifier - (int64_t) file_extent->physical_block_number;
-			encryption_identifier = file_extent->encryption_identifier + file_extent_offset;
-		}
-		if( libfsapfs_data_block_read(
-		     data_block,
-		     file_system_data_handle->io_handle,
-		     file_system_data_handle->encryption_context,
-		     file_io_handle,
-		     element_data_offset,
-		     encryption_identifier,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data block.",
-			 function );
+			if( libfsapfs_data_block_read(
+			     data_block,
+			     file_system_data_handle->io_handle,
+			     file_system_data_handle->encryption_context,
+			     file_io_handle,
+			     element_data_offset,
+			     encryption_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data block.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 	}
 #if defined( HAVE_PROFILER )
@@ -333,7 +568,7 @@ int libfsapfs_file_system_data_handle_read_data_block(
 		     profiler_start_timestamp,
 		     function,
 		     element_data_offset,
-		     element_data_size,
+		     element_data_size * number_of_data_blocks,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -348,24 +583,27 @@ int libfsapfs_file_system_data_handle_read_data_block(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfdata_vector_set_element_value_by_index(
-	     vector,
-	     (intptr_t *) file_io_handle,
-	     (libfdata_cache_t *) cache,
-	     element_index,
-	     (intptr_t *) data_block,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_data_block_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-	     error ) != 1 )
+	if( data_block != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data block as element value.",
-		 function );
+		if( libfdata_vector_set_element_value_by_index(
+		     vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) cache,
+		     element_index,
+		     (intptr_t *) data_block,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_data_block_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data block as element value.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	return( 1 );
 
@@ -378,4 +616,3 @@ on_error:
 	}
 	return( -1 );
 }
-
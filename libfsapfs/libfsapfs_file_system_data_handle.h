@@ -52,6 +52,10 @@ struct libfsapfs_file_system_data_handle
 	/* The file extents
 	 */
 	libcdata_array_t *file_extents;
+
+	/* The number of data blocks to read ahead, where 0 represents the number of cache entries
+	 */
+	int read_ahead_number_of_blocks;
 };
 
 int libfsapfs_file_system_data_handle_initialize(
@@ -65,6 +69,18 @@ int libfsapfs_file_system_data_handle_free(
      libfsapfs_file_system_data_handle_t **file_system_data_handle,
      libcerror_error_t **error );
 
+int libfsapfs_file_system_data_handle_read_data_block_run(
+     libfsapfs_file_system_data_handle_t *file_system_data_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfcache_cache_t *cache,
+     int element_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     int number_of_data_blocks,
+     uint64_t encryption_identifier,
+     libcerror_error_t **error );
+
 int libfsapfs_file_system_data_handle_read_data_block(
      libfsapfs_file_system_data_handle_t *file_system_data_handle,
      libbfio_handle_t *file_io_handle,
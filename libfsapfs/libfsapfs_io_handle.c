@@ -23,9 +23,13 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_definitions.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_object_map_descriptor_cache.h"
 #include "libfsapfs_profiler.h"
+#include "libfsapfs_worker_pool.h"
 
 const char fsapfs_container_signature[ 4 ] = "NXSB";
 const char fsapfs_volume_signature[ 4 ]    = "APSB";
@@ -125,14 +129,63 @@ int libfsapfs_io_handle_initialize(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	( *io_handle )->bytes_per_sector = 512;
-	( *io_handle )->block_size       = 4096;
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->data_block_cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize data block cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_worker_pool_initialize(
+	     &( ( *io_handle )->worker_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize worker pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *io_handle )->bytes_per_sector                                = 512;
+	( *io_handle )->block_size                                      = 4096;
+	( *io_handle )->maximum_number_of_cached_btree_nodes            = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
+	( *io_handle )->maximum_number_of_cached_data_blocks            = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_SHARED_DATA_BLOCKS;
+	( *io_handle )->maximum_number_of_cached_compressed_blocks      = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_COMPRESSED_BLOCKS;
+	( *io_handle )->maximum_number_of_cached_object_map_descriptors = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_OBJECT_MAP_DESCRIPTORS;
+	( *io_handle )->number_of_decryption_threads                    = 1;
+	( *io_handle )->number_of_decompression_threads                 = 1;
+	( *io_handle )->number_of_file_io_handles                       = 1;
 
 	return( 1 );
 
 on_error:
 	if( *io_handle != NULL )
 	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( *io_handle )->worker_pool != NULL )
+		{
+			libfsapfs_worker_pool_free(
+			 &( ( *io_handle )->worker_pool ),
+			 NULL );
+		}
+		if( ( *io_handle )->data_block_cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *io_handle )->data_block_cache_mutex ),
+			 NULL );
+		}
+#endif
 #if defined( HAVE_PROFILER )
 		if( ( *io_handle )->profiler != NULL )
 		{
@@ -201,6 +254,34 @@ int libfsapfs_io_handle_free(
 		}
 #endif /* defined( HAVE_PROFILER ) */
 
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libfsapfs_worker_pool_free(
+		     &( ( *io_handle )->worker_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free worker pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->data_block_cache_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data block cache mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -216,8 +297,22 @@ int libfsapfs_io_handle_clear(
      libfsapfs_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function          = "libfsapfs_io_handle_clear";
-
+	static char *function                               = "libfsapfs_io_handle_clear";
+	int maximum_number_of_cached_btree_nodes            = 0;
+	int maximum_number_of_cached_compressed_blocks      = 0;
+	int maximum_number_of_cached_data_blocks            = 0;
+	int maximum_number_of_cached_object_map_descriptors = 0;
+	int io_uring_queue_depth                            = 0;
+	int number_of_decompression_threads                 = 0;
+	int number_of_decryption_threads                    = 0;
+	int number_of_file_io_handles                       = 0;
+	uint8_t lazy_volume_open                            = 0;
+	uint8_t verify_object_checksums                     = 0;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_t *data_block_cache_mutex         = NULL;
+	libfsapfs_worker_pool_t *worker_pool                = NULL;
+#endif
 #if defined( HAVE_PROFILER )
 	libfsapfs_profiler_t *profiler = NULL;
 #endif
@@ -233,9 +328,26 @@ int libfsapfs_io_handle_clear(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	data_block_cache_mutex = io_handle->data_block_cache_mutex;
+	worker_pool            = io_handle->worker_pool;
+#endif
 #if defined( HAVE_PROFILER )
 	profiler = io_handle->profiler;
 #endif
+	/* The cache, decryption, decompression, file IO, io_uring, verification and lazy volume open settings are set by the user and are retained
+	 */
+	maximum_number_of_cached_btree_nodes            = io_handle->maximum_number_of_cached_btree_nodes;
+	maximum_number_of_cached_data_blocks            = io_handle->maximum_number_of_cached_data_blocks;
+	maximum_number_of_cached_compressed_blocks      = io_handle->maximum_number_of_cached_compressed_blocks;
+	maximum_number_of_cached_object_map_descriptors = io_handle->maximum_number_of_cached_object_map_descriptors;
+	number_of_decryption_threads                    = io_handle->number_of_decryption_threads;
+	number_of_decompression_threads                 = io_handle->number_of_decompression_threads;
+	number_of_file_io_handles                       = io_handle->number_of_file_io_handles;
+	io_uring_queue_depth                            = io_handle->io_uring_queue_depth;
+	verify_object_checksums                         = io_handle->verify_object_checksums;
+	lazy_volume_open                                = io_handle->lazy_volume_open;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -250,12 +362,382 @@ int libfsapfs_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->bytes_per_sector = 512;
-	io_handle->block_size       = 4096;
-
+	io_handle->bytes_per_sector                                = 512;
+	io_handle->block_size                                      = 4096;
+	io_handle->maximum_number_of_cached_btree_nodes            = maximum_number_of_cached_btree_nodes;
+	io_handle->maximum_number_of_cached_data_blocks            = maximum_number_of_cached_data_blocks;
+	io_handle->maximum_number_of_cached_compressed_blocks      = maximum_number_of_cached_compressed_blocks;
+	io_handle->maximum_number_of_cached_object_map_descriptors = maximum_number_of_cached_object_map_descriptors;
+	io_handle->number_of_decryption_threads                    = number_of_decryption_threads;
+	io_handle->number_of_decompression_threads                 = number_of_decompression_threads;
+	io_handle->number_of_file_io_handles                       = number_of_file_io_handles;
+	io_handle->io_uring_queue_depth                            = io_uring_queue_depth;
+	io_handle->verify_object_checksums                         = verify_object_checksums;
+	io_handle->lazy_volume_open                                = lazy_volume_open;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	io_handle->data_block_cache_mutex = data_block_cache_mutex;
+	io_handle->worker_pool            = worker_pool;
+#endif
 #if defined( HAVE_PROFILER )
 	io_handle->profiler = profiler;
 #endif
 	return( 1 );
 }
 
+/* Retrieves the maximum size of a specific cache
+ * The size is an estimate in bytes based on the block size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_get_maximum_cache_size(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_get_maximum_cache_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+	switch( cache_type )
+	{
+		case LIBFSAPFS_CACHE_TYPE_BTREE_NODES:
+			*maximum_cache_size = (size64_t) io_handle->maximum_number_of_cached_btree_nodes * io_handle->block_size;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS:
+			*maximum_cache_size = (size64_t) io_handle->maximum_number_of_cached_data_blocks * io_handle->block_size;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_COMPRESSED_BLOCKS:
+			*maximum_cache_size = (size64_t) io_handle->maximum_number_of_cached_compressed_blocks * LIBFSAPFS_COMPRESSED_BLOCK_SIZE;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_OBJECT_MAP_DESCRIPTORS:
+			*maximum_cache_size = (size64_t) io_handle->maximum_number_of_cached_object_map_descriptors * sizeof( libfsapfs_object_map_descriptor_cache_entry_t );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported cache type: %d.",
+			 function,
+			 cache_type );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the maximum size of a specific cache
+ * The size is converted into a number of cache entries of the block size,
+ * of the compressed block size for the compressed block cache or of the cache
+ * entry size for the object map descriptor cache,
+ * where a cache always contains at least 1 and at most LIBFSAPFS_MAXIMUM_NUMBER_OF_CACHE_ENTRIES entries
+ * The maximum number of cached data blocks is shared by the data block caches of all data streams
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_set_maximum_cache_size(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libfsapfs_io_handle_set_maximum_cache_size";
+	size64_t number_of_cache_entries = 0;
+	size_t cache_entry_size          = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing block size.",
+		 function );
+
+		return( -1 );
+	}
+	switch( cache_type )
+	{
+		case LIBFSAPFS_CACHE_TYPE_BTREE_NODES:
+		case LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS:
+			cache_entry_size = (size_t) io_handle->block_size;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_COMPRESSED_BLOCKS:
+			cache_entry_size = LIBFSAPFS_COMPRESSED_BLOCK_SIZE;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_OBJECT_MAP_DESCRIPTORS:
+			cache_entry_size = sizeof( libfsapfs_object_map_descriptor_cache_entry_t );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported cache type: %d.",
+			 function,
+			 cache_type );
+
+			return( -1 );
+	}
+	number_of_cache_entries = maximum_cache_size / cache_entry_size;
+
+	if( number_of_cache_entries == 0 )
+	{
+		number_of_cache_entries = 1;
+	}
+	else if( number_of_cache_entries > (size64_t) LIBFSAPFS_MAXIMUM_NUMBER_OF_CACHE_ENTRIES )
+	{
+		number_of_cache_entries = (size64_t) LIBFSAPFS_MAXIMUM_NUMBER_OF_CACHE_ENTRIES;
+	}
+	switch( cache_type )
+	{
+		case LIBFSAPFS_CACHE_TYPE_BTREE_NODES:
+			io_handle->maximum_number_of_cached_btree_nodes = (int) number_of_cache_entries;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS:
+			io_handle->maximum_number_of_cached_data_blocks = (int) number_of_cache_entries;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_COMPRESSED_BLOCKS:
+			io_handle->maximum_number_of_cached_compressed_blocks = (int) number_of_cache_entries;
+			break;
+
+		case LIBFSAPFS_CACHE_TYPE_OBJECT_MAP_DESCRIPTORS:
+			io_handle->maximum_number_of_cached_object_map_descriptors = (int) number_of_cache_entries;
+			break;
+	}
+	return( 1 );
+}
+
+/* Reserves data block cache entries from the maximum number of cached data blocks
+ * The maximum is shared by the data block caches of all data streams that use the IO handle
+ * Fewer entries than requested are reserved when the maximum would be exceeded,
+ * but never fewer than the minimum number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_reserve_cached_data_blocks(
+     libfsapfs_io_handle_t *io_handle,
+     int requested_number_of_data_blocks,
+     int minimum_number_of_data_blocks,
+     int *number_of_data_blocks,
+     libcerror_error_t **error )
+{
+	static char *function               = "libfsapfs_io_handle_reserve_cached_data_blocks";
+	int available_number_of_data_blocks = 0;
+	int reserved_number_of_data_blocks  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( requested_number_of_data_blocks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid requested number of data blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( minimum_number_of_data_blocks < 0 )
+	 || ( minimum_number_of_data_blocks > requested_number_of_data_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid minimum number of data blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_data_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of data blocks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->data_block_cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab data block cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( io_handle->number_of_cached_data_blocks < io_handle->maximum_number_of_cached_data_blocks )
+	{
+		available_number_of_data_blocks = io_handle->maximum_number_of_cached_data_blocks - io_handle->number_of_cached_data_blocks;
+	}
+	reserved_number_of_data_blocks = requested_number_of_data_blocks;
+
+	if( reserved_number_of_data_blocks > available_number_of_data_blocks )
+	{
+		reserved_number_of_data_blocks = available_number_of_data_blocks;
+	}
+	if( reserved_number_of_data_blocks < minimum_number_of_data_blocks )
+	{
+		reserved_number_of_data_blocks = minimum_number_of_data_blocks;
+	}
+	if( reserved_number_of_data_blocks > ( INT_MAX - io_handle->number_of_cached_data_blocks ) )
+	{
+		reserved_number_of_data_blocks = 0;
+	}
+	io_handle->number_of_cached_data_blocks += reserved_number_of_data_blocks;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->data_block_cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release data block cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_data_blocks = reserved_number_of_data_blocks;
+
+	return( 1 );
+}
+
+/* Releases data block cache entries previously reserved from the maximum number of cached data blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_release_cached_data_blocks(
+     libfsapfs_io_handle_t *io_handle,
+     int number_of_data_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_release_cached_data_blocks";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_data_blocks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of data blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->data_block_cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab data block cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Clearing the IO handle resets the number of cached data blocks
+	 * hence it can be smaller than the number released
+	 */
+	if( number_of_data_blocks < io_handle->number_of_cached_data_blocks )
+	{
+		io_handle->number_of_cached_data_blocks -= number_of_data_blocks;
+	}
+	else
+	{
+		io_handle->number_of_cached_data_blocks = 0;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->data_block_cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release data block cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -25,8 +25,12 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_file_io_handle_pool.h"
+#include "libfsapfs_io_uring.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_profiler.h"
+#include "libfsapfs_worker_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -51,6 +55,73 @@ struct libfsapfs_io_handle
 	 */
 	size64_t container_size;
 
+	/* The maximum number of cached B-tree nodes
+	 */
+	int maximum_number_of_cached_btree_nodes;
+
+	/* The maximum number of cached data blocks
+	 * The maximum is shared by the data block caches of all data streams
+	 */
+	int maximum_number_of_cached_data_blocks;
+
+	/* The number of data blocks cached by the data streams
+	 */
+	int number_of_cached_data_blocks;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The data block cache mutex
+	 */
+	libcthreads_mutex_t *data_block_cache_mutex;
+#endif
+
+	/* The maximum number of cached (uncompressed) compressed blocks
+	 */
+	int maximum_number_of_cached_compressed_blocks;
+
+	/* The maximum number of cached object map descriptors
+	 */
+	int maximum_number_of_cached_object_map_descriptors;
+
+	/* The number of threads used to decrypt data
+	 */
+	int number_of_decryption_threads;
+
+	/* The number of threads used to decompress data
+	 */
+	int number_of_decompression_threads;
+
+	/* The worker pool used to decrypt and decompress data
+	 * The worker pool is owned by the container and shared with its volumes
+	 */
+	libfsapfs_worker_pool_t *worker_pool;
+
+	/* The number of file IO handles used to read data
+	 */
+	int number_of_file_io_handles;
+
+	/* The file IO handle pool
+	 * The pool is owned by the container and only set when more than 1 file IO handle is used
+	 */
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool;
+
+	/* The io_uring queue depth, where 0 represents io_uring is not used
+	 */
+	int io_uring_queue_depth;
+
+	/* The io_uring
+	 * The io_uring is owned by the container and only set when the kernel supports io_uring
+	 */
+	libfsapfs_io_uring_t *io_uring;
+
+	/* Value to indicate the checksum of metadata objects should be verified when they are read
+	 */
+	uint8_t verify_object_checksums;
+
+	/* Value to indicate volumes should be opened lazily
+	 * The snapshots and volume key bag are then read on first use
+	 */
+	uint8_t lazy_volume_open;
+
 #if defined( HAVE_PROFILER )
 	/* The profiler
 	 */
@@ -74,6 +145,30 @@ int libfsapfs_io_handle_clear(
      libfsapfs_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libfsapfs_io_handle_get_maximum_cache_size(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_set_maximum_cache_size(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_reserve_cached_data_blocks(
+     libfsapfs_io_handle_t *io_handle,
+     int requested_number_of_data_blocks,
+     int minimum_number_of_data_blocks,
+     int *number_of_data_blocks,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_release_cached_data_blocks(
+     libfsapfs_io_handle_t *io_handle,
+     int number_of_data_blocks,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
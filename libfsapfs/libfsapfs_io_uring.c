@@ -0,0 +1,936 @@
+/*
+ * The io_uring read functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_io_uring.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+
+/* Sets up the submission and completion queues
+ * Returns 1 if successful, 0 if not supported by the kernel or -1 on error
+ */
+int libfsapfs_io_uring_setup(
+     libfsapfs_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	struct io_uring_params parameters;
+
+	static char *function = "libfsapfs_io_uring_setup";
+	void *mapped_memory   = NULL;
+	int ring_descriptor   = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &parameters,
+	     0,
+	     sizeof( struct io_uring_params ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parameters.",
+		 function );
+
+		return( -1 );
+	}
+	ring_descriptor = (int) syscall(
+	                         __NR_io_uring_setup,
+	                         io_uring->queue_depth,
+	                         &parameters );
+
+	if( ring_descriptor < 0 )
+	{
+		/* The kernel does not support io_uring or its use is not permitted
+		 */
+		return( 0 );
+	}
+	io_uring->ring_descriptor = ring_descriptor;
+
+	io_uring->submission_queue_ring_size = parameters.sq_off.array + ( parameters.sq_entries * sizeof( uint32_t ) );
+	io_uring->completion_queue_ring_size = parameters.cq_off.cqes + ( parameters.cq_entries * sizeof( struct io_uring_cqe ) );
+
+	if( ( parameters.features & IORING_FEAT_SINGLE_MMAP ) != 0 )
+	{
+		if( io_uring->completion_queue_ring_size > io_uring->submission_queue_ring_size )
+		{
+			io_uring->submission_queue_ring_size = io_uring->completion_queue_ring_size;
+		}
+		io_uring->completion_queue_ring_size = 0;
+	}
+	mapped_memory = mmap(
+	                 NULL,
+	                 io_uring->submission_queue_ring_size,
+	                 PROT_READ | PROT_WRITE,
+	                 MAP_SHARED | MAP_POPULATE,
+	                 ring_descriptor,
+	                 IORING_OFF_SQ_RING );
+
+	if( mapped_memory == MAP_FAILED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to map submission queue ring.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->submission_queue_ring = (uint8_t *) mapped_memory;
+
+	if( io_uring->completion_queue_ring_size == 0 )
+	{
+		io_uring->completion_queue_ring = io_uring->submission_queue_ring;
+	}
+	else
+	{
+		mapped_memory = mmap(
+		                 NULL,
+		                 io_uring->completion_queue_ring_size,
+		                 PROT_READ | PROT_WRITE,
+		                 MAP_SHARED | MAP_POPULATE,
+		                 ring_descriptor,
+		                 IORING_OFF_CQ_RING );
+
+		if( mapped_memory == MAP_FAILED )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to map completion queue ring.",
+			 function );
+
+			goto on_error;
+		}
+		io_uring->completion_queue_ring = (uint8_t *) mapped_memory;
+	}
+	io_uring->submission_queue_entries_size = parameters.sq_entries * sizeof( struct io_uring_sqe );
+
+	mapped_memory = mmap(
+	                 NULL,
+	                 io_uring->submission_queue_entries_size,
+	                 PROT_READ | PROT_WRITE,
+	                 MAP_SHARED | MAP_POPULATE,
+	                 ring_descriptor,
+	                 IORING_OFF_SQES );
+
+	if( mapped_memory == MAP_FAILED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to map submission queue entries.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->submission_queue_entries = (uint8_t *) mapped_memory;
+
+	io_uring->submission_queue_head      = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.head ] );
+	io_uring->submission_queue_tail      = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.tail ] );
+	io_uring->submission_queue_ring_mask = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.ring_mask ] );
+	io_uring->submission_queue_array     = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.array ] );
+	io_uring->completion_queue_head      = (uint32_t *) &( io_uring->completion_queue_ring[ parameters.cq_off.head ] );
+	io_uring->completion_queue_tail      = (uint32_t *) &( io_uring->completion_queue_ring[ parameters.cq_off.tail ] );
+	io_uring->completion_queue_ring_mask = (uint32_t *) &( io_uring->completion_queue_ring[ parameters.cq_off.ring_mask ] );
+	io_uring->completion_queue_entries   = &( io_uring->completion_queue_ring[ parameters.cq_off.cqes ] );
+
+	/* The kernel can round up the number of entries
+	 */
+	io_uring->queue_depth = parameters.sq_entries;
+
+	return( 1 );
+
+on_error:
+	if( io_uring->submission_queue_entries != NULL )
+	{
+		munmap(
+		 io_uring->submission_queue_entries,
+		 io_uring->submission_queue_entries_size );
+
+		io_uring->submission_queue_entries = NULL;
+	}
+	if( ( io_uring->completion_queue_ring != NULL )
+	 && ( io_uring->completion_queue_ring != io_uring->submission_queue_ring ) )
+	{
+		munmap(
+		 io_uring->completion_queue_ring,
+		 io_uring->completion_queue_ring_size );
+	}
+	io_uring->completion_queue_ring = NULL;
+
+	if( io_uring->submission_queue_ring != NULL )
+	{
+		munmap(
+		 io_uring->submission_queue_ring,
+		 io_uring->submission_queue_ring_size );
+
+		io_uring->submission_queue_ring = NULL;
+	}
+	close(
+	 ring_descriptor );
+
+	io_uring->ring_descriptor = -1;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * The file is opened a second time, for reading only, and shared by all the reads submitted to the ring
+ * Returns 1 if successful, 0 if io_uring is not supported or -1 on error
+ */
+int libfsapfs_io_uring_initialize(
+     libfsapfs_io_uring_t **io_uring,
+     const char *filename,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_uring_initialize";
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+	int result            = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth < 1 )
+	 || ( queue_depth > LIBFSAPFS_MAXIMUM_IO_URING_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+	*io_uring = memory_allocate_structure(
+	             libfsapfs_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libfsapfs_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		return( -1 );
+	}
+	( *io_uring )->file_descriptor = -1;
+	( *io_uring )->ring_descriptor = -1;
+	( *io_uring )->queue_depth     = (uint32_t) queue_depth;
+
+	result = libfsapfs_io_uring_setup(
+	          *io_uring,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to set up io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		return( 0 );
+	}
+	( *io_uring )->file_descriptor = open(
+	                                  filename,
+	                                  O_RDONLY | O_CLOEXEC );
+
+	if( ( *io_uring )->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_uring )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		libfsapfs_io_uring_free(
+		 io_uring,
+		 NULL );
+	}
+	return( -1 );
+
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+}
+
+/* Frees an io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_uring_free(
+     libfsapfs_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_uring_free";
+	int result            = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( *io_uring )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *io_uring )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+		if( ( *io_uring )->submission_queue_entries != NULL )
+		{
+			munmap(
+			 ( *io_uring )->submission_queue_entries,
+			 ( *io_uring )->submission_queue_entries_size );
+		}
+		if( ( ( *io_uring )->completion_queue_ring != NULL )
+		 && ( ( *io_uring )->completion_queue_ring != ( *io_uring )->submission_queue_ring ) )
+		{
+			munmap(
+			 ( *io_uring )->completion_queue_ring,
+			 ( *io_uring )->completion_queue_ring_size );
+		}
+		if( ( *io_uring )->submission_queue_ring != NULL )
+		{
+			munmap(
+			 ( *io_uring )->submission_queue_ring,
+			 ( *io_uring )->submission_queue_ring_size );
+		}
+		if( ( *io_uring )->ring_descriptor != -1 )
+		{
+			if( close(
+			     ( *io_uring )->ring_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close ring descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_uring )->file_descriptor != -1 )
+		{
+			if( close(
+			     ( *io_uring )->file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close file descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+
+/* Submits the reads to the ring and waits for them to complete
+ * Every read starts at its read count, so that a read that returned less data
+ * than requested is submitted again for the remaining data
+ * On error no new reads are submitted, but the reads in flight are waited for,
+ * since they reference the buffers of the caller. If the reads in flight cannot
+ * be waited for the ring is marked as unusable
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_uring_submit_reads(
+     libfsapfs_io_uring_t *io_uring,
+     libfsapfs_io_uring_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error )
+{
+	struct io_uring_cqe *completion_queue_entry   = NULL;
+	struct io_uring_sqe *submission_queue_entry   = NULL;
+	struct iovec *io_vectors                      = NULL;
+	int *pending_reads                            = NULL;
+	static char *function                         = "libfsapfs_io_uring_submit_reads";
+	uint32_t completion_queue_head                = 0;
+	uint32_t entry_index                          = 0;
+	uint32_t number_of_entries_to_submit          = 0;
+	uint32_t submission_queue_tail                = 0;
+	int error_code                                = 0;
+	int number_of_pending_reads                   = 0;
+	int number_of_reads_completed                 = 0;
+	int number_of_reads_in_flight                 = 0;
+	int number_of_unsubmitted_reads               = 0;
+	int pending_reads_index                       = 0;
+	int read_index                                = 0;
+	int result                                    = 1;
+
+	io_vectors = (struct iovec *) memory_allocate(
+	                               sizeof( struct iovec ) * number_of_reads );
+
+	if( io_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO vectors.",
+		 function );
+
+		goto on_error;
+	}
+	/* The pending reads are a circular queue of read indexes that still need to be submitted
+	 */
+	pending_reads = (int *) memory_allocate(
+	                         sizeof( int ) * number_of_reads );
+
+	if( pending_reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pending reads.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		pending_reads[ read_index ] = read_index;
+	}
+	number_of_pending_reads = number_of_reads;
+
+	while( number_of_reads_completed < number_of_reads )
+	{
+		/* Once a read has failed no new reads are submitted, but the reads in flight
+		 * must complete before their buffers can be handed back to the caller
+		 */
+		if( ( result == -1 )
+		 && ( number_of_reads_in_flight == 0 ) )
+		{
+			break;
+		}
+		submission_queue_tail = *( io_uring->submission_queue_tail );
+
+		while( ( result == 1 )
+		    && ( number_of_pending_reads > 0 )
+		    && ( (uint32_t) number_of_reads_in_flight < io_uring->queue_depth ) )
+		{
+			read_index = pending_reads[ pending_reads_index ];
+
+			pending_reads_index++;
+
+			if( pending_reads_index >= number_of_reads )
+			{
+				pending_reads_index = 0;
+			}
+			number_of_pending_reads--;
+
+			io_vectors[ read_index ].iov_base = &( reads[ read_index ].buffer[ reads[ read_index ].read_count ] );
+			io_vectors[ read_index ].iov_len  = reads[ read_index ].buffer_size - reads[ read_index ].read_count;
+
+			entry_index = submission_queue_tail & *( io_uring->submission_queue_ring_mask );
+
+			submission_queue_entry = &( ( (struct io_uring_sqe *) io_uring->submission_queue_entries )[ entry_index ] );
+
+			memory_set(
+			 submission_queue_entry,
+			 0,
+			 sizeof( struct io_uring_sqe ) );
+
+			submission_queue_entry->opcode    = IORING_OP_READV;
+			submission_queue_entry->fd        = io_uring->file_descriptor;
+			submission_queue_entry->off       = (uint64_t) reads[ read_index ].file_offset + reads[ read_index ].read_count;
+			submission_queue_entry->addr      = (uint64_t) (uintptr_t) &( io_vectors[ read_index ] );
+			submission_queue_entry->len       = 1;
+			submission_queue_entry->user_data = (uint64_t) read_index;
+
+			io_uring->submission_queue_array[ entry_index ] = entry_index;
+
+			submission_queue_tail++;
+			number_of_reads_in_flight++;
+		}
+		__atomic_store_n(
+		 io_uring->submission_queue_tail,
+		 submission_queue_tail,
+		 __ATOMIC_RELEASE );
+
+		/* The kernel advances the submission queue head when it has consumed an entry
+		 */
+		number_of_entries_to_submit = submission_queue_tail - __atomic_load_n(
+		                                                       io_uring->submission_queue_head,
+		                                                       __ATOMIC_ACQUIRE );
+
+		if( syscall(
+		     __NR_io_uring_enter,
+		     io_uring->ring_descriptor,
+		     number_of_entries_to_submit,
+		     1,
+		     IORING_ENTER_GETEVENTS,
+		     NULL,
+		     0 ) < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			if( result == -1 )
+			{
+				/* The reads in flight cannot be waited for, hence the kernel can still
+				 * write to their buffers and the ring must not be used again
+				 */
+				io_uring->is_unusable = 1;
+
+				break;
+			}
+			error_code = errno;
+			result     = -1;
+
+			/* The entries that were not consumed by the kernel are taken back,
+			 * which is safe since the kernel only consumes entries on enter
+			 */
+			number_of_unsubmitted_reads = (int) ( submission_queue_tail - __atomic_load_n(
+			                                                               io_uring->submission_queue_head,
+			                                                               __ATOMIC_ACQUIRE ) );
+
+			__atomic_store_n(
+			 io_uring->submission_queue_tail,
+			 submission_queue_tail - (uint32_t) number_of_unsubmitted_reads,
+			 __ATOMIC_RELEASE );
+
+			number_of_reads_in_flight -= number_of_unsubmitted_reads;
+		}
+		completion_queue_head = *( io_uring->completion_queue_head );
+
+		while( completion_queue_head != __atomic_load_n(
+		                                 io_uring->completion_queue_tail,
+		                                 __ATOMIC_ACQUIRE ) )
+		{
+			entry_index = completion_queue_head & *( io_uring->completion_queue_ring_mask );
+
+			completion_queue_entry = &( ( (struct io_uring_cqe *) io_uring->completion_queue_entries )[ entry_index ] );
+
+			read_index = (int) completion_queue_entry->user_data;
+
+			number_of_reads_in_flight--;
+
+			if( completion_queue_entry->res < 0 )
+			{
+				if( result == 1 )
+				{
+					error_code = -( completion_queue_entry->res );
+				}
+				result = -1;
+			}
+			else if( completion_queue_entry->res == 0 )
+			{
+				/* The file ends before the data that was requested
+				 */
+				if( result == 1 )
+				{
+					error_code = 0;
+				}
+				result = -1;
+			}
+			else
+			{
+				reads[ read_index ].read_count += (size_t) completion_queue_entry->res;
+
+				if( reads[ read_index ].read_count < reads[ read_index ].buffer_size )
+				{
+					pending_reads[ ( pending_reads_index + number_of_pending_reads ) % number_of_reads ] = read_index;
+
+					number_of_pending_reads++;
+				}
+				else
+				{
+					number_of_reads_completed++;
+				}
+			}
+			completion_queue_head++;
+		}
+		__atomic_store_n(
+		 io_uring->completion_queue_head,
+		 completion_queue_head,
+		 __ATOMIC_RELEASE );
+	}
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 error_code,
+		 "%s: unable to read data.",
+		 function );
+	}
+	memory_free(
+	 pending_reads );
+
+	memory_free(
+	 io_vectors );
+
+	return( result );
+
+on_error:
+	if( pending_reads != NULL )
+	{
+		memory_free(
+		 pending_reads );
+	}
+	if( io_vectors != NULL )
+	{
+		memory_free(
+		 io_vectors );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+/* Reads multiple buffers
+ * The reads are submitted to the io_uring when available, otherwise they are read
+ * one after the other from the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_uring_read_buffers(
+     libfsapfs_io_uring_t *io_uring,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_io_uring_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_uring_read_buffers";
+	ssize_t read_count    = 0;
+	int read_index        = 0;
+	int result            = 1;
+
+	if( reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		if( reads[ read_index ].buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid read: %d - missing buffer.",
+			 function,
+			 read_index );
+
+			return( -1 );
+		}
+		if( ( reads[ read_index ].buffer_size == 0 )
+		 || ( reads[ read_index ].buffer_size > (size_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid read: %d - buffer size value out of bounds.",
+			 function,
+			 read_index );
+
+			return( -1 );
+		}
+		if( reads[ read_index ].file_offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid read: %d - file offset value out of bounds.",
+			 function,
+			 read_index );
+
+			return( -1 );
+		}
+		reads[ read_index ].read_count = 0;
+	}
+	if( number_of_reads == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+	/* A single read gains nothing from the ring
+	 */
+	if( ( io_uring != NULL )
+	 && ( number_of_reads > 1 ) )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     io_uring->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* An unusable ring falls back to reading from the file IO handle
+		 */
+		result = 0;
+
+		if( io_uring->is_unusable == 0 )
+		{
+			result = libfsapfs_io_uring_submit_reads(
+			          io_uring,
+			          reads,
+			          number_of_reads,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffers using io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     io_uring->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( result != 0 )
+		{
+			return( result );
+		}
+		result = 1;
+	}
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              reads[ read_index ].buffer,
+		              reads[ read_index ].buffer_size,
+		              reads[ read_index ].file_offset,
+		              error );
+
+		if( read_count != (ssize_t) reads[ read_index ].buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 reads[ read_index ].file_offset,
+			 reads[ read_index ].file_offset );
+
+			return( -1 );
+		}
+		reads[ read_index ].read_count = (size_t) read_count;
+	}
+	return( result );
+}
+
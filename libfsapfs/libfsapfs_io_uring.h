@@ -0,0 +1,184 @@
+/*
+ * The io_uring read functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_IO_URING_H )
+#define _LIBFSAPFS_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_SYSCALL_H ) && defined( __GNUC__ )
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter )
+#define HAVE_LIBFSAPFS_IO_URING		1
+#endif
+
+#endif /* defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_SYSCALL_H ) && defined( __GNUC__ ) */
+
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_io_uring_read libfsapfs_io_uring_read_t;
+
+struct libfsapfs_io_uring_read
+{
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The number of bytes read
+	 */
+	size_t read_count;
+};
+
+typedef struct libfsapfs_io_uring libfsapfs_io_uring_t;
+
+/* The io_uring submits reads of a file to the kernel without waiting on each read,
+ * so that multiple reads are in flight at the same time
+ */
+struct libfsapfs_io_uring
+{
+	/* The file descriptor of the file that is read
+	 */
+	int file_descriptor;
+
+	/* The file descriptor of the ring
+	 */
+	int ring_descriptor;
+
+	/* The queue depth
+	 */
+	uint32_t queue_depth;
+
+	/* The submission queue ring
+	 */
+	uint8_t *submission_queue_ring;
+
+	/* The submission queue ring size
+	 */
+	size_t submission_queue_ring_size;
+
+	/* The completion queue ring
+	 */
+	uint8_t *completion_queue_ring;
+
+	/* The completion queue ring size
+	 */
+	size_t completion_queue_ring_size;
+
+	/* The submission queue entries
+	 */
+	uint8_t *submission_queue_entries;
+
+	/* The submission queue entries size
+	 */
+	size_t submission_queue_entries_size;
+
+	/* The submission queue head, tail, ring mask and index array
+	 */
+	uint32_t *submission_queue_head;
+	uint32_t *submission_queue_tail;
+	uint32_t *submission_queue_ring_mask;
+	uint32_t *submission_queue_array;
+
+	/* The completion queue head, tail and ring mask
+	 */
+	uint32_t *completion_queue_head;
+	uint32_t *completion_queue_tail;
+	uint32_t *completion_queue_ring_mask;
+
+	/* The completion queue entries
+	 */
+	uint8_t *completion_queue_entries;
+
+	/* Value to indicate the ring can no longer be used
+	 * This is the case when the reads in flight could not be waited for
+	 */
+	uint8_t is_unusable;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+
+int libfsapfs_io_uring_setup(
+     libfsapfs_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+int libfsapfs_io_uring_initialize(
+     libfsapfs_io_uring_t **io_uring,
+     const char *filename,
+     int queue_depth,
+     libcerror_error_t **error );
+
+int libfsapfs_io_uring_free(
+     libfsapfs_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+
+int libfsapfs_io_uring_submit_reads(
+     libfsapfs_io_uring_t *io_uring,
+     libfsapfs_io_uring_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+int libfsapfs_io_uring_read_buffers(
+     libfsapfs_io_uring_t *io_uring,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_io_uring_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_IO_URING_H ) */
+
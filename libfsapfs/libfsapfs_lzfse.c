@@ -0,0 +1,2085 @@
+/*
+ * LZFSE (un)compression functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_lzfse.h"
+#include "libfsapfs_lzvn.h"
+
+/* Lookup table to map the lower 5 bits of a compressed frequency value to its number of bits
+ */
+const uint8_t libfsapfs_lzfse_frequency_number_of_bits_table[ 32 ] = {
+	2, 3, 2, 5, 2, 3, 2, 8, 2, 3, 2, 5, 2, 3, 2, 14,
+	2, 3, 2, 5, 2, 3, 2, 8, 2, 3, 2, 5, 2, 3, 2, 14 };
+
+/* Lookup table to map the lower 5 bits of a compressed frequency value to its value
+ * for values that are stored in 5 bits or less
+ */
+const uint16_t libfsapfs_lzfse_frequency_value_table[ 32 ] = {
+	0, 2, 1, 4, 0, 3, 1, 0, 0, 2, 1, 5, 0, 3, 1, 0,
+	0, 2, 1, 6, 0, 3, 1, 0, 0, 2, 1, 7, 0, 3, 1, 0 };
+
+/* The L value symbols number of extra bits and base values
+ */
+const uint8_t libfsapfs_lzfse_l_value_bits_table[ LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3, 5, 8 };
+
+const int32_t libfsapfs_lzfse_l_value_base_table[ LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS ] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20, 28, 60 };
+
+/* The M value symbols number of extra bits and base values
+ */
+const uint8_t libfsapfs_lzfse_m_value_bits_table[ LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 5, 8, 11 };
+
+const int32_t libfsapfs_lzfse_m_value_base_table[ LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS ] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 24, 56, 312 };
+
+/* The D value symbols number of extra bits and base values
+ */
+const uint8_t libfsapfs_lzfse_d_value_bits_table[ LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS ] = {
+	0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+	4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7,
+	8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11,
+	12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15 };
+
+const int32_t libfsapfs_lzfse_d_value_base_table[ LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS ] = {
+	0, 1, 2, 3, 4, 6, 8, 10, 12, 16, 20, 24, 28, 36, 44, 52,
+	60, 76, 92, 108, 124, 156, 188, 220, 252, 316, 380, 444, 508, 636, 764, 892,
+	1020, 1276, 1532, 1788, 2044, 2556, 3068, 3580, 4092, 5116, 6140, 7164, 8188, 10236, 12284, 14332,
+	16380, 20476, 24572, 28668, 32764, 40956, 49148, 57340, 65532, 81916, 98300, 114684, 131068, 163836, 196604, 229372 };
+
+/* Lookup table to map a match distance of less than 8 to the smallest multiple
+ * of the distance that is 8 or more
+ */
+const uint8_t libfsapfs_lzfse_pattern_distances[ 8 ] = {
+	0, 8, 8, 9, 8, 10, 12, 14 };
+
+/* Retrieves a value from the bit buffer
+ * The number of bits must not exceed the bit buffer size
+ */
+#define libfsapfs_lzfse_bit_buffer_get_value( bit_buffer, bit_buffer_size, number_of_bits, value_64bit ) \
+	bit_buffer_size -= number_of_bits; \
+	value_64bit      = bit_buffer >> bit_buffer_size; \
+	bit_buffer      &= ( (uint64_t) 1 << bit_buffer_size ) - 1;
+
+/* Builds a decoder table
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_build_decoder_table(
+     int number_of_states,
+     int number_of_symbols,
+     const uint16_t *frequency_table,
+     uint32_t *decoder_table,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfsapfs_lzfse_build_decoder_table";
+	uint32_t decoder_entry   = 0;
+	int base_decoder_weight  = 0;
+	int decoder_table_index  = 0;
+	int frequency            = 0;
+	int frequency_index      = 0;
+	int number_of_bits       = 0;
+	int sum_of_frequencies   = 0;
+	int symbol               = 0;
+
+	if( ( number_of_states <= 0 )
+	 || ( number_of_states > LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of states value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_symbols <= 0 )
+	 || ( number_of_symbols > LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_SYMBOLS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of symbols value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( frequency_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid frequency table.",
+		 function );
+
+		return( -1 );
+	}
+	if( decoder_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     decoder_table,
+	     0,
+	     sizeof( uint32_t ) * number_of_states ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		frequency = (int) frequency_table[ symbol ];
+
+		if( frequency == 0 )
+		{
+			continue;
+		}
+		sum_of_frequencies += frequency;
+
+		if( sum_of_frequencies > number_of_states )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid sum of frequencies value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		/* The number of bits is the smallest value for which:
+		 * number of states <= ( frequency << number of bits ) < 2 * number of states
+		 */
+		for( number_of_bits = 0;
+		     ( frequency << number_of_bits ) < number_of_states;
+		     number_of_bits++ )
+		{
+		}
+		base_decoder_weight = ( ( 2 * number_of_states ) >> number_of_bits ) - frequency;
+
+		for( frequency_index = 0;
+		     frequency_index < frequency;
+		     frequency_index++ )
+		{
+			if( frequency_index < base_decoder_weight )
+			{
+				decoder_entry = (uint32_t) ( ( ( frequency + frequency_index ) << number_of_bits ) - number_of_states ) << 16;
+				decoder_entry |= (uint32_t) number_of_bits;
+			}
+			else
+			{
+				decoder_entry = (uint32_t) ( ( frequency_index - base_decoder_weight ) << ( number_of_bits - 1 ) ) << 16;
+				decoder_entry |= (uint32_t) ( number_of_bits - 1 );
+			}
+			decoder_entry |= (uint32_t) symbol << 8;
+
+			decoder_table[ decoder_table_index++ ] = decoder_entry;
+		}
+	}
+	return( 1 );
+}
+
+/* Builds a value decoder table
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_build_value_decoder_table(
+     int number_of_states,
+     int number_of_symbols,
+     const uint16_t *frequency_table,
+     const uint8_t *value_bits_table,
+     const int32_t *value_base_table,
+     libfsapfs_lzfse_value_decoder_entry_t *value_decoder_table,
+     libcerror_error_t **error )
+{
+	libfsapfs_lzfse_value_decoder_entry_t *value_decoder_entry = NULL;
+	static char *function                                      = "libfsapfs_lzfse_build_value_decoder_table";
+	int base_decoder_weight                                    = 0;
+	int decoder_table_index                                    = 0;
+	int frequency                                              = 0;
+	int frequency_index                                        = 0;
+	int number_of_bits                                         = 0;
+	int sum_of_frequencies                                     = 0;
+	int symbol                                                 = 0;
+
+	if( ( number_of_states <= 0 )
+	 || ( number_of_states > LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_STATES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of states value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_symbols <= 0 )
+	 || ( number_of_symbols > LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of symbols value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( frequency_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid frequency table.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_bits_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value bits table.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_base_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value base table.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_decoder_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     value_decoder_table,
+	     0,
+	     sizeof( libfsapfs_lzfse_value_decoder_entry_t ) * number_of_states ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear value decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		frequency = (int) frequency_table[ symbol ];
+
+		if( frequency == 0 )
+		{
+			continue;
+		}
+		sum_of_frequencies += frequency;
+
+		if( sum_of_frequencies > number_of_states )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid sum of frequencies value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		for( number_of_bits = 0;
+		     ( frequency << number_of_bits ) < number_of_states;
+		     number_of_bits++ )
+		{
+		}
+		base_decoder_weight = ( ( 2 * number_of_states ) >> number_of_bits ) - frequency;
+
+		for( frequency_index = 0;
+		     frequency_index < frequency;
+		     frequency_index++ )
+		{
+			value_decoder_entry = &( value_decoder_table[ decoder_table_index++ ] );
+
+			value_decoder_entry->number_of_value_bits = value_bits_table[ symbol ];
+			value_decoder_entry->value_base           = value_base_table[ symbol ];
+
+			if( frequency_index < base_decoder_weight )
+			{
+				value_decoder_entry->number_of_bits = (uint8_t) number_of_bits + value_decoder_entry->number_of_value_bits;
+				value_decoder_entry->delta          = (int16_t) ( ( ( frequency + frequency_index ) << number_of_bits ) - number_of_states );
+			}
+			else
+			{
+				value_decoder_entry->number_of_bits = (uint8_t) ( number_of_bits - 1 ) + value_decoder_entry->number_of_value_bits;
+				value_decoder_entry->delta          = (int16_t) ( ( frequency_index - base_decoder_weight ) << ( number_of_bits - 1 ) );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a compressed block v1 header
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_read_block_v1_header(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_data_offset,
+     libcerror_error_t **error )
+{
+	const uint8_t *header_data = NULL;
+	static char *function      = "libfsapfs_lzfse_read_block_v1_header";
+	size_t safe_data_offset    = 0;
+	uint32_t value_32bit       = 0;
+	int symbol_index           = 0;
+
+	if( decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	safe_data_offset = *compressed_data_offset;
+
+	if( ( safe_data_offset > compressed_data_size )
+	 || ( ( compressed_data_size - safe_data_offset ) < LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V1_HEADER_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: compressed data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	header_data = &( compressed_data[ safe_data_offset ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 4 ] ),
+	 decoder->number_of_raw_bytes );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 12 ] ),
+	 decoder->number_of_literals );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 16 ] ),
+	 decoder->number_of_lmd_values );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 20 ] ),
+	 decoder->literals_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 24 ] ),
+	 decoder->lmd_values_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 28 ] ),
+	 value_32bit );
+
+	decoder->literal_bits = (int32_t) value_32bit;
+
+	for( symbol_index = 0;
+	     symbol_index < 4;
+	     symbol_index++ )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( header_data[ 32 + ( symbol_index * 2 ) ] ),
+		 decoder->literal_states[ symbol_index ] );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 40 ] ),
+	 value_32bit );
+
+	decoder->lmd_values_bits = (int32_t) value_32bit;
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( header_data[ 44 ] ),
+	 decoder->l_value_state );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( header_data[ 46 ] ),
+	 decoder->m_value_state );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( header_data[ 48 ] ),
+	 decoder->d_value_state );
+
+	for( symbol_index = 0;
+	     symbol_index < LIBFSAPFS_LZFSE_NUMBER_OF_SYMBOLS;
+	     symbol_index++ )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( header_data[ 50 + ( symbol_index * 2 ) ] ),
+		 decoder->frequency_table[ symbol_index ] );
+	}
+	*compressed_data_offset = safe_data_offset + LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V1_HEADER_SIZE;
+
+	return( 1 );
+}
+
+/* Reads a compressed block v2 header
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_read_block_v2_header(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_data_offset,
+     libcerror_error_t **error )
+{
+	const uint8_t *header_data = NULL;
+	static char *function      = "libfsapfs_lzfse_read_block_v2_header";
+	size_t safe_data_offset    = 0;
+	uint64_t packed_fields1    = 0;
+	uint64_t packed_fields2    = 0;
+	uint64_t packed_fields3    = 0;
+	uint32_t header_size       = 0;
+
+	if( decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	safe_data_offset = *compressed_data_offset;
+
+	if( ( safe_data_offset > compressed_data_size )
+	 || ( ( compressed_data_size - safe_data_offset ) < LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_HEADER_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: compressed data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	header_data = &( compressed_data[ safe_data_offset ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( header_data[ 4 ] ),
+	 decoder->number_of_raw_bytes );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( header_data[ 8 ] ),
+	 packed_fields1 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( header_data[ 16 ] ),
+	 packed_fields2 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( header_data[ 24 ] ),
+	 packed_fields3 );
+
+	decoder->number_of_literals   = (uint32_t) ( packed_fields1 & 0x000fffffUL );
+	decoder->literals_data_size   = (uint32_t) ( ( packed_fields1 >> 20 ) & 0x000fffffUL );
+	decoder->number_of_lmd_values = (uint32_t) ( ( packed_fields1 >> 40 ) & 0x000fffffUL );
+	decoder->literal_bits         = (int32_t) ( ( packed_fields1 >> 60 ) & 0x00000007UL ) - 7;
+
+	decoder->literal_states[ 0 ]  = (uint16_t) ( packed_fields2 & 0x000003ffUL );
+	decoder->literal_states[ 1 ]  = (uint16_t) ( ( packed_fields2 >> 10 ) & 0x000003ffUL );
+	decoder->literal_states[ 2 ]  = (uint16_t) ( ( packed_fields2 >> 20 ) & 0x000003ffUL );
+	decoder->literal_states[ 3 ]  = (uint16_t) ( ( packed_fields2 >> 30 ) & 0x000003ffUL );
+	decoder->lmd_values_data_size = (uint32_t) ( ( packed_fields2 >> 40 ) & 0x000fffffUL );
+	decoder->lmd_values_bits      = (int32_t) ( ( packed_fields2 >> 60 ) & 0x00000007UL ) - 7;
+
+	header_size                   = (uint32_t) ( packed_fields3 & 0xffffffffUL );
+	decoder->l_value_state        = (uint16_t) ( ( packed_fields3 >> 32 ) & 0x000003ffUL );
+	decoder->m_value_state        = (uint16_t) ( ( packed_fields3 >> 42 ) & 0x000003ffUL );
+	decoder->d_value_state        = (uint16_t) ( ( packed_fields3 >> 52 ) & 0x000003ffUL );
+
+	if( ( header_size < LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_HEADER_SIZE )
+	 || ( (size_t) header_size > ( compressed_data_size - safe_data_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_size == LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_HEADER_SIZE )
+	{
+		/* The frequency tables were omitted
+		 */
+		if( memory_set(
+		     decoder->frequency_table,
+		     0,
+		     sizeof( uint16_t ) * LIBFSAPFS_LZFSE_NUMBER_OF_SYMBOLS ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear frequency table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libfsapfs_lzfse_read_compressed_frequency_table(
+	          &( header_data[ LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_HEADER_SIZE ] ),
+	          (size_t) header_size - LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_HEADER_SIZE,
+	          decoder->frequency_table,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read compressed frequency table.",
+		 function );
+
+		return( -1 );
+	}
+	*compressed_data_offset = safe_data_offset + header_size;
+
+	return( 1 );
+}
+
+/* Reads a compressed frequency table
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_read_compressed_frequency_table(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t *frequency_table,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfsapfs_lzfse_read_compressed_frequency_table";
+	size_t compressed_data_offset = 0;
+	uint32_t value_32bit          = 0;
+	uint16_t frequency_value      = 0;
+	uint8_t bit_buffer_size       = 0;
+	uint8_t lookup_index          = 0;
+	uint8_t number_of_bits        = 0;
+	int symbol_index              = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( frequency_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid frequency table.",
+		 function );
+
+		return( -1 );
+	}
+	for( symbol_index = 0;
+	     symbol_index < LIBFSAPFS_LZFSE_NUMBER_OF_SYMBOLS;
+	     symbol_index++ )
+	{
+		while( ( compressed_data_offset < compressed_data_size )
+		    && ( ( bit_buffer_size + 8 ) <= 32 ) )
+		{
+			value_32bit     |= (uint32_t) compressed_data[ compressed_data_offset++ ] << bit_buffer_size;
+			bit_buffer_size += 8;
+		}
+		lookup_index   = (uint8_t) ( value_32bit & 0x0000001fUL );
+		number_of_bits = libfsapfs_lzfse_frequency_number_of_bits_table[ lookup_index ];
+
+		if( number_of_bits == 8 )
+		{
+			frequency_value = (uint16_t) ( ( value_32bit >> 4 ) & 0x0000000fUL ) + 8;
+		}
+		else if( number_of_bits == 14 )
+		{
+			frequency_value = (uint16_t) ( ( value_32bit >> 4 ) & 0x000003ffUL ) + 24;
+		}
+		else
+		{
+			frequency_value = libfsapfs_lzfse_frequency_value_table[ lookup_index ];
+		}
+		if( number_of_bits > bit_buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: compressed data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		frequency_table[ symbol_index ] = frequency_value;
+
+		value_32bit    >>= number_of_bits;
+		bit_buffer_size -= number_of_bits;
+	}
+	if( ( bit_buffer_size >= 8 )
+	 || ( compressed_data_offset != compressed_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed frequency table data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Builds the decoder tables from the frequency table
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_build_decoder_tables(
+     libfsapfs_lzfse_decoder_t *decoder,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_lzfse_build_decoder_tables";
+
+	if( decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_lzfse_build_value_decoder_table(
+	     LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_STATES,
+	     LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS,
+	     &( decoder->frequency_table[ 0 ] ),
+	     libfsapfs_lzfse_l_value_bits_table,
+	     libfsapfs_lzfse_l_value_base_table,
+	     decoder->l_value_decoder_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build L value decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_lzfse_build_value_decoder_table(
+	     LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_STATES,
+	     LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS,
+	     &( decoder->frequency_table[ LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS ] ),
+	     libfsapfs_lzfse_m_value_bits_table,
+	     libfsapfs_lzfse_m_value_base_table,
+	     decoder->m_value_decoder_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build M value decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_lzfse_build_value_decoder_table(
+	     LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_STATES,
+	     LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS,
+	     &( decoder->frequency_table[ LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS + LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS ] ),
+	     libfsapfs_lzfse_d_value_bits_table,
+	     libfsapfs_lzfse_d_value_base_table,
+	     decoder->d_value_decoder_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build D value decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_lzfse_build_decoder_table(
+	     LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES,
+	     LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_SYMBOLS,
+	     &( decoder->frequency_table[ LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS + LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS + LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS ] ),
+	     decoder->literal_decoder_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build literal decoder table.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the literal values
+ * The literal values are stored in a bit stream that is read from its end towards its start
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_read_literal_values(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfsapfs_lzfse_read_literal_values";
+	size_t compressed_data_offset = 0;
+	uint64_t bit_buffer           = 0;
+	uint64_t value_64bit          = 0;
+	uint32_t decoder_entry        = 0;
+	uint32_t literal_index        = 0;
+	uint16_t literal_state1       = 0;
+	uint16_t literal_state2       = 0;
+	uint16_t literal_state3       = 0;
+	uint16_t literal_state4       = 0;
+	uint8_t bit_buffer_size       = 0;
+	uint8_t number_of_bits        = 0;
+	uint8_t number_of_bytes       = 0;
+	int byte_index                = 0;
+
+	if( decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( decoder->number_of_literals > LIBFSAPFS_LZFSE_LITERALS_PER_BLOCK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decoder - number of literals value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( decoder->literal_bits < -7 )
+	 || ( decoder->literal_bits > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decoder - literal bits value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	literal_state1 = decoder->literal_states[ 0 ];
+	literal_state2 = decoder->literal_states[ 1 ];
+	literal_state3 = decoder->literal_states[ 2 ];
+	literal_state4 = decoder->literal_states[ 3 ];
+
+	if( ( literal_state1 >= LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES )
+	 || ( literal_state2 >= LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES )
+	 || ( literal_state3 >= LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES )
+	 || ( literal_state4 >= LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decoder - literal state value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	compressed_data_offset = compressed_data_size;
+
+	if( decoder->literal_bits != 0 )
+	{
+		if( compressed_data_offset < 8 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: compressed data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		compressed_data_offset -= 8;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( compressed_data[ compressed_data_offset ] ),
+		 bit_buffer );
+
+		bit_buffer_size = (uint8_t) ( 64 + decoder->literal_bits );
+	}
+	else
+	{
+		if( compressed_data_offset < 7 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: compressed data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		compressed_data_offset -= 7;
+
+		for( byte_index = 6;
+		     byte_index >= 0;
+		     byte_index-- )
+		{
+			bit_buffer <<= 8;
+			bit_buffer  |= compressed_data[ compressed_data_offset + byte_index ];
+		}
+		bit_buffer_size = 56;
+	}
+	if( ( bit_buffer >> bit_buffer_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bit buffer - unsupported unused bits.",
+		 function );
+
+		return( -1 );
+	}
+	/* The literals are decoded in groups of 4 using interleaved states, a refill
+	 * of the bit buffer provides at least 56 bits and a literal uses at most 10 bits
+	 */
+	for( literal_index = 0;
+	     literal_index < decoder->number_of_literals;
+	     literal_index += 4 )
+	{
+		number_of_bytes = ( 63 - bit_buffer_size ) >> 3;
+
+		if( number_of_bytes > 0 )
+		{
+			if( (size_t) number_of_bytes > compressed_data_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: compressed data size value too small.",
+				 function );
+
+				return( -1 );
+			}
+			compressed_data_offset -= number_of_bytes;
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( compressed_data[ compressed_data_offset ] ),
+			 value_64bit );
+
+			number_of_bits   = number_of_bytes * 8;
+			bit_buffer     <<= number_of_bits;
+			bit_buffer      |= value_64bit & ( ( (uint64_t) 1 << number_of_bits ) - 1 );
+			bit_buffer_size += number_of_bits;
+		}
+		decoder_entry  = decoder->literal_decoder_table[ literal_state1 ];
+		number_of_bits = (uint8_t) ( decoder_entry & 0x000000ffUL );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 number_of_bits,
+		 value_64bit );
+
+		literal_state1                                  = (uint16_t) ( ( decoder_entry >> 16 ) + value_64bit );
+		decoder->literal_values[ literal_index ]        = (uint8_t) ( decoder_entry >> 8 );
+
+		decoder_entry  = decoder->literal_decoder_table[ literal_state2 ];
+		number_of_bits = (uint8_t) ( decoder_entry & 0x000000ffUL );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 number_of_bits,
+		 value_64bit );
+
+		literal_state2                                  = (uint16_t) ( ( decoder_entry >> 16 ) + value_64bit );
+		decoder->literal_values[ literal_index + 1 ]    = (uint8_t) ( decoder_entry >> 8 );
+
+		decoder_entry  = decoder->literal_decoder_table[ literal_state3 ];
+		number_of_bits = (uint8_t) ( decoder_entry & 0x000000ffUL );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 number_of_bits,
+		 value_64bit );
+
+		literal_state3                                  = (uint16_t) ( ( decoder_entry >> 16 ) + value_64bit );
+		decoder->literal_values[ literal_index + 2 ]    = (uint8_t) ( decoder_entry >> 8 );
+
+		decoder_entry  = decoder->literal_decoder_table[ literal_state4 ];
+		number_of_bits = (uint8_t) ( decoder_entry & 0x000000ffUL );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 number_of_bits,
+		 value_64bit );
+
+		literal_state4                                  = (uint16_t) ( ( decoder_entry >> 16 ) + value_64bit );
+		decoder->literal_values[ literal_index + 3 ]    = (uint8_t) ( decoder_entry >> 8 );
+	}
+	return( 1 );
+}
+
+/* Reads the L, M, D values and decodes the corresponding literals and matches
+ * The L, M, D values are stored in a bit stream that is read from its end towards its start
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_read_lmd_values(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error )
+{
+	libfsapfs_lzfse_value_decoder_entry_t *value_decoder_entry = NULL;
+	static char *function                                      = "libfsapfs_lzfse_read_lmd_values";
+	size_t compressed_data_offset                              = 0;
+	size_t match_end_offset                                    = 0;
+	size_t match_offset                                        = 0;
+	size_t safe_uncompressed_data_offset                       = 0;
+	uint64_t bit_buffer                                        = 0;
+	uint64_t value_64bit                                       = 0;
+	uint32_t literal_index                                     = 0;
+	uint32_t lmd_value_index                                   = 0;
+	uint32_t literal_size                                      = 0;
+	uint32_t literal_value_offset                              = 0;
+	uint32_t match_size                                        = 0;
+	uint16_t d_value_state                                     = 0;
+	uint16_t l_value_state                                     = 0;
+	uint16_t m_value_state                                     = 0;
+	uint8_t bit_buffer_size                                    = 0;
+	uint8_t number_of_bits                                     = 0;
+	uint8_t number_of_bytes                                    = 0;
+	int32_t distance                                           = -1;
+	int32_t d_value                                            = 0;
+	int byte_index                                             = 0;
+
+	if( decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	safe_uncompressed_data_offset = *uncompressed_data_offset;
+
+	if( safe_uncompressed_data_offset > uncompressed_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid uncompressed data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( decoder->number_of_lmd_values > LIBFSAPFS_LZFSE_MATCHES_PER_BLOCK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decoder - number of L, M, D values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( decoder->lmd_values_bits < -7 )
+	 || ( decoder->lmd_values_bits > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decoder - L, M, D values bits value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	l_value_state = decoder->l_value_state;
+	m_value_state = decoder->m_value_state;
+	d_value_state = decoder->d_value_state;
+
+	if( ( l_value_state >= LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_STATES )
+	 || ( m_value_state >= LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_STATES )
+	 || ( d_value_state >= LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_STATES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decoder - L, M, D value state value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	compressed_data_offset = compressed_data_size;
+
+	if( decoder->lmd_values_bits != 0 )
+	{
+		if( compressed_data_offset < 8 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: compressed data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		compressed_data_offset -= 8;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( compressed_data[ compressed_data_offset ] ),
+		 bit_buffer );
+
+		bit_buffer_size = (uint8_t) ( 64 + decoder->lmd_values_bits );
+	}
+	else
+	{
+		if( compressed_data_offset < 7 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: compressed data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		compressed_data_offset -= 7;
+
+		for( byte_index = 6;
+		     byte_index >= 0;
+		     byte_index-- )
+		{
+			bit_buffer <<= 8;
+			bit_buffer  |= compressed_data[ compressed_data_offset + byte_index ];
+		}
+		bit_buffer_size = 56;
+	}
+	if( ( bit_buffer >> bit_buffer_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bit buffer - unsupported unused bits.",
+		 function );
+
+		return( -1 );
+	}
+	/* A refill of the bit buffer provides at least 56 bits and an L, M, D value
+	 * triplet uses at most 54 bits
+	 */
+	for( lmd_value_index = 0;
+	     lmd_value_index < decoder->number_of_lmd_values;
+	     lmd_value_index++ )
+	{
+		number_of_bytes = ( 63 - bit_buffer_size ) >> 3;
+
+		if( number_of_bytes > 0 )
+		{
+			if( (size_t) number_of_bytes > compressed_data_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: compressed data size value too small.",
+				 function );
+
+				return( -1 );
+			}
+			compressed_data_offset -= number_of_bytes;
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( compressed_data[ compressed_data_offset ] ),
+			 value_64bit );
+
+			number_of_bits   = number_of_bytes * 8;
+			bit_buffer     <<= number_of_bits;
+			bit_buffer      |= value_64bit & ( ( (uint64_t) 1 << number_of_bits ) - 1 );
+			bit_buffer_size += number_of_bits;
+		}
+		value_decoder_entry = &( decoder->l_value_decoder_table[ l_value_state ] );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 value_decoder_entry->number_of_bits,
+		 value_64bit );
+
+		l_value_state = (uint16_t) ( value_decoder_entry->delta + (int32_t) ( value_64bit >> value_decoder_entry->number_of_value_bits ) );
+		literal_size  = (uint32_t) ( value_decoder_entry->value_base + (int32_t) ( value_64bit & ( ( (uint64_t) 1 << value_decoder_entry->number_of_value_bits ) - 1 ) ) );
+
+		value_decoder_entry = &( decoder->m_value_decoder_table[ m_value_state ] );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 value_decoder_entry->number_of_bits,
+		 value_64bit );
+
+		m_value_state = (uint16_t) ( value_decoder_entry->delta + (int32_t) ( value_64bit >> value_decoder_entry->number_of_value_bits ) );
+		match_size    = (uint32_t) ( value_decoder_entry->value_base + (int32_t) ( value_64bit & ( ( (uint64_t) 1 << value_decoder_entry->number_of_value_bits ) - 1 ) ) );
+
+		value_decoder_entry = &( decoder->d_value_decoder_table[ d_value_state ] );
+
+		libfsapfs_lzfse_bit_buffer_get_value(
+		 bit_buffer,
+		 bit_buffer_size,
+		 value_decoder_entry->number_of_bits,
+		 value_64bit );
+
+		d_value_state = (uint16_t) ( value_decoder_entry->delta + (int32_t) ( value_64bit >> value_decoder_entry->number_of_value_bits ) );
+		d_value       = value_decoder_entry->value_base + (int32_t) ( value_64bit & ( ( (uint64_t) 1 << value_decoder_entry->number_of_value_bits ) - 1 ) );
+
+		/* A D value of 0 indicates the previous distance is reused
+		 */
+		if( d_value != 0 )
+		{
+			distance = d_value;
+		}
+		if( literal_size > ( decoder->number_of_literals - literal_index ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: literal size value exceeds number of literals.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( (size_t) literal_size + (size_t) match_size ) > ( uncompressed_data_size - safe_uncompressed_data_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: literal and match size value exceeds uncompressed data size.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( match_size > 0 )
+		 && ( ( distance <= 0 )
+		  || ( (size_t) distance > ( safe_uncompressed_data_offset + literal_size ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: distance value exceeds uncompressed data offset.",
+			 function );
+
+			return( -1 );
+		}
+		match_end_offset = safe_uncompressed_data_offset + literal_size + match_size;
+
+		if( ( uncompressed_data_size - match_end_offset ) >= 16 )
+		{
+			/* The uncompressed data has sufficient slack to copy the literals
+			 * and match in chunks that can extend up to 15 bytes past their end,
+			 * the literal values have at least 64 bytes of slack
+			 */
+			for( literal_value_offset = 0;
+			     literal_value_offset < literal_size;
+			     literal_value_offset += 16 )
+			{
+				memory_copy(
+				 &( uncompressed_data[ safe_uncompressed_data_offset + literal_value_offset ] ),
+				 &( decoder->literal_values[ literal_index + literal_value_offset ] ),
+				 16 );
+			}
+			literal_index                 += literal_size;
+			safe_uncompressed_data_offset += literal_size;
+
+			if( match_size > 0 )
+			{
+				match_offset = safe_uncompressed_data_offset - distance;
+
+				if( distance == 1 )
+				{
+					memory_set(
+					 &( uncompressed_data[ safe_uncompressed_data_offset ] ),
+					 uncompressed_data[ match_offset ],
+					 (size_t) match_size );
+				}
+				else
+				{
+					if( distance < 8 )
+					{
+						/* The first 8 bytes of an overlapping match are copied one at a time,
+						 * after which the pattern repeats at a distance of 8 or more
+						 */
+						uncompressed_data[ safe_uncompressed_data_offset ]     = uncompressed_data[ match_offset ];
+						uncompressed_data[ safe_uncompressed_data_offset + 1 ] = uncompressed_data[ match_offset + 1 ];
+						uncompressed_data[ safe_uncompressed_data_offset + 2 ] = uncompressed_data[ match_offset + 2 ];
+						uncompressed_data[ safe_uncompressed_data_offset + 3 ] = uncompressed_data[ match_offset + 3 ];
+						uncompressed_data[ safe_uncompressed_data_offset + 4 ] = uncompressed_data[ match_offset + 4 ];
+						uncompressed_data[ safe_uncompressed_data_offset + 5 ] = uncompressed_data[ match_offset + 5 ];
+						uncompressed_data[ safe_uncompressed_data_offset + 6 ] = uncompressed_data[ match_offset + 6 ];
+						uncompressed_data[ safe_uncompressed_data_offset + 7 ] = uncompressed_data[ match_offset + 7 ];
+
+						safe_uncompressed_data_offset += 8;
+						match_offset                   = safe_uncompressed_data_offset - libfsapfs_lzfse_pattern_distances[ distance ];
+					}
+					if( distance >= 16 )
+					{
+						while( safe_uncompressed_data_offset < match_end_offset )
+						{
+							memory_copy(
+							 &( uncompressed_data[ safe_uncompressed_data_offset ] ),
+							 &( uncompressed_data[ match_offset ] ),
+							 16 );
+
+							safe_uncompressed_data_offset += 16;
+							match_offset                  += 16;
+						}
+					}
+					else
+					{
+						while( safe_uncompressed_data_offset < match_end_offset )
+						{
+							memory_copy(
+							 &( uncompressed_data[ safe_uncompressed_data_offset ] ),
+							 &( uncompressed_data[ match_offset ] ),
+							 8 );
+
+							safe_uncompressed_data_offset += 8;
+							match_offset                  += 8;
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			while( literal_size > 0 )
+			{
+				uncompressed_data[ safe_uncompressed_data_offset++ ] = decoder->literal_values[ literal_index++ ];
+
+				literal_size--;
+			}
+			if( match_size > 0 )
+			{
+				match_offset = safe_uncompressed_data_offset - distance;
+
+				while( safe_uncompressed_data_offset < match_end_offset )
+				{
+					uncompressed_data[ safe_uncompressed_data_offset++ ] = uncompressed_data[ match_offset++ ];
+				}
+			}
+		}
+		safe_uncompressed_data_offset = match_end_offset;
+	}
+	*uncompressed_data_offset = safe_uncompressed_data_offset;
+
+	return( 1 );
+}
+
+/* Reads a compressed block and decodes its literals and matches
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_read_block(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_data_offset,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function                = "libfsapfs_lzfse_read_block";
+	size_t safe_compressed_data_offset   = 0;
+	size_t safe_uncompressed_data_offset = 0;
+	uint32_t block_marker                = 0;
+	int result                           = 0;
+
+	if( decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	safe_compressed_data_offset   = *compressed_data_offset;
+	safe_uncompressed_data_offset = *uncompressed_data_offset;
+
+	if( ( safe_compressed_data_offset > compressed_data_size )
+	 || ( ( compressed_data_size - safe_compressed_data_offset ) < 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: compressed data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( compressed_data[ safe_compressed_data_offset ] ),
+	 block_marker );
+
+	if( block_marker == LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V1_MARKER )
+	{
+		result = libfsapfs_lzfse_read_block_v1_header(
+		          decoder,
+		          compressed_data,
+		          compressed_data_size,
+		          &safe_compressed_data_offset,
+		          error );
+	}
+	else if( block_marker == LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_MARKER )
+	{
+		result = libfsapfs_lzfse_read_block_v2_header(
+		          decoder,
+		          compressed_data,
+		          compressed_data_size,
+		          &safe_compressed_data_offset,
+		          error );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported block marker: 0x%08" PRIx32 ".",
+		 function,
+		 block_marker );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (size_t) decoder->literals_data_size > ( compressed_data_size - safe_compressed_data_offset ) )
+	 || ( (size_t) decoder->lmd_values_data_size > ( compressed_data_size - safe_compressed_data_offset - decoder->literals_data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid payload size value exceeds compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) decoder->number_of_raw_bytes > ( uncompressed_data_size - safe_uncompressed_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of raw bytes value exceeds uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_lzfse_build_decoder_tables(
+	     decoder,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build decoder tables.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_lzfse_read_literal_values(
+	     decoder,
+	     &( compressed_data[ safe_compressed_data_offset ] ),
+	     (size_t) decoder->literals_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read literal values.",
+		 function );
+
+		return( -1 );
+	}
+	safe_compressed_data_offset += decoder->literals_data_size;
+
+	if( libfsapfs_lzfse_read_lmd_values(
+	     decoder,
+	     &( compressed_data[ safe_compressed_data_offset ] ),
+	     (size_t) decoder->lmd_values_data_size,
+	     uncompressed_data,
+	     uncompressed_data_size,
+	     &safe_uncompressed_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read L, M, D values.",
+		 function );
+
+		return( -1 );
+	}
+	safe_compressed_data_offset += decoder->lmd_values_data_size;
+
+	if( ( safe_uncompressed_data_offset - *uncompressed_data_offset ) != (size_t) decoder->number_of_raw_bytes )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in number of raw bytes and decoded data size.",
+		 function );
+
+		return( -1 );
+	}
+	*compressed_data_offset   = safe_compressed_data_offset;
+	*uncompressed_data_offset = safe_uncompressed_data_offset;
+
+	return( 1 );
+}
+
+/* Decompresses LZFSE compressed data
+ * Returns 1 on success or -1 on error
+ */
+int libfsapfs_lzfse_decompress(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_lzfse_decoder_t *decoder = NULL;
+	static char *function              = "libfsapfs_lzfse_decompress";
+	size_t compressed_data_offset      = 0;
+	size_t safe_uncompressed_data_size = 0;
+	size_t uncompressed_data_offset    = 0;
+	uint32_t block_marker              = 0;
+	uint32_t compressed_block_size     = 0;
+	uint32_t uncompressed_block_size   = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	safe_uncompressed_data_size = *uncompressed_data_size;
+
+	while( ( compressed_data_size - compressed_data_offset ) >= 4 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( compressed_data[ compressed_data_offset ] ),
+		 block_marker );
+
+		if( block_marker == LIBFSAPFS_LZFSE_END_OF_STREAM_BLOCK_MARKER )
+		{
+			compressed_data_offset += 4;
+
+			break;
+		}
+		else if( block_marker == LIBFSAPFS_LZFSE_UNCOMPRESSED_BLOCK_MARKER )
+		{
+			if( ( compressed_data_size - compressed_data_offset ) < 8 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: compressed data size value too small.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 &( compressed_data[ compressed_data_offset + 4 ] ),
+			 uncompressed_block_size );
+
+			compressed_data_offset += 8;
+
+			if( (size_t) uncompressed_block_size > ( compressed_data_size - compressed_data_offset ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: compressed data size value too small.",
+				 function );
+
+				goto on_error;
+			}
+			if( (size_t) uncompressed_block_size > ( safe_uncompressed_data_size - uncompressed_data_offset ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: uncompressed data size value too small.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     &( uncompressed_data[ uncompressed_data_offset ] ),
+			     &( compressed_data[ compressed_data_offset ] ),
+			     (size_t) uncompressed_block_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy uncompressed block data.",
+				 function );
+
+				goto on_error;
+			}
+			compressed_data_offset   += uncompressed_block_size;
+			uncompressed_data_offset += uncompressed_block_size;
+		}
+		else if( block_marker == LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_LZVN_MARKER )
+		{
+			if( ( compressed_data_size - compressed_data_offset ) < 12 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: compressed data size value too small.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 &( compressed_data[ compressed_data_offset + 4 ] ),
+			 uncompressed_block_size );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 &( compressed_data[ compressed_data_offset + 8 ] ),
+			 compressed_block_size );
+
+			compressed_data_offset += 12;
+
+			if( (size_t) compressed_block_size > ( compressed_data_size - compressed_data_offset ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: compressed data size value too small.",
+				 function );
+
+				goto on_error;
+			}
+			if( (size_t) uncompressed_block_size > ( safe_uncompressed_data_size - uncompressed_data_offset ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: uncompressed data size value too small.",
+				 function );
+
+				goto on_error;
+			}
+			safe_uncompressed_data_size = (size_t) uncompressed_block_size;
+
+			if( libfsapfs_lzvn_decompress(
+			     &( compressed_data[ compressed_data_offset ] ),
+			     (size_t) compressed_block_size,
+			     &( uncompressed_data[ uncompressed_data_offset ] ),
+			     &safe_uncompressed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decompress LZVN compressed block.",
+				 function );
+
+				goto on_error;
+			}
+			if( safe_uncompressed_data_size != (size_t) uncompressed_block_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISMATCH,
+				 "%s: mismatch in uncompressed block size and decompressed data size.",
+				 function );
+
+				goto on_error;
+			}
+			safe_uncompressed_data_size = *uncompressed_data_size;
+
+			compressed_data_offset   += compressed_block_size;
+			uncompressed_data_offset += uncompressed_block_size;
+		}
+		else if( ( block_marker == LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V1_MARKER )
+		      || ( block_marker == LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_MARKER ) )
+		{
+			/* The decoder is large and only needed for FSE compressed blocks
+			 */
+			if( decoder == NULL )
+			{
+				decoder = memory_allocate_structure(
+				           libfsapfs_lzfse_decoder_t );
+
+				if( decoder == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create decoder.",
+					 function );
+
+					goto on_error;
+				}
+				if( memory_set(
+				     decoder,
+				     0,
+				     sizeof( libfsapfs_lzfse_decoder_t ) ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear decoder.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libfsapfs_lzfse_read_block(
+			     decoder,
+			     compressed_data,
+			     compressed_data_size,
+			     &compressed_data_offset,
+			     uncompressed_data,
+			     safe_uncompressed_data_size,
+			     &uncompressed_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decompress LZFSE compressed block.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported block marker: 0x%08" PRIx32 ".",
+			 function,
+			 block_marker );
+
+			goto on_error;
+		}
+	}
+	if( decoder != NULL )
+	{
+		memory_free(
+		 decoder );
+	}
+	*uncompressed_data_size = uncompressed_data_offset;
+
+	return( 1 );
+
+on_error:
+	if( decoder != NULL )
+	{
+		memory_free(
+		 decoder );
+	}
+	return( -1 );
+}
+
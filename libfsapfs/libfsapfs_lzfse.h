@@ -0,0 +1,242 @@
+/*
+ * LZFSE (un)compression functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_LZFSE_COMPRESSION_H )
+#define _LIBFSAPFS_LZFSE_COMPRESSION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The block markers
+ */
+#define LIBFSAPFS_LZFSE_END_OF_STREAM_BLOCK_MARKER		0x24787662UL
+#define LIBFSAPFS_LZFSE_UNCOMPRESSED_BLOCK_MARKER		0x2d787662UL
+#define LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V1_MARKER		0x31787662UL
+#define LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_MARKER		0x32787662UL
+#define LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_LZVN_MARKER		0x6e787662UL
+
+/* The block header sizes
+ */
+#define LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V1_HEADER_SIZE		772
+#define LIBFSAPFS_LZFSE_COMPRESSED_BLOCK_V2_HEADER_SIZE		32
+
+/* The number of symbols
+ */
+#define LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS		20
+#define LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS		20
+#define LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS		64
+#define LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_SYMBOLS		256
+
+#define LIBFSAPFS_LZFSE_NUMBER_OF_SYMBOLS \
+	( LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_SYMBOLS + LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_SYMBOLS + LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_SYMBOLS + LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_SYMBOLS )
+
+/* The number of states
+ */
+#define LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_STATES		64
+#define LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_STATES		64
+#define LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_STATES		256
+#define LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES		1024
+
+/* The maximum number of matches and literals in a compressed block
+ */
+#define LIBFSAPFS_LZFSE_MATCHES_PER_BLOCK			10000
+#define LIBFSAPFS_LZFSE_LITERALS_PER_BLOCK			( 4 * LIBFSAPFS_LZFSE_MATCHES_PER_BLOCK )
+
+typedef struct libfsapfs_lzfse_value_decoder_entry libfsapfs_lzfse_value_decoder_entry_t;
+
+struct libfsapfs_lzfse_value_decoder_entry
+{
+	/* The number of bits, which consists of the number of state bits and value bits
+	 */
+	uint8_t number_of_bits;
+
+	/* The number of value bits
+	 */
+	uint8_t number_of_value_bits;
+
+	/* The state delta
+	 */
+	int16_t delta;
+
+	/* The value base
+	 */
+	int32_t value_base;
+};
+
+typedef struct libfsapfs_lzfse_decoder libfsapfs_lzfse_decoder_t;
+
+struct libfsapfs_lzfse_decoder
+{
+	/* The number of uncompressed bytes of the block
+	 */
+	uint32_t number_of_raw_bytes;
+
+	/* The number of literals
+	 */
+	uint32_t number_of_literals;
+
+	/* The number of L, M, D values
+	 */
+	uint32_t number_of_lmd_values;
+
+	/* The size of the literals data
+	 */
+	uint32_t literals_data_size;
+
+	/* The size of the L, M, D values data
+	 */
+	uint32_t lmd_values_data_size;
+
+	/* The number of bits in the last byte of the literals data
+	 */
+	int32_t literal_bits;
+
+	/* The literal states
+	 */
+	uint16_t literal_states[ 4 ];
+
+	/* The number of bits in the last byte of the L, M, D values data
+	 */
+	int32_t lmd_values_bits;
+
+	/* The L value state
+	 */
+	uint16_t l_value_state;
+
+	/* The M value state
+	 */
+	uint16_t m_value_state;
+
+	/* The D value state
+	 */
+	uint16_t d_value_state;
+
+	/* The frequency table, which contains the L, M, D value and literal frequencies
+	 */
+	uint16_t frequency_table[ LIBFSAPFS_LZFSE_NUMBER_OF_SYMBOLS ];
+
+	/* The literal decoder table
+	 * An entry contains the state delta in the upper 16 bits, the symbol in bits 8 to 15
+	 * and the number of bits in the lower 8 bits
+	 */
+	uint32_t literal_decoder_table[ LIBFSAPFS_LZFSE_NUMBER_OF_LITERAL_STATES ];
+
+	/* The L value decoder table
+	 */
+	libfsapfs_lzfse_value_decoder_entry_t l_value_decoder_table[ LIBFSAPFS_LZFSE_NUMBER_OF_L_VALUE_STATES ];
+
+	/* The M value decoder table
+	 */
+	libfsapfs_lzfse_value_decoder_entry_t m_value_decoder_table[ LIBFSAPFS_LZFSE_NUMBER_OF_M_VALUE_STATES ];
+
+	/* The D value decoder table
+	 */
+	libfsapfs_lzfse_value_decoder_entry_t d_value_decoder_table[ LIBFSAPFS_LZFSE_NUMBER_OF_D_VALUE_STATES ];
+
+	/* The literal values, which has 64 bytes of slack for wide copies
+	 */
+	uint8_t literal_values[ LIBFSAPFS_LZFSE_LITERALS_PER_BLOCK + 64 ];
+};
+
+int libfsapfs_lzfse_build_decoder_table(
+     int number_of_states,
+     int number_of_symbols,
+     const uint16_t *frequency_table,
+     uint32_t *decoder_table,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_build_value_decoder_table(
+     int number_of_states,
+     int number_of_symbols,
+     const uint16_t *frequency_table,
+     const uint8_t *value_bits_table,
+     const int32_t *value_base_table,
+     libfsapfs_lzfse_value_decoder_entry_t *value_decoder_table,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_read_block_v1_header(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_data_offset,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_read_block_v2_header(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_data_offset,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_read_compressed_frequency_table(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t *frequency_table,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_build_decoder_tables(
+     libfsapfs_lzfse_decoder_t *decoder,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_read_literal_values(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_read_lmd_values(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_read_block(
+     libfsapfs_lzfse_decoder_t *decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_data_offset,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error );
+
+int libfsapfs_lzfse_decompress(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_LZFSE_COMPRESSION_H ) */
+
@@ -318,6 +318,12 @@ uint8_t libfsapfs_lzvn_oppcode_types[ 256 ] = {
 	LIBFSAPFS_LZVN_OPPCODE_TYPE_MATCH_SMALL,	/* 0xff */
 };
 
+/* Lookup table to map a match distance of less than 8 to the smallest multiple
+ * of the distance that is 8 or more
+ */
+uint8_t libfsapfs_lzvn_pattern_distances[ 8 ] = {
+	0, 8, 8, 9, 8, 10, 12, 14 };
+
 /* Decompresses LIBFSAPFS_LZVN compressed data
  * Returns 1 on success or -1 on error
  */
@@ -330,6 +336,7 @@ int libfsapfs_lzvn_decompress(
 {
 	static char *function           = "libfsapfs_lzvn_decompress";
 	size_t compressed_data_offset   = 0;
+	size_t match_end_offset         = 0;
 	size_t match_offset             = 0;
 	size_t uncompressed_data_offset = 0;
 	uint16_t distance               = 0;
@@ -572,10 +579,23 @@ int libfsapfs_lzvn_decompress(
 
 				return( -1 );
 			}
-			if( memory_copy(
-			     &( uncompressed_data[ uncompressed_data_offset ] ),
-			     &( compressed_data[ compressed_data_offset ] ),
-			     (size_t) literal_size ) == NULL )
+			/* Small literals are copied as a single 16 byte chunk when both buffers
+			 * have sufficient slack, the bytes written past the literal are overwritten
+			 * by subsequent oppcodes
+			 */
+			if( ( literal_size <= 16 )
+			 && ( ( compressed_data_size - compressed_data_offset ) >= 16 )
+			 && ( ( *uncompressed_data_size - uncompressed_data_offset ) >= 16 ) )
+			{
+				memory_copy(
+				 &( uncompressed_data[ uncompressed_data_offset ] ),
+				 &( compressed_data[ compressed_data_offset ] ),
+				 16 );
+			}
+			else if( memory_copy(
+			          &( uncompressed_data[ uncompressed_data_offset ] ),
+			          &( compressed_data[ compressed_data_offset ] ),
+			          (size_t) literal_size ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
@@ -616,11 +636,74 @@ int libfsapfs_lzvn_decompress(
 
 				return( -1 );
 			}
-			while( match_size > 0 )
+			match_end_offset = uncompressed_data_offset + match_size;
+
+			if( distance == 1 )
 			{
-				uncompressed_data[ uncompressed_data_offset++ ] = uncompressed_data[ match_offset++ ];
+				memory_set(
+				 &( uncompressed_data[ uncompressed_data_offset ] ),
+				 uncompressed_data[ match_offset ],
+				 (size_t) match_size );
 
-				match_size--;
+				uncompressed_data_offset = match_end_offset;
+			}
+			else if( ( distance != 0 )
+			      && ( ( *uncompressed_data_size - match_end_offset ) >= 16 ) )
+			{
+				/* The uncompressed data has sufficient slack to copy the match
+				 * in chunks that can extend up to 15 bytes past its end
+				 */
+				if( distance < 8 )
+				{
+					/* The first 8 bytes of an overlapping match are copied one at a time,
+					 * after which the pattern repeats at a distance of 8 or more
+					 */
+					uncompressed_data[ uncompressed_data_offset ]     = uncompressed_data[ match_offset ];
+					uncompressed_data[ uncompressed_data_offset + 1 ] = uncompressed_data[ match_offset + 1 ];
+					uncompressed_data[ uncompressed_data_offset + 2 ] = uncompressed_data[ match_offset + 2 ];
+					uncompressed_data[ uncompressed_data_offset + 3 ] = uncompressed_data[ match_offset + 3 ];
+					uncompressed_data[ uncompressed_data_offset + 4 ] = uncompressed_data[ match_offset + 4 ];
+					uncompressed_data[ uncompressed_data_offset + 5 ] = uncompressed_data[ match_offset + 5 ];
+					uncompressed_data[ uncompressed_data_offset + 6 ] = uncompressed_data[ match_offset + 6 ];
+					uncompressed_data[ uncompressed_data_offset + 7 ] = uncompressed_data[ match_offset + 7 ];
+
+					uncompressed_data_offset += 8;
+					match_offset              = uncompressed_data_offset - libfsapfs_lzvn_pattern_distances[ distance ];
+				}
+				if( distance >= 16 )
+				{
+					while( uncompressed_data_offset < match_end_offset )
+					{
+						memory_copy(
+						 &( uncompressed_data[ uncompressed_data_offset ] ),
+						 &( uncompressed_data[ match_offset ] ),
+						 16 );
+
+						uncompressed_data_offset += 16;
+						match_offset             += 16;
+					}
+				}
+				else
+				{
+					while( uncompressed_data_offset < match_end_offset )
+					{
+						memory_copy(
+						 &( uncompressed_data[ uncompressed_data_offset ] ),
+						 &( uncompressed_data[ match_offset ] ),
+						 8 );
+
+						uncompressed_data_offset += 8;
+						match_offset             += 8;
+					}
+				}
+				uncompressed_data_offset = match_end_offset;
+			}
+			else
+			{
+				while( uncompressed_data_offset < match_end_offset )
+				{
+					uncompressed_data[ uncompressed_data_offset++ ] = uncompressed_data[ match_offset++ ];
+				}
 			}
 		}
 	}
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
@@ -29,6 +30,10 @@
 #include "libfsapfs_libuna.h"
 #include "libfsapfs_name.h"
 
+/* The size of the buffer of UTF-32 stream data of which the checksum is calculated at once
+ */
+#define LIBFSAPFS_NAME_HASH_UTF32_STREAM_SIZE	512
+
 libfsapfs_name_decomposition_mapping_t special_case_folding_000000df = { 2, { 0x00000073, 0x00000073 } };
 libfsapfs_name_decomposition_mapping_t special_case_folding_00000130 = { 2, { 0x00000069, 0x00000307 } };
 libfsapfs_name_decomposition_mapping_t special_case_folding_00000149 = { 2, { 0x000002bc, 0x0000006e } };
@@ -132,22 +137,16 @@ int libfsapfs_name_hash_calculate_from_utf8_string(
      libcerror_error_t **error )
 {
 	libfsapfs_name_decomposition_mapping_t single_nfd_mapping = { 1, { 0 } };
+	uint8_t utf32_stream[ LIBFSAPFS_NAME_HASH_UTF32_STREAM_SIZE ];
 
 	libfsapfs_name_decomposition_mapping_t *nfd_mapping       = NULL;
 	static char *function                                     = "libfsapfs_name_hash_calculate_from_utf8_string";
 	libuna_unicode_character_t unicode_character              = 0;
 	size_t utf8_string_index                                  = 0;
+	size_t utf32_stream_index                                 = 0;
 	uint32_t calculated_checksum                              = 0;
-	uint32_t checksum_table_index                             = 0;
-	uint8_t byte_value                                        = 0;
 	uint8_t nfd_character_index                               = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t utf32_stream[ 512 ];
-
-	size_t utf32_stream_index                                 = 0;
-#endif
-
 	if( name_hash == NULL )
 	{
 		libcerror_error_set(
@@ -361,56 +360,28 @@ int libfsapfs_name_hash_calculate_from_utf8_string(
 		     nfd_character_index < nfd_mapping->number_of_characters;
 		     nfd_character_index++ )
 		{
-			unicode_character = nfd_mapping->characters[ nfd_character_index ];
-
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-			unicode_character  >>= 8;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
-			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
-			}
-#endif
+			byte_stream_copy_from_uint32_little_endian(
+			 &( utf32_stream[ utf32_stream_index ] ),
+			 nfd_mapping->characters[ nfd_character_index ] );
 
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-			unicode_character  >>= 8;
+			utf32_stream_index += 4;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
+			if( utf32_stream_index >= LIBFSAPFS_NAME_HASH_UTF32_STREAM_SIZE )
 			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
-			}
-#endif
+				calculated_checksum = libfsapfs_checksum_update_crc32(
+				                       calculated_checksum,
+				                       utf32_stream,
+				                       utf32_stream_index );
 
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-			unicode_character  >>= 8;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
-			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
-			}
-#endif
-
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
-			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
+				utf32_stream_index = 0;
 			}
-#endif
 		}
 	}
+	calculated_checksum = libfsapfs_checksum_update_crc32(
+	                       calculated_checksum,
+	                       utf32_stream,
+	                       utf32_stream_index );
+
 	*name_hash = calculated_checksum & 0x003fffffUL;
 
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -453,22 +424,16 @@ int libfsapfs_name_hash_calculate_from_utf16_string(
      libcerror_error_t **error )
 {
 	libfsapfs_name_decomposition_mapping_t single_nfd_mapping = { 1, { 0 } };
+	uint8_t utf32_stream[ LIBFSAPFS_NAME_HASH_UTF32_STREAM_SIZE ];
 
 	libfsapfs_name_decomposition_mapping_t *nfd_mapping       = NULL;
 	static char *function                                     = "libfsapfs_name_hash_calculate_from_utf16_string";
 	libuna_unicode_character_t unicode_character              = 0;
 	size_t utf16_string_index                                 = 0;
+	size_t utf32_stream_index                                 = 0;
 	uint32_t calculated_checksum                              = 0;
-	uint32_t checksum_table_index                             = 0;
-	uint8_t byte_value                                        = 0;
 	uint8_t nfd_character_index                               = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t utf32_stream[ 512 ];
-
-	size_t utf32_stream_index                                 = 0;
-#endif
-
 	if( name_hash == NULL )
 	{
 		libcerror_error_set(
@@ -682,56 +647,28 @@ int libfsapfs_name_hash_calculate_from_utf16_string(
 		     nfd_character_index < nfd_mapping->number_of_characters;
 		     nfd_character_index++ )
 		{
-			unicode_character = nfd_mapping->characters[ nfd_character_index ];
-
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-			unicode_character  >>= 8;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
-			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
-			}
-#endif
+			byte_stream_copy_from_uint32_little_endian(
+			 &( utf32_stream[ utf32_stream_index ] ),
+			 nfd_mapping->characters[ nfd_character_index ] );
 
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-			unicode_character  >>= 8;
+			utf32_stream_index += 4;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
+			if( utf32_stream_index >= LIBFSAPFS_NAME_HASH_UTF32_STREAM_SIZE )
 			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
-			}
-#endif
-
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-			unicode_character  >>= 8;
+				calculated_checksum = libfsapfs_checksum_update_crc32(
+				                       calculated_checksum,
+				                       utf32_stream,
+				                       utf32_stream_index );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
-			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
+				utf32_stream_index = 0;
 			}
-#endif
-
-			byte_value           = (uint8_t) ( unicode_character & 0x000000ffUL );
-			checksum_table_index = ( calculated_checksum ^ (uint32_t) byte_value ) & 0x000000ffUL;
-			calculated_checksum  = libfsapfs_checksum_crc32_table[ checksum_table_index ] ^ ( calculated_checksum >> 8 );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( utf32_stream_index < 512 )
-			{
-				utf32_stream[ utf32_stream_index++ ] = byte_value;
-			}
-#endif
 		}
 	}
+	calculated_checksum = libfsapfs_checksum_update_crc32(
+	                       calculated_checksum,
+	                       utf32_stream,
+	                       utf32_stream_index );
+
 	*name_hash = calculated_checksum & 0x003fffffUL;
 
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -73,6 +73,11 @@ int libfsapfs_object_read_data(
      size_t data_size,
      libcerror_error_t **error );
 
+int libfsapfs_object_verify_checksum(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -26,16 +26,20 @@
 
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_node.h"
+#include "libfsapfs_btree_node_cache.h"
 #include "libfsapfs_data_block.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_object.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_descriptor_cache.h"
 
 #include "fsapfs_object.h"
 #include "fsapfs_object_map.h"
@@ -51,7 +55,9 @@ int libfsapfs_object_map_btree_initialize(
      uint64_t root_node_block_number,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_object_map_btree_initialize";
+	static char *function                          = "libfsapfs_object_map_btree_initialize";
+	int maximum_number_of_cache_entries            = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
+	int maximum_number_of_descriptor_cache_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_OBJECT_MAP_DESCRIPTORS;
 
 	if( object_map_btree == NULL )
 	{
@@ -122,9 +128,14 @@ int libfsapfs_object_map_btree_initialize(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
+	if( io_handle != NULL )
+	{
+		maximum_number_of_cache_entries            = io_handle->maximum_number_of_cached_btree_nodes;
+		maximum_number_of_descriptor_cache_entries = io_handle->maximum_number_of_cached_object_map_descriptors;
+	}
+	if( libfsapfs_btree_node_cache_initialize(
 	     &( ( *object_map_btree )->node_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES,
+	     maximum_number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -136,6 +147,35 @@ int libfsapfs_object_map_btree_initialize(
 
 		goto on_error;
 	}
+	if( libfsapfs_object_map_descriptor_cache_initialize(
+	     &( ( *object_map_btree )->descriptor_cache ),
+	     maximum_number_of_descriptor_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create descriptor cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *object_map_btree )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *object_map_btree )->io_handle              = io_handle;
 	( *object_map_btree )->data_block_vector      = data_block_vector;
 	( *object_map_btree )->root_node_block_number = root_node_block_number;
@@ -145,6 +185,24 @@ int libfsapfs_object_map_btree_initialize(
 on_error:
 	if( *object_map_btree != NULL )
 	{
+		if( ( *object_map_btree )->descriptor_cache != NULL )
+		{
+			libfsapfs_object_map_descriptor_cache_free(
+			 &( ( *object_map_btree )->descriptor_cache ),
+			 NULL );
+		}
+		if( ( *object_map_btree )->node_cache != NULL )
+		{
+			libfsapfs_btree_node_cache_free(
+			 &( ( *object_map_btree )->node_cache ),
+			 NULL );
+		}
+		if( ( *object_map_btree )->data_block_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *object_map_btree )->data_block_cache ),
+			 NULL );
+		}
 		memory_free(
 		 *object_map_btree );
 
@@ -178,7 +236,35 @@ int libfsapfs_object_map_btree_free(
 	{
 		/* The data_block_vector is referenced and freed elsewhere
 		 */
-		if( libfcache_cache_free(
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *object_map_btree )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libfsapfs_object_map_descriptor_cache_free(
+		     &( ( *object_map_btree )->descriptor_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free descriptor cache.",
+			 function );
+
+			result = -1;
+		}
+		if( libfsapfs_btree_node_cache_free(
 		     &( ( *object_map_btree )->node_cache ),
 		     error ) != 1 )
 		{
@@ -212,6 +298,238 @@ int libfsapfs_object_map_btree_free(
 	return( result );
 }
 
+/* Reads a object map B-tree node
+ * The read/write lock is only held while the data block is retrieved, since the data block cache
+ * is shared by the readers of the B-tree. The node is read from a copy of the data block data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_btree_read_node(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t node_block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *safe_node  = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	uint8_t *node_data                 = NULL;
+	static char *function              = "libfsapfs_object_map_btree_read_node";
+	size_t node_data_size              = 0;
+	int result                         = 1;
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_block_number > (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid node value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_initialize(
+	     &safe_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create B-tree node.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     object_map_btree->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		libfsapfs_btree_node_free(
+		 &safe_node,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_vector_get_element_value_by_index(
+	     object_map_btree->data_block_vector,
+	     (intptr_t *) file_io_handle,
+	     (libfdata_cache_t *) object_map_btree->data_block_cache,
+	     (int) node_block_number,
+	     (intptr_t **) &data_block,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data block: %" PRIu64 ".",
+		 function,
+		 node_block_number );
+
+		result = -1;
+	}
+	else if( data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block: %" PRIu64 ".",
+		 function,
+		 node_block_number );
+
+		result = -1;
+	}
+	/* The data block can be evicted from the data block cache once the read/write
+	 * lock is released, hence its data is copied while the lock is held
+	 */
+	if( result == 1 )
+	{
+		node_data_size = data_block->data_size;
+
+		node_data = (uint8_t *) memory_allocate(
+		                         sizeof( uint8_t ) * node_data_size );
+
+		if( node_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create node data.",
+			 function );
+
+			result = -1;
+		}
+		else if( memory_copy(
+		          node_data,
+		          data_block->data,
+		          node_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy node data.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     object_map_btree->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( ( result == 1 )
+	 && ( object_map_btree->io_handle != NULL )
+	 && ( object_map_btree->io_handle->verify_object_checksums != 0 ) )
+	{
+		if( libfsapfs_object_verify_checksum(
+		     node_data,
+		     node_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+			 "%s: unable to verify B-tree node checksum.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfsapfs_btree_node_read_data(
+		     safe_node,
+		     node_data,
+		     node_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( node_data != NULL )
+	{
+		memory_free(
+		 node_data );
+	}
+	if( result != 1 )
+	{
+		libfsapfs_btree_node_free(
+		 &safe_node,
+		 NULL );
+
+		return( -1 );
+	}
+	*node = safe_node;
+
+	return( 1 );
+}
+
 /* Retrieves the object map B-tree root node
  * Returns 1 if successful or -1 on error
  */
@@ -222,14 +540,12 @@ int libfsapfs_object_map_btree_get_root_node(
      libfsapfs_btree_node_t **root_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_object_map_btree_get_root_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node     = NULL;
+	static char *function            = "libfsapfs_object_map_btree_get_root_node";
+	int result                       = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp = 0;
 #endif
 
 	if( object_map_btree == NULL )
@@ -285,12 +601,10 @@ int libfsapfs_object_map_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_btree_node_cache_get_node(
 	          object_map_btree->node_cache,
-	          0,
-	          (off64_t) root_node_block_number,
-	          0,
-	          &cache_value,
+	          root_node_block_number,
+	          root_node,
 	          error );
 
 	if( result == -1 )
@@ -299,69 +613,27 @@ int libfsapfs_object_map_btree_get_root_node(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value from cache.",
+		 "%s: unable to retrieve node from cache.",
 		 function );
 
 		goto on_error;
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
-		     object_map_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) object_map_btree->data_block_cache,
-		     (int) root_node_block_number,
-		     (intptr_t **) &data_block,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data block: %" PRIu64 ".",
-			 function,
-			 root_node_block_number );
-
-			goto on_error;
-		}
-		if( data_block == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid data block: %" PRIu64 ".",
-			 function,
-			 root_node_block_number );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_initialize(
+		if( libfsapfs_object_map_btree_read_node(
+		     object_map_btree,
+		     file_io_handle,
+		     root_node_block_number,
 		     &node,
 		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
-		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 "%s: unable to read B-tree node: %" PRIu64 ".",
+			 function,
+			 root_node_block_number );
 
 			goto on_error;
 		}
@@ -435,44 +707,23 @@ int libfsapfs_object_map_btree_get_root_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_btree_node_cache_set_node(
 		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     root_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*root_node = node;
 		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
-			 function );
-
-			goto on_error;
-		}
 	}
 #if defined( HAVE_PROFILER )
 	if( object_map_btree->io_handle->profiler != NULL )
@@ -497,20 +748,6 @@ int libfsapfs_object_map_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve root node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -533,14 +770,12 @@ int libfsapfs_object_map_btree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_object_map_btree_get_sub_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node     = NULL;
+	static char *function            = "libfsapfs_object_map_btree_get_sub_node";
+	int result                       = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp = 0;
 #endif
 
 	if( object_map_btree == NULL )
@@ -596,12 +831,10 @@ int libfsapfs_object_map_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_btree_node_cache_get_node(
 	          object_map_btree->node_cache,
-	          0,
-	          (off64_t) sub_node_block_number,
-	          0,
-	          &cache_value,
+	          sub_node_block_number,
+	          sub_node,
 	          error );
 
 	if( result == -1 )
@@ -610,69 +843,27 @@ int libfsapfs_object_map_btree_get_sub_node(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value from cache.",
+		 "%s: unable to retrieve node from cache.",
 		 function );
 
 		goto on_error;
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
-		     object_map_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) object_map_btree->data_block_cache,
-		     (int) sub_node_block_number,
-		     (intptr_t **) &data_block,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data block: %" PRIu64 ".",
-			 function,
-			 sub_node_block_number );
-
-			goto on_error;
-		}
-		if( data_block == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid data block: %" PRIu64 ".",
-			 function,
-			 sub_node_block_number );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_initialize(
+		if( libfsapfs_object_map_btree_read_node(
+		     object_map_btree,
+		     file_io_handle,
+		     sub_node_block_number,
 		     &node,
 		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
-		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 "%s: unable to read B-tree node: %" PRIu64 ".",
+			 function,
+			 sub_node_block_number );
 
 			goto on_error;
 		}
@@ -713,44 +904,23 @@ int libfsapfs_object_map_btree_get_sub_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_btree_node_cache_set_node(
 		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     sub_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*sub_node = node;
 		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
-			 function );
-
-			goto on_error;
-		}
 	}
 #if defined( HAVE_PROFILER )
 	if( object_map_btree->io_handle->profiler != NULL )
@@ -775,20 +945,6 @@ int libfsapfs_object_map_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -802,22 +958,29 @@ on_error:
 }
 
 /* Retrieves an entry for a specific identifier from the object map B-tree node
+ * The entry of the most recent version of the object with a transaction identifier
+ * equal to or less than the transaction identifier is returned
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libfsapfs_btree_node_t *node,
      uint64_t object_identifier,
+     uint64_t transaction_identifier,
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	static char *function                   = "libfsapfs_object_map_btree_get_entry_from_node_by_identifier";
-	uint64_t object_map_identifier          = 0;
-	int btree_entry_index                   = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
+	libfsapfs_btree_entry_t *entry                 = NULL;
+	libfsapfs_btree_entry_t *lower_entry           = NULL;
+	static char *function                          = "libfsapfs_object_map_btree_get_entry_from_node_by_identifier";
+	uint64_t lower_object_map_identifier           = 0;
+	uint64_t object_map_identifier                 = 0;
+	uint64_t object_map_transaction_identifier     = 0;
+	int btree_entry_index                          = 0;
+	int is_leaf_node                               = 0;
+	int lower_entry_index                          = 0;
+	int number_of_entries                          = 0;
+	int upper_entry_index                          = 0;
 
 	if( object_map_btree == NULL )
 	{
@@ -845,9 +1008,10 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: retrieving B-tree entry identifier: %" PRIu64 ".\n",
+		 "%s: retrieving B-tree entry identifier: %" PRIu64 ", transaction: %" PRIu64 ".\n",
 		 function,
-		 object_identifier );
+		 object_identifier,
+		 transaction_identifier );
 	}
 #endif
 	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
@@ -879,10 +1043,17 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
+	/* The entries are stored sorted by identifier and transaction identifier,
+	 * a binary search is used to determine the last entry with a key equal to
+	 * or less than the object identifier and transaction identifier (lower entry)
+	 */
+	lower_entry_index = 0;
+	upper_entry_index = number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
 	{
+		btree_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
 		if( libfsapfs_btree_node_get_entry_by_index(
 		     node,
 		     btree_entry_index,
@@ -922,7 +1093,7 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 
 			return( -1 );
 		}
-		if( entry->key_data_size < 8 )
+		if( entry->key_data_size < 16 )
 		{
 			libcerror_error_set(
 			 error,
@@ -938,52 +1109,46 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 		 entry->key_data,
 		 object_map_identifier );
 
+		byte_stream_copy_to_uint64_little_endian(
+		 &( entry->key_data[ 8 ] ),
+		 object_map_transaction_identifier );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 "\n",
+			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", transaction: %" PRIu64 "\n",
 			 function,
 			 btree_entry_index,
-			 object_map_identifier );
+			 object_map_identifier,
+			 object_map_transaction_identifier );
 		}
 #endif
-		if( object_map_identifier > object_identifier )
+		if( ( object_map_identifier < object_identifier )
+		 || ( ( object_map_identifier == object_identifier )
+		  &&  ( object_map_transaction_identifier <= transaction_identifier ) ) )
 		{
-			break;
-		}
-		if( is_leaf_node != 0 )
-		{
-			if( object_map_identifier == object_identifier )
-			{
-				*btree_entry = entry;
-
-				return( 1 );
-			}
+			lower_entry                 = entry;
+			lower_object_map_identifier = object_map_identifier;
+			lower_entry_index           = btree_entry_index + 1;
 		}
 		else
 		{
-			if( object_map_identifier >= object_identifier )
-			{
-				if( ( previous_entry == NULL )
-				 || ( object_map_identifier == object_identifier ) )
-				{
-					previous_entry = entry;
-				}
-				*btree_entry = previous_entry;
-
-				return( 1 );
-			}
-			previous_entry = entry;
+			upper_entry_index = btree_entry_index;
 		}
 	}
-	if( is_leaf_node == 0 )
+	if( lower_entry == NULL )
 	{
-		*btree_entry = previous_entry;
-
-		return( 1 );
+		return( 0 );
 	}
-	return( 0 );
+	if( ( is_leaf_node != 0 )
+	 && ( lower_object_map_identifier != object_identifier ) )
+	{
+		return( 0 );
+	}
+	*btree_entry = lower_entry;
+
+	return( 1 );
 }
 
 /* Retrieves an entry for a specific identifier from the object map B-tree
@@ -993,6 +1158,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libbfio_handle_t *file_io_handle,
      uint64_t object_identifier,
+     uint64_t transaction_identifier,
      libfsapfs_btree_node_t **btree_node,
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error )
@@ -1087,6 +1253,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 		          object_map_btree,
 		          node,
 		          object_identifier,
+		          transaction_identifier,
 		          &entry,
 		          error );
 
@@ -1185,18 +1352,27 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 }
 
 /* Retrieves the object map descriptor of a specific object identifier
+ * The descriptor of the most recent version of the object with a transaction identifier
+ * equal to or less than the transaction identifier is returned, where
+ * LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER refers to the most recent version overall
+ * The descriptor cache is consulted before the object map B-tree is traversed
  * Returns 1 if successful, 0 if no such value or -1 on error
  */
 int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libbfio_handle_t *file_io_handle,
      uint64_t object_identifier,
+     uint64_t transaction_identifier,
      libfsapfs_object_map_descriptor_t **descriptor,
      libcerror_error_t **error )
 {
+	libfsapfs_object_map_descriptor_t cached_descriptor;
+
 	libfsapfs_btree_entry_t *entry = NULL;
 	libfsapfs_btree_node_t *node   = NULL;
 	static char *function          = "libfsapfs_object_map_btree_get_descriptor_by_object_identifier";
+	int access_epoch               = 0;
+	int access_started             = 0;
 	int result                     = 0;
 
 	if( object_map_btree == NULL )
@@ -1232,10 +1408,69 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
 
 		return( -1 );
 	}
+	if( object_map_btree->descriptor_cache != NULL )
+	{
+		result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+		          object_map_btree->descriptor_cache,
+		          object_identifier,
+		          transaction_identifier,
+		          &cached_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve descriptor from cache.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libfsapfs_object_map_descriptor_initialize(
+			     descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create object map descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			**descriptor = cached_descriptor;
+
+			return( 1 );
+		}
+	}
+	/* The B-tree nodes are referenced from the node cache until the access has ended
+	 */
+	if( libfsapfs_btree_node_cache_begin_access(
+	     object_map_btree->node_cache,
+	     &access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin node cache access.",
+		 function );
+
+		goto on_error;
+	}
+	access_started = 1;
+
 	result = libfsapfs_object_map_btree_get_entry_by_identifier(
 	          object_map_btree,
 	          file_io_handle,
 	          object_identifier,
+	          transaction_identifier,
 	          &node,
 	          &entry,
 	          error );
@@ -1319,10 +1554,52 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
 			goto on_error;
 		}
 		node = NULL;
+
+		if( object_map_btree->descriptor_cache != NULL )
+		{
+			if( libfsapfs_object_map_descriptor_cache_set_descriptor(
+			     object_map_btree->descriptor_cache,
+			     transaction_identifier,
+			     *descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set descriptor in cache.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	access_started = 0;
+
+	if( libfsapfs_btree_node_cache_end_access(
+	     object_map_btree->node_cache,
+	     access_epoch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end node cache access.",
+		 function );
+
+		goto on_error;
 	}
 	return( result );
 
 on_error:
+	if( access_started != 0 )
+	{
+		libfsapfs_btree_node_cache_end_access(
+		 object_map_btree->node_cache,
+		 access_epoch,
+		 NULL );
+	}
 	if( *descriptor != NULL )
 	{
 		libfsapfs_object_map_descriptor_free(
@@ -27,12 +27,15 @@
 
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_node.h"
+#include "libfsapfs_btree_node_cache.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_descriptor_cache.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -56,11 +59,22 @@ struct libfsapfs_object_map_btree
 
 	/* The node cache
 	 */
-	libfcache_cache_t *node_cache;
+	libfsapfs_btree_node_cache_t *node_cache;
+
+	/* The descriptor cache
+	 */
+	libfsapfs_object_map_descriptor_cache_t *descriptor_cache;
 
 	/* Block number of B-tree root node
 	 */
 	uint64_t root_node_block_number;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 * The lock protects the data block cache, the node and descriptor caches have their own locks
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libfsapfs_object_map_btree_initialize(
@@ -74,6 +88,13 @@ int libfsapfs_object_map_btree_free(
      libfsapfs_object_map_btree_t **object_map_btree,
      libcerror_error_t **error );
 
+int libfsapfs_object_map_btree_read_node(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t node_block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
 int libfsapfs_object_map_btree_get_root_node(
      libfsapfs_object_map_btree_t *object_map_btree,
      libbfio_handle_t *file_io_handle,
@@ -92,6 +113,7 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libfsapfs_btree_node_t *node,
      uint64_t object_identifier,
+     uint64_t transaction_identifier,
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error );
 
@@ -99,6 +121,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libbfio_handle_t *file_io_handle,
      uint64_t object_identifier,
+     uint64_t transaction_identifier,
      libfsapfs_btree_node_t **btree_node,
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error );
@@ -107,6 +130,7 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libbfio_handle_t *file_io_handle,
      uint64_t object_identifier,
+     uint64_t transaction_identifier,
      libfsapfs_object_map_descriptor_t **descriptor,
      libcerror_error_t **error );
 
@@ -0,0 +1,864 @@
+/*
+ * The object map descriptor cache functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_DEBUG_OUTPUT )
+#include "libfsapfs_libcnotify.h"
+#endif
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_descriptor_cache.h"
+
+/* Creates an object map descriptor cache
+ * Make sure the value descriptor_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_initialize(
+     libfsapfs_object_map_descriptor_cache_t **descriptor_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_descriptor_cache_initialize";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int shard_index       = 0;
+#endif
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *descriptor_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid object map descriptor cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*descriptor_cache = memory_allocate_structure(
+	                     libfsapfs_object_map_descriptor_cache_t );
+
+	if( *descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create object map descriptor cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *descriptor_cache,
+	     0,
+	     sizeof( libfsapfs_object_map_descriptor_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear object map descriptor cache.",
+		 function );
+
+		memory_free(
+		 *descriptor_cache );
+
+		*descriptor_cache = NULL;
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_descriptor_cache_allocate_entries(
+	     *descriptor_cache,
+	     maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *descriptor_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *descriptor_cache )->shards[ shard_index ].mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex of shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *descriptor_cache != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		for( shard_index = 0;
+		     shard_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			if( ( *descriptor_cache )->shards[ shard_index ].mutex != NULL )
+			{
+				libcthreads_mutex_free(
+				 &( ( *descriptor_cache )->shards[ shard_index ].mutex ),
+				 NULL );
+			}
+		}
+		if( ( *descriptor_cache )->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *descriptor_cache )->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( ( *descriptor_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *descriptor_cache )->entries );
+		}
+		memory_free(
+		 *descriptor_cache );
+
+		*descriptor_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an object map descriptor cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_free(
+     libfsapfs_object_map_descriptor_cache_t **descriptor_cache,
+     libcerror_error_t **error )
+{
+	static char *function     = "libfsapfs_object_map_descriptor_cache_free";
+	int result                = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+#endif
+#if defined( HAVE_DEBUG_OUTPUT ) || defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	int shard_index           = 0;
+#endif
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *descriptor_cache != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			for( shard_index = 0;
+			     shard_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS;
+			     shard_index++ )
+			{
+				number_of_hits   += ( *descriptor_cache )->shards[ shard_index ].number_of_hits;
+				number_of_misses += ( *descriptor_cache )->shards[ shard_index ].number_of_misses;
+			}
+			libcnotify_printf(
+			 "%s: number of hits\t\t\t: %" PRIu64 "\n",
+			 function,
+			 number_of_hits );
+
+			libcnotify_printf(
+			 "%s: number of misses\t\t\t: %" PRIu64 "\n",
+			 function,
+			 number_of_misses );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		for( shard_index = 0;
+		     shard_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *descriptor_cache )->shards[ shard_index ].mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex of shard: %d.",
+				 function,
+				 shard_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( ( *descriptor_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *descriptor_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *descriptor_cache )->entries );
+		}
+		memory_free(
+		 *descriptor_cache );
+
+		*descriptor_cache = NULL;
+	}
+	return( result );
+}
+
+/* Allocates the entries of the object map descriptor cache
+ * The number of sets is the largest power of 2 for which the number of entries
+ * does not exceed the maximum number of entries, with a minimum of 1 set
+ * Any previously cached entries are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_allocate_entries(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_descriptor_cache_entry_t *entries = NULL;
+	static char *function                                  = "libfsapfs_object_map_descriptor_cache_allocate_entries";
+	size_t entries_size                                    = 0;
+	uint32_t number_of_sets                                = 1;
+	int shard_index                                        = 0;
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( number_of_sets < ( (uint32_t) INT32_MAX / ( 2 * LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS ) ) )
+	    && ( ( number_of_sets * 2 * LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS ) <= (uint32_t) maximum_number_of_entries ) )
+	{
+		number_of_sets *= 2;
+	}
+	entries_size = (size_t) number_of_sets * LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS * sizeof( libfsapfs_object_map_descriptor_cache_entry_t );
+
+	if( ( entries_size == 0 )
+	 || ( entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entries size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries = (libfsapfs_object_map_descriptor_cache_entry_t *) memory_allocate(
+	                                                             entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 entries );
+
+		return( -1 );
+	}
+	if( descriptor_cache->entries != NULL )
+	{
+		memory_free(
+		 descriptor_cache->entries );
+	}
+	descriptor_cache->entries        = entries;
+	descriptor_cache->number_of_sets = number_of_sets;
+
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		descriptor_cache->shards[ shard_index ].current_time = 0;
+	}
+
+	return( 1 );
+}
+
+/* Resizes the object map descriptor cache
+ * The cached entries are discarded, the hit and miss counters are retained
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_resize(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_descriptor_cache_resize";
+	int result            = 1;
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     descriptor_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_object_map_descriptor_cache_allocate_entries(
+	     descriptor_cache,
+	     maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     descriptor_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the object map descriptor of a specific object identifier and lookup transaction identifier
+ * The descriptor is copied since the cache entry can be replaced by another
+ * reader once the lock is released
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_get_descriptor(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     uint64_t object_identifier,
+     uint64_t transaction_identifier,
+     libfsapfs_object_map_descriptor_t *descriptor,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_descriptor_cache_entry_t *entry = NULL;
+	libfsapfs_object_map_descriptor_cache_shard_t *shard = NULL;
+	static char *function                                = "libfsapfs_object_map_descriptor_cache_get_descriptor";
+	uint32_t entry_index                                 = 0;
+	uint32_t set_index                                   = 0;
+	int result                                           = 0;
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     descriptor_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set_index = (uint32_t) ( ( ( object_identifier ^ transaction_identifier ) * 0x9e3779b97f4a7c15UL ) >> 32 ) & ( descriptor_cache->number_of_sets - 1 );
+
+	shard = &( descriptor_cache->shards[ set_index & ( LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS - 1 ) ] );
+
+	/* The mutex of the shard is needed since the counters and the last used time are updated
+	 */
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex of shard.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 descriptor_cache->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	entry = &( descriptor_cache->entries[ set_index * LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		if( ( entry[ entry_index ].is_set != 0 )
+		 && ( entry[ entry_index ].descriptor.identifier == object_identifier )
+		 && ( entry[ entry_index ].transaction_identifier == transaction_identifier ) )
+		{
+			shard->current_time += 1;
+
+			entry[ entry_index ].last_used_time = shard->current_time;
+
+			*descriptor = entry[ entry_index ].descriptor;
+
+			result = 1;
+
+			break;
+		}
+	}
+	if( result != 0 )
+	{
+		shard->number_of_hits += 1;
+	}
+	else
+	{
+		shard->number_of_misses += 1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex of shard.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     descriptor_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the object map descriptor of its object identifier and a lookup transaction identifier
+ * The lookup transaction identifier is the transaction identifier the descriptor was
+ * retrieved for, which can differ from the transaction identifier of the descriptor
+ * The least recently used entry of the set is replaced if the set is full
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_set_descriptor(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     uint64_t transaction_identifier,
+     const libfsapfs_object_map_descriptor_t *descriptor,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_descriptor_cache_entry_t *entry = NULL;
+	libfsapfs_object_map_descriptor_cache_shard_t *shard = NULL;
+	static char *function                                = "libfsapfs_object_map_descriptor_cache_set_descriptor";
+	uint32_t entry_index                                 = 0;
+	uint32_t replace_entry_index                         = 0;
+	uint32_t set_index                                   = 0;
+	int result                                           = 1;
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     descriptor_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set_index = (uint32_t) ( ( ( descriptor->identifier ^ transaction_identifier ) * 0x9e3779b97f4a7c15UL ) >> 32 ) & ( descriptor_cache->number_of_sets - 1 );
+
+	shard = &( descriptor_cache->shards[ set_index & ( LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS - 1 ) ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex of shard.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 descriptor_cache->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	entry = &( descriptor_cache->entries[ set_index * LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		/* Reuse the entry of the same object identifier and lookup transaction identifier or an unused entry
+		 */
+		if( ( entry[ entry_index ].is_set == 0 )
+		 || ( ( entry[ entry_index ].descriptor.identifier == descriptor->identifier )
+		  &&  ( entry[ entry_index ].transaction_identifier == transaction_identifier ) ) )
+		{
+			replace_entry_index = entry_index;
+
+			break;
+		}
+		if( entry[ entry_index ].last_used_time < entry[ replace_entry_index ].last_used_time )
+		{
+			replace_entry_index = entry_index;
+		}
+	}
+	shard->current_time += 1;
+
+	entry[ replace_entry_index ].descriptor             = *descriptor;
+	entry[ replace_entry_index ].transaction_identifier = transaction_identifier;
+	entry[ replace_entry_index ].last_used_time         = shard->current_time;
+	entry[ replace_entry_index ].is_set                 = 1;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex of shard.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     descriptor_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of cache hits and misses
+ * The counters are summed over the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_descriptor_cache_get_statistics(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_descriptor_cache_get_statistics";
+	uint64_t safe_hits    = 0;
+	uint64_t safe_misses  = 0;
+	int shard_index       = 0;
+
+	if( descriptor_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map descriptor cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     descriptor_cache->shards[ shard_index ].mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex of shard: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_hits   += descriptor_cache->shards[ shard_index ].number_of_hits;
+		safe_misses += descriptor_cache->shards[ shard_index ].number_of_misses;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     descriptor_cache->shards[ shard_index ].mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex of shard: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_hits;
+	*number_of_misses = safe_misses;
+
+	return( 1 );
+}
+
@@ -0,0 +1,162 @@
+/*
+ * The object map descriptor cache functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_H )
+#define _LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_object_map_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of entries per set of the object map descriptor cache
+ */
+#define LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_WAYS	4
+
+/* The number of shards of the object map descriptor cache, where every shard has its own lock
+ * This value must be a power of 2
+ */
+#define LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS	16
+
+typedef struct libfsapfs_object_map_descriptor_cache_entry libfsapfs_object_map_descriptor_cache_entry_t;
+
+struct libfsapfs_object_map_descriptor_cache_entry
+{
+	/* The object map descriptor
+	 */
+	libfsapfs_object_map_descriptor_t descriptor;
+
+	/* The lookup transaction identifier
+	 */
+	uint64_t transaction_identifier;
+
+	/* The last time the entry was used
+	 */
+	uint64_t last_used_time;
+
+	/* Value to indicate the entry is set
+	 */
+	uint8_t is_set;
+};
+
+typedef struct libfsapfs_object_map_descriptor_cache_shard libfsapfs_object_map_descriptor_cache_shard_t;
+
+struct libfsapfs_object_map_descriptor_cache_shard
+{
+	/* The current time
+	 */
+	uint64_t current_time;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+typedef struct libfsapfs_object_map_descriptor_cache libfsapfs_object_map_descriptor_cache_t;
+
+/* The object map descriptor cache maps virtual object identifiers and lookup
+ * transaction identifiers onto their object map descriptors. The entries are stored in a set associative hash table
+ * where the least recently used entry of a set is replaced when the set is full.
+ * The sets are divided over shards so that lookups of different sets do not contend on the same lock.
+ */
+struct libfsapfs_object_map_descriptor_cache
+{
+	/* The entries
+	 */
+	libfsapfs_object_map_descriptor_cache_entry_t *entries;
+
+	/* The number of sets
+	 * This value is always a power of 2
+	 */
+	uint32_t number_of_sets;
+
+	/* The shards
+	 */
+	libfsapfs_object_map_descriptor_cache_shard_t shards[ LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_NUMBER_OF_SHARDS ];
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 * The lock is grabbed for reading by lookups and for writing when the entries are reallocated
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfsapfs_object_map_descriptor_cache_initialize(
+     libfsapfs_object_map_descriptor_cache_t **descriptor_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_descriptor_cache_free(
+     libfsapfs_object_map_descriptor_cache_t **descriptor_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_descriptor_cache_allocate_entries(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_descriptor_cache_resize(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_descriptor_cache_get_descriptor(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     uint64_t object_identifier,
+     uint64_t transaction_identifier,
+     libfsapfs_object_map_descriptor_t *descriptor,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_descriptor_cache_set_descriptor(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     uint64_t transaction_identifier,
+     const libfsapfs_object_map_descriptor_t *descriptor,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_descriptor_cache_get_statistics(
+     libfsapfs_object_map_descriptor_cache_t *descriptor_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_OBJECT_MAP_DESCRIPTOR_CACHE_H ) */
+
@@ -25,10 +25,19 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfsapfs_change_iterator.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_system.h"
+#include "libfsapfs_file_system_btree.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libfcache.h"
+#include "libfsapfs_libfdata.h"
+#include "libfsapfs_object_map_btree.h"
+#include "libfsapfs_object_map_descriptor.h"
 #include "libfsapfs_snapshot.h"
 #include "libfsapfs_snapshot_metadata.h"
 #include "libfsapfs_snapshot_metadata_tree.h"
@@ -36,13 +45,20 @@
 
 /* Creates a snapshot
  * Make sure the value snapshot is referencing, is set to NULL
+ * The encryption context, file system data block vector, file system B-tree node cache
+ * and object map B-tree are shared with the volume
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_snapshot_initialize(
      libfsapfs_snapshot_t **snapshot,
      libfsapfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libfdata_vector_t *file_system_data_block_vector,
+     libfsapfs_btree_node_cache_t *file_system_node_cache,
+     libfsapfs_object_map_btree_t *object_map_btree,
      libfsapfs_snapshot_metadata_t *snapshot_metadata,
+     uint8_t is_locked,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_snapshot_t *internal_snapshot = NULL;
@@ -132,9 +148,14 @@ int libfsapfs_snapshot_initialize(
 		goto on_error;
 	}
 /* TODO clone file_io_handle? */
-	internal_snapshot->io_handle         = io_handle;
-	internal_snapshot->file_io_handle    = file_io_handle;
-	internal_snapshot->snapshot_metadata = snapshot_metadata;
+	internal_snapshot->io_handle                     = io_handle;
+	internal_snapshot->file_io_handle                = file_io_handle;
+	internal_snapshot->encryption_context            = encryption_context;
+	internal_snapshot->file_system_data_block_vector = file_system_data_block_vector;
+	internal_snapshot->file_system_node_cache        = file_system_node_cache;
+	internal_snapshot->object_map_btree              = object_map_btree;
+	internal_snapshot->snapshot_metadata             = snapshot_metadata;
+	internal_snapshot->is_locked                     = is_locked;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
@@ -191,6 +212,25 @@ int libfsapfs_snapshot_free(
 		internal_snapshot = (libfsapfs_internal_snapshot_t *) *snapshot;
 		*snapshot         = NULL;
 
+		/* The encryption_context, file_system_data_block_vector, file_system_node_cache,
+		 * object_map_btree and snapshot_metadata are referenced and freed elsewhere
+		 */
+		if( internal_snapshot->volume_superblock != NULL )
+		{
+			if( libfsapfs_internal_snapshot_close(
+			     internal_snapshot,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close snapshot.",
+				 function );
+
+				result = -1;
+			}
+		}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 		if( libcthreads_read_write_lock_free(
 		     &( internal_snapshot->read_write_lock ),
@@ -350,7 +390,22 @@ int libfsapfs_internal_snapshot_close(
 			result = -1;
 		}
 	}
-/* TODO */
+	if( internal_snapshot->file_system != NULL )
+	{
+		if( libfsapfs_file_system_free(
+		     &( internal_snapshot->file_system ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file system.",
+			 function );
+
+			result = -1;
+		}
+	}
 	return( result );
 }
 
@@ -650,3 +705,779 @@ int libfsapfs_snapshot_get_utf16_name(
 	return( result );
 }
 
+/* Determines the file system
+ * The file system B-tree of the snapshot is the version of the file system B-tree
+ * of the transaction of the snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_snapshot_get_file_system(
+     libfsapfs_internal_snapshot_t *internal_snapshot,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_system_btree_t *file_system_btree         = NULL;
+	libfsapfs_object_map_descriptor_t *object_map_descriptor = NULL;
+	static char *function                                    = "libfsapfs_internal_snapshot_get_file_system";
+	uint8_t use_case_folding                                 = 0;
+
+	if( internal_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_snapshot->volume_superblock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid snapshot - missing volume superblock.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_snapshot->snapshot_metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid snapshot - missing snapshot metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_snapshot->file_system != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid snapshot - file system value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_snapshot->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported locked volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
+	     internal_snapshot->object_map_btree,
+	     internal_snapshot->file_io_handle,
+	     internal_snapshot->volume_superblock->file_system_root_object_identifier,
+	     internal_snapshot->snapshot_metadata->transaction_identifier,
+	     &object_map_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve object map descriptor for file system root object identifier: %" PRIu64 " and transaction identifier: %" PRIu64 ".",
+		 function,
+		 internal_snapshot->volume_superblock->file_system_root_object_identifier,
+		 internal_snapshot->snapshot_metadata->transaction_identifier );
+
+		goto on_error;
+	}
+	if( object_map_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid object map descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_snapshot->volume_superblock->incompatible_features_flags & 0x00000000000000001 ) != 0 )
+	{
+		use_case_folding = 1;
+	}
+	if( libfsapfs_file_system_btree_initialize(
+	     &file_system_btree,
+	     internal_snapshot->io_handle,
+	     internal_snapshot->encryption_context,
+	     internal_snapshot->file_system_data_block_vector,
+	     internal_snapshot->file_system_node_cache,
+	     internal_snapshot->object_map_btree,
+	     object_map_descriptor->physical_address,
+	     internal_snapshot->snapshot_metadata->transaction_identifier,
+	     use_case_folding,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_initialize(
+	     &( internal_snapshot->file_system ),
+	     internal_snapshot->io_handle,
+	     internal_snapshot->encryption_context,
+	     file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system.",
+		 function );
+
+		goto on_error;
+	}
+	file_system_btree = NULL;
+
+	if( libfsapfs_object_map_descriptor_free(
+	     &object_map_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free object map descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_snapshot->file_system != NULL )
+	{
+		libfsapfs_file_system_free(
+		 &( internal_snapshot->file_system ),
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	if( object_map_descriptor != NULL )
+	{
+		libfsapfs_object_map_descriptor_free(
+		 &object_map_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the root directory file entry
+ * Returns 1 if successful, or 0 if not available or -1 on error
+ */
+int libfsapfs_snapshot_get_root_directory(
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_snapshot_t *internal_snapshot = NULL;
+	static char *function                            = "libfsapfs_snapshot_get_root_directory";
+	int result                                       = 1;
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	internal_snapshot = (libfsapfs_internal_snapshot_t *) snapshot;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_snapshot->file_system == NULL )
+	{
+		if( libfsapfs_internal_snapshot_get_file_system(
+		     internal_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		result = libfsapfs_file_system_get_file_entry_by_identifier(
+		          internal_snapshot->file_system,
+		          internal_snapshot->file_io_handle,
+		          2,
+		          file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve root directory inode: 2 from file system B-tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file entry for a specific identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_snapshot_get_file_entry_by_identifier(
+     libfsapfs_snapshot_t *snapshot,
+     uint64_t identifier,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_snapshot_t *internal_snapshot = NULL;
+	static char *function                            = "libfsapfs_snapshot_get_file_entry_by_identifier";
+	int result                                       = 1;
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	internal_snapshot = (libfsapfs_internal_snapshot_t *) snapshot;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_snapshot->file_system == NULL )
+	{
+		if( libfsapfs_internal_snapshot_get_file_system(
+		     internal_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		result = libfsapfs_file_system_get_file_entry_by_identifier(
+		          internal_snapshot->file_system,
+		          internal_snapshot->file_io_handle,
+		          identifier,
+		          file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
+			 function,
+			 identifier );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file entry for an UTF-8 encoded path
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsapfs_snapshot_get_file_entry_by_utf8_path(
+     libfsapfs_snapshot_t *snapshot,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_snapshot_t *internal_snapshot = NULL;
+	static char *function                            = "libfsapfs_snapshot_get_file_entry_by_utf8_path";
+	int result                                       = 1;
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	internal_snapshot = (libfsapfs_internal_snapshot_t *) snapshot;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_snapshot->file_system == NULL )
+	{
+		if( libfsapfs_internal_snapshot_get_file_system(
+		     internal_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		result = libfsapfs_file_system_get_file_entry_by_utf8_path(
+		          internal_snapshot->file_system,
+		          internal_snapshot->file_io_handle,
+		          utf8_string,
+		          utf8_string_length,
+		          file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry from file system by UTF-8 path.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file entry for an UTF-16 encoded path
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsapfs_snapshot_get_file_entry_by_utf16_path(
+     libfsapfs_snapshot_t *snapshot,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_snapshot_t *internal_snapshot = NULL;
+	static char *function                            = "libfsapfs_snapshot_get_file_entry_by_utf16_path";
+	int result                                       = 1;
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	internal_snapshot = (libfsapfs_internal_snapshot_t *) snapshot;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_snapshot->file_system == NULL )
+	{
+		if( libfsapfs_internal_snapshot_get_file_system(
+		     internal_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		result = libfsapfs_file_system_get_file_entry_by_utf16_path(
+		          internal_snapshot->file_system,
+		          internal_snapshot->file_io_handle,
+		          utf16_string,
+		          utf16_string_length,
+		          file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry from file system by UTF-16 path.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file system B-tree
+ * The file system B-tree is created on first use and is freed with the snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_snapshot_get_file_system_btree(
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_file_system_btree_t **file_system_btree,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_snapshot_t *internal_snapshot = NULL;
+	static char *function                            = "libfsapfs_snapshot_get_file_system_btree";
+	int result                                       = 1;
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	internal_snapshot = (libfsapfs_internal_snapshot_t *) snapshot;
+
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_snapshot->file_system == NULL )
+	{
+		if( libfsapfs_internal_snapshot_get_file_system(
+		     internal_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		*file_system_btree = internal_snapshot->file_system->file_system_btree;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a change iterator
+ * The iterator returns the changes between the snapshot and a newer snapshot of the same volume
+ * Both snapshots must not be freed before the iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_snapshot_get_change_iterator(
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_snapshot_t *newer_snapshot,
+     libfsapfs_change_iterator_t **change_iterator,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_system_btree_t *first_file_system_btree  = NULL;
+	libfsapfs_file_system_btree_t *second_file_system_btree = NULL;
+	libfsapfs_internal_snapshot_t *internal_snapshot        = NULL;
+	static char *function                                   = "libfsapfs_snapshot_get_change_iterator";
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	internal_snapshot = (libfsapfs_internal_snapshot_t *) snapshot;
+
+	if( newer_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid newer snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_snapshot->object_map_btree != ( (libfsapfs_internal_snapshot_t *) newer_snapshot )->object_map_btree )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported newer snapshot - not a snapshot of the same volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_snapshot_get_file_system_btree(
+	     snapshot,
+	     &first_file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file system B-tree of snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_snapshot_get_file_system_btree(
+	     newer_snapshot,
+	     &second_file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file system B-tree of newer snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_change_iterator_initialize(
+	     change_iterator,
+	     internal_snapshot->file_io_handle,
+	     first_file_system_btree,
+	     second_file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create change iterator.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
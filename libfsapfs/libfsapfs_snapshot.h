@@ -25,11 +25,18 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_btree_node_cache.h"
+#include "libfsapfs_encryption_context.h"
 #include "libfsapfs_extern.h"
+#include "libfsapfs_file_system.h"
+#include "libfsapfs_file_system_btree.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcthreads.h"
+#include "libfsapfs_libfcache.h"
+#include "libfsapfs_libfdata.h"
+#include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_snapshot_metadata.h"
 #include "libfsapfs_types.h"
 #include "libfsapfs_volume_superblock.h"
@@ -58,6 +65,31 @@ struct libfsapfs_internal_snapshot
 	 */
 	libfsapfs_snapshot_metadata_t *snapshot_metadata;
 
+	/* The encryption context
+	 */
+	libfsapfs_encryption_context_t *encryption_context;
+
+	/* The file system data block vector
+	 */
+	libfdata_vector_t *file_system_data_block_vector;
+
+	/* The file system B-tree node cache
+	 * This cache is shared with the volume
+	 */
+	libfsapfs_btree_node_cache_t *file_system_node_cache;
+
+	/* The volume object map B-tree
+	 */
+	libfsapfs_object_map_btree_t *object_map_btree;
+
+	/* The file system
+	 */
+	libfsapfs_file_system_t *file_system;
+
+	/* Value to indicate if the volume is locked
+	 */
+	uint8_t is_locked;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -69,7 +101,12 @@ int libfsapfs_snapshot_initialize(
      libfsapfs_snapshot_t **snapshot,
      libfsapfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libfdata_vector_t *file_system_data_block_vector,
+     libfsapfs_btree_node_cache_t *file_system_node_cache,
+     libfsapfs_object_map_btree_t *object_map_btree,
      libfsapfs_snapshot_metadata_t *snapshot_metadata,
+     uint8_t is_locked,
      libcerror_error_t **error );
 
 LIBFSAPFS_EXTERN \
@@ -113,6 +150,51 @@ int libfsapfs_snapshot_get_utf16_name(
      size_t utf16_string_size,
      libcerror_error_t **error );
 
+int libfsapfs_internal_snapshot_get_file_system(
+     libfsapfs_internal_snapshot_t *internal_snapshot,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_snapshot_get_root_directory(
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_snapshot_get_file_entry_by_identifier(
+     libfsapfs_snapshot_t *snapshot,
+     uint64_t identifier,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_snapshot_get_file_entry_by_utf8_path(
+     libfsapfs_snapshot_t *snapshot,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_snapshot_get_file_entry_by_utf16_path(
+     libfsapfs_snapshot_t *snapshot,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsapfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+int libfsapfs_snapshot_get_file_system_btree(
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_file_system_btree_t **file_system_btree,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_snapshot_get_change_iterator(
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_snapshot_t *newer_snapshot,
+     libfsapfs_change_iterator_t **change_iterator,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
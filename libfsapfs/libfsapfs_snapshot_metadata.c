@@ -152,10 +152,6 @@ int libfsapfs_snapshot_metadata_read_key_data(
 {
 	static char *function = "libfsapfs_snapshot_metadata_read_key_data";
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint64_t value_64bit  = 0;
-#endif
-
 	if( snapshot_metadata == NULL )
 	{
 		libcerror_error_set(
@@ -203,22 +199,28 @@ int libfsapfs_snapshot_metadata_read_key_data(
 	}
 #endif
 
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_snapshot_metadata_btree_key_t *) data )->object_identifier,
+	 snapshot_metadata->transaction_identifier );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_snapshot_metadata_btree_key_t *) data )->object_identifier,
-		 value_64bit );
 		libcnotify_printf(
 		 "%s: object identifier\t\t: 0x%08" PRIx64 "\n",
 		 function,
-		 value_64bit );
+		 snapshot_metadata->transaction_identifier );
 
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
+	/* The upper 4 bits of the object identifier contain the record type,
+	 * the lower 60 bits the transaction identifier of the snapshot
+	 */
+	snapshot_metadata->transaction_identifier &= 0x0fffffffffffffffUL;
+
 	return( 1 );
 }
 
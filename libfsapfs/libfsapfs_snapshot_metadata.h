@@ -35,6 +35,10 @@ typedef struct libfsapfs_snapshot_metadata libfsapfs_snapshot_metadata_t;
 
 struct libfsapfs_snapshot_metadata
 {
+	/* Transaction identifier
+	 */
+	uint64_t transaction_identifier;
+
 	/* Volume superblock block number
 	 */
 	uint64_t volume_superblock_block_number;
@@ -35,6 +35,7 @@
 #include "libfsapfs_libcnotify.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_object.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_object_map_descriptor.h"
 #include "libfsapfs_snapshot_metadata.h"
@@ -55,7 +56,8 @@ int libfsapfs_snapshot_metadata_tree_initialize(
      uint64_t root_node_block_number,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_snapshot_metadata_tree_initialize";
+	static char *function               = "libfsapfs_snapshot_metadata_tree_initialize";
+	int maximum_number_of_cache_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
 
 	if( snapshot_metadata_tree == NULL )
 	{
@@ -126,9 +128,13 @@ int libfsapfs_snapshot_metadata_tree_initialize(
 
 		goto on_error;
 	}
+	if( io_handle != NULL )
+	{
+		maximum_number_of_cache_entries = io_handle->maximum_number_of_cached_btree_nodes;
+	}
 	if( libfcache_cache_initialize(
 	     &( ( *snapshot_metadata_tree )->node_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES,
+	     maximum_number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -304,6 +310,7 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry(
 	          snapshot_metadata_tree->object_map_btree,
 	          file_io_handle,
 	          sub_node_object_identifier,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	          &object_map_descriptor,
 	          error );
 
@@ -507,6 +514,24 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 
 			goto on_error;
 		}
+		if( ( snapshot_metadata_tree->io_handle != NULL )
+		 && ( snapshot_metadata_tree->io_handle->verify_object_checksums != 0 ) )
+		{
+			if( libfsapfs_object_verify_checksum(
+			     data_block->data,
+			     data_block->data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+				 "%s: unable to verify B-tree node checksum.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libfsapfs_btree_node_read_data(
 		     node,
 		     data_block->data,
@@ -817,6 +842,24 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 
 			goto on_error;
 		}
+		if( ( snapshot_metadata_tree->io_handle != NULL )
+		 && ( snapshot_metadata_tree->io_handle->verify_object_checksums != 0 ) )
+		{
+			if( libfsapfs_object_verify_checksum(
+			     data_block->data,
+			     data_block->data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+				 "%s: unable to verify B-tree node checksum.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libfsapfs_btree_node_read_data(
 		     node,
 		     data_block->data,
@@ -25,6 +25,9 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfsapfs_btree_node_cache.h"
+#include "libfsapfs_change_iterator.h"
+#include "libfsapfs_compressed_block_cache.h"
 #include "libfsapfs_container_data_handle.h"
 #include "libfsapfs_container_key_bag.h"
 #include "libfsapfs_debug.h"
@@ -32,6 +35,7 @@
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_extent_reference_tree.h"
 #include "libfsapfs_file_entry.h"
+#include "libfsapfs_file_entry_iterator.h"
 #include "libfsapfs_file_system.h"
 #include "libfsapfs_file_system_btree.h"
 #include "libfsapfs_file_system_data_handle.h"
@@ -41,11 +45,13 @@
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
 #include "libfsapfs_libcthreads.h"
+#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_libuna.h"
 #include "libfsapfs_object_map.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_descriptor_cache.h"
 #include "libfsapfs_snapshot.h"
 #include "libfsapfs_snapshot_metadata.h"
 #include "libfsapfs_snapshot_metadata_tree.h"
@@ -139,8 +145,56 @@ int libfsapfs_volume_initialize(
 
 		goto on_error;
 	}
+	internal_volume->io_handle = memory_allocate_structure(
+	                              libfsapfs_io_handle_t );
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     internal_volume->io_handle,
+	     io_handle,
+	     sizeof( libfsapfs_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data block cache budget of the volume is accounted separately from that of the container
+	 */
+	internal_volume->io_handle->number_of_cached_data_blocks = 0;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	internal_volume->io_handle->data_block_cache_mutex = NULL;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_volume->io_handle->data_block_cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize data block cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 /* TODO clone file_io_handle? */
-	internal_volume->io_handle         = io_handle;
 	internal_volume->file_io_handle    = file_io_handle;
 	internal_volume->container_key_bag = container_key_bag;
 	internal_volume->is_locked         = 1;
@@ -167,6 +221,19 @@ int libfsapfs_volume_initialize(
 on_error:
 	if( internal_volume != NULL )
 	{
+		if( internal_volume->io_handle != NULL )
+		{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+			if( internal_volume->io_handle->data_block_cache_mutex != NULL )
+			{
+				libcthreads_mutex_free(
+				 &( internal_volume->io_handle->data_block_cache_mutex ),
+				 NULL );
+			}
+#endif
+			memory_free(
+			 internal_volume->io_handle );
+		}
 		memory_free(
 		 internal_volume );
 	}
@@ -231,6 +298,28 @@ int libfsapfs_volume_free(
 			result = -1;
 		}
 #endif
+		/* The IO handle is a copy and the profiler is owned by the container IO handle
+		 */
+		if( internal_volume->io_handle != NULL )
+		{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_free(
+			     &( internal_volume->io_handle->data_block_cache_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data block cache mutex.",
+				 function );
+
+				result = -1;
+			}
+#endif
+			memory_free(
+			 internal_volume->io_handle );
+		}
 		memory_free(
 		 internal_volume );
 	}
@@ -250,8 +339,6 @@ int libfsapfs_internal_volume_open_read(
 	libfsapfs_file_system_data_handle_t *file_system_data_handle = NULL;
 	libfsapfs_object_map_t *object_map                           = NULL;
 	static char *function                                        = "libfsapfs_internal_volume_open_read";
-	uint64_t key_bag_block_number                                = 0;
-	uint64_t key_bag_number_of_blocks                            = 0;
 	int element_index                                            = 0;
 	int result                                                   = 0;
 
@@ -559,8 +646,8 @@ int libfsapfs_internal_volume_open_read(
 		result = libfsapfs_container_key_bag_get_volume_key_bag_extent_by_identifier(
 		          internal_volume->container_key_bag,
 		          internal_volume->superblock->volume_identifier,
-		          &key_bag_block_number,
-		          &key_bag_number_of_blocks,
+		          &( internal_volume->key_bag_block_number ),
+		          &( internal_volume->key_bag_number_of_blocks ),
 		          error );
 
 		if( result == -1 )
@@ -576,8 +663,8 @@ int libfsapfs_internal_volume_open_read(
 		}
 		else if( result != 0 )
 		{
-			if( ( key_bag_block_number == 0 )
-			 || ( key_bag_number_of_blocks == 0 ) )
+			if( ( internal_volume->key_bag_block_number == 0 )
+			 || ( internal_volume->key_bag_number_of_blocks == 0 ) )
 			{
 				libcerror_error_set(
 				 error,
@@ -588,40 +675,24 @@ int libfsapfs_internal_volume_open_read(
 
 				goto on_error;
 			}
-			if( libfsapfs_volume_key_bag_initialize(
-			     &( internal_volume->key_bag ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create volume key bag.",
-				 function );
-
-				goto on_error;
-			}
-			file_offset = key_bag_block_number * internal_volume->io_handle->block_size;
-
-			if( libfsapfs_volume_key_bag_read_file_io_handle(
-			     internal_volume->key_bag,
-			     internal_volume->io_handle,
-			     file_io_handle,
-			     file_offset,
-			     (size64_t) key_bag_number_of_blocks * internal_volume->io_handle->block_size,
-			     internal_volume->superblock->volume_identifier,
-			     error ) != 1 )
+			/* When the volume is opened lazily the volume key bag is read when the volume is unlocked
+			 */
+			if( internal_volume->io_handle->lazy_volume_open == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read volume key bag at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 file_offset,
-				 file_offset );
-
-				goto on_error;
+				if( libfsapfs_internal_volume_read_key_bag(
+				     internal_volume,
+				     file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read volume key bag.",
+					 function );
+
+					goto on_error;
+				}
 			}
 			if( libfsapfs_encryption_context_initialize(
 			     &( internal_volume->encryption_context ),
@@ -637,11 +708,30 @@ int libfsapfs_internal_volume_open_read(
 
 				goto on_error;
 			}
+			if( internal_volume->io_handle->number_of_decryption_threads > 1 )
+			{
+				if( libfsapfs_encryption_context_set_number_of_threads(
+				     internal_volume->encryption_context,
+				     internal_volume->io_handle->worker_pool,
+				     internal_volume->io_handle->number_of_decryption_threads,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set number of threads in encryption context.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			internal_volume->is_locked = 1;
 		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
-	if( internal_volume->superblock->extent_reference_tree_block_number != 0 )
+	if( ( internal_volume->io_handle->lazy_volume_open == 0 )
+	 && ( internal_volume->superblock->extent_reference_tree_block_number != 0 ) )
 	{
 		if( libfsapfs_extent_reference_tree_initialize(
 		     &extent_reference_tree,
@@ -705,36 +795,20 @@ int libfsapfs_internal_volume_open_read(
 
 		goto on_error;
 	}
-	if( internal_volume->superblock->snapshot_metadata_tree_block_number != 0 )
+	/* When the volume is opened lazily the snapshots are read on first use
+	 */
+	if( internal_volume->io_handle->lazy_volume_open == 0 )
 	{
-		if( libfsapfs_snapshot_metadata_tree_initialize(
-		     &( internal_volume->snapshot_metadata_tree ),
-		     internal_volume->io_handle,
-		     internal_volume->container_data_block_vector,
-		     internal_volume->object_map_btree,
-		     internal_volume->superblock->snapshot_metadata_tree_block_number,
+		if( libfsapfs_internal_volume_read_snapshots(
+		     internal_volume,
+		     file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create snapshot metadata tree.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_snapshot_metadata_tree_get_snapshots(
-		     internal_volume->snapshot_metadata_tree,
-		     internal_volume->file_io_handle,
-		     internal_volume->snapshots,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve snapshots.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read snapshots.",
 			 function );
 
 			goto on_error;
@@ -808,6 +882,20 @@ int libfsapfs_internal_volume_open_read(
 
 		goto on_error;
 	}
+	if( libfsapfs_btree_node_cache_initialize(
+	     &( internal_volume->file_system_node_cache ),
+	     internal_volume->io_handle->maximum_number_of_cached_btree_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree node cache.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -835,7 +923,7 @@ on_error:
 		 &( internal_volume->key_bag ),
 		 NULL );
 	}
-	if( internal_volume->snapshot_metadata_tree != NULL )
+	if( internal_volume->snapshots != NULL )
 	{
 		libcdata_array_free(
 		 &( internal_volume->snapshots ),
@@ -889,15 +977,16 @@ on_error:
 	return( -1 );
 }
 
-/* Closes a volume
- * Returns 0 if successful or -1 on error
+/* Reads the volume key bag
+ * Returns 1 if successful or -1 on error
  */
-int libfsapfs_internal_volume_close(
+int libfsapfs_internal_volume_read_key_bag(
      libfsapfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_internal_volume_close";
-	int result            = 0;
+	static char *function = "libfsapfs_internal_volume_read_key_bag";
+	off64_t file_offset   = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -921,206 +1010,304 @@ int libfsapfs_internal_volume_close(
 
 		return( -1 );
 	}
-	internal_volume->file_io_handle = NULL;
-	internal_volume->is_locked      = 1;
-
-	if( internal_volume->user_password != NULL )
+	if( internal_volume->superblock == NULL )
 	{
-		if( memory_set(
-		     internal_volume->user_password,
-		     0,
-		     internal_volume->user_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear user password.",
-			 function );
-
-			result = -1;
-		}
-		memory_free(
-		 internal_volume->user_password );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing superblock.",
+		 function );
 
-		internal_volume->user_password      = NULL;
-		internal_volume->user_password_size = 0;
+		return( -1 );
 	}
-	if( internal_volume->recovery_password != NULL )
+	if( internal_volume->key_bag != NULL )
 	{
-		if( memory_set(
-		     internal_volume->recovery_password,
-		     0,
-		     internal_volume->recovery_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear recovery password.",
-			 function );
-
-			result = -1;
-		}
-		memory_free(
-		 internal_volume->recovery_password );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - key bag value already set.",
+		 function );
 
-		internal_volume->recovery_password      = NULL;
-		internal_volume->recovery_password_size = 0;
+		return( -1 );
 	}
-	if( internal_volume->superblock != NULL )
+	if( ( internal_volume->key_bag_block_number == 0 )
+	 || ( internal_volume->key_bag_number_of_blocks == 0 ) )
 	{
-		if( libfsapfs_volume_superblock_free(
-		     &( internal_volume->superblock ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free superblock.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid key bag extent.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( libfdata_vector_free(
-	     &( internal_volume->container_data_block_vector ),
+	if( libfsapfs_volume_key_bag_initialize(
+	     &( internal_volume->key_bag ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free container data block vector.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume key bag.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_volume->object_map_btree != NULL )
-	{
-		if( libfsapfs_object_map_btree_free(
-		     &( internal_volume->object_map_btree ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free object map B-tree.",
-			 function );
+	file_offset = internal_volume->key_bag_block_number * internal_volume->io_handle->block_size;
 
-			result = -1;
-		}
-	}
-	if( internal_volume->snapshot_metadata_tree != NULL )
+	if( libfsapfs_volume_key_bag_read_file_io_handle(
+	     internal_volume->key_bag,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     file_offset,
+	     (size64_t) internal_volume->key_bag_number_of_blocks * internal_volume->io_handle->block_size,
+	     internal_volume->superblock->volume_identifier,
+	     error ) != 1 )
 	{
-		if( libfsapfs_snapshot_metadata_tree_free(
-		     &( internal_volume->snapshot_metadata_tree ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free snapshot metadata tree.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume key bag at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_volume->snapshots != NULL )
+	return( 1 );
+
+on_error:
+	if( internal_volume->key_bag != NULL )
 	{
-		if( libcdata_array_free(
-		     &( internal_volume->snapshots ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_snapshot_metadata_free,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free snapshots array.",
-			 function );
+		libfsapfs_volume_key_bag_free(
+		 &( internal_volume->key_bag ),
+		 NULL );
+	}
+	return( -1 );
+}
 
-			result = -1;
-		}
+/* Reads the snapshots
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_volume_read_snapshots(
+     libfsapfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_volume_read_snapshots";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_volume->key_bag != NULL )
+	if( internal_volume->superblock == NULL )
 	{
-		if( libfsapfs_volume_key_bag_free(
-		     &( internal_volume->key_bag ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing superblock.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->snapshot_metadata_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - snapshot metadata tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->superblock->snapshot_metadata_tree_block_number != 0 )
+	{
+		if( libfsapfs_snapshot_metadata_tree_initialize(
+		     &( internal_volume->snapshot_metadata_tree ),
+		     internal_volume->io_handle,
+		     internal_volume->container_data_block_vector,
+		     internal_volume->object_map_btree,
+		     internal_volume->superblock->snapshot_metadata_tree_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free key bag.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create snapshot metadata tree.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_volume->encryption_context != NULL )
-	{
-		if( libfsapfs_encryption_context_free(
-		     &( internal_volume->encryption_context ),
-		     error ) != 1 )
+		if( libfsapfs_snapshot_metadata_tree_get_snapshots(
+		     internal_volume->snapshot_metadata_tree,
+		     file_io_handle,
+		     internal_volume->snapshots,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free encryption context.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshots.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
 	}
-	if( libfdata_vector_free(
-	     &( internal_volume->file_system_data_block_vector ),
-	     error ) != 1 )
+	internal_volume->snapshots_read = 1;
+
+	return( 1 );
+
+on_error:
+	libcdata_array_empty(
+	 internal_volume->snapshots,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_snapshot_metadata_free,
+	 NULL );
+
+	if( internal_volume->snapshot_metadata_tree != NULL )
+	{
+		libfsapfs_snapshot_metadata_tree_free(
+		 &( internal_volume->snapshot_metadata_tree ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the snapshots, when not read before, and grabs the read/write lock for reading
+ * The snapshots are read under the write lock when they are not yet available,
+ * after which the lock is grabbed for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_volume_grab_snapshots_for_read(
+     libfsapfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_volume_grab_snapshots_for_read";
+	int result            = 1;
+
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file system data block vector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( internal_volume->file_system != NULL )
+	do
 	{
-		if( libfsapfs_file_system_free(
-		     &( internal_volume->file_system ),
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_volume->read_write_lock,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file system.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
 			 function );
 
-			result = -1;
+			return( -1 );
+		}
+#endif
+		if( internal_volume->snapshots_read != 0 )
+		{
+			return( 1 );
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* Another thread can have read the snapshots in the meantime
+		 */
+		if( internal_volume->snapshots_read == 0 )
+		{
+			if( libfsapfs_internal_volume_read_snapshots(
+			     internal_volume,
+			     internal_volume->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read snapshots.",
+				 function );
+
+				result = -1;
+			}
 		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
 	}
-	return( result );
+	while( result == 1 );
+
+	return( -1 );
 }
 
-/* Unlocks an encrypted volume
- * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+/* Closes a volume
+ * Returns 0 if successful or -1 on error
  */
-int libfsapfs_internal_volume_unlock(
+int libfsapfs_internal_volume_close(
      libfsapfs_internal_volume_t *internal_volume,
      libcerror_error_t **error )
 {
-	uint8_t volume_key[ 32 ];
-	uint8_t volume_master_key[ 32 ];
-
-	static char *function = "libfsapfs_internal_volume_unlock";
+	static char *function = "libfsapfs_internal_volume_close";
 	int result            = 0;
 
 	if( internal_volume == NULL )
@@ -1134,125 +1321,740 @@ int libfsapfs_internal_volume_unlock(
 
 		return( -1 );
 	}
-	if( internal_volume->superblock == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing superblock.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_volume->key_bag == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing key bag.",
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	result = libfsapfs_volume_key_bag_get_volume_key(
-	          internal_volume->key_bag,
-	          internal_volume->user_password,
-	          internal_volume->user_password_size - 1,
-	          internal_volume->recovery_password,
-	          internal_volume->recovery_password_size - 1,
-	          volume_key,
-	          256,
-	          error );
+	internal_volume->file_io_handle           = NULL;
+	internal_volume->is_locked                = 1;
+	internal_volume->snapshots_read           = 0;
+	internal_volume->key_bag_block_number     = 0;
+	internal_volume->key_bag_number_of_blocks = 0;
 
-	if( result == -1 )
+	if( internal_volume->user_password != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume key using password.",
-		 function );
+		if( memory_set(
+		     internal_volume->user_password,
+		     0,
+		     internal_volume->user_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear user password.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
+		memory_free(
+		 internal_volume->user_password );
+
+		internal_volume->user_password      = NULL;
+		internal_volume->user_password_size = 0;
 	}
-	else if( result != 0 )
+	if( internal_volume->recovery_password != NULL )
 	{
-		if( libfsapfs_container_key_bag_get_volume_master_key_by_identifier(
-		     internal_volume->container_key_bag,
-		     internal_volume->superblock->volume_identifier,
-		     volume_key,
-		     256,
-		     volume_master_key,
-		     256,
-		     error ) != 1 )
+		if( memory_set(
+		     internal_volume->recovery_password,
+		     0,
+		     internal_volume->recovery_password_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve volume master key.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear recovery password.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		memory_set(
-		 volume_key,
-		 0,
-		 32 );
+		memory_free(
+		 internal_volume->recovery_password );
 
-		if( libfsapfs_encryption_context_set_keys(
-		     internal_volume->encryption_context,
-		     volume_master_key,
-		     16,
-		     &( volume_master_key[ 16 ] ),
-		     16,
+		internal_volume->recovery_password      = NULL;
+		internal_volume->recovery_password_size = 0;
+	}
+	if( internal_volume->superblock != NULL )
+	{
+		if( libfsapfs_volume_superblock_free(
+		     &( internal_volume->superblock ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set keys in encryption context.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free superblock.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		memory_set(
-		 volume_master_key,
-		 0,
-		 32 );
 	}
-	if( result != 0 )
+	if( libfdata_vector_free(
+	     &( internal_volume->container_data_block_vector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free container data block vector.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_volume->object_map_btree != NULL )
+	{
+		if( libfsapfs_object_map_btree_free(
+		     &( internal_volume->object_map_btree ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free object map B-tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->snapshot_metadata_tree != NULL )
+	{
+		if( libfsapfs_snapshot_metadata_tree_free(
+		     &( internal_volume->snapshot_metadata_tree ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free snapshot metadata tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->snapshots != NULL )
+	{
+		if( libcdata_array_free(
+		     &( internal_volume->snapshots ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_snapshot_metadata_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free snapshots array.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->key_bag != NULL )
+	{
+		if( libfsapfs_volume_key_bag_free(
+		     &( internal_volume->key_bag ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free key bag.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->encryption_context != NULL )
+	{
+		if( libfsapfs_encryption_context_free(
+		     &( internal_volume->encryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libfdata_vector_free(
+	     &( internal_volume->file_system_data_block_vector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system data block vector.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_volume->file_system != NULL )
+	{
+		if( libfsapfs_file_system_free(
+		     &( internal_volume->file_system ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->file_system_node_cache != NULL )
+	{
+		if( libfsapfs_btree_node_cache_free(
+		     &( internal_volume->file_system_node_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file system B-tree node cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Unlocks an encrypted volume
+ * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+ */
+int libfsapfs_internal_volume_unlock(
+     libfsapfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	uint8_t volume_key[ 32 ];
+	uint8_t volume_master_key[ 32 ];
+
+	static char *function = "libfsapfs_internal_volume_unlock";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->superblock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing superblock.",
+		 function );
+
+		return( -1 );
+	}
+	/* When the volume was opened lazily the volume key bag has not been read yet
+	 */
+	if( ( internal_volume->key_bag == NULL )
+	 && ( internal_volume->key_bag_block_number != 0 ) )
+	{
+		if( libfsapfs_internal_volume_read_key_bag(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read volume key bag.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->key_bag == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing key bag.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsapfs_volume_key_bag_get_volume_key(
+	          internal_volume->key_bag,
+	          internal_volume->user_password,
+	          internal_volume->user_password_size - 1,
+	          internal_volume->recovery_password,
+	          internal_volume->recovery_password_size - 1,
+	          volume_key,
+	          256,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume key using password.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfsapfs_container_key_bag_get_volume_master_key_by_identifier(
+		     internal_volume->container_key_bag,
+		     internal_volume->superblock->volume_identifier,
+		     volume_key,
+		     256,
+		     volume_master_key,
+		     256,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume master key.",
+			 function );
+
+			goto on_error;
+		}
+		memory_set(
+		 volume_key,
+		 0,
+		 32 );
+
+		if( libfsapfs_encryption_context_set_keys(
+		     internal_volume->encryption_context,
+		     volume_master_key,
+		     16,
+		     &( volume_master_key[ 16 ] ),
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in encryption context.",
+			 function );
+
+			goto on_error;
+		}
+		memory_set(
+		 volume_master_key,
+		 0,
+		 32 );
+	}
+	if( result != 0 )
+	{
+		internal_volume->is_locked = 0;
+	}
+	return( result );
+
+on_error:
+	memory_set(
+	 volume_master_key,
+	 0,
+	 32 );
+
+	memory_set(
+	 volume_key,
+	 0,
+	 32 );
+
+	return( -1 );
+}
+
+/* Unlocks the volume
+ * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+ */
+int libfsapfs_volume_unlock(
+     libfsapfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_unlock";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->is_locked != 0 )
+	{
+		result = libfsapfs_internal_volume_unlock(
+		          internal_volume,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unlock volume.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the feature flags
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_features_flags(
+     libfsapfs_volume_t *volume,
+     uint64_t *compatible_features_flags,
+     uint64_t *incompatible_features_flags,
+     uint64_t *read_only_compatible_features_flags,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_features_flags";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( internal_volume->superblock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing superblock.",
+		 function );
+
+		return( -1 );
+	}
+	if( compatible_features_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compatible features flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( incompatible_features_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid incompatible features flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_only_compatible_features_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-only compatible features flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*compatible_features_flags           = internal_volume->superblock->compatible_features_flags;
+	*incompatible_features_flags         = internal_volume->superblock->incompatible_features_flags;
+	*read_only_compatible_features_flags = internal_volume->superblock->read_only_compatible_features_flags;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_size(
+     libfsapfs_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( internal_volume->superblock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing superblock.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+/* TODO implement */
+	*size = (size64_t) 0;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( -1 );
+}
+
+/* Retrieves the identifier
+ * The identifier is an UUID stored in big-endian and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_identifier(
+     libfsapfs_volume_t *volume,
+     uint8_t *uuid_data,
+     size_t uuid_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_identifier";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( internal_volume->superblock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing superblock.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_volume_superblock_get_volume_identifier(
+	     internal_volume->superblock,
+	     uuid_data,
+	     uuid_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume identifier.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		internal_volume->is_locked = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
+#endif
 	return( result );
-
-on_error:
-	memory_set(
-	 volume_master_key,
-	 0,
-	 32 );
-
-	memory_set(
-	 volume_key,
-	 0,
-	 32 );
-
-	return( -1 );
 }
 
-/* Unlocks the volume
- * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+/* Retrieves the size of the UTF-8 encoded name
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_unlock(
+int libfsapfs_volume_get_utf8_name_size(
      libfsapfs_volume_t *volume,
+     size_t *utf8_string_size,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_unlock";
+	static char *function                        = "libfsapfs_volume_get_utf8_name_size";
 	int result                                   = 1;
 
 	if( volume == NULL )
@@ -1269,7 +2071,7 @@ int libfsapfs_volume_unlock(
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1277,32 +2079,28 @@ int libfsapfs_volume_unlock(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_volume->is_locked != 0 )
+	if( libfsapfs_volume_superblock_get_utf8_volume_name_size(
+	     internal_volume->superblock,
+	     utf8_string_size,
+	     error ) != 1 )
 	{
-		result = libfsapfs_internal_volume_unlock(
-		          internal_volume,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unlock volume.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string size.",
+		 function );
 
-			result = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1310,7 +2108,7 @@ int libfsapfs_volume_unlock(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -1319,18 +2117,19 @@ int libfsapfs_volume_unlock(
 	return( result );
 }
 
-/* Retrieves the feature flags
+/* Retrieves the UTF-8 encoded name
+ * The size should include the end of string character
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_features_flags(
+int libfsapfs_volume_get_utf8_name(
      libfsapfs_volume_t *volume,
-     uint64_t *compatible_features_flags,
-     uint64_t *incompatible_features_flags,
-     uint64_t *read_only_compatible_features_flags,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_features_flags";
+	static char *function                        = "libfsapfs_volume_get_utf8_name";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -1345,50 +2144,80 @@ int libfsapfs_volume_get_features_flags(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-	if( internal_volume->superblock == NULL )
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing superblock.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( compatible_features_flags == NULL )
+#endif
+	if( libfsapfs_volume_superblock_get_utf8_volume_name(
+	     internal_volume->superblock,
+	     utf8_string,
+	     utf8_string_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compatible features flags.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( incompatible_features_flags == NULL )
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid incompatible features flags.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( read_only_compatible_features_flags == NULL )
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-16 encoded name
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_utf16_name_size(
+     libfsapfs_volume_t *volume,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_utf16_name_size";
+	int result                                   = 1;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid read-only compatible features flags.",
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -1404,10 +2233,20 @@ int libfsapfs_volume_get_features_flags(
 		return( -1 );
 	}
 #endif
-	*compatible_features_flags           = internal_volume->superblock->compatible_features_flags;
-	*incompatible_features_flags         = internal_volume->superblock->incompatible_features_flags;
-	*read_only_compatible_features_flags = internal_volume->superblock->read_only_compatible_features_flags;
+	if( libfsapfs_volume_superblock_get_utf16_volume_name_size(
+	     internal_volume->superblock,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string size.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1423,19 +2262,22 @@ int libfsapfs_volume_get_features_flags(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the size
+/* Retrieves the UTF-16 encoded name
+ * The size should include the end of string character
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_size(
+int libfsapfs_volume_get_utf16_name(
      libfsapfs_volume_t *volume,
-     size64_t *size,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_size";
+	static char *function                        = "libfsapfs_volume_get_utf16_name";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -1450,28 +2292,78 @@ int libfsapfs_volume_get_size(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-	if( internal_volume->superblock == NULL )
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing superblock.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
+#endif
+	if( libfsapfs_volume_superblock_get_utf16_volume_name(
+	     internal_volume->superblock,
+	     utf16_string,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines if the volume is locked
+ * Returns 1 if locked, 0 if not or -1 on error
+ */
+int libfsapfs_volume_is_locked(
+     libfsapfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_is_locked";
+	uint8_t is_locked                            = 0;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -1487,8 +2379,7 @@ int libfsapfs_volume_get_size(
 		return( -1 );
 	}
 #endif
-/* TODO implement */
-	*size = (size64_t) 0;
+	is_locked = internal_volume->is_locked;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -1505,47 +2396,35 @@ int libfsapfs_volume_get_size(
 		return( -1 );
 	}
 #endif
-	return( -1 );
+	return( is_locked );
 }
 
-/* Retrieves the identifier
- * The identifier is an UUID stored in big-endian and is 16 bytes of size
+/* Retrieves the maximum size of a specific cache
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_identifier(
+int libfsapfs_volume_get_maximum_cache_size(
      libfsapfs_volume_t *volume,
-     uint8_t *uuid_data,
-     size_t uuid_data_size,
+     int cache_type,
+     size64_t *maximum_cache_size,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_identifier";
+	static char *function                        = "libfsapfs_volume_get_maximum_cache_size";
 	int result                                   = 1;
 
-	if( volume == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
-	}
-	internal_volume = (libfsapfs_internal_volume_t *) volume;
-
-	if( internal_volume->superblock == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing superblock.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -1561,17 +2440,17 @@ int libfsapfs_volume_get_identifier(
 		return( -1 );
 	}
 #endif
-	if( libfsapfs_volume_superblock_get_volume_identifier(
-	     internal_volume->superblock,
-	     uuid_data,
-	     uuid_data_size,
+	if( libfsapfs_io_handle_get_maximum_cache_size(
+	     internal_volume->io_handle,
+	     cache_type,
+	     maximum_cache_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume identifier.",
+		 "%s: unable to retrieve maximum cache size.",
 		 function );
 
 		result = -1;
@@ -1594,17 +2473,17 @@ int libfsapfs_volume_get_identifier(
 	return( result );
 }
 
-/* Retrieves the size of the UTF-8 encoded name
- * The returned size includes the end of string character
+/* Sets the maximum size of a specific cache
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_utf8_name_size(
+int libfsapfs_volume_set_maximum_cache_size(
      libfsapfs_volume_t *volume,
-     size_t *utf8_string_size,
+     int cache_type,
+     size64_t maximum_cache_size,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_utf8_name_size";
+	static char *function                        = "libfsapfs_volume_set_maximum_cache_size";
 	int result                                   = 1;
 
 	if( volume == NULL )
@@ -1621,7 +2500,7 @@ int libfsapfs_volume_get_utf8_name_size(
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1629,28 +2508,130 @@ int libfsapfs_volume_get_utf8_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfsapfs_volume_superblock_get_utf8_volume_name_size(
-	     internal_volume->superblock,
-	     utf8_string_size,
+	if( libfsapfs_io_handle_set_maximum_cache_size(
+	     internal_volume->io_handle,
+	     cache_type,
+	     maximum_cache_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 string size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum cache size.",
 		 function );
 
 		result = -1;
 	}
+	/* The data block caches are resized on their next read
+	 */
+	if( cache_type == LIBFSAPFS_CACHE_TYPE_BTREE_NODES )
+	{
+		if( ( result == 1 )
+		 && ( internal_volume->object_map_btree != NULL ) )
+		{
+			if( libfsapfs_btree_node_cache_resize(
+			     internal_volume->object_map_btree->node_cache,
+			     internal_volume->io_handle->maximum_number_of_cached_btree_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize object map B-tree node cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( result == 1 )
+		 && ( internal_volume->file_system_node_cache != NULL ) )
+		{
+			if( libfsapfs_btree_node_cache_resize(
+			     internal_volume->file_system_node_cache,
+			     internal_volume->io_handle->maximum_number_of_cached_btree_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize file system B-tree node cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( result == 1 )
+		 && ( internal_volume->snapshot_metadata_tree != NULL ) )
+		{
+			if( libfcache_cache_resize(
+			     internal_volume->snapshot_metadata_tree->node_cache,
+			     internal_volume->io_handle->maximum_number_of_cached_btree_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize snapshot metadata tree node cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	else if( cache_type == LIBFSAPFS_CACHE_TYPE_COMPRESSED_BLOCKS )
+	{
+		if( ( result == 1 )
+		 && ( internal_volume->file_system != NULL ) )
+		{
+			if( libfsapfs_compressed_block_cache_resize(
+			     internal_volume->file_system->compressed_block_cache,
+			     internal_volume->io_handle->maximum_number_of_cached_compressed_blocks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize compressed block cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	else if( cache_type == LIBFSAPFS_CACHE_TYPE_OBJECT_MAP_DESCRIPTORS )
+	{
+		if( ( result == 1 )
+		 && ( internal_volume->object_map_btree != NULL ) )
+		{
+			if( libfsapfs_object_map_descriptor_cache_resize(
+			     internal_volume->object_map_btree->descriptor_cache,
+			     internal_volume->io_handle->maximum_number_of_cached_object_map_descriptors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize object map descriptor cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1658,7 +2639,7 @@ int libfsapfs_volume_get_utf8_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1667,19 +2648,16 @@ int libfsapfs_volume_get_utf8_name_size(
 	return( result );
 }
 
-/* Retrieves the UTF-8 encoded name
- * The size should include the end of string character
+/* Retrieves the number of threads used to decrypt data
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_utf8_name(
+int libfsapfs_volume_get_number_of_decryption_threads(
      libfsapfs_volume_t *volume,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
+     int *number_of_threads,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_utf8_name";
-	int result                                   = 1;
+	static char *function                        = "libfsapfs_volume_get_number_of_decryption_threads";
 
 	if( volume == NULL )
 	{
@@ -1694,36 +2672,45 @@ int libfsapfs_volume_get_utf8_name(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libfsapfs_volume_superblock_get_utf8_volume_name(
-	     internal_volume->superblock,
-	     utf8_string,
-	     utf8_string_size,
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 string.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
+#endif
+	*number_of_threads = internal_volume->io_handle->number_of_decryption_threads;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1739,20 +2726,19 @@ int libfsapfs_volume_get_utf8_name(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the size of the UTF-16 encoded name
- * The returned size includes the end of string character
+/* Sets the number of threads used to decrypt data
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_utf16_name_size(
+int libfsapfs_volume_set_number_of_decryption_threads(
      libfsapfs_volume_t *volume,
-     size_t *utf16_string_size,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_utf16_name_size";
+	static char *function                        = "libfsapfs_volume_set_number_of_decryption_threads";
 	int result                                   = 1;
 
 	if( volume == NULL )
@@ -1768,37 +2754,66 @@ int libfsapfs_volume_get_utf16_name_size(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libfsapfs_volume_superblock_get_utf16_volume_name_size(
-	     internal_volume->superblock,
-	     utf16_string_size,
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 string size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->number_of_decryption_threads = number_of_threads;
+
+	if( internal_volume->encryption_context != NULL )
+	{
+		if( libfsapfs_encryption_context_set_number_of_threads(
+		     internal_volume->encryption_context,
+		     internal_volume->io_handle->worker_pool,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of threads in encryption context.",
+			 function );
+
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1806,7 +2821,7 @@ int libfsapfs_volume_get_utf16_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1815,19 +2830,16 @@ int libfsapfs_volume_get_utf16_name_size(
 	return( result );
 }
 
-/* Retrieves the UTF-16 encoded name
- * The size should include the end of string character
+/* Retrieves the number of threads used to decompress data
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_get_utf16_name(
+int libfsapfs_volume_get_number_of_decompression_threads(
      libfsapfs_volume_t *volume,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
+     int *number_of_threads,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_get_utf16_name";
-	int result                                   = 1;
+	static char *function                        = "libfsapfs_volume_get_number_of_decompression_threads";
 
 	if( volume == NULL )
 	{
@@ -1842,36 +2854,45 @@ int libfsapfs_volume_get_utf16_name(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libfsapfs_volume_superblock_get_utf16_volume_name(
-	     internal_volume->superblock,
-	     utf16_string,
-	     utf16_string_size,
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 string.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
+#endif
+	*number_of_threads = internal_volume->io_handle->number_of_decompression_threads;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1887,35 +2908,59 @@ int libfsapfs_volume_get_utf16_name(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
 }
 
-/* Determines if the volume is locked
- * Returns 1 if locked, 0 if not or -1 on error
+/* Sets the number of threads used to decompress data
+ * The setting applies to file entries that are retrieved afterwards
+ * Returns 1 if successful or -1 on error
  */
-int libfsapfs_volume_is_locked(
+int libfsapfs_volume_set_number_of_decompression_threads(
      libfsapfs_volume_t *volume,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libfsapfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsapfs_volume_is_locked";
-	uint8_t is_locked                            = 0;
+	static char *function                        = "libfsapfs_volume_set_number_of_decompression_threads";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-	if( volume == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsapfs_internal_volume_t *) volume;
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
 
+		return( -1 );
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1923,16 +2968,16 @@ int libfsapfs_volume_is_locked(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	is_locked = internal_volume->is_locked;
+	internal_volume->io_handle->number_of_decompression_threads = number_of_threads;
 
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1940,13 +2985,13 @@ int libfsapfs_volume_is_locked(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( is_locked );
+	return( 1 );
 }
 
 /* Sets an UTF-8 formatted password
@@ -2645,60 +3690,39 @@ int libfsapfs_volume_get_root_directory(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libfsapfs_internal_volume_grab_file_system_for_read(
+	     internal_volume,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine file system.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_volume->file_system == NULL )
-	{
-		if( libfsapfs_internal_volume_get_file_system(
-		     internal_volume,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine file system.",
-			 function );
+	result = libfsapfs_file_system_get_file_entry_by_identifier(
+	          internal_volume->file_system,
+	          internal_volume->file_io_handle,
+	          2,
+	          file_entry,
+	          error );
 
-			result = -1;
-		}
-	}
-	if( result != -1 )
+	if( result == -1 )
 	{
-		result = libfsapfs_file_system_get_file_entry_by_identifier(
-		          internal_volume->file_system,
-		          internal_volume->file_io_handle,
-		          2,
-		          file_entry,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve root directory inode: 2 from file system B-tree.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root directory inode: 2 from file system B-tree.",
+		 function );
 
-			result = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2706,7 +3730,7 @@ int libfsapfs_volume_get_root_directory(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -2839,6 +3863,7 @@ int libfsapfs_internal_volume_get_file_system(
 	     internal_volume->object_map_btree,
 	     internal_volume->file_io_handle,
 	     internal_volume->superblock->file_system_root_object_identifier,
+	     LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	     &object_map_descriptor,
 	     error ) != 1 )
 	{
@@ -2872,8 +3897,10 @@ int libfsapfs_internal_volume_get_file_system(
 	     internal_volume->io_handle,
 	     internal_volume->encryption_context,
 	     internal_volume->file_system_data_block_vector,
+	     internal_volume->file_system_node_cache,
 	     internal_volume->object_map_btree,
 	     object_map_descriptor->physical_address,
+	     LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	     use_case_folding,
 	     error ) != 1 )
 	{
@@ -2902,6 +3929,8 @@ int libfsapfs_internal_volume_get_file_system(
 
 		goto on_error;
 	}
+	file_system_btree = NULL;
+
 	if( libfsapfs_object_map_descriptor_free(
 	     &object_map_descriptor,
 	     error ) != 1 )
@@ -2939,6 +3968,117 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the file system and grabs the read/write lock for reading
+ * The file system is determined under the write lock when it is not yet available,
+ * after which the lock is grabbed for reading, so that lookups can run concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_volume_grab_file_system_for_read(
+     libfsapfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_volume_grab_file_system_for_read";
+	int result            = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( internal_volume->file_system != NULL )
+		{
+			return( 1 );
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* Another thread can have determined the file system in the meantime
+		 */
+		if( internal_volume->file_system == NULL )
+		{
+			if( libfsapfs_internal_volume_get_file_system(
+			     internal_volume,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine file system.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	while( result == 1 );
+
+	return( -1 );
+}
+
 /* Retrieves the file entry for a specific identifier
  * Returns 1 if successful, 0 if not available or -1 on error
  */
@@ -2965,8 +4105,40 @@ int libfsapfs_volume_get_file_entry_by_identifier(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
+	if( libfsapfs_internal_volume_grab_file_system_for_read(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine file system.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsapfs_file_system_get_file_entry_by_identifier(
+	          internal_volume->file_system,
+	          internal_volume->file_io_handle,
+	          identifier,
+	          file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
+		 function,
+		 identifier );
+
+		result = -1;
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2974,52 +4146,76 @@ int libfsapfs_volume_get_file_entry_by_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_volume->file_system == NULL )
+	return( result );
+}
+
+/* Retrieves a file entry iterator
+ * The iterator returns the file entries in order of their identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_file_entry_iterator(
+     libfsapfs_volume_t *volume,
+     libfsapfs_file_entry_iterator_t **file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_file_entry_iterator";
+	int result                                   = 1;
+
+	if( volume == NULL )
 	{
-		if( libfsapfs_internal_volume_get_file_system(
-		     internal_volume,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine file system.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( result != -1 )
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( libfsapfs_internal_volume_grab_file_system_for_read(
+	     internal_volume,
+	     error ) != 1 )
 	{
-		result = libfsapfs_file_system_get_file_entry_by_identifier(
-		          internal_volume->file_system,
-		          internal_volume->file_io_handle,
-		          identifier,
-		          file_entry,
-		          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine file system.",
+		 function );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
-			 function,
-			 identifier );
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_iterator_initialize(
+	     file_entry_iterator,
+	     internal_volume->file_system->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume->file_system->encryption_context,
+	     internal_volume->file_system->file_system_btree,
+	     internal_volume->file_system->compressed_block_cache,
+	     LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry iterator.",
+		 function );
 
-			result = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3027,7 +4223,7 @@ int libfsapfs_volume_get_file_entry_by_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -3085,61 +4281,40 @@ int libfsapfs_volume_get_file_entry_by_utf8_path(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libfsapfs_internal_volume_grab_file_system_for_read(
+	     internal_volume,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine file system.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_volume->file_system == NULL )
-	{
-		if( libfsapfs_internal_volume_get_file_system(
-		     internal_volume,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine file system.",
-			 function );
+	result = libfsapfs_file_system_get_file_entry_by_utf8_path(
+	          internal_volume->file_system,
+	          internal_volume->file_io_handle,
+	          utf8_string,
+	          utf8_string_length,
+	          file_entry,
+	          error );
 
-			result = -1;
-		}
-	}
-	if( result != -1 )
+	if( result == -1 )
 	{
-		result = libfsapfs_file_system_get_file_entry_by_utf8_path(
-		          internal_volume->file_system,
-		          internal_volume->file_io_handle,
-		          utf8_string,
-		          utf8_string_length,
-		          file_entry,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry from file system by UTF-8 path.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry from file system by UTF-8 path.",
+		 function );
 
-			result = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3147,7 +4322,7 @@ int libfsapfs_volume_get_file_entry_by_utf8_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -3183,61 +4358,40 @@ int libfsapfs_volume_get_file_entry_by_utf16_path(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libfsapfs_internal_volume_grab_file_system_for_read(
+	     internal_volume,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine file system.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_volume->file_system == NULL )
-	{
-		if( libfsapfs_internal_volume_get_file_system(
-		     internal_volume,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine file system.",
-			 function );
+	result = libfsapfs_file_system_get_file_entry_by_utf16_path(
+	          internal_volume->file_system,
+	          internal_volume->file_io_handle,
+	          utf16_string,
+	          utf16_string_length,
+	          file_entry,
+	          error );
 
-			result = -1;
-		}
-	}
-	if( result != -1 )
+	if( result == -1 )
 	{
-		result = libfsapfs_file_system_get_file_entry_by_utf16_path(
-		          internal_volume->file_system,
-		          internal_volume->file_io_handle,
-		          utf16_string,
-		          utf16_string_length,
-		          file_entry,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry from file system by UTF-16 path.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry from file system by UTF-16 path.",
+		 function );
 
-			result = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3245,7 +4399,7 @@ int libfsapfs_volume_get_file_entry_by_utf16_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -3279,21 +4433,19 @@ int libfsapfs_volume_get_number_of_snapshots(
 	}
 	internal_volume = (libfsapfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+	if( libfsapfs_internal_volume_grab_snapshots_for_read(
+	     internal_volume,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve snapshots.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	if( libcdata_array_get_number_of_entries(
 	     internal_volume->snapshots,
 	     number_of_snapshots,
@@ -3340,6 +4492,7 @@ int libfsapfs_volume_get_snapshot_by_index(
 	libfsapfs_snapshot_metadata_t *snapshot_metadata = NULL;
 	static char *function                            = "libfsapfs_volume_get_snapshot_by_index";
 	off64_t file_offset                              = 0;
+	int result                                       = 0;
 
 	if( volume == NULL )
 	{
@@ -3377,7 +4530,7 @@ int libfsapfs_volume_get_snapshot_by_index(
 		return( -1 );
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3385,12 +4538,29 @@ int libfsapfs_volume_get_snapshot_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
+	if( internal_volume->snapshots_read == 0 )
+	{
+		if( libfsapfs_internal_volume_read_snapshots(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read snapshots.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_volume->snapshots,
 	     snapshot_index,
@@ -3405,7 +4575,7 @@ int libfsapfs_volume_get_snapshot_by_index(
 		 function,
 		 snapshot_index );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( snapshot_metadata == NULL )
 	{
@@ -3419,11 +4589,36 @@ int libfsapfs_volume_get_snapshot_by_index(
 
 		goto on_error;
 	}
+	/* The file system of the snapshot is encrypted with the same volume key
+	 */
+	if( internal_volume->is_locked != 0 )
+	{
+		result = libfsapfs_internal_volume_unlock(
+		          internal_volume,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unlock volume.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libfsapfs_snapshot_initialize(
 	     snapshot,
 	     internal_volume->io_handle,
 	     internal_volume->file_io_handle,
+	     internal_volume->encryption_context,
+	     internal_volume->file_system_data_block_vector,
+	     internal_volume->file_system_node_cache,
+	     internal_volume->object_map_btree,
 	     snapshot_metadata,
+	     internal_volume->is_locked,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -3454,7 +4649,7 @@ int libfsapfs_volume_get_snapshot_by_index(
 		goto on_error;
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3462,7 +4657,7 @@ int libfsapfs_volume_get_snapshot_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -3478,10 +4673,146 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_volume->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
+/* Retrieves a change iterator
+ * The iterator returns the changes between a snapshot of the volume and the volume
+ * The volume and the snapshot must not be freed before the iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_change_iterator(
+     libfsapfs_volume_t *volume,
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_change_iterator_t **change_iterator,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_system_btree_t *first_file_system_btree  = NULL;
+	libfsapfs_file_system_btree_t *second_file_system_btree = NULL;
+	libfsapfs_internal_volume_t *internal_volume            = NULL;
+	static char *function                                   = "libfsapfs_volume_get_change_iterator";
+	int result                                              = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (libfsapfs_internal_snapshot_t *) snapshot )->object_map_btree != internal_volume->object_map_btree )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported snapshot - not a snapshot of the volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_snapshot_get_file_system_btree(
+	     snapshot,
+	     &first_file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file system B-tree of snapshot.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_system == NULL )
+	{
+		if( libfsapfs_internal_volume_get_file_system(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		second_file_system_btree = internal_volume->file_system->file_system_btree;
+
+		if( libfsapfs_change_iterator_initialize(
+		     change_iterator,
+		     internal_volume->file_io_handle,
+		     first_file_system_btree,
+		     second_file_system_btree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create change iterator.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
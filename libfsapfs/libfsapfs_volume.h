@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_btree_node_cache.h"
 #include "libfsapfs_container_data_handle.h"
 #include "libfsapfs_container_key_bag.h"
 #include "libfsapfs_encryption_context.h"
@@ -37,6 +38,7 @@
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcthreads.h"
+#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_snapshot_metadata_tree.h"
@@ -80,10 +82,23 @@ struct libfsapfs_internal_volume
 	 */
 	libcdata_array_t *snapshots;
 
+	/* Value to indicate the snapshots have been read
+	 */
+	uint8_t snapshots_read;
+
 	/* The volume key bag
 	 */
 	libfsapfs_volume_key_bag_t *key_bag;
 
+	/* The volume key bag block number
+	 * When the volume was opened lazily the volume key bag is read when the volume is unlocked
+	 */
+	uint64_t key_bag_block_number;
+
+	/* The volume key bag number of blocks
+	 */
+	uint64_t key_bag_number_of_blocks;
+
 	/* The encryption context
 	 */
 	libfsapfs_encryption_context_t *encryption_context;
@@ -100,11 +115,13 @@ struct libfsapfs_internal_volume
 	 */
 	libfsapfs_file_system_t *file_system;
 
-	/* The file system B-tree
+	/* The file system B-tree node cache
+	 * This cache is shared by the file system B-trees of the volume and its snapshots
 	 */
-	libfsapfs_file_system_btree_t *file_system_btree;
+	libfsapfs_btree_node_cache_t *file_system_node_cache;
 
 	/* The IO handle
+	 * This is a copy of the container IO handle so that the cache settings are per volume
 	 */
 	libfsapfs_io_handle_t *io_handle;
 
@@ -157,6 +174,20 @@ int libfsapfs_internal_volume_open_read(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libfsapfs_internal_volume_read_key_bag(
+     libfsapfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_volume_read_snapshots(
+     libfsapfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_volume_grab_snapshots_for_read(
+     libfsapfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
 int libfsapfs_internal_volume_close(
      libfsapfs_internal_volume_t *internal_volume,
      libcerror_error_t **error );
@@ -222,6 +253,44 @@ int libfsapfs_volume_is_locked(
      libfsapfs_volume_t *volume,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_maximum_cache_size(
+     libfsapfs_volume_t *volume,
+     int cache_type,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_set_maximum_cache_size(
+     libfsapfs_volume_t *volume,
+     int cache_type,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_number_of_decryption_threads(
+     libfsapfs_volume_t *volume,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_set_number_of_decryption_threads(
+     libfsapfs_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_number_of_decompression_threads(
+     libfsapfs_volume_t *volume,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_set_number_of_decompression_threads(
+     libfsapfs_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_volume_set_utf8_password(
      libfsapfs_volume_t *volume,
@@ -266,6 +335,10 @@ int libfsapfs_internal_volume_get_file_system(
      libfsapfs_internal_volume_t *internal_volume,
      libcerror_error_t **error );
 
+int libfsapfs_internal_volume_grab_file_system_for_read(
+     libfsapfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_volume_get_file_entry_by_identifier(
      libfsapfs_volume_t *volume,
@@ -273,6 +346,12 @@ int libfsapfs_volume_get_file_entry_by_identifier(
      libfsapfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_file_entry_iterator(
+     libfsapfs_volume_t *volume,
+     libfsapfs_file_entry_iterator_t **file_entry_iterator,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_volume_get_file_entry_by_utf8_path(
      libfsapfs_volume_t *volume,
@@ -302,6 +381,13 @@ int libfsapfs_volume_get_snapshot_by_index(
      libfsapfs_snapshot_t **snapshot,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_change_iterator(
+     libfsapfs_volume_t *volume,
+     libfsapfs_snapshot_t *snapshot,
+     libfsapfs_change_iterator_t **change_iterator,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,608 @@
+/*
+ * The worker pool functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_worker_pool.h"
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+/* Creates a worker pool
+ * Make sure the value worker_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_worker_pool_initialize(
+     libfsapfs_worker_pool_t **worker_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_worker_pool_initialize";
+
+	if( worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *worker_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid worker pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*worker_pool = memory_allocate_structure(
+	                libfsapfs_worker_pool_t );
+
+	if( *worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create worker pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *worker_pool,
+	     0,
+	     sizeof( libfsapfs_worker_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear worker pool.",
+		 function );
+
+		memory_free(
+		 *worker_pool );
+
+		*worker_pool = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *worker_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *worker_pool )->jobs_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize jobs mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *worker_pool )->jobs_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize jobs condition.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *worker_pool != NULL )
+	{
+		if( ( *worker_pool )->jobs_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *worker_pool )->jobs_mutex ),
+			 NULL );
+		}
+		if( ( *worker_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *worker_pool )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *worker_pool );
+
+		*worker_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a worker pool
+ * The worker threads are joined after they finished the pushed jobs
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_worker_pool_free(
+     libfsapfs_worker_pool_t **worker_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_worker_pool_free";
+	int result            = 1;
+
+	if( worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *worker_pool != NULL )
+	{
+		if( ( *worker_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *worker_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *worker_pool )->jobs_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free jobs condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *worker_pool )->jobs_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free jobs mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *worker_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *worker_pool );
+
+		*worker_pool = NULL;
+	}
+	return( result );
+}
+
+/* Grabs the worker threads for the calling thread
+ * The worker threads are started on first use, and restarted when more are needed
+ * Returns 1 if successful, 0 if the worker threads are in use by another caller or -1 on error
+ */
+int libfsapfs_worker_pool_grab(
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_worker_pool_grab";
+	int result            = 0;
+
+	if( worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_mutex_try_grab(
+	          worker_pool->mutex,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The previous caller waited for all its jobs to finish hence the worker threads are idle
+	 */
+	if( ( worker_pool->thread_pool != NULL )
+	 && ( worker_pool->number_of_threads < number_of_threads ) )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( worker_pool->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		worker_pool->number_of_threads = 0;
+	}
+	if( worker_pool->thread_pool == NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( worker_pool->thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     number_of_threads,
+		     (int (*)(intptr_t *, void *)) &libfsapfs_worker_pool_run_job,
+		     (void *) worker_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		worker_pool->number_of_threads = number_of_threads;
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 worker_pool->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Releases the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_worker_pool_release(
+     libfsapfs_worker_pool_t *worker_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_worker_pool_release";
+
+	if( worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     worker_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Runs a job
+ * Callback for the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_worker_pool_run_job(
+     libfsapfs_worker_pool_job_t *job,
+     libfsapfs_worker_pool_t *worker_pool )
+{
+	int result = 1;
+
+	if( ( job == NULL )
+	 || ( job->function == NULL )
+	 || ( worker_pool == NULL ) )
+	{
+		return( -1 );
+	}
+	/* The error cannot be passed between threads
+	 */
+	job->result = job->function(
+	               job->arguments );
+
+	if( libcthreads_mutex_grab(
+	     worker_pool->jobs_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	worker_pool->number_of_pending_jobs -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     worker_pool->jobs_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     worker_pool->jobs_mutex,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Pushes a job onto the worker threads
+ * The worker threads must be grabbed by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_worker_pool_push_job(
+     libfsapfs_worker_pool_t *worker_pool,
+     libfsapfs_worker_pool_job_t *job,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_worker_pool_push_job";
+	int result            = 1;
+
+	if( worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker_pool->thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker pool - missing thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job.",
+		 function );
+
+		return( -1 );
+	}
+	job->result = 0;
+
+	if( libcthreads_mutex_grab(
+	     worker_pool->jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	worker_pool->number_of_pending_jobs += 1;
+
+	if( libcthreads_mutex_release(
+	     worker_pool->jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     worker_pool->thread_pool,
+	     (intptr_t *) job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push job onto thread pool.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     worker_pool->jobs_mutex,
+		     NULL ) == 1 )
+		{
+			worker_pool->number_of_pending_jobs -= 1;
+
+			libcthreads_mutex_release(
+			 worker_pool->jobs_mutex,
+			 NULL );
+		}
+	}
+	return( result );
+}
+
+/* Waits for the pushed jobs to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_worker_pool_wait_for_jobs(
+     libfsapfs_worker_pool_t *worker_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_worker_pool_wait_for_jobs";
+	int result            = 1;
+
+	if( worker_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     worker_pool->jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( worker_pool->number_of_pending_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     worker_pool->jobs_condition,
+		     worker_pool->jobs_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for jobs condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     worker_pool->jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release jobs mutex.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,127 @@
+/*
+ * The worker pool functions
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_WORKER_POOL_H )
+#define _LIBFSAPFS_WORKER_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_worker_pool_job libfsapfs_worker_pool_job_t;
+
+struct libfsapfs_worker_pool_job
+{
+	/* The job function
+	 */
+	int (*function)(
+	       void *arguments );
+
+	/* The job function arguments
+	 */
+	void *arguments;
+
+	/* The result of the job function
+	 */
+	int result;
+};
+
+typedef struct libfsapfs_worker_pool libfsapfs_worker_pool_t;
+
+/* The worker pool keeps worker threads alive between the decrypt and decompress
+ * calls that spread their work across threads, where the worker threads are
+ * started on first use and a single caller uses the worker threads at a time
+ */
+struct libfsapfs_worker_pool
+{
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The number of pushed jobs that have not finished
+	 */
+	int number_of_pending_jobs;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that serializes the use of the worker threads
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The mutex that protects the number of pending jobs
+	 */
+	libcthreads_mutex_t *jobs_mutex;
+
+	/* The condition that signals that a job has finished
+	 */
+	libcthreads_condition_t *jobs_condition;
+#endif
+};
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+int libfsapfs_worker_pool_initialize(
+     libfsapfs_worker_pool_t **worker_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_worker_pool_free(
+     libfsapfs_worker_pool_t **worker_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_worker_pool_grab(
+     libfsapfs_worker_pool_t *worker_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsapfs_worker_pool_release(
+     libfsapfs_worker_pool_t *worker_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_worker_pool_run_job(
+     libfsapfs_worker_pool_job_t *job,
+     libfsapfs_worker_pool_t *worker_pool );
+
+int libfsapfs_worker_pool_push_job(
+     libfsapfs_worker_pool_t *worker_pool,
+     libfsapfs_worker_pool_job_t *job,
+     libcerror_error_t **error );
+
+int libfsapfs_worker_pool_wait_for_jobs(
+     libfsapfs_worker_pool_t *worker_pool,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_WORKER_POOL_H ) */
+
@@ -34,6 +34,7 @@
 #include "pyfsapfs_extended_attributes.h"
 #include "pyfsapfs_file_entries.h"
 #include "pyfsapfs_file_entry.h"
+#include "pyfsapfs_file_entry_iterator.h"
 #include "pyfsapfs_file_object_io_handle.h"
 #include "pyfsapfs_libbfio.h"
 #include "pyfsapfs_libcerror.h"
@@ -684,6 +685,23 @@ PyMODINIT_FUNC initpyfsapfs(
 	 "file_entry",
 	 (PyObject *) &pyfsapfs_file_entry_type_object );
 
+	/* Setup the file_entry_iterator type object
+	 */
+	pyfsapfs_file_entry_iterator_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pyfsapfs_file_entry_iterator_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyfsapfs_file_entry_iterator_type_object );
+
+	PyModule_AddObject(
+	 module,
+	 "file_entry_iterator",
+	 (PyObject *) &pyfsapfs_file_entry_iterator_type_object );
+
 	/* Setup the volume type object
 	 */
 	pyfsapfs_volume_type_object.tp_new = PyType_GenericNew;
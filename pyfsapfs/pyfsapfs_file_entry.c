@@ -33,6 +33,7 @@
 #include "pyfsapfs_extended_attributes.h"
 #include "pyfsapfs_file_entries.h"
 #include "pyfsapfs_file_entry.h"
+#include "pyfsapfs_file_entry_iterator.h"
 #include "pyfsapfs_integer.h"
 #include "pyfsapfs_libcerror.h"
 #include "pyfsapfs_libfsapfs.h"
@@ -223,6 +224,13 @@ PyMethodDef pyfsapfs_file_entry_object_methods[] = {
 	  "\n"
 	  "Retrieves the sub file entry specified by the name." },
 
+	{ "iterate_sub_file_entries",
+	  (PyCFunction) pyfsapfs_file_entry_iterate_sub_file_entries,
+	  METH_NOARGS,
+	  "iterate_sub_file_entries() -> Object\n"
+	  "\n"
+	  "Retrieves an iterator that reads the sub file entries one at a time." },
+
 	{ "read_buffer",
 	  (PyCFunction) pyfsapfs_file_entry_read_buffer,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -2622,6 +2630,77 @@ on_error:
 	return( NULL );
 }
 
+/* Retrieves an iterator of the sub file entries
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyfsapfs_file_entry_iterate_sub_file_entries(
+           pyfsapfs_file_entry_t *pyfsapfs_file_entry,
+           PyObject *arguments PYFSAPFS_ATTRIBUTE_UNUSED )
+{
+	PyObject *iterator_object                                = NULL;
+	libcerror_error_t *error                                 = NULL;
+	libfsapfs_file_entry_iterator_t *sub_file_entry_iterator = NULL;
+	static char *function                                    = "pyfsapfs_file_entry_iterate_sub_file_entries";
+	int result                                               = 0;
+
+	PYFSAPFS_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyfsapfs_file_entry == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libfsapfs_file_entry_get_sub_file_entry_iterator(
+	          pyfsapfs_file_entry->file_entry,
+	          &sub_file_entry_iterator,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyfsapfs_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve sub file entry iterator.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	iterator_object = pyfsapfs_file_entry_iterator_new(
+	                   sub_file_entry_iterator,
+	                   pyfsapfs_file_entry->parent_object );
+
+	if( iterator_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create sub file entry iterator object.",
+		 function );
+
+		goto on_error;
+	}
+	return( iterator_object );
+
+on_error:
+	if( sub_file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &sub_file_entry_iterator,
+		 NULL );
+	}
+	return( NULL );
+}
+
 /* Reads data at the current offset into a buffer
  * Returns a Python object if successful or NULL on error
  */
@@ -187,6 +187,10 @@ PyObject *pyfsapfs_file_entry_get_sub_file_entry_by_name(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyfsapfs_file_entry_iterate_sub_file_entries(
+           pyfsapfs_file_entry_t *pyfsapfs_file_entry,
+           PyObject *arguments );
+
 PyObject *pyfsapfs_file_entry_read_buffer(
            pyfsapfs_file_entry_t *pyfsapfs_file_entry,
            PyObject *arguments,
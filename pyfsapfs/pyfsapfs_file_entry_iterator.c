@@ -0,0 +1,380 @@
+/*
+ * Python object definition of the file entry iterator object
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyfsapfs_error.h"
+#include "pyfsapfs_file_entry.h"
+#include "pyfsapfs_file_entry_iterator.h"
+#include "pyfsapfs_libcerror.h"
+#include "pyfsapfs_libfsapfs.h"
+#include "pyfsapfs_python.h"
+
+PyTypeObject pyfsapfs_file_entry_iterator_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pyfsapfs.file_entry_iterator",
+	/* tp_basicsize */
+	sizeof( pyfsapfs_file_entry_iterator_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pyfsapfs_file_entry_iterator_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	0,
+	/* tp_flags */
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_ITER,
+	/* tp_doc */
+	"pyfsapfs iterator object of file entries",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	(getiterfunc) pyfsapfs_file_entry_iterator_iter,
+	/* tp_iternext */
+	(iternextfunc) pyfsapfs_file_entry_iterator_iternext,
+	/* tp_methods */
+	0,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	0,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pyfsapfs_file_entry_iterator_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Creates a new file entry iterator object
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyfsapfs_file_entry_iterator_new(
+           libfsapfs_file_entry_iterator_t *file_entry_iterator,
+           PyObject *parent_object )
+{
+	pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator = NULL;
+	static char *function                                        = "pyfsapfs_file_entry_iterator_new";
+
+	if( file_entry_iterator == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( NULL );
+	}
+	/* PyObject_New does not invoke tp_init
+	 */
+	pyfsapfs_file_entry_iterator = PyObject_New(
+	                                struct pyfsapfs_file_entry_iterator,
+	                                &pyfsapfs_file_entry_iterator_type_object );
+
+	if( pyfsapfs_file_entry_iterator == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
+	pyfsapfs_file_entry_iterator->file_entry_iterator = file_entry_iterator;
+	pyfsapfs_file_entry_iterator->parent_object       = parent_object;
+
+	if( pyfsapfs_file_entry_iterator->parent_object != NULL )
+	{
+		Py_IncRef(
+		 pyfsapfs_file_entry_iterator->parent_object );
+	}
+	return( (PyObject *) pyfsapfs_file_entry_iterator );
+
+on_error:
+	if( pyfsapfs_file_entry_iterator != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) pyfsapfs_file_entry_iterator );
+	}
+	return( NULL );
+}
+
+/* Initializes a file entry iterator object
+ * Returns 0 if successful or -1 on error
+ */
+int pyfsapfs_file_entry_iterator_init(
+     pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator )
+{
+	static char *function = "pyfsapfs_file_entry_iterator_init";
+
+	if( pyfsapfs_file_entry_iterator == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure libfsapfs file entry iterator is set to NULL
+	 */
+	pyfsapfs_file_entry_iterator->file_entry_iterator = NULL;
+	pyfsapfs_file_entry_iterator->parent_object       = NULL;
+
+	PyErr_Format(
+	 PyExc_NotImplementedError,
+	 "%s: initialize of file entry iterator not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Frees a file entry iterator object
+ */
+void pyfsapfs_file_entry_iterator_free(
+      pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator )
+{
+	struct _typeobject *ob_type = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyfsapfs_file_entry_iterator_free";
+	int result                  = 0;
+
+	if( pyfsapfs_file_entry_iterator == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           pyfsapfs_file_entry_iterator );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( pyfsapfs_file_entry_iterator->file_entry_iterator != NULL )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libfsapfs_file_entry_iterator_free(
+		          &( pyfsapfs_file_entry_iterator->file_entry_iterator ),
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pyfsapfs_error_raise(
+			 error,
+			 PyExc_MemoryError,
+			 "%s: unable to free libfsapfs file entry iterator.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	if( pyfsapfs_file_entry_iterator->parent_object != NULL )
+	{
+		Py_DecRef(
+		 pyfsapfs_file_entry_iterator->parent_object );
+	}
+	ob_type->tp_free(
+	 (PyObject*) pyfsapfs_file_entry_iterator );
+}
+
+/* The file entry iterator iter() function
+ */
+PyObject *pyfsapfs_file_entry_iterator_iter(
+           pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator )
+{
+	static char *function = "pyfsapfs_file_entry_iterator_iter";
+
+	if( pyfsapfs_file_entry_iterator == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 (PyObject *) pyfsapfs_file_entry_iterator );
+
+	return( (PyObject *) pyfsapfs_file_entry_iterator );
+}
+
+/* The file entry iterator iternext() function
+ */
+PyObject *pyfsapfs_file_entry_iterator_iternext(
+           pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator )
+{
+	PyObject *file_entry_object        = NULL;
+	libcerror_error_t *error           = NULL;
+	libfsapfs_file_entry_t *file_entry = NULL;
+	static char *function              = "pyfsapfs_file_entry_iterator_iternext";
+	int result                         = 0;
+
+	if( pyfsapfs_file_entry_iterator == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libfsapfs_file_entry_iterator_get_next_file_entry(
+	          pyfsapfs_file_entry_iterator->file_entry_iterator,
+	          &file_entry,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result == -1 )
+	{
+		pyfsapfs_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve next file entry.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		PyErr_SetNone(
+		 PyExc_StopIteration );
+
+		return( NULL );
+	}
+	file_entry_object = pyfsapfs_file_entry_new(
+	                     file_entry,
+	                     pyfsapfs_file_entry_iterator->parent_object );
+
+	if( file_entry_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create file entry object.",
+		 function );
+
+		goto on_error;
+	}
+	return( file_entry_object );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( NULL );
+}
+
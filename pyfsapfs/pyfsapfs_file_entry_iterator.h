@@ -0,0 +1,75 @@
+/*
+ * Python object definition of the file entry iterator object
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYFSAPFS_FILE_ENTRY_ITERATOR_H )
+#define _PYFSAPFS_FILE_ENTRY_ITERATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyfsapfs_libfsapfs.h"
+#include "pyfsapfs_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct pyfsapfs_file_entry_iterator pyfsapfs_file_entry_iterator_t;
+
+struct pyfsapfs_file_entry_iterator
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The libfsapfs file entry iterator
+	 */
+	libfsapfs_file_entry_iterator_t *file_entry_iterator;
+
+	/* The parent object
+	 */
+	PyObject *parent_object;
+};
+
+extern PyTypeObject pyfsapfs_file_entry_iterator_type_object;
+
+PyObject *pyfsapfs_file_entry_iterator_new(
+           libfsapfs_file_entry_iterator_t *file_entry_iterator,
+           PyObject *parent_object );
+
+int pyfsapfs_file_entry_iterator_init(
+     pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator );
+
+void pyfsapfs_file_entry_iterator_free(
+      pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator );
+
+PyObject *pyfsapfs_file_entry_iterator_iter(
+           pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator );
+
+PyObject *pyfsapfs_file_entry_iterator_iternext(
+           pyfsapfs_file_entry_iterator_t *pyfsapfs_file_entry_iterator );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYFSAPFS_FILE_ENTRY_ITERATOR_H ) */
+
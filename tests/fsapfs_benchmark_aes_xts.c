@@ -0,0 +1,568 @@
+/*
+ * AES-XTS decryption benchmark program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_aes_xts_context.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_libcaes.h"
+
+#define FSAPFS_BENCHMARK_AES_XTS_BYTES_PER_SECTOR	512
+#define FSAPFS_BENCHMARK_AES_XTS_NUMBER_OF_RUNS		3
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+uint8_t fsapfs_benchmark_aes_xts_key[ 16 ] = {
+	0x27, 0x18, 0x28, 0x18, 0x28, 0x45, 0x90, 0x45,
+	0x23, 0x53, 0x60, 0x28, 0x74, 0x71, 0x35, 0x26 };
+
+uint8_t fsapfs_benchmark_aes_xts_tweak_key[ 16 ] = {
+	0x31, 0x41, 0x59, 0x26, 0x53, 0x58, 0x97, 0x93,
+	0x23, 0x84, 0x62, 0x64, 0x33, 0x83, 0x27, 0x95 };
+
+/* Retrieves the name of an AES-XTS backend
+ * Returns the name
+ */
+const char *fsapfs_benchmark_aes_xts_get_backend_name(
+             int backend )
+{
+	switch( backend )
+	{
+		case LIBFSAPFS_AES_XTS_BACKEND_AES_NI:
+			return( "AES-NI" );
+
+		case LIBFSAPFS_AES_XTS_BACKEND_VAES:
+			return( "VAES" );
+
+		case LIBFSAPFS_AES_XTS_BACKEND_ARMV8_CRYPTO:
+			return( "ARMv8 cryptography extension" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Decrypts the data with libcaes, a sector at a time, as the encryption context does without an AES-XTS backend
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_aes_xts_decrypt_with_libcaes(
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	uint8_t tweak_value[ 16 ];
+
+	libcaes_tweaked_context_t *decryption_context = NULL;
+	static char *function                         = "fsapfs_benchmark_aes_xts_decrypt_with_libcaes";
+	size_t data_offset                            = 0;
+	uint64_t sector_number                        = 0;
+	int64_t start_timestamp                       = 0;
+	int64_t stop_timestamp                        = 0;
+
+	if( libcaes_tweaked_context_initialize(
+	     &decryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize decryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_tweaked_context_set_keys(
+	     decryption_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     fsapfs_benchmark_aes_xts_key,
+	     128,
+	     fsapfs_benchmark_aes_xts_tweak_key,
+	     128,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys in decryption context.",
+		 function );
+
+		goto on_error;
+	}
+	memory_set(
+	 tweak_value,
+	 0,
+	 16 );
+
+	if( fsapfs_benchmark_get_timestamp(
+	     &start_timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset += FSAPFS_BENCHMARK_AES_XTS_BYTES_PER_SECTOR )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 tweak_value,
+		 sector_number );
+
+		if( libcaes_crypt_xts(
+		     decryption_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     tweak_value,
+		     16,
+		     &( input_data[ data_offset ] ),
+		     FSAPFS_BENCHMARK_AES_XTS_BYTES_PER_SECTOR,
+		     &( output_data[ data_offset ] ),
+		     FSAPFS_BENCHMARK_AES_XTS_BYTES_PER_SECTOR,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt data.",
+			 function );
+
+			goto on_error;
+		}
+		sector_number += 1;
+	}
+	if( fsapfs_benchmark_get_timestamp(
+	     &stop_timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	*elapsed_time = stop_timestamp - start_timestamp;
+
+	if( libcaes_tweaked_context_free(
+	     &decryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free decryption context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( decryption_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &decryption_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Decrypts the data with an AES-XTS backend
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_aes_xts_decrypt_with_backend(
+     int backend,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	libfsapfs_aes_xts_context_t *aes_xts_context = NULL;
+	static char *function                        = "fsapfs_benchmark_aes_xts_decrypt_with_backend";
+	int64_t start_timestamp                      = 0;
+	int64_t stop_timestamp                       = 0;
+
+	if( libfsapfs_aes_xts_context_initialize(
+	     &aes_xts_context,
+	     backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize AES-XTS context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_aes_xts_context_set_keys(
+	     aes_xts_context,
+	     fsapfs_benchmark_aes_xts_key,
+	     fsapfs_benchmark_aes_xts_tweak_key,
+	     128,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys in AES-XTS context.",
+		 function );
+
+		goto on_error;
+	}
+	if( fsapfs_benchmark_get_timestamp(
+	     &start_timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_aes_xts_context_decrypt(
+	     aes_xts_context,
+	     input_data,
+	     data_size,
+	     output_data,
+	     0,
+	     FSAPFS_BENCHMARK_AES_XTS_BYTES_PER_SECTOR,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt data.",
+		 function );
+
+		goto on_error;
+	}
+	if( fsapfs_benchmark_get_timestamp(
+	     &stop_timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	*elapsed_time = stop_timestamp - start_timestamp;
+
+	if( libfsapfs_aes_xts_context_free(
+	     &aes_xts_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free AES-XTS context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( aes_xts_context != NULL )
+	{
+		libfsapfs_aes_xts_context_free(
+		 &aes_xts_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* Prints usage information
+ */
+void fsapfs_benchmark_aes_xts_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fsapfs_benchmark_aes_xts to compare the AES-XTS decryption\n"
+	                 "throughput of the backends supported by the CPU with libcaes.\n\n" );
+
+	fprintf( stream, "Usage: fsapfs_benchmark_aes_xts [ -s size ]\n\n" );
+
+	fprintf( stream, "\t-s:     specify the size of the data in MiB, the default is 64\n" );
+	fprintf( stream, "\n" );
+	fprintf( stream, "Every backend decrypts the data %d times, the fastest time is reported.\n"
+	                 "The output of every backend is compared with that of libcaes.\n",
+	         FSAPFS_BENCHMARK_AES_XTS_NUMBER_OF_RUNS );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+	libcerror_error_t *error       = NULL;
+	uint8_t *input_data            = NULL;
+	uint8_t *output_data           = NULL;
+	uint8_t *reference_output_data = NULL;
+	size_t data_offset             = 0;
+	size_t data_size               = 0;
+	uint32_t random_value          = 0x12345678UL;
+	int64_t elapsed_time           = 0;
+	int64_t minimum_elapsed_time   = 0;
+	int64_t reference_elapsed_time = 0;
+	system_integer_t option        = 0;
+	int backend                    = 0;
+	int data_size_in_mib           = 64;
+	int run_index                  = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hs:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %s.\n",
+				 argv[ optind - 1 ] );
+
+				fsapfs_benchmark_aes_xts_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				fsapfs_benchmark_aes_xts_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 's':
+				data_size_in_mib = atoi(
+				                    optarg );
+
+				break;
+		}
+	}
+	if( ( data_size_in_mib < 1 )
+	 || ( data_size_in_mib > 4096 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported size: %d.\n",
+		 data_size_in_mib );
+
+		return( EXIT_FAILURE );
+	}
+	data_size = (size_t) data_size_in_mib * 1024 * 1024;
+
+	input_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * data_size );
+
+	output_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * data_size );
+
+	reference_output_data = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * data_size );
+
+	if( ( input_data == NULL )
+	 || ( output_data == NULL )
+	 || ( reference_output_data == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	/* Fill the input data with pseudo random values using xorshift
+	 */
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		input_data[ data_offset ] = (uint8_t) random_value;
+	}
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_AES_XTS_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		if( fsapfs_benchmark_aes_xts_decrypt_with_libcaes(
+		     input_data,
+		     reference_output_data,
+		     data_size,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( ( run_index == 0 )
+		 || ( elapsed_time < reference_elapsed_time ) )
+		{
+			reference_elapsed_time = elapsed_time;
+		}
+	}
+	fsapfs_benchmark_print_throughput(
+	 "libcaes",
+	 (size64_t) data_size,
+	 reference_elapsed_time,
+	 reference_elapsed_time );
+
+	backend = libfsapfs_aes_xts_context_get_supported_backend();
+
+	while( backend != LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	{
+		for( run_index = 0;
+		     run_index < FSAPFS_BENCHMARK_AES_XTS_NUMBER_OF_RUNS;
+		     run_index++ )
+		{
+			if( fsapfs_benchmark_aes_xts_decrypt_with_backend(
+			     backend,
+			     input_data,
+			     output_data,
+			     data_size,
+			     &elapsed_time,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+			if( ( run_index == 0 )
+			 || ( elapsed_time < minimum_elapsed_time ) )
+			{
+				minimum_elapsed_time = elapsed_time;
+			}
+		}
+		if( memory_compare(
+		     output_data,
+		     reference_output_data,
+		     data_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Decrypted data of backend: %s does not match that of libcaes.\n",
+			 fsapfs_benchmark_aes_xts_get_backend_name(
+			  backend ) );
+
+			goto on_error;
+		}
+		fsapfs_benchmark_print_throughput(
+		 fsapfs_benchmark_aes_xts_get_backend_name(
+		  backend ),
+		 (size64_t) data_size,
+		 minimum_elapsed_time,
+		 reference_elapsed_time );
+
+		backend = libfsapfs_aes_xts_context_get_fallback_backend(
+		           backend );
+	}
+	memory_free(
+	 reference_output_data );
+	memory_free(
+	 output_data );
+	memory_free(
+	 input_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( reference_output_data != NULL )
+	{
+		memory_free(
+		 reference_output_data );
+	}
+	if( output_data != NULL )
+	{
+		memory_free(
+		 output_data );
+	}
+	if( input_data != NULL )
+	{
+		memory_free(
+		 input_data );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "The AES-XTS context functions are not available.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,1001 @@
+/*
+ * B-tree lookup benchmark program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_btree_entry.h"
+#include "../libfsapfs/libfsapfs_btree_node.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_file_system.h"
+#include "../libfsapfs/libfsapfs_file_system_btree.h"
+#include "../libfsapfs/libfsapfs_object_map_btree.h"
+#include "../libfsapfs/libfsapfs_volume.h"
+
+#define FSAPFS_BENCHMARK_BTREE_NUMBER_OF_RUNS	8
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Appends an identifier to the identifiers
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_btree_append_identifier(
+     uint64_t **identifiers,
+     int *number_of_identifiers,
+     int *maximum_number_of_identifiers,
+     uint64_t identifier,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "fsapfs_benchmark_btree_append_identifier";
+
+	if( *number_of_identifiers >= *maximum_number_of_identifiers )
+	{
+		if( *maximum_number_of_identifiers >= ( INT_MAX - 4096 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of identifiers value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                *identifiers,
+		                sizeof( uint64_t ) * ( *maximum_number_of_identifiers + 4096 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize identifiers.",
+			 function );
+
+			return( -1 );
+		}
+		*identifiers                    = (uint64_t *) reallocation;
+		*maximum_number_of_identifiers += 4096;
+	}
+	( *identifiers )[ *number_of_identifiers ] = identifier;
+
+	*number_of_identifiers += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the object identifiers in the leaf nodes of an object map B-tree (sub) node
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_btree_get_object_map_identifiers(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_btree_node_t *node,
+     int recursion_depth,
+     uint64_t **identifiers,
+     int *number_of_identifiers,
+     int *maximum_number_of_identifiers,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry   = NULL;
+	libfsapfs_btree_node_t *sub_node = NULL;
+	uint64_t *sub_node_block_numbers = NULL;
+	static char *function            = "fsapfs_benchmark_btree_get_object_map_identifiers";
+	uint64_t object_identifier       = 0;
+	int entry_index                  = 0;
+	int is_leaf_node                 = 0;
+	int number_of_entries            = 0;
+
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
+	                node,
+	                error );
+
+	if( is_leaf_node == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if B-tree node is a leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_btree_node_get_number_of_entries(
+	     node,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from B-tree node.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+	/* The node is owned by the node cache and can be evicted when the sub nodes
+	 * are read, hence the sub node block numbers are copied first
+	 */
+	if( is_leaf_node == 0 )
+	{
+		sub_node_block_numbers = (uint64_t *) memory_allocate(
+		                                       sizeof( uint64_t ) * number_of_entries );
+
+		if( sub_node_block_numbers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub node block numbers.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libfsapfs_btree_node_get_entry_by_index(
+		     node,
+		     entry_index,
+		     &entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from B-tree node.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( ( entry == NULL )
+		 || ( entry->key_data == NULL )
+		 || ( entry->key_data_size < 8 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry: %d - missing key data.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( is_leaf_node == 0 )
+		{
+			if( ( entry->value_data == NULL )
+			 || ( entry->value_data_size != 8 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: invalid B-tree entry: %d - unsupported value data.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 entry->value_data,
+			 sub_node_block_numbers[ entry_index ] );
+
+			continue;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 entry->key_data,
+		 object_identifier );
+
+		/* Successive versions of an object share the object identifier
+		 */
+		if( ( *number_of_identifiers > 0 )
+		 && ( ( *identifiers )[ *number_of_identifiers - 1 ] == object_identifier ) )
+		{
+			continue;
+		}
+		if( fsapfs_benchmark_btree_append_identifier(
+		     identifiers,
+		     number_of_identifiers,
+		     maximum_number_of_identifiers,
+		     object_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( is_leaf_node != 0 )
+	{
+		return( 1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		sub_node = NULL;
+
+		if( libfsapfs_object_map_btree_get_sub_node(
+		     object_map_btree,
+		     file_io_handle,
+		     sub_node_block_numbers[ entry_index ],
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
+			 function,
+			 sub_node_block_numbers[ entry_index ] );
+
+			goto on_error;
+		}
+		if( fsapfs_benchmark_btree_get_object_map_identifiers(
+		     object_map_btree,
+		     file_io_handle,
+		     sub_node,
+		     recursion_depth + 1,
+		     identifiers,
+		     number_of_identifiers,
+		     maximum_number_of_identifiers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve object identifiers from B-tree sub node: %" PRIu64 ".",
+			 function,
+			 sub_node_block_numbers[ entry_index ] );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 sub_node_block_numbers );
+
+	return( 1 );
+
+on_error:
+	if( sub_node_block_numbers != NULL )
+	{
+		memory_free(
+		 sub_node_block_numbers );
+	}
+	return( -1 );
+}
+
+/* Retrieves the identifiers of the file entries of a volume
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_btree_get_file_system_identifiers(
+     libfsapfs_volume_t *volume,
+     uint64_t **identifiers,
+     int *number_of_identifiers,
+     int *maximum_number_of_identifiers,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_entry_t *file_entry                   = NULL;
+	libfsapfs_file_entry_iterator_t *file_entry_iterator = NULL;
+	static char *function                                = "fsapfs_benchmark_btree_get_file_system_identifiers";
+	uint64_t identifier                                  = 0;
+	int result                                           = 0;
+
+	if( libfsapfs_volume_get_file_entry_iterator(
+	     volume,
+	     &file_entry_iterator,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libfsapfs_file_entry_iterator_get_next_file_entry(
+		          file_entry_iterator,
+		          &file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next file entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfsapfs_file_entry_get_identifier(
+		     file_entry,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_entry_free(
+		     &file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( fsapfs_benchmark_btree_append_identifier(
+		     identifiers,
+		     number_of_identifiers,
+		     maximum_number_of_identifiers,
+		     identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( result == 1 );
+
+	if( libfsapfs_file_entry_iterator_free(
+	     &file_entry_iterator,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Looks up every identifier in the object map B-tree
+ * The B-tree is traversed from the root node, bypassing the descriptor cache
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_btree_lookup_object_map(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     const uint64_t *identifiers,
+     int number_of_identifiers,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry = NULL;
+	libfsapfs_btree_node_t *node   = NULL;
+	static char *function          = "fsapfs_benchmark_btree_lookup_object_map";
+	int64_t start_timestamp        = 0;
+	int64_t stop_timestamp         = 0;
+	int identifier_index           = 0;
+	int run_index                  = 0;
+
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_BTREE_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		if( fsapfs_benchmark_get_timestamp(
+		     &start_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		for( identifier_index = 0;
+		     identifier_index < number_of_identifiers;
+		     identifier_index++ )
+		{
+			node  = NULL;
+			entry = NULL;
+
+			if( libfsapfs_object_map_btree_get_entry_by_identifier(
+			     object_map_btree,
+			     file_io_handle,
+			     identifiers[ identifier_index ],
+			     LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+			     &node,
+			     &entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry for object identifier: %" PRIu64 ".",
+				 function,
+				 identifiers[ identifier_index ] );
+
+				return( -1 );
+			}
+		}
+		if( fsapfs_benchmark_get_timestamp(
+		     &stop_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( run_index == 0 )
+		 || ( ( stop_timestamp - start_timestamp ) < *elapsed_time ) )
+		{
+			*elapsed_time = stop_timestamp - start_timestamp;
+		}
+	}
+	return( 1 );
+}
+
+/* Looks up the inode of every identifier in the file system B-tree
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_btree_lookup_file_system(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     const uint64_t *identifiers,
+     int number_of_identifiers,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry = NULL;
+	libfsapfs_btree_node_t *node   = NULL;
+	static char *function          = "fsapfs_benchmark_btree_lookup_file_system";
+	int64_t start_timestamp        = 0;
+	int64_t stop_timestamp         = 0;
+	int identifier_index           = 0;
+	int run_index                  = 0;
+
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_BTREE_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		if( fsapfs_benchmark_get_timestamp(
+		     &start_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		for( identifier_index = 0;
+		     identifier_index < number_of_identifiers;
+		     identifier_index++ )
+		{
+			node  = NULL;
+			entry = NULL;
+
+			if( libfsapfs_file_system_btree_get_entry_by_identifier(
+			     file_system_btree,
+			     file_io_handle,
+			     identifiers[ identifier_index ],
+			     LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+			     &node,
+			     &entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve inode entry for identifier: %" PRIu64 ".",
+				 function,
+				 identifiers[ identifier_index ] );
+
+				return( -1 );
+			}
+		}
+		if( fsapfs_benchmark_get_timestamp(
+		     &stop_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( run_index == 0 )
+		 || ( ( stop_timestamp - start_timestamp ) < *elapsed_time ) )
+		{
+			*elapsed_time = stop_timestamp - start_timestamp;
+		}
+	}
+	return( 1 );
+}
+
+/* Prints the number of lookups per second of a benchmark
+ */
+void fsapfs_benchmark_btree_print_lookups(
+      const char *name,
+      int number_of_lookups,
+      int64_t elapsed_time )
+{
+	double lookups_per_second = 0.0;
+
+	if( elapsed_time > 0 )
+	{
+		lookups_per_second = (double) number_of_lookups / ( (double) elapsed_time / 1000000000.0 );
+	}
+	fprintf(
+	 stdout,
+	 "%-32s %12d lookups %10.3f ms %14.1f lookups/s\n",
+	 name,
+	 number_of_lookups,
+	 (double) elapsed_time / 1000000.0,
+	 lookups_per_second );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Prints usage information
+ */
+void fsapfs_benchmark_btree_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fsapfs_benchmark_btree to determine the number of object map\n"
+	                 "and file system B-tree lookups per second of a volume.\n\n" );
+
+	fprintf( stream, "Usage: fsapfs_benchmark_btree [ -p password ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file that contains the container\n\n" );
+	fprintf( stream, "\t-p:     specify the password of the first volume\n" );
+	fprintf( stream, "\n" );
+	fprintf( stream, "Every object identifier in the object map and every inode of the\n"
+	                 "first volume is looked up from the B-tree root node %d times,\n"
+	                 "the fastest time is reported.\n",
+	         FSAPFS_BENCHMARK_BTREE_NUMBER_OF_RUNS );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_container_t *container             = NULL;
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	libfsapfs_btree_node_t *root_node            = NULL;
+	libfsapfs_volume_t *volume                   = NULL;
+	uint64_t *identifiers                        = NULL;
+	char *option_password                        = NULL;
+	char *source                                 = NULL;
+	int64_t elapsed_time                         = 0;
+	system_integer_t option                      = 0;
+	int maximum_number_of_identifiers            = 0;
+	int number_of_identifiers                    = 0;
+	int result                                   = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hp:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %s.\n",
+				 argv[ optind - 1 ] );
+
+				fsapfs_benchmark_btree_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				fsapfs_benchmark_btree_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_password = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		fsapfs_benchmark_btree_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	if( libfsapfs_container_initialize(
+	     &container,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create container.\n" );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_open(
+	     container,
+	     source,
+	     LIBFSAPFS_OPEN_READ,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open container: %s.\n",
+		 source );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_get_volume_by_index(
+	     container,
+	     0,
+	     &volume,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve volume: 0.\n" );
+
+		goto on_error;
+	}
+	if( option_password != NULL )
+	{
+		if( libfsapfs_volume_set_utf8_password(
+		     volume,
+		     (uint8_t *) option_password,
+		     narrow_string_length(
+		      option_password ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set password.\n" );
+
+			goto on_error;
+		}
+		if( libfsapfs_volume_unlock(
+		     volume,
+		     &error ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to unlock volume.\n" );
+
+			goto on_error;
+		}
+	}
+	result = libfsapfs_volume_is_locked(
+	          volume,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine if volume is locked.\n" );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Volume is locked.\n" );
+
+		goto on_error;
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( internal_volume->file_system == NULL )
+	{
+		if( libfsapfs_internal_volume_get_file_system(
+		     internal_volume,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine file system.\n" );
+
+			goto on_error;
+		}
+	}
+	if( libfsapfs_object_map_btree_get_root_node(
+	     internal_volume->object_map_btree,
+	     internal_volume->file_io_handle,
+	     internal_volume->object_map_btree->root_node_block_number,
+	     &root_node,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve object map B-tree root node.\n" );
+
+		goto on_error;
+	}
+	if( fsapfs_benchmark_btree_get_object_map_identifiers(
+	     internal_volume->object_map_btree,
+	     internal_volume->file_io_handle,
+	     root_node,
+	     0,
+	     &identifiers,
+	     &number_of_identifiers,
+	     &maximum_number_of_identifiers,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve object map identifiers.\n" );
+
+		goto on_error;
+	}
+	if( number_of_identifiers > 0 )
+	{
+		if( fsapfs_benchmark_btree_lookup_object_map(
+		     internal_volume->object_map_btree,
+		     internal_volume->file_io_handle,
+		     identifiers,
+		     number_of_identifiers,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to look up object map identifiers.\n" );
+
+			goto on_error;
+		}
+		fsapfs_benchmark_btree_print_lookups(
+		 "object map",
+		 number_of_identifiers,
+		 elapsed_time );
+	}
+	number_of_identifiers = 0;
+
+	if( fsapfs_benchmark_btree_get_file_system_identifiers(
+	     volume,
+	     &identifiers,
+	     &number_of_identifiers,
+	     &maximum_number_of_identifiers,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve file system identifiers.\n" );
+
+		goto on_error;
+	}
+	if( number_of_identifiers > 0 )
+	{
+		if( fsapfs_benchmark_btree_lookup_file_system(
+		     internal_volume->file_system->file_system_btree,
+		     internal_volume->file_io_handle,
+		     identifiers,
+		     number_of_identifiers,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to look up file system identifiers.\n" );
+
+			goto on_error;
+		}
+		fsapfs_benchmark_btree_print_lookups(
+		 "file system inodes",
+		 number_of_identifiers,
+		 elapsed_time );
+	}
+	memory_free(
+	 identifiers );
+
+	identifiers = NULL;
+
+	if( libfsapfs_volume_free(
+	     &volume,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free volume.\n" );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_close(
+	     container,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close container.\n" );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_free(
+	     &container,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free container.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( identifiers != NULL )
+	{
+		memory_free(
+		 identifiers );
+	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( container != NULL )
+	{
+		libfsapfs_container_free(
+		 &container,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "The B-tree lookup functions are not available.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,571 @@
+/*
+ * CRC-32C checksum and name hash benchmark program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_checksum.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_name_hash.h"
+
+/* The byte-at-a-time table lookup, which is used as the reference
+ */
+#define FSAPFS_BENCHMARK_CRC32_BACKEND_BYTEWISE		-1
+
+#define FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE	32
+#define FSAPFS_BENCHMARK_CRC32_NUMBER_OF_RUNS		3
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Retrieves the name of a CRC-32 backend
+ * Returns the name
+ */
+const char *fsapfs_benchmark_crc32_get_backend_name(
+             int backend )
+{
+	switch( backend )
+	{
+		case FSAPFS_BENCHMARK_CRC32_BACKEND_BYTEWISE:
+			return( "bytewise table" );
+
+		case LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SLICING_BY_8:
+			return( "slicing-by-8" );
+
+		case LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SSE4_2:
+			return( "SSE4.2" );
+
+		case LIBFSAPFS_CHECKSUM_CRC32_BACKEND_ARM:
+			return( "ARMv8 CRC32" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Updates a CRC-32 checksum a byte at a time
+ * Returns the updated checksum
+ */
+uint32_t fsapfs_benchmark_crc32_update_bytewise(
+          uint32_t checksum,
+          const uint8_t *buffer,
+          size_t size )
+{
+	size_t buffer_offset = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		checksum = libfsapfs_checksum_crc32_table[ 0 ][ ( checksum ^ buffer[ buffer_offset ] ) & 0x000000ffUL ] ^ ( checksum >> 8 );
+	}
+	return( checksum );
+}
+
+/* Calculates the CRC-32C checksum of the data with a backend
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_crc32_calculate_checksum(
+     int backend,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *checksum,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function   = "fsapfs_benchmark_crc32_calculate_checksum";
+	int64_t start_timestamp = 0;
+	int64_t stop_timestamp  = 0;
+	int run_index           = 0;
+
+	if( backend != FSAPFS_BENCHMARK_CRC32_BACKEND_BYTEWISE )
+	{
+		libfsapfs_checksum_crc32_backend = backend;
+	}
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_CRC32_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		if( fsapfs_benchmark_get_timestamp(
+		     &start_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( backend == FSAPFS_BENCHMARK_CRC32_BACKEND_BYTEWISE )
+		{
+			*checksum = fsapfs_benchmark_crc32_update_bytewise(
+			             0xffffffffUL,
+			             data,
+			             data_size );
+		}
+		else
+		{
+			*checksum = libfsapfs_checksum_update_crc32(
+			             0xffffffffUL,
+			             data,
+			             data_size );
+		}
+		if( fsapfs_benchmark_get_timestamp(
+		     &stop_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( run_index == 0 )
+		 || ( ( stop_timestamp - start_timestamp ) < *elapsed_time ) )
+		{
+			*elapsed_time = stop_timestamp - start_timestamp;
+		}
+	}
+	return( 1 );
+}
+
+/* Calculates the case folded name hashes of the names with a backend
+ * The names are stored at a fixed distance of FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE bytes
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_crc32_calculate_name_hashes(
+     int backend,
+     const uint8_t *names,
+     const size_t *name_lengths,
+     int number_of_names,
+     uint32_t *combined_name_hash,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function   = "fsapfs_benchmark_crc32_calculate_name_hashes";
+	int64_t start_timestamp = 0;
+	int64_t stop_timestamp  = 0;
+	uint32_t name_hash      = 0;
+	int name_index          = 0;
+	int run_index           = 0;
+
+	libfsapfs_checksum_crc32_backend = backend;
+
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_CRC32_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		*combined_name_hash = 0;
+
+		if( fsapfs_benchmark_get_timestamp(
+		     &start_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		for( name_index = 0;
+		     name_index < number_of_names;
+		     name_index++ )
+		{
+			if( libfsapfs_name_hash_calculate_from_utf8_string(
+			     &name_hash,
+			     &( names[ name_index * FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE ] ),
+			     name_lengths[ name_index ],
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to calculate name hash: %d.",
+				 function,
+				 name_index );
+
+				return( -1 );
+			}
+			*combined_name_hash ^= name_hash;
+		}
+		if( fsapfs_benchmark_get_timestamp(
+		     &stop_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( run_index == 0 )
+		 || ( ( stop_timestamp - start_timestamp ) < *elapsed_time ) )
+		{
+			*elapsed_time = stop_timestamp - start_timestamp;
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* Prints usage information
+ */
+void fsapfs_benchmark_crc32_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fsapfs_benchmark_crc32 to compare the CRC-32C checksum and\n"
+	                 "name hash throughput of the CRC-32 backends supported by the CPU.\n\n" );
+
+	fprintf( stream, "Usage: fsapfs_benchmark_crc32 [ -n names ] [ -s size ]\n\n" );
+
+	fprintf( stream, "\t-n:     specify the number of names to hash, the default is 100000\n" );
+	fprintf( stream, "\t-s:     specify the size of the checksummed data in MiB, the default is 64\n" );
+	fprintf( stream, "\n" );
+	fprintf( stream, "The checksums are compared with a byte-at-a-time table lookup and the\n"
+	                 "name hashes with slicing-by-8. The name hash throughput is that of\n"
+	                 "the UTF-8 names with case folding.\n" );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+	char name[ 32 ];
+	int backends[ 3 ];
+
+	libcerror_error_t *error           = NULL;
+	size_t *name_lengths               = NULL;
+	uint8_t *data                      = NULL;
+	uint8_t *names                     = NULL;
+	size_t data_offset                 = 0;
+	size_t data_size                   = 0;
+	size64_t names_size                = 0;
+	uint32_t checksum                  = 0;
+	uint32_t combined_name_hash        = 0;
+	uint32_t random_value              = 0x12345678UL;
+	uint32_t reference_checksum        = 0;
+	uint32_t reference_name_hash       = 0;
+	int64_t elapsed_time               = 0;
+	int64_t reference_elapsed_time     = 0;
+	system_integer_t option            = 0;
+	int backend_index                  = 0;
+	int data_size_in_mib               = 64;
+	int name_index                     = 0;
+	int number_of_backends             = 0;
+	int number_of_names                = 100000;
+	int supported_backend              = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hn:s:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %s.\n",
+				 argv[ optind - 1 ] );
+
+				fsapfs_benchmark_crc32_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				fsapfs_benchmark_crc32_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'n':
+				number_of_names = atoi(
+				                   optarg );
+
+				break;
+
+			case (system_integer_t) 's':
+				data_size_in_mib = atoi(
+				                    optarg );
+
+				break;
+		}
+	}
+	if( ( number_of_names < 1 )
+	 || ( number_of_names > 10000000 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported number of names: %d.\n",
+		 number_of_names );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( data_size_in_mib < 1 )
+	 || ( data_size_in_mib > 4096 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported size: %d.\n",
+		 data_size_in_mib );
+
+		return( EXIT_FAILURE );
+	}
+	data_size = (size_t) data_size_in_mib * 1024 * 1024;
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	names = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE * number_of_names );
+
+	name_lengths = (size_t *) memory_allocate(
+	                           sizeof( size_t ) * number_of_names );
+
+	if( ( data == NULL )
+	 || ( names == NULL )
+	 || ( name_lengths == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	/* Fill the data with pseudo random values using xorshift
+	 */
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		data[ data_offset ] = (uint8_t) random_value;
+	}
+	/* Every other name contains characters that are composed or case folded
+	 */
+	for( name_index = 0;
+	     name_index < number_of_names;
+	     name_index++ )
+	{
+		if( ( name_index % 2 ) == 0 )
+		{
+			name_lengths[ name_index ] = (size_t) snprintf(
+			                                       (char *) &( names[ name_index * FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE ] ),
+			                                       FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE,
+			                                       "document_%07d.txt",
+			                                       name_index );
+		}
+		else
+		{
+			name_lengths[ name_index ] = (size_t) snprintf(
+			                                       (char *) &( names[ name_index * FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE ] ),
+			                                       FSAPFS_BENCHMARK_CRC32_MAXIMUM_NAME_SIZE,
+			                                       "R\xc3\xa9sum\xc3\xa9 %07d.PDF",
+			                                       name_index );
+		}
+		names_size += name_lengths[ name_index ];
+	}
+	/* Initializing the table also selects the CRC-32C instructions if the CPU supports them
+	 */
+	libfsapfs_checksum_initialize_crc32_table(
+	 0x82f63b78UL );
+
+	supported_backend = libfsapfs_checksum_crc32_backend;
+
+	backends[ number_of_backends++ ] = FSAPFS_BENCHMARK_CRC32_BACKEND_BYTEWISE;
+	backends[ number_of_backends++ ] = LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SLICING_BY_8;
+
+	if( supported_backend != LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SLICING_BY_8 )
+	{
+		backends[ number_of_backends++ ] = supported_backend;
+	}
+	for( backend_index = 0;
+	     backend_index < number_of_backends;
+	     backend_index++ )
+	{
+		if( fsapfs_benchmark_crc32_calculate_checksum(
+		     backends[ backend_index ],
+		     data,
+		     data_size,
+		     &checksum,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( backend_index == 0 )
+		{
+			reference_checksum     = checksum;
+			reference_elapsed_time = elapsed_time;
+		}
+		else if( checksum != reference_checksum )
+		{
+			fprintf(
+			 stderr,
+			 "Checksum of backend: %s does not match.\n",
+			 fsapfs_benchmark_crc32_get_backend_name(
+			  backends[ backend_index ] ) );
+
+			goto on_error;
+		}
+		snprintf(
+		 name,
+		 32,
+		 "CRC-32C %s",
+		 fsapfs_benchmark_crc32_get_backend_name(
+		  backends[ backend_index ] ) );
+
+		fsapfs_benchmark_print_throughput(
+		 name,
+		 (size64_t) data_size,
+		 elapsed_time,
+		 reference_elapsed_time );
+	}
+	/* The name hash is only calculated with the library backends
+	 */
+	for( backend_index = 1;
+	     backend_index < number_of_backends;
+	     backend_index++ )
+	{
+		if( fsapfs_benchmark_crc32_calculate_name_hashes(
+		     backends[ backend_index ],
+		     names,
+		     name_lengths,
+		     number_of_names,
+		     &combined_name_hash,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( backend_index == 1 )
+		{
+			reference_name_hash    = combined_name_hash;
+			reference_elapsed_time = elapsed_time;
+		}
+		else if( combined_name_hash != reference_name_hash )
+		{
+			fprintf(
+			 stderr,
+			 "Name hashes of backend: %s do not match.\n",
+			 fsapfs_benchmark_crc32_get_backend_name(
+			  backends[ backend_index ] ) );
+
+			goto on_error;
+		}
+		snprintf(
+		 name,
+		 32,
+		 "name hash %s",
+		 fsapfs_benchmark_crc32_get_backend_name(
+		  backends[ backend_index ] ) );
+
+		fsapfs_benchmark_print_throughput(
+		 name,
+		 names_size,
+		 elapsed_time,
+		 reference_elapsed_time );
+	}
+	libfsapfs_checksum_crc32_backend = supported_backend;
+
+	memory_free(
+	 name_lengths );
+	memory_free(
+	 names );
+	memory_free(
+	 data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_lengths != NULL )
+	{
+		memory_free(
+		 name_lengths );
+	}
+	if( names != NULL )
+	{
+		memory_free(
+		 names );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "The checksum and name hash functions are not available.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,528 @@
+/*
+ * Deflate decompression benchmark program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_deflate.h"
+
+/* The size of the compressed blocks, which is that of decmpfs
+ */
+#define FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE		65536
+
+#define FSAPFS_BENCHMARK_DEFLATE_NUMBER_OF_RUNS		3
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && ( ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) )
+
+#define FSAPFS_BENCHMARK_DEFLATE_HAVE_ZLIB
+
+const char *fsapfs_benchmark_deflate_words[ 16 ] = {
+	"apple ", "block ", "container ", "data ", "extent ", "file ", "group ", "hash ",
+	"inode ", "journal ", "key ", "link ", "map ", "node ", "object ", "partition\n" };
+
+/* Fills data with text of pseudo randomly chosen words
+ */
+void fsapfs_benchmark_deflate_generate_text(
+      uint8_t *data,
+      size_t data_size )
+{
+	const char *word      = NULL;
+	size_t data_offset    = 0;
+	uint32_t random_value = 0x12345678UL;
+
+	while( data_offset < data_size )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		word = fsapfs_benchmark_deflate_words[ random_value % 16 ];
+
+		while( ( *word != 0 )
+		    && ( data_offset < data_size ) )
+		{
+			data[ data_offset++ ] = (uint8_t) *word++;
+		}
+	}
+}
+
+/* Decompresses the blocks with zlib or the built-in deflate implementation
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_deflate_decompress_blocks(
+     int use_zlib,
+     const uint8_t *compressed_data,
+     const size_t *compressed_block_offsets,
+     const size_t *compressed_block_sizes,
+     int number_of_blocks,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function           = "fsapfs_benchmark_deflate_decompress_blocks";
+	uLongf zlib_block_size          = 0;
+	size_t block_size               = 0;
+	size_t uncompressed_data_offset = 0;
+	int64_t start_timestamp         = 0;
+	int64_t stop_timestamp          = 0;
+	int block_index                 = 0;
+	int run_index                   = 0;
+
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_DEFLATE_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		uncompressed_data_offset = 0;
+
+		if( fsapfs_benchmark_get_timestamp(
+		     &start_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			block_size = uncompressed_data_size - uncompressed_data_offset;
+
+			if( block_size > FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE )
+			{
+				block_size = FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE;
+			}
+			if( use_zlib != 0 )
+			{
+				zlib_block_size = (uLongf) block_size;
+
+				if( uncompress(
+				     (Bytef *) &( uncompressed_data[ uncompressed_data_offset ] ),
+				     &zlib_block_size,
+				     (Bytef *) &( compressed_data[ compressed_block_offsets[ block_index ] ] ),
+				     (uLong) compressed_block_sizes[ block_index ] ) != Z_OK )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+					 "%s: unable to decompress block: %d with zlib.",
+					 function,
+					 block_index );
+
+					return( -1 );
+				}
+				block_size = (size_t) zlib_block_size;
+			}
+			else if( libfsapfs_deflate_decompress_zlib(
+			          &( compressed_data[ compressed_block_offsets[ block_index ] ] ),
+			          compressed_block_sizes[ block_index ],
+			          &( uncompressed_data[ uncompressed_data_offset ] ),
+			          &block_size,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to decompress block: %d.",
+				 function,
+				 block_index );
+
+				return( -1 );
+			}
+			uncompressed_data_offset += block_size;
+		}
+		if( fsapfs_benchmark_get_timestamp(
+		     &stop_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data_offset != uncompressed_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid uncompressed data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( run_index == 0 )
+		 || ( ( stop_timestamp - start_timestamp ) < *elapsed_time ) )
+		{
+			*elapsed_time = stop_timestamp - start_timestamp;
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && ( ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) ) */
+
+/* Prints usage information
+ */
+void fsapfs_benchmark_deflate_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fsapfs_benchmark_deflate to compare the throughput of the built-in\n"
+	                 "deflate decompression with that of zlib.\n\n" );
+
+	fprintf( stream, "Usage: fsapfs_benchmark_deflate [ -s size ] [ source ]\n\n" );
+
+	fprintf( stream, "\tsource: a file of which the content is compressed, the default\n"
+	                 "\t        is generated text\n\n" );
+	fprintf( stream, "\t-s:     specify the size of the generated text in MiB, the default is 16\n" );
+	fprintf( stream, "\n" );
+	fprintf( stream, "The data is compressed with zlib in blocks of %d bytes, like decmpfs\n"
+	                 "compressed data. The decompressed data is compared with the original data.\n",
+	         FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+#if defined( FSAPFS_BENCHMARK_DEFLATE_HAVE_ZLIB )
+	libcerror_error_t *error          = NULL;
+	size_t *compressed_block_offsets  = NULL;
+	size_t *compressed_block_sizes    = NULL;
+	uint8_t *compressed_data          = NULL;
+	uint8_t *data                     = NULL;
+	uint8_t *uncompressed_data        = NULL;
+	char *source                      = NULL;
+	uLongf zlib_compressed_block_size = 0;
+	size_t block_size                 = 0;
+	size_t compressed_data_offset     = 0;
+	size_t data_offset                = 0;
+	size_t data_size                  = 0;
+	size_t maximum_compressed_size    = 0;
+	int64_t elapsed_time              = 0;
+	int64_t reference_elapsed_time    = 0;
+	system_integer_t option           = 0;
+	int block_index                   = 0;
+	int data_size_in_mib              = 16;
+	int number_of_blocks              = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hs:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %s.\n",
+				 argv[ optind - 1 ] );
+
+				fsapfs_benchmark_deflate_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				fsapfs_benchmark_deflate_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 's':
+				data_size_in_mib = atoi(
+				                    optarg );
+
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+
+		if( fsapfs_benchmark_read_file(
+		     source,
+		     &data,
+		     &data_size ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read source file: %s.\n",
+			 source );
+
+			goto on_error;
+		}
+		if( data_size == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Empty source file: %s.\n",
+			 source );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( ( data_size_in_mib < 1 )
+		 || ( data_size_in_mib > 4096 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported size: %d.\n",
+			 data_size_in_mib );
+
+			return( EXIT_FAILURE );
+		}
+		data_size = (size_t) data_size_in_mib * 1024 * 1024;
+
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * data_size );
+
+		if( data == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create data.\n" );
+
+			goto on_error;
+		}
+		fsapfs_benchmark_deflate_generate_text(
+		 data,
+		 data_size );
+	}
+	number_of_blocks = (int) ( ( data_size + FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE - 1 ) / FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE );
+
+	maximum_compressed_size = (size_t) compressBound(
+	                                    (uLong) FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * maximum_compressed_size * number_of_blocks );
+
+	compressed_block_offsets = (size_t *) memory_allocate(
+	                                       sizeof( size_t ) * number_of_blocks );
+
+	compressed_block_sizes = (size_t *) memory_allocate(
+	                                     sizeof( size_t ) * number_of_blocks );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * data_size );
+
+	if( ( compressed_data == NULL )
+	 || ( compressed_block_offsets == NULL )
+	 || ( compressed_block_sizes == NULL )
+	 || ( uncompressed_data == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		block_size = data_size - data_offset;
+
+		if( block_size > FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE )
+		{
+			block_size = FSAPFS_BENCHMARK_DEFLATE_BLOCK_SIZE;
+		}
+		zlib_compressed_block_size = (uLongf) maximum_compressed_size;
+
+		if( compress2(
+		     (Bytef *) &( compressed_data[ compressed_data_offset ] ),
+		     &zlib_compressed_block_size,
+		     (Bytef *) &( data[ data_offset ] ),
+		     (uLong) block_size,
+		     Z_DEFAULT_COMPRESSION ) != Z_OK )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to compress block: %d.\n",
+			 block_index );
+
+			goto on_error;
+		}
+		compressed_block_offsets[ block_index ] = compressed_data_offset;
+		compressed_block_sizes[ block_index ]   = (size_t) zlib_compressed_block_size;
+
+		compressed_data_offset += (size_t) zlib_compressed_block_size;
+		data_offset            += block_size;
+	}
+	fprintf(
+	 stdout,
+	 "Compressed %" PRIzd " bytes into %" PRIzd " bytes in %d blocks.\n",
+	 data_size,
+	 compressed_data_offset,
+	 number_of_blocks );
+
+	if( fsapfs_benchmark_deflate_decompress_blocks(
+	     1,
+	     compressed_data,
+	     compressed_block_offsets,
+	     compressed_block_sizes,
+	     number_of_blocks,
+	     uncompressed_data,
+	     data_size,
+	     &reference_elapsed_time,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	fsapfs_benchmark_print_throughput(
+	 "zlib",
+	 (size64_t) data_size,
+	 reference_elapsed_time,
+	 reference_elapsed_time );
+
+	memory_set(
+	 uncompressed_data,
+	 0,
+	 data_size );
+
+	if( fsapfs_benchmark_deflate_decompress_blocks(
+	     0,
+	     compressed_data,
+	     compressed_block_offsets,
+	     compressed_block_sizes,
+	     number_of_blocks,
+	     uncompressed_data,
+	     data_size,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     uncompressed_data,
+	     data,
+	     data_size ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Decompressed data does not match the original data.\n" );
+
+		goto on_error;
+	}
+	fsapfs_benchmark_print_throughput(
+	 "built-in deflate",
+	 (size64_t) data_size,
+	 elapsed_time,
+	 reference_elapsed_time );
+
+	memory_free(
+	 uncompressed_data );
+	memory_free(
+	 compressed_block_sizes );
+	memory_free(
+	 compressed_block_offsets );
+	memory_free(
+	 compressed_data );
+	memory_free(
+	 data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_block_sizes != NULL )
+	{
+		memory_free(
+		 compressed_block_sizes );
+	}
+	if( compressed_block_offsets != NULL )
+	{
+		memory_free(
+		 compressed_block_offsets );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "Benchmarking deflate decompression requires zlib.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+}
+
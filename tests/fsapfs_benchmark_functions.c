@@ -0,0 +1,184 @@
+/*
+ * Functions for benchmarking
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+
+/* Retrieves a timestamp in nanoseconds, used to determine elapsed time
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_get_timestamp(
+     int64_t *timestamp )
+{
+#if defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+#endif
+
+	if( timestamp == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+#else
+	*timestamp = (int64_t) clock() * ( 1000000000 / CLOCKS_PER_SEC );
+#endif
+	return( 1 );
+}
+
+/* Prints the throughput of a benchmark
+ * The speedup is relative to the reference elapsed time, if not 0
+ */
+void fsapfs_benchmark_print_throughput(
+      const char *name,
+      size64_t size,
+      int64_t elapsed_time,
+      int64_t reference_elapsed_time )
+{
+	double mebibytes_per_second = 0.0;
+
+	if( elapsed_time > 0 )
+	{
+		mebibytes_per_second = ( (double) size / ( 1024.0 * 1024.0 ) ) / ( (double) elapsed_time / 1000000000.0 );
+	}
+	fprintf(
+	 stdout,
+	 "%-32s %12" PRIu64 " bytes %10.3f ms %10.1f MiB/s",
+	 name,
+	 size,
+	 (double) elapsed_time / 1000000.0,
+	 mebibytes_per_second );
+
+	if( ( reference_elapsed_time > 0 )
+	 && ( elapsed_time > 0 ) )
+	{
+		fprintf(
+		 stdout,
+		 " %6.2fx",
+		 (double) reference_elapsed_time / (double) elapsed_time );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Reads the entire content of a file
+ * The data is allocated and must be freed with memory_free
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_read_file(
+     const char *filename,
+     uint8_t **data,
+     size_t *data_size )
+{
+	FILE *file_stream        = NULL;
+	void *reallocation       = NULL;
+	size_t maximum_data_size = 0;
+	size_t read_count        = 0;
+
+	if( ( filename == NULL )
+	 || ( data == NULL )
+	 || ( data_size == NULL ) )
+	{
+		return( -1 );
+	}
+	*data      = NULL;
+	*data_size = 0;
+
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	do
+	{
+		if( *data_size >= maximum_data_size )
+		{
+			maximum_data_size += 1024 * 1024;
+
+			reallocation = memory_reallocate(
+			                *data,
+			                sizeof( uint8_t ) * maximum_data_size );
+
+			if( reallocation == NULL )
+			{
+				goto on_error;
+			}
+			*data = (uint8_t *) reallocation;
+		}
+		read_count = file_stream_read(
+		              file_stream,
+		              &( ( *data )[ *data_size ] ),
+		              maximum_data_size - *data_size );
+
+		*data_size += read_count;
+	}
+	while( read_count > 0 );
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( *data != NULL )
+	{
+		memory_free(
+		 *data );
+
+		*data = NULL;
+	}
+	*data_size = 0;
+
+	return( -1 );
+}
+
@@ -0,0 +1,51 @@
+/*
+ * Functions for benchmarking
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FSAPFS_BENCHMARK_FUNCTIONS_H )
+#define _FSAPFS_BENCHMARK_FUNCTIONS_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int fsapfs_benchmark_get_timestamp(
+     int64_t *timestamp );
+
+void fsapfs_benchmark_print_throughput(
+      const char *name,
+      size64_t size,
+      int64_t elapsed_time,
+      int64_t reference_elapsed_time );
+
+int fsapfs_benchmark_read_file(
+     const char *filename,
+     uint8_t **data,
+     size_t *data_size );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FSAPFS_BENCHMARK_FUNCTIONS_H ) */
+
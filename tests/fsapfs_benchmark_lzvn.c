@@ -0,0 +1,334 @@
+/*
+ * LZVN decompression benchmark program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_lzvn.h"
+
+/* The default maximum uncompressed size, which is the decmpfs block size
+ */
+#define FSAPFS_BENCHMARK_LZVN_UNCOMPRESSED_DATA_SIZE	65536
+
+#define FSAPFS_BENCHMARK_LZVN_NUMBER_OF_RUNS		16
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Decompresses a LZVN compressed stream
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_lzvn_decompress(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t maximum_uncompressed_data_size,
+     size_t *uncompressed_data_size,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function   = "fsapfs_benchmark_lzvn_decompress";
+	int64_t start_timestamp = 0;
+	int64_t stop_timestamp  = 0;
+	int run_index           = 0;
+
+	for( run_index = 0;
+	     run_index < FSAPFS_BENCHMARK_LZVN_NUMBER_OF_RUNS;
+	     run_index++ )
+	{
+		*uncompressed_data_size = maximum_uncompressed_data_size;
+
+		if( fsapfs_benchmark_get_timestamp(
+		     &start_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_lzvn_decompress(
+		     compressed_data,
+		     compressed_data_size,
+		     uncompressed_data,
+		     uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data.",
+			 function );
+
+			return( -1 );
+		}
+		if( fsapfs_benchmark_get_timestamp(
+		     &stop_timestamp ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( run_index == 0 )
+		 || ( ( stop_timestamp - start_timestamp ) < *elapsed_time ) )
+		{
+			*elapsed_time = stop_timestamp - start_timestamp;
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* Prints usage information
+ */
+void fsapfs_benchmark_lzvn_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fsapfs_benchmark_lzvn to determine the LZVN decompression\n"
+	                 "throughput of a corpus of LZVN compressed streams.\n\n" );
+
+	fprintf( stream, "Usage: fsapfs_benchmark_lzvn [ -u size ] source [ source ... ]\n\n" );
+
+	fprintf( stream, "\tsource: a file that contains a LZVN compressed stream, such as\n"
+	                 "\t        a block of a decmpfs compression type 7 or 8 file\n\n" );
+	fprintf( stream, "\t-u:     specify the maximum uncompressed size of a stream in bytes,\n"
+	                 "\t        the default is %d\n",
+	         FSAPFS_BENCHMARK_LZVN_UNCOMPRESSED_DATA_SIZE );
+	fprintf( stream, "\n" );
+	fprintf( stream, "Every stream is decompressed %d times, the fastest time is reported.\n"
+	                 "The throughput is that of the uncompressed data.\n",
+	         FSAPFS_BENCHMARK_LZVN_NUMBER_OF_RUNS );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+	libcerror_error_t *error              = NULL;
+	uint8_t *compressed_data              = NULL;
+	uint8_t *uncompressed_data            = NULL;
+	char *source                          = NULL;
+	size64_t total_uncompressed_data_size = 0;
+	size_t compressed_data_size           = 0;
+	size_t maximum_uncompressed_data_size = FSAPFS_BENCHMARK_LZVN_UNCOMPRESSED_DATA_SIZE;
+	size_t total_compressed_data_size     = 0;
+	size_t uncompressed_data_size         = 0;
+	int64_t elapsed_time                  = 0;
+	int64_t total_elapsed_time            = 0;
+	system_integer_t option               = 0;
+	int source_index                      = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hu:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %s.\n",
+				 argv[ optind - 1 ] );
+
+				fsapfs_benchmark_lzvn_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				fsapfs_benchmark_lzvn_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'u':
+				maximum_uncompressed_data_size = (size_t) strtoul(
+				                                           optarg,
+				                                           NULL,
+				                                           10 );
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		fsapfs_benchmark_lzvn_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( maximum_uncompressed_data_size == 0 )
+	 || ( maximum_uncompressed_data_size > (size_t) ( 256 * 1024 * 1024 ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported maximum uncompressed size: %" PRIzd ".\n",
+		 maximum_uncompressed_data_size );
+
+		return( EXIT_FAILURE );
+	}
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * maximum_uncompressed_data_size );
+
+	if( uncompressed_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create uncompressed data.\n" );
+
+		goto on_error;
+	}
+	for( source_index = optind;
+	     source_index < argc;
+	     source_index++ )
+	{
+		source = argv[ source_index ];
+
+		if( fsapfs_benchmark_read_file(
+		     source,
+		     &compressed_data,
+		     &compressed_data_size ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read source file: %s.\n",
+			 source );
+
+			goto on_error;
+		}
+		if( fsapfs_benchmark_lzvn_decompress(
+		     compressed_data,
+		     compressed_data_size,
+		     uncompressed_data,
+		     maximum_uncompressed_data_size,
+		     &uncompressed_data_size,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to decompress source file: %s.\n",
+			 source );
+
+			goto on_error;
+		}
+		memory_free(
+		 compressed_data );
+
+		compressed_data = NULL;
+
+		fsapfs_benchmark_print_throughput(
+		 source,
+		 (size64_t) uncompressed_data_size,
+		 elapsed_time,
+		 0 );
+
+		total_compressed_data_size   += compressed_data_size;
+		total_uncompressed_data_size += uncompressed_data_size;
+		total_elapsed_time           += elapsed_time;
+	}
+	if( ( argc - optind ) > 1 )
+	{
+		fsapfs_benchmark_print_throughput(
+		 "total",
+		 total_uncompressed_data_size,
+		 total_elapsed_time,
+		 0 );
+	}
+	fprintf(
+	 stdout,
+	 "Decompressed %" PRIzd " bytes into %" PRIu64 " bytes.\n",
+	 total_compressed_data_size,
+	 total_uncompressed_data_size );
+
+	memory_free(
+	 uncompressed_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "The LZVN decompression function is not available.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,803 @@
+/*
+ * Multi-threaded file entry read benchmark program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_PTHREAD )
+#include <pthread.h>
+#endif
+
+#include "fsapfs_benchmark_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_unused.h"
+
+#define FSAPFS_BENCHMARK_READ_BUFFER_SIZE		1024 * 1024
+#define FSAPFS_BENCHMARK_READ_MAXIMUM_NUMBER_OF_THREADS	64
+
+#if defined( HAVE_PTHREAD ) && defined( LIBFSAPFS_HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+typedef struct fsapfs_benchmark_read_thread fsapfs_benchmark_read_thread_t;
+
+struct fsapfs_benchmark_read_thread
+{
+	/* The file entries
+	 */
+	libfsapfs_file_entry_t **file_entries;
+
+	/* The number of file entries
+	 */
+	int number_of_file_entries;
+
+	/* The index of the first file entry read by the thread
+	 */
+	int first_file_entry_index;
+
+	/* The number of threads, which is the distance between the file entries read by the thread
+	 */
+	int number_of_threads;
+
+	/* The number of bytes read
+	 */
+	size64_t read_size;
+
+	/* The result
+	 */
+	int result;
+};
+
+/* Reads the data of every file entry assigned to a thread
+ * Sets the result of the thread to 1 if successful or -1 on error
+ */
+void *fsapfs_benchmark_read_thread_function(
+       void *arguments )
+{
+	fsapfs_benchmark_read_thread_t *thread = NULL;
+	libcerror_error_t *error               = NULL;
+	uint8_t *buffer                        = NULL;
+	size64_t file_size                     = 0;
+	ssize_t read_count                     = 0;
+	off64_t file_offset                    = 0;
+	int file_entry_index                   = 0;
+
+	thread = (fsapfs_benchmark_read_thread_t *) arguments;
+
+	thread->read_size = 0;
+	thread->result    = -1;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * FSAPFS_BENCHMARK_READ_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		return( NULL );
+	}
+	for( file_entry_index = thread->first_file_entry_index;
+	     file_entry_index < thread->number_of_file_entries;
+	     file_entry_index += thread->number_of_threads )
+	{
+		if( libfsapfs_file_entry_get_size(
+		     thread->file_entries[ file_entry_index ],
+		     &file_size,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		file_offset = 0;
+
+		while( (size64_t) file_offset < file_size )
+		{
+			read_count = libfsapfs_file_entry_read_buffer_at_offset(
+			              thread->file_entries[ file_entry_index ],
+			              buffer,
+			              FSAPFS_BENCHMARK_READ_BUFFER_SIZE,
+			              file_offset,
+			              &error );
+
+			if( read_count < 0 )
+			{
+				goto on_error;
+			}
+			else if( read_count == 0 )
+			{
+				break;
+			}
+			file_offset       += read_count;
+			thread->read_size += read_count;
+		}
+	}
+	thread->result = 1;
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	memory_free(
+	 buffer );
+
+	return( NULL );
+}
+
+/* Frees the file entries
+ */
+void fsapfs_benchmark_read_free_file_entries(
+      libfsapfs_file_entry_t ***file_entries,
+      int number_of_file_entries )
+{
+	int file_entry_index = 0;
+
+	if( *file_entries == NULL )
+	{
+		return;
+	}
+	for( file_entry_index = 0;
+	     file_entry_index < number_of_file_entries;
+	     file_entry_index++ )
+	{
+		libfsapfs_file_entry_free(
+		 &( ( *file_entries )[ file_entry_index ] ),
+		 NULL );
+	}
+	memory_free(
+	 *file_entries );
+
+	*file_entries = NULL;
+}
+
+/* Reads the regular files of the first volume in a container using multiple threads
+ * The container is opened with a file IO handle per thread
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_benchmark_read_volume(
+     const char *source,
+     const char *password,
+     int number_of_threads,
+     size64_t *read_size,
+     int64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	fsapfs_benchmark_read_thread_t threads[ FSAPFS_BENCHMARK_READ_MAXIMUM_NUMBER_OF_THREADS ];
+	pthread_t thread_identifiers[ FSAPFS_BENCHMARK_READ_MAXIMUM_NUMBER_OF_THREADS ];
+
+	libfsapfs_container_t *container                     = NULL;
+	libfsapfs_file_entry_t **file_entries                = NULL;
+	libfsapfs_file_entry_t *file_entry                   = NULL;
+	libfsapfs_file_entry_iterator_t *file_entry_iterator = NULL;
+	libfsapfs_volume_t *volume                           = NULL;
+	void *reallocation                                   = NULL;
+	static char *function                                = "fsapfs_benchmark_read_volume";
+	size64_t file_size                                   = 0;
+	int64_t start_timestamp                              = 0;
+	int64_t stop_timestamp                               = 0;
+	uint16_t file_mode                                   = 0;
+	int maximum_number_of_file_entries                   = 0;
+	int number_of_file_entries                           = 0;
+	int number_of_threads_created                        = 0;
+	int result                                           = 0;
+	int thread_index                                     = 0;
+
+	if( libfsapfs_container_initialize(
+	     &container,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create container.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_set_number_of_file_io_handles(
+	     container,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_open(
+	     container,
+	     source,
+	     LIBFSAPFS_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open container: %s.",
+		 function,
+		 source );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_get_volume_by_index(
+	     container,
+	     0,
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( password != NULL )
+	{
+		if( libfsapfs_volume_set_utf8_password(
+		     volume,
+		     (uint8_t *) password,
+		     narrow_string_length(
+		      password ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set password.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_volume_unlock(
+		     volume,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unlock volume.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	result = libfsapfs_volume_is_locked(
+	          volume,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume is locked.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: volume is locked.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_volume_get_file_entry_iterator(
+	     volume,
+	     &file_entry_iterator,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libfsapfs_file_entry_iterator_get_next_file_entry(
+		          file_entry_iterator,
+		          &file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next file entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfsapfs_file_entry_get_file_mode(
+		     file_entry,
+		     &file_mode,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file mode.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_entry_get_size(
+		     file_entry,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size.",
+			 function );
+
+			goto on_error;
+		}
+		/* Only regular files that contain data are read
+		 */
+		if( ( ( file_mode & 0xf000 ) != 0x8000 )
+		 || ( file_size == 0 ) )
+		{
+			if( libfsapfs_file_entry_free(
+			     &file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file entry.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( number_of_file_entries >= maximum_number_of_file_entries )
+		{
+			maximum_number_of_file_entries += 1024;
+
+			reallocation = memory_reallocate(
+			                file_entries,
+			                sizeof( libfsapfs_file_entry_t * ) * maximum_number_of_file_entries );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize file entries.",
+				 function );
+
+				goto on_error;
+			}
+			file_entries = (libfsapfs_file_entry_t **) reallocation;
+		}
+		file_entries[ number_of_file_entries++ ] = file_entry;
+
+		file_entry = NULL;
+	}
+	while( result == 1 );
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		threads[ thread_index ].file_entries           = file_entries;
+		threads[ thread_index ].number_of_file_entries = number_of_file_entries;
+		threads[ thread_index ].first_file_entry_index = thread_index;
+		threads[ thread_index ].number_of_threads      = number_of_threads;
+		threads[ thread_index ].read_size              = 0;
+		threads[ thread_index ].result                 = 0;
+	}
+	if( fsapfs_benchmark_get_timestamp(
+	     &start_timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( pthread_create(
+		     &( thread_identifiers[ thread_index ] ),
+		     NULL,
+		     &fsapfs_benchmark_read_thread_function,
+		     &( threads[ thread_index ] ) ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+		number_of_threads_created++;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		pthread_join(
+		 thread_identifiers[ thread_index ],
+		 NULL );
+	}
+	number_of_threads_created = 0;
+
+	if( fsapfs_benchmark_get_timestamp(
+	     &stop_timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	*read_size    = 0;
+	*elapsed_time = stop_timestamp - start_timestamp;
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file entries in thread: %d.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+		*read_size += threads[ thread_index ].read_size;
+	}
+	fsapfs_benchmark_read_free_file_entries(
+	 &file_entries,
+	 number_of_file_entries );
+
+	if( libfsapfs_file_entry_iterator_free(
+	     &file_entry_iterator,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry iterator.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_volume_free(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_close(
+	     container,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close container.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_container_free(
+	     &container,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free container.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	for( thread_index = 0;
+	     thread_index < number_of_threads_created;
+	     thread_index++ )
+	{
+		pthread_join(
+		 thread_identifiers[ thread_index ],
+		 NULL );
+	}
+	if( file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	fsapfs_benchmark_read_free_file_entries(
+	 &file_entries,
+	 number_of_file_entries );
+
+	if( file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( container != NULL )
+	{
+		libfsapfs_container_free(
+		 &container,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_PTHREAD ) && defined( LIBFSAPFS_HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Prints usage information
+ */
+void fsapfs_benchmark_read_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fsapfs_benchmark_read to determine how reading the files of\n"
+	                 "a volume scales with the number of threads.\n\n" );
+
+	fprintf( stream, "Usage: fsapfs_benchmark_read [ -p password ] [ -t threads ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file that contains the container\n\n" );
+	fprintf( stream, "\t-p:     specify the password of the first volume\n" );
+	fprintf( stream, "\t-t:     specify the maximum number of threads, the default is 4\n" );
+	fprintf( stream, "\n" );
+	fprintf( stream, "The files are read once before the timed runs, so that every run\n"
+	                 "reads from the same state of the operating system cache.\n" );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+#if defined( HAVE_PTHREAD ) && defined( LIBFSAPFS_HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	char name[ 32 ];
+
+	libcerror_error_t *error       = NULL;
+	char *option_password          = NULL;
+	char *source                   = NULL;
+	size64_t read_size             = 0;
+	int64_t elapsed_time           = 0;
+	int64_t reference_elapsed_time = 0;
+	system_integer_t option        = 0;
+	int maximum_number_of_threads  = 4;
+	int number_of_threads          = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hp:t:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %s.\n",
+				 argv[ optind - 1 ] );
+
+				fsapfs_benchmark_read_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				fsapfs_benchmark_read_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_password = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				maximum_number_of_threads = atoi(
+				                             optarg );
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		fsapfs_benchmark_read_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	if( ( maximum_number_of_threads < 1 )
+	 || ( maximum_number_of_threads > FSAPFS_BENCHMARK_READ_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported maximum number of threads: %d.\n",
+		 maximum_number_of_threads );
+
+		return( EXIT_FAILURE );
+	}
+	if( fsapfs_benchmark_read_volume(
+	     source,
+	     option_password,
+	     maximum_number_of_threads,
+	     &read_size,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	number_of_threads = 1;
+
+	while( number_of_threads <= maximum_number_of_threads )
+	{
+		if( fsapfs_benchmark_read_volume(
+		     source,
+		     option_password,
+		     number_of_threads,
+		     &read_size,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( number_of_threads == 1 )
+		{
+			reference_elapsed_time = elapsed_time;
+		}
+		snprintf(
+		 name,
+		 32,
+		 "%d thread(s)",
+		 number_of_threads );
+
+		fsapfs_benchmark_print_throughput(
+		 name,
+		 read_size,
+		 elapsed_time,
+		 reference_elapsed_time );
+
+		if( number_of_threads == maximum_number_of_threads )
+		{
+			break;
+		}
+		number_of_threads *= 2;
+
+		if( number_of_threads > maximum_number_of_threads )
+		{
+			number_of_threads = maximum_number_of_threads;
+		}
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "Multi-threaded reads are not supported.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+}
+
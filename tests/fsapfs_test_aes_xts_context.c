@@ -0,0 +1,748 @@
+/*
+ * Library aes_xts_context type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_aes_xts_context.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* IEEE P1619 XTS-AES-128 test vector 1 ciphertext
+ */
+uint8_t fsapfs_test_aes_xts_context_vector1_encrypted_data[ 32 ] = {
+	0x91, 0x7c, 0xf6, 0x9e, 0xbd, 0x68, 0xb2, 0xec,
+	0x9b, 0x9f, 0xe9, 0xa3, 0xea, 0xdd, 0xa6, 0x92,
+	0xcd, 0x43, 0xd2, 0xf5, 0x95, 0x98, 0xed, 0x85,
+	0x8c, 0x02, 0xc2, 0x65, 0x2f, 0xbf, 0x92, 0x2e };
+
+/* IEEE P1619 XTS-AES-128 test vector 2 ciphertext
+ */
+uint8_t fsapfs_test_aes_xts_context_vector2_encrypted_data[ 32 ] = {
+	0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e,
+	0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+	0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4,
+	0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0 };
+
+/* Tests the libfsapfs_aes_xts_context_get_fallback_backend function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_xts_context_get_fallback_backend(
+     void )
+{
+	int backend = 0;
+
+	backend = libfsapfs_aes_xts_context_get_fallback_backend(
+	           LIBFSAPFS_AES_XTS_BACKEND_VAES );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBFSAPFS_AES_XTS_BACKEND_AES_NI );
+
+	backend = libfsapfs_aes_xts_context_get_fallback_backend(
+	           LIBFSAPFS_AES_XTS_BACKEND_AES_NI );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBFSAPFS_AES_XTS_BACKEND_NONE );
+
+	backend = libfsapfs_aes_xts_context_get_fallback_backend(
+	           LIBFSAPFS_AES_XTS_BACKEND_ARMV8_CRYPTO );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBFSAPFS_AES_XTS_BACKEND_NONE );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfsapfs_aes_xts_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_xts_context_initialize(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_aes_xts_context_t *aes_xts_context = NULL;
+	int backend                                  = 0;
+	int result                                   = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests              = 1;
+	int number_of_memset_fail_tests              = 1;
+	int test_number                              = 0;
+#endif
+
+	backend = libfsapfs_aes_xts_context_get_supported_backend();
+
+	/* Test regular cases
+	 */
+	if( backend != LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	{
+		result = libfsapfs_aes_xts_context_initialize(
+		          &aes_xts_context,
+		          backend,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "aes_xts_context",
+		 aes_xts_context );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsapfs_aes_xts_context_free(
+		          &aes_xts_context,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "aes_xts_context",
+		 aes_xts_context );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libfsapfs_aes_xts_context_initialize(
+	          NULL,
+	          backend,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	aes_xts_context = (libfsapfs_aes_xts_context_t *) 0x12345678UL;
+
+	result = libfsapfs_aes_xts_context_initialize(
+	          &aes_xts_context,
+	          backend,
+	          &error );
+
+	aes_xts_context = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_xts_context_initialize(
+	          &aes_xts_context,
+	          LIBFSAPFS_AES_XTS_BACKEND_NONE,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "aes_xts_context",
+	 aes_xts_context );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	if( backend != LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	{
+		for( test_number = 0;
+		     test_number < number_of_malloc_fail_tests;
+		     test_number++ )
+		{
+			/* Test libfsapfs_aes_xts_context_initialize with malloc failing
+			 */
+			fsapfs_test_malloc_attempts_before_fail = test_number;
+
+			result = libfsapfs_aes_xts_context_initialize(
+			          &aes_xts_context,
+			          backend,
+			          &error );
+
+			if( fsapfs_test_malloc_attempts_before_fail != -1 )
+			{
+				fsapfs_test_malloc_attempts_before_fail = -1;
+
+				if( aes_xts_context != NULL )
+				{
+					libfsapfs_aes_xts_context_free(
+					 &aes_xts_context,
+					 NULL );
+				}
+			}
+			else
+			{
+				FSAPFS_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 -1 );
+
+				FSAPFS_TEST_ASSERT_IS_NULL(
+				 "aes_xts_context",
+				 aes_xts_context );
+
+				FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+				 "error",
+				 error );
+
+				libcerror_error_free(
+				 &error );
+			}
+		}
+		for( test_number = 0;
+		     test_number < number_of_memset_fail_tests;
+		     test_number++ )
+		{
+			/* Test libfsapfs_aes_xts_context_initialize with memset failing
+			 */
+			fsapfs_test_memset_attempts_before_fail = test_number;
+
+			result = libfsapfs_aes_xts_context_initialize(
+			          &aes_xts_context,
+			          backend,
+			          &error );
+
+			if( fsapfs_test_memset_attempts_before_fail != -1 )
+			{
+				fsapfs_test_memset_attempts_before_fail = -1;
+
+				if( aes_xts_context != NULL )
+				{
+					libfsapfs_aes_xts_context_free(
+					 &aes_xts_context,
+					 NULL );
+				}
+			}
+			else
+			{
+				FSAPFS_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 -1 );
+
+				FSAPFS_TEST_ASSERT_IS_NULL(
+				 "aes_xts_context",
+				 aes_xts_context );
+
+				FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+				 "error",
+				 error );
+
+				libcerror_error_free(
+				 &error );
+			}
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( aes_xts_context != NULL )
+	{
+		libfsapfs_aes_xts_context_free(
+		 &aes_xts_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_aes_xts_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_xts_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_aes_xts_context_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_aes_xts_context_decrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_xts_context_decrypt(
+     libfsapfs_aes_xts_context_t *aes_xts_context )
+{
+	uint8_t data[ 32 ];
+	uint8_t key[ 16 ];
+	uint8_t tweak_key[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases with IEEE P1619 test vector 1
+	 */
+	result = memory_set(
+	          key,
+	          0,
+	          16 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          tweak_key,
+	          0,
+	          16 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsapfs_aes_xts_context_set_keys(
+	          aes_xts_context,
+	          key,
+	          tweak_key,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_aes_xts_context_decrypt(
+	          aes_xts_context,
+	          fsapfs_test_aes_xts_context_vector1_encrypted_data,
+	          32,
+	          data,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( result = 0;
+	     result < 32;
+	     result++ )
+	{
+		if( data[ result ] != 0 )
+		{
+			break;
+		}
+	}
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 32 );
+
+	/* Test regular cases with IEEE P1619 test vector 2
+	 */
+	result = memory_set(
+	          key,
+	          0x11,
+	          16 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          tweak_key,
+	          0x22,
+	          16 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsapfs_aes_xts_context_set_keys(
+	          aes_xts_context,
+	          key,
+	          tweak_key,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_aes_xts_context_decrypt(
+	          aes_xts_context,
+	          fsapfs_test_aes_xts_context_vector2_encrypted_data,
+	          32,
+	          data,
+	          0x3333333333ULL,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( result = 0;
+	     result < 32;
+	     result++ )
+	{
+		if( data[ result ] != 0x44 )
+		{
+			break;
+		}
+	}
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 32 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_aes_xts_context_decrypt(
+	          NULL,
+	          fsapfs_test_aes_xts_context_vector2_encrypted_data,
+	          32,
+	          data,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_xts_context_decrypt(
+	          aes_xts_context,
+	          NULL,
+	          32,
+	          data,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_xts_context_decrypt(
+	          aes_xts_context,
+	          fsapfs_test_aes_xts_context_vector2_encrypted_data,
+	          32,
+	          NULL,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_xts_context_decrypt(
+	          aes_xts_context,
+	          fsapfs_test_aes_xts_context_vector2_encrypted_data,
+	          32,
+	          data,
+	          0,
+	          24,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_xts_context_decrypt(
+	          aes_xts_context,
+	          fsapfs_test_aes_xts_context_vector2_encrypted_data,
+	          24,
+	          data,
+	          0,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_aes_xts_context_t *aes_xts_context = NULL;
+	int backend                                  = 0;
+	int result                                   = 0;
+#endif
+
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_xts_context_get_fallback_backend",
+	 fsapfs_test_aes_xts_context_get_fallback_backend );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_xts_context_initialize",
+	 fsapfs_test_aes_xts_context_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_xts_context_free",
+	 fsapfs_test_aes_xts_context_free );
+
+	/* TODO: add tests for libfsapfs_aes_xts_context_set_keys */
+
+	backend = libfsapfs_aes_xts_context_get_supported_backend();
+
+	while( backend != LIBFSAPFS_AES_XTS_BACKEND_NONE )
+	{
+		/* Initialize test
+		 */
+		result = libfsapfs_aes_xts_context_initialize(
+		          &aes_xts_context,
+		          backend,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "aes_xts_context",
+		 aes_xts_context );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSAPFS_TEST_RUN_WITH_ARGS(
+		 "libfsapfs_aes_xts_context_decrypt",
+		 fsapfs_test_aes_xts_context_decrypt,
+		 aes_xts_context );
+
+		/* Clean up
+		 */
+		result = libfsapfs_aes_xts_context_free(
+		          &aes_xts_context,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "aes_xts_context",
+		 aes_xts_context );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Also test the slower backends the CPU supports
+		 */
+		backend = libfsapfs_aes_xts_context_get_fallback_backend(
+		           backend );
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( aes_xts_context != NULL )
+	{
+		libfsapfs_aes_xts_context_free(
+		 &aes_xts_context,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+}
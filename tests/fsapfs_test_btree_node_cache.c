@@ -0,0 +1,1181 @@
+/*
+ * Library btree_node_cache type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcdata.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_btree_node.h"
+#include "../libfsapfs/libfsapfs_btree_node_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_btree_node_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_btree_node_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libfsapfs_btree_node_cache_t *node_cache = NULL;
+	int result                               = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests          = 2;
+	int number_of_memset_fail_tests          = 2;
+	int test_number                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_btree_node_cache_initialize(
+	          &node_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The number of sets is at least the number of shards
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "node_cache->number_of_sets",
+	 node_cache->number_of_sets,
+	 LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS );
+
+	result = libfsapfs_btree_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_btree_node_cache_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	node_cache = (libfsapfs_btree_node_cache_t *) 0x12345678UL;
+
+	result = libfsapfs_btree_node_cache_initialize(
+	          &node_cache,
+	          4,
+	          &error );
+
+	node_cache = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_initialize(
+	          &node_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_btree_node_cache_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_btree_node_cache_initialize(
+		          &node_cache,
+		          4,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( node_cache != NULL )
+			{
+				libfsapfs_btree_node_cache_free(
+				 &node_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "node_cache",
+			 node_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_btree_node_cache_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_btree_node_cache_initialize(
+		          &node_cache,
+		          4,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( node_cache != NULL )
+			{
+				libfsapfs_btree_node_cache_free(
+				 &node_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "node_cache",
+			 node_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_btree_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_btree_node_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_btree_node_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_btree_node_cache_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_btree_node_cache_get_node and libfsapfs_btree_node_cache_set_node functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_btree_node_cache_get_and_set_node(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libfsapfs_btree_node_cache_t *node_cache = NULL;
+	libfsapfs_btree_node_t *cached_node      = NULL;
+	libfsapfs_btree_node_t *node             = NULL;
+	libfsapfs_btree_node_t *other_node       = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_btree_node_cache_initialize(
+	          &node_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_btree_node_cache_get_node(
+	          node_cache,
+	          100,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	other_node = node;
+
+	result = libfsapfs_btree_node_cache_set_node(
+	          node_cache,
+	          100,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "node",
+	 (intptr_t) node,
+	 (intptr_t) other_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The cache has taken over the ownership of the node
+	 */
+	node = NULL;
+
+	result = libfsapfs_btree_node_cache_get_node(
+	          node_cache,
+	          100,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "cached_node",
+	 (intptr_t) cached_node,
+	 (intptr_t) other_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_cache_get_node(
+	          node_cache,
+	          101,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Setting a node of a block number that is already cached returns the cached node
+	 */
+	result = libfsapfs_btree_node_initialize(
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_cache_set_node(
+	          node_cache,
+	          100,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "node",
+	 (intptr_t) node,
+	 (intptr_t) other_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	node = NULL;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_btree_node_cache_get_node(
+	          NULL,
+	          100,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_get_node(
+	          node_cache,
+	          100,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_set_node(
+	          NULL,
+	          100,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_set_node(
+	          node_cache,
+	          100,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_set_node(
+	          node_cache,
+	          100,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_btree_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &node,
+		 NULL );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_btree_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_btree_node_cache_begin_access and libfsapfs_btree_node_cache_end_access functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_btree_node_cache_begin_and_end_access(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libfsapfs_btree_node_cache_t *node_cache = NULL;
+	libfsapfs_btree_node_t *cached_node      = NULL;
+	libfsapfs_btree_node_t *first_node       = NULL;
+	libfsapfs_btree_node_t *node             = NULL;
+	uint64_t block_numbers[ LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS + 1 ];
+	uint64_t block_number                    = 0;
+	uint32_t set_index                       = 0;
+	int access_epoch                         = 0;
+	int block_index                          = 0;
+	int number_of_entries                    = 0;
+	int result                               = 0;
+	int shard_index                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_btree_node_cache_initialize(
+	          &node_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Determine block numbers that map onto the same set
+	 */
+	set_index = (uint32_t) ( ( 1 * 0x9e3779b97f4a7c15UL ) >> 32 ) & ( node_cache->number_of_sets - 1 );
+
+	for( block_number = 1;
+	     block_index <= LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS;
+	     block_number++ )
+	{
+		if( ( (uint32_t) ( ( block_number * 0x9e3779b97f4a7c15UL ) >> 32 ) & ( node_cache->number_of_sets - 1 ) ) == set_index )
+		{
+			block_numbers[ block_index++ ] = block_number;
+		}
+	}
+	/* Test regular cases
+	 */
+	result = libfsapfs_btree_node_cache_begin_access(
+	          node_cache,
+	          &access_epoch,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The access is counted in the shard assigned to the thread
+	 */
+	shard_index = libfsapfs_btree_node_cache_get_thread_shard_index();
+
+	FSAPFS_TEST_ASSERT_GREATER_THAN_INT(
+	 "shard_index",
+	 shard_index,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_LESS_THAN_INT(
+	 "shard_index",
+	 shard_index,
+	 LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_SHARDS );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node_cache->shards[ shard_index ].number_of_accesses[ access_epoch ]",
+	 node_cache->shards[ shard_index ].number_of_accesses[ access_epoch ],
+	 1 );
+
+	for( block_index = 0;
+	     block_index <= LIBFSAPFS_BTREE_NODE_CACHE_NUMBER_OF_WAYS;
+	     block_index++ )
+	{
+		result = libfsapfs_btree_node_initialize(
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( block_index == 0 )
+		{
+			first_node = node;
+		}
+		result = libfsapfs_btree_node_cache_set_node(
+		          node_cache,
+		          block_numbers[ block_index ],
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		node = NULL;
+	}
+	/* The oldest node of the set was replaced but is retained while the access has not ended
+	 */
+	result = libfsapfs_btree_node_cache_get_node(
+	          node_cache,
+	          block_numbers[ 0 ],
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          node_cache->retired_nodes[ access_epoch ],
+	          &number_of_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_entry_by_index(
+	          node_cache->retired_nodes[ access_epoch ],
+	          0,
+	          (intptr_t **) &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "cached_node",
+	 (intptr_t) cached_node,
+	 (intptr_t) first_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Accesses that begin after a node was retired use a new access epoch
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node_cache->access_epoch",
+	 node_cache->access_epoch,
+	 1 - access_epoch );
+
+	result = libfsapfs_btree_node_cache_end_access(
+	          node_cache,
+	          access_epoch,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The retired node is freed once the access has ended
+	 */
+	result = libcdata_array_get_number_of_entries(
+	          node_cache->retired_nodes[ access_epoch ],
+	          &number_of_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_btree_node_cache_begin_access(
+	          NULL,
+	          &access_epoch,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_begin_access(
+	          node_cache,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_end_access(
+	          NULL,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_end_access(
+	          node_cache,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfsapfs_btree_node_cache_end_access without a corresponding access
+	 */
+	result = libfsapfs_btree_node_cache_end_access(
+	          node_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_btree_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &node,
+		 NULL );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_btree_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_btree_node_cache_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_btree_node_cache_resize(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libfsapfs_btree_node_cache_t *node_cache = NULL;
+	libfsapfs_btree_node_t *cached_node      = NULL;
+	libfsapfs_btree_node_t *node             = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_btree_node_cache_initialize(
+	          &node_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_cache_set_node(
+	          node_cache,
+	          100,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	node = NULL;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_btree_node_cache_resize(
+	          node_cache,
+	          1000,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The number of sets is rounded down to a power of 2
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "node_cache->number_of_sets",
+	 node_cache->number_of_sets,
+	 128 );
+
+	/* The cached nodes are retired
+	 */
+	result = libfsapfs_btree_node_cache_get_node(
+	          node_cache,
+	          100,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_btree_node_cache_resize(
+	          NULL,
+	          1000,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_cache_resize(
+	          node_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_btree_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &node,
+		 NULL );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_btree_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_btree_node_cache_initialize",
+	 fsapfs_test_btree_node_cache_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_btree_node_cache_free",
+	 fsapfs_test_btree_node_cache_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_btree_node_cache_resize",
+	 fsapfs_test_btree_node_cache_resize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_btree_node_cache_get_and_set_node",
+	 fsapfs_test_btree_node_cache_get_and_set_node );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_btree_node_cache_begin_and_end_access",
+	 fsapfs_test_btree_node_cache_begin_and_end_access );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,6 +34,7 @@
 #include "fsapfs_test_unused.h"
 
 #include "../libfsapfs/libfsapfs_checksum.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
@@ -158,6 +160,324 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_checksum_update_crc32 function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_checksum_update_crc32(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	size_t byte_index          = 0;
+	size_t data_offset         = 0;
+	size_t data_size           = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	int backend                = 0;
+	int bit_index              = 0;
+
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( ( data_offset * 167 ) + 13 );
+	}
+	libfsapfs_checksum_initialize_crc32_table(
+	 0x82f63b78UL );
+
+	backend = libfsapfs_checksum_crc32_backend;
+
+	/* Test regular cases
+	 */
+	checksum = libfsapfs_checksum_update_crc32(
+	            0xffffffffUL,
+	            (uint8_t *) "123456789",
+	            9 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x1cf96d7cUL );
+
+	/* Test the accelerated and slicing-by-8 calculations against a bitwise calculation
+	 * with different alignments and sizes
+	 */
+	for( data_offset = 0;
+	     data_offset < 16;
+	     data_offset++ )
+	{
+		for( data_size = 0;
+		     data_size < ( 1024 - 16 );
+		     data_size += 1 + ( data_size / 8 ) )
+		{
+			expected_checksum = 0xffffffffUL;
+
+			for( byte_index = 0;
+			     byte_index < data_size;
+			     byte_index++ )
+			{
+				expected_checksum ^= data[ data_offset + byte_index ];
+
+				for( bit_index = 0;
+				     bit_index < 8;
+				     bit_index++ )
+				{
+					if( ( expected_checksum & 1 ) != 0 )
+					{
+						expected_checksum = 0x82f63b78UL ^ ( expected_checksum >> 1 );
+					}
+					else
+					{
+						expected_checksum = expected_checksum >> 1;
+					}
+				}
+			}
+			libfsapfs_checksum_crc32_backend = backend;
+
+			checksum = libfsapfs_checksum_update_crc32(
+			            0xffffffffUL,
+			            &( data[ data_offset ] ),
+			            data_size );
+
+			FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+
+			libfsapfs_checksum_crc32_backend = LIBFSAPFS_CHECKSUM_CRC32_BACKEND_SLICING_BY_8;
+
+			checksum = libfsapfs_checksum_update_crc32(
+			            0xffffffffUL,
+			            &( data[ data_offset ] ),
+			            data_size );
+
+			FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+		}
+	}
+	libfsapfs_checksum_crc32_backend = backend;
+
+	return( 1 );
+
+on_error:
+	libfsapfs_checksum_crc32_backend = backend;
+
+	return( 0 );
+}
+
+/* Tests the libfsapfs_checksum_calculate_fletcher64 function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_checksum_calculate_fletcher64(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	uint8_t *data              = NULL;
+	size_t data_offset         = 0;
+	size_t data_size           = 0;
+	uint64_t checksum          = 0;
+	uint64_t expected_checksum = 0;
+	int backend                = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * ( 320 * 1024 ) );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_offset = 0;
+	     data_offset < ( 320 * 1024 );
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( ( data_offset * 167 ) + 13 );
+	}
+	libfsapfs_checksum_initialize_fletcher64_backend();
+
+	backend = libfsapfs_checksum_fletcher64_backend;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_checksum_calculate_fletcher64(
+	          &checksum,
+	          data,
+	          1024,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "checksum",
+	 checksum,
+	 (uint64_t) 0xd77bf497a7058be7ULL );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the vectorized calculation against the scalar calculation
+	 * with different alignments and sizes, including sizes that span multiple chunks
+	 */
+	for( data_offset = 0;
+	     data_offset < 16;
+	     data_offset += 4 )
+	{
+		for( data_size = 0;
+		     data_size < ( 316 * 1024 );
+		     data_size += 4 + ( ( data_size / 64 ) & ~( (size_t) 3 ) ) )
+		{
+			libfsapfs_checksum_fletcher64_backend = LIBFSAPFS_CHECKSUM_FLETCHER64_BACKEND_SCALAR;
+
+			result = libfsapfs_checksum_calculate_fletcher64(
+			          &expected_checksum,
+			          &( data[ data_offset ] ),
+			          data_size,
+			          0,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			libfsapfs_checksum_fletcher64_backend = backend;
+
+			result = libfsapfs_checksum_calculate_fletcher64(
+			          &checksum,
+			          &( data[ data_offset ] ),
+			          data_size,
+			          0,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libfsapfs_checksum_calculate_fletcher64(
+	          NULL,
+	          data,
+	          1024,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_checksum_calculate_fletcher64(
+	          &checksum,
+	          NULL,
+	          1024,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_checksum_calculate_fletcher64(
+	          &checksum,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_checksum_calculate_fletcher64(
+	          &checksum,
+	          data,
+	          1023,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	libfsapfs_checksum_fletcher64_backend = backend;
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -181,10 +501,18 @@ int main(
 	 "libfsapfs_checksum_initialize_crc32_table",
 	 fsapfs_test_checksum_initialize_crc32_table );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_checksum_update_crc32",
+	 fsapfs_test_checksum_update_crc32 );
+
 	FSAPFS_TEST_RUN(
 	 "libfsapfs_checksum_calculate_weak_crc32",
 	 fsapfs_test_checksum_calculate_weak_crc32 );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_checksum_calculate_fletcher64",
+	 fsapfs_test_checksum_calculate_fletcher64 );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1216 @@
+/*
+ * Library compressed_block_cache type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_compressed_block_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_compressed_block_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_block_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfsapfs_compressed_block_cache_t *compressed_block_cache = NULL;
+	int result                                                 = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                            = 2;
+	int number_of_memset_fail_tests                            = 2;
+	int test_number                                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_block_cache_free(
+	          &compressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_block_cache_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compressed_block_cache = (libfsapfs_compressed_block_cache_t *) 0x12345678UL;
+
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          4,
+	          &error );
+
+	compressed_block_cache = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_compressed_block_cache_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_compressed_block_cache_initialize(
+		          &compressed_block_cache,
+		          4,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( compressed_block_cache != NULL )
+			{
+				libfsapfs_compressed_block_cache_free(
+				 &compressed_block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "compressed_block_cache",
+			 compressed_block_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_compressed_block_cache_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_compressed_block_cache_initialize(
+		          &compressed_block_cache,
+		          4,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( compressed_block_cache != NULL )
+			{
+				libfsapfs_compressed_block_cache_free(
+				 &compressed_block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "compressed_block_cache",
+			 compressed_block_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_block_cache != NULL )
+	{
+		libfsapfs_compressed_block_cache_free(
+		 &compressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_compressed_block_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_block_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_block_cache_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_compressed_block_cache_get_block_data and libfsapfs_compressed_block_cache_set_block_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_block_cache_get_and_set_block_data(
+     void )
+{
+	uint8_t block_data[ 64 ];
+	uint8_t cached_block_data[ 64 ];
+
+	libcerror_error_t *error                                   = NULL;
+	libfsapfs_compressed_block_cache_t *compressed_block_cache = NULL;
+	size_t uncompressed_block_size                             = 0;
+	uint32_t block_index                                       = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < 2;
+	     block_index++ )
+	{
+		result = memory_set(
+		          block_data,
+		          'A' + (int) block_index,
+		          64 ) != NULL;
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_compressed_block_cache_set_block_data(
+		          compressed_block_cache,
+		          16,
+		          block_index,
+		          block_data,
+		          32 + ( block_index * 32 ),
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_block_size",
+	 uncompressed_block_size,
+	 (size_t) 32 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "cached_block_data[ 31 ]",
+	 cached_block_data[ 31 ],
+	 (uint8_t) 'A' );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The same block index of another file is not available
+	 */
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          17,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          NULL,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          NULL,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          1,
+	          cached_block_data,
+	          32,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_set_block_data(
+	          NULL,
+	          16,
+	          0,
+	          block_data,
+	          64,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_set_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          NULL,
+	          64,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_set_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          block_data,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_block_cache_free(
+	          &compressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_block_cache != NULL )
+	{
+		libfsapfs_compressed_block_cache_free(
+		 &compressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_compressed_block_cache_allocate_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_block_cache_allocate_entries(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfsapfs_compressed_block_cache_t *compressed_block_cache = NULL;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_block_cache->number_of_sets",
+	 compressed_block_cache->number_of_sets,
+	 (uint32_t) 1 );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_block_cache_allocate_entries(
+	          compressed_block_cache,
+	          256,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_block_cache->number_of_sets",
+	 compressed_block_cache->number_of_sets,
+	 (uint32_t) 256 / LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS );
+
+	result = libfsapfs_compressed_block_cache_allocate_entries(
+	          compressed_block_cache,
+	          300,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_block_cache->number_of_sets",
+	 compressed_block_cache->number_of_sets,
+	 (uint32_t) 256 / LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_block_cache_allocate_entries(
+	          NULL,
+	          256,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_allocate_entries(
+	          compressed_block_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_block_cache_free(
+	          &compressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_block_cache != NULL )
+	{
+		libfsapfs_compressed_block_cache_free(
+		 &compressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_compressed_block_cache_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_block_cache_resize(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfsapfs_compressed_block_cache_t *compressed_block_cache = NULL;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_block_cache_resize(
+	          compressed_block_cache,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_block_cache_resize(
+	          NULL,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_block_cache_resize(
+	          compressed_block_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_block_cache_free(
+	          &compressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_block_cache != NULL )
+	{
+		libfsapfs_compressed_block_cache_free(
+		 &compressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests replacing the least recently used block of a set
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_block_cache_replace_block_data(
+     void )
+{
+	uint8_t block_data[ 64 ];
+	uint8_t cached_block_data[ 64 ];
+
+	libcerror_error_t *error                                   = NULL;
+	libfsapfs_compressed_block_cache_t *compressed_block_cache = NULL;
+	size_t uncompressed_block_size                             = 0;
+	uint32_t block_index                                       = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 * A cache of a single set where every block maps onto the same set
+	 */
+	result = libfsapfs_compressed_block_cache_initialize(
+	          &compressed_block_cache,
+	          LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS;
+	     block_index++ )
+	{
+		result = memory_set(
+		          block_data,
+		          'A' + (int) block_index,
+		          64 ) != NULL;
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_compressed_block_cache_set_block_data(
+		          compressed_block_cache,
+		          16,
+		          block_index,
+		          block_data,
+		          64,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Use block 0 so that block 1 is the least recently used block
+	 */
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = memory_set(
+	          block_data,
+	          'Z',
+	          64 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsapfs_compressed_block_cache_set_block_data(
+	          compressed_block_cache,
+	          16,
+	          LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS,
+	          block_data,
+	          48,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          1,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "cached_block_data[ 63 ]",
+	 cached_block_data[ 63 ],
+	 (uint8_t) 'A' );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          LIBFSAPFS_COMPRESSED_BLOCK_CACHE_NUMBER_OF_WAYS,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_block_size",
+	 uncompressed_block_size,
+	 (size_t) 48 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "cached_block_data[ 47 ]",
+	 cached_block_data[ 47 ],
+	 (uint8_t) 'Z' );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Setting a block that is already cached replaces its data
+	 */
+	result = libfsapfs_compressed_block_cache_set_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          block_data,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_block_cache_get_block_data(
+	          compressed_block_cache,
+	          16,
+	          0,
+	          cached_block_data,
+	          64,
+	          &uncompressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_block_size",
+	 uncompressed_block_size,
+	 (size_t) 16 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "cached_block_data[ 15 ]",
+	 cached_block_data[ 15 ],
+	 (uint8_t) 'Z' );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_block_cache_free(
+	          &compressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_block_cache",
+	 compressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_block_cache != NULL )
+	{
+		libfsapfs_compressed_block_cache_free(
+		 &compressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_block_cache_initialize",
+	 fsapfs_test_compressed_block_cache_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_block_cache_free",
+	 fsapfs_test_compressed_block_cache_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_block_cache_allocate_entries",
+	 fsapfs_test_compressed_block_cache_allocate_entries );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_block_cache_resize",
+	 fsapfs_test_compressed_block_cache_resize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_block_cache_get_and_set_block_data",
+	 fsapfs_test_compressed_block_cache_get_and_set_block_data );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_block_cache_replace_block_data",
+	 fsapfs_test_compressed_block_cache_replace_block_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
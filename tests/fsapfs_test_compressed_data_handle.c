@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -37,6 +38,7 @@
 #include "../libfsapfs/libfsapfs_compressed_data_handle.h"
 #include "../libfsapfs/libfsapfs_data_stream.h"
 #include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_worker_pool.h"
 
 uint8_t fsapfs_test_compressed_data_handle_lzvn_compressed_data1[ 35 ] = {
 	0x66, 0x70, 0x6d, 0x63, 0x07, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -541,6 +543,1017 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_compressed_data_handle_read_compressed_block function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_read_compressed_block(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfdata_stream_t *compressed_data_stream                  = NULL;
+	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	uint8_t *compressed_block_data                             = NULL;
+	size_t compressed_block_size                               = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_data_stream_initialize_from_data(
+	          &compressed_data_stream,
+	          fsapfs_test_compressed_data_handle_lzvn_compressed_data1,
+	          35,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
+	          compressed_data_stream,
+	          16,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_get_compressed_block_offsets(
+	          compressed_data_handle,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_data_handle_read_compressed_block(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          &compressed_block_data,
+	          &compressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block_data",
+	 compressed_block_data );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "compressed_block_size",
+	 compressed_block_size,
+	 (size_t) 19 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          compressed_block_data,
+	          &( fsapfs_test_compressed_data_handle_lzvn_compressed_data1[ 16 ] ),
+	          19 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_data_handle_read_compressed_block(
+	          NULL,
+	          NULL,
+	          0,
+	          &compressed_block_data,
+	          &compressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_read_compressed_block(
+	          compressed_data_handle,
+	          NULL,
+	          1,
+	          &compressed_block_data,
+	          &compressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_read_compressed_block(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          NULL,
+	          &compressed_block_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_read_compressed_block(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          &compressed_block_data,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &compressed_data_stream,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data_handle != NULL )
+	{
+		libfsapfs_compressed_data_handle_free(
+		 &compressed_data_handle,
+		 NULL );
+	}
+	if( compressed_data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &compressed_data_stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_compressed_data_handle_set_number_of_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_set_number_of_threads(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfdata_stream_t *compressed_data_stream                  = NULL;
+	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_data_stream_initialize_from_data(
+	          &compressed_data_stream,
+	          fsapfs_test_compressed_data_handle_lzvn_compressed_data1,
+	          35,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
+	          compressed_data_stream,
+	          16,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "compressed_data_handle->number_of_threads",
+	 compressed_data_handle->number_of_threads,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_data_handle_set_number_of_threads(
+	          compressed_data_handle,
+	          NULL,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "compressed_data_handle->number_of_threads",
+	 compressed_data_handle->number_of_threads,
+	 4 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_data_handle_set_number_of_threads(
+	          NULL,
+	          NULL,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_set_number_of_threads(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_set_number_of_threads(
+	          compressed_data_handle,
+	          NULL,
+	          LIBFSAPFS_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS + 1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &compressed_data_stream,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data_handle != NULL )
+	{
+		libfsapfs_compressed_data_handle_free(
+		 &compressed_data_handle,
+		 NULL );
+	}
+	if( compressed_data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &compressed_data_stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Creates compressed test data of LZVN compressed blocks that contain uncompressed data
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_create_blocks(
+     uint8_t **compressed_data,
+     uint32_t **compressed_block_offsets,
+     uint32_t number_of_compressed_blocks )
+{
+	size_t data_offset   = 0;
+	uint32_t block_index = 0;
+	uint32_t byte_index  = 0;
+
+	*compressed_data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * number_of_compressed_blocks * ( LIBFSAPFS_COMPRESSED_BLOCK_SIZE + 1 ) );
+
+	if( *compressed_data == NULL )
+	{
+		return( 0 );
+	}
+	*compressed_block_offsets = (uint32_t *) memory_allocate(
+	                                          sizeof( uint32_t ) * ( number_of_compressed_blocks + 1 ) );
+
+	if( *compressed_block_offsets == NULL )
+	{
+		memory_free(
+		 *compressed_data );
+
+		*compressed_data = NULL;
+
+		return( 0 );
+	}
+	for( block_index = 0;
+	     block_index < number_of_compressed_blocks;
+	     block_index++ )
+	{
+		( *compressed_block_offsets )[ block_index ] = (uint32_t) data_offset;
+
+		( *compressed_data )[ data_offset++ ] = 0x06;
+
+		for( byte_index = 0;
+		     byte_index < LIBFSAPFS_COMPRESSED_BLOCK_SIZE;
+		     byte_index++ )
+		{
+			( *compressed_data )[ data_offset++ ] = (uint8_t) ( block_index + byte_index );
+		}
+	}
+	( *compressed_block_offsets )[ block_index ] = (uint32_t) data_offset;
+
+	return( 1 );
+}
+
+/* Checks uncompressed test data of compressed blocks
+ * Returns 1 if the data matches or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_check_blocks(
+     const uint8_t *uncompressed_data,
+     uint32_t number_of_compressed_blocks )
+{
+	size_t data_offset   = 0;
+	uint32_t block_index = 0;
+	uint32_t byte_index  = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_compressed_blocks;
+	     block_index++ )
+	{
+		for( byte_index = 0;
+		     byte_index < LIBFSAPFS_COMPRESSED_BLOCK_SIZE;
+		     byte_index++ )
+		{
+			if( uncompressed_data[ data_offset++ ] != (uint8_t) ( block_index + byte_index ) )
+			{
+				return( 0 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the libfsapfs_compressed_data_handle_decompress_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_decompress_blocks(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	uint32_t *compressed_block_offsets = NULL;
+	uint8_t *compressed_data           = NULL;
+	uint8_t *uncompressed_data         = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_compressed_data_handle_create_blocks(
+	          &compressed_data,
+	          &compressed_block_offsets,
+	          3 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * 3 * LIBFSAPFS_COMPRESSED_BLOCK_SIZE );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_data_handle_decompress_blocks(
+	          compressed_data,
+	          0,
+	          compressed_block_offsets,
+	          3,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_compressed_data_handle_check_blocks(
+	          uncompressed_data,
+	          3 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_data_handle_decompress_blocks(
+	          NULL,
+	          0,
+	          compressed_block_offsets,
+	          3,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_decompress_blocks(
+	          compressed_data,
+	          0,
+	          NULL,
+	          3,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_decompress_blocks(
+	          compressed_data,
+	          0,
+	          compressed_block_offsets,
+	          3,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the compressed data offset exceeds the block offset
+	 */
+	result = libfsapfs_compressed_data_handle_decompress_blocks(
+	          compressed_data,
+	          1,
+	          compressed_block_offsets,
+	          3,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	memory_free(
+	 compressed_block_offsets );
+
+	compressed_block_offsets = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_block_offsets != NULL )
+	{
+		memory_free(
+		 compressed_block_offsets );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+/* Tests the libfsapfs_compressed_data_handle_read_compressed_blocks_parallel function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_read_compressed_blocks_parallel(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfdata_stream_t *compressed_data_stream                  = NULL;
+	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	libfsapfs_worker_pool_t *worker_pool                       = NULL;
+	uint32_t *compressed_block_offsets                         = NULL;
+	uint8_t *compressed_data                                   = NULL;
+	uint8_t *uncompressed_data                                 = NULL;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_compressed_data_handle_create_blocks(
+	          &compressed_data,
+	          &compressed_block_offsets,
+	          6 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * 6 * LIBFSAPFS_COMPRESSED_BLOCK_SIZE );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	result = libfsapfs_data_stream_initialize_from_data(
+	          &compressed_data_stream,
+	          compressed_data,
+	          (size_t) compressed_block_offsets[ 6 ],
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
+	          compressed_data_stream,
+	          6 * LIBFSAPFS_COMPRESSED_BLOCK_SIZE,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The compressed data handle takes over the compressed block offsets
+	 */
+	compressed_data_handle->compressed_block_offsets    = compressed_block_offsets;
+	compressed_data_handle->number_of_compressed_blocks = 6;
+
+	compressed_block_offsets = NULL;
+
+	result = libfsapfs_worker_pool_initialize(
+	          &worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_set_number_of_threads(
+	          compressed_data_handle,
+	          worker_pool,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          6,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_compressed_data_handle_check_blocks(
+	          uncompressed_data,
+	          6 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+	          NULL,
+	          NULL,
+	          0,
+	          6,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+	          compressed_data_handle,
+	          NULL,
+	          2,
+	          5,
+	          uncompressed_data,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_compressed_data_handle_read_compressed_blocks_parallel(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          6,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_worker_pool_release(
+	          worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &compressed_data_stream,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_worker_pool_free(
+	          &worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data_handle != NULL )
+	{
+		libfsapfs_compressed_data_handle_free(
+		 &compressed_data_handle,
+		 NULL );
+	}
+	if( compressed_data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &compressed_data_stream,
+		 NULL );
+	}
+	if( worker_pool != NULL )
+	{
+		libfsapfs_worker_pool_free(
+		 &worker_pool,
+		 NULL );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_block_offsets != NULL )
+	{
+		memory_free(
+		 compressed_block_offsets );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 /* Tests the libfsapfs_compressed_data_handle_read_segment_data function
  * Returns 1 if successful or 0 if not
  */
@@ -972,10 +1985,30 @@ int main(
 	 "libfsapfs_compressed_data_handle_free",
 	 fsapfs_test_compressed_data_handle_free );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_set_number_of_threads",
+	 fsapfs_test_compressed_data_handle_set_number_of_threads );
+
 	FSAPFS_TEST_RUN(
 	 "libfsapfs_compressed_data_handle_get_compressed_block_offsets",
 	 fsapfs_test_compressed_data_handle_get_compressed_block_offsets );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_read_compressed_block",
+	 fsapfs_test_compressed_data_handle_read_compressed_block );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_decompress_blocks",
+	 fsapfs_test_compressed_data_handle_decompress_blocks );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_read_compressed_blocks_parallel",
+	 fsapfs_test_compressed_data_handle_read_compressed_blocks_parallel );
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 	FSAPFS_TEST_RUN(
 	 "libfsapfs_compressed_data_handle_read_segment_data",
 	 fsapfs_test_compressed_data_handle_read_segment_data );
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
 #include <narrow_string.h>
 #include <system_string.h>
@@ -40,7 +41,9 @@
 #include "fsapfs_test_macros.h"
 #include "fsapfs_test_memory.h"
 
+#include "../libfsapfs/libfsapfs_checksum.h"
 #include "../libfsapfs/libfsapfs_container.h"
+#include "../libfsapfs/libfsapfs_container_superblock.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -50,6 +53,9 @@
 #define FSAPFS_TEST_CONTAINER_VERBOSE
  */
 
+#define FSAPFS_TEST_CONTAINER_BLOCK_SIZE		4096
+#define FSAPFS_TEST_CONTAINER_NUMBER_OF_BLOCKS		301
+
 #if !defined( LIBFSAPFS_HAVE_BFIO )
 
 LIBFSAPFS_EXTERN \
@@ -1196,21 +1202,43 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfsapfs_container_get_number_of_volumes function
+/* Tests the libfsapfs_container_get_lazy_volume_open function
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_container_get_number_of_volumes(
-     libfsapfs_container_t *container )
+int fsapfs_test_container_get_lazy_volume_open(
+     void )
 {
-	libcerror_error_t *error = NULL;
-	int number_of_volumes    = 0;
-	int result               = 0;
+	libcerror_error_t *error         = NULL;
+	libfsapfs_container_t *container = NULL;
+	uint8_t lazy_volume_open         = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_container_initialize(
+	          &container,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "container",
+	 container );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test regular cases
 	 */
-	result = libfsapfs_container_get_number_of_volumes(
+	lazy_volume_open = 0xff;
+
+	result = libfsapfs_container_get_lazy_volume_open(
 	          container,
-	          &number_of_volumes,
+	          &lazy_volume_open,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -1218,15 +1246,20 @@ int fsapfs_test_container_get_number_of_volumes(
 	 result,
 	 1 );
 
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "lazy_volume_open",
+	 lazy_volume_open,
+	 0 );
+
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
 	/* Test error cases
 	 */
-	result = libfsapfs_container_get_number_of_volumes(
+	result = libfsapfs_container_get_lazy_volume_open(
 	          NULL,
-	          &number_of_volumes,
+	          &lazy_volume_open,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -1241,7 +1274,7 @@ int fsapfs_test_container_get_number_of_volumes(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsapfs_container_get_number_of_volumes(
+	result = libfsapfs_container_get_lazy_volume_open(
 	          container,
 	          NULL,
 	          &error );
@@ -1258,6 +1291,25 @@ int fsapfs_test_container_get_number_of_volumes(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libfsapfs_container_free(
+	          &container,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "container",
+	 container );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1266,95 +1318,792 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( container != NULL )
+	{
+		libfsapfs_container_free(
+		 &container,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libfsapfs_container_set_lazy_volume_open function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc,
-     wchar_t * const argv[] )
-#else
-int main(
-     int argc,
-     char * const argv[] )
-#endif
+int fsapfs_test_container_set_lazy_volume_open(
+     void )
 {
-	libbfio_handle_t *file_io_handle  = NULL;
-	libcerror_error_t *error          = NULL;
-	libfsapfs_container_t *container  = NULL;
-	system_character_t *option_offset = NULL;
-	system_character_t *source        = NULL;
-	system_integer_t option           = 0;
-	size_t string_length              = 0;
-	off64_t volume_offset             = 0;
-	int result                        = 0;
+	libcerror_error_t *error         = NULL;
+	libfsapfs_container_t *container = NULL;
+	uint8_t lazy_volume_open         = 0;
+	int result                       = 0;
 
-	while( ( option = fsapfs_test_getopt(
-	                   argc,
-	                   argv,
-	                   _SYSTEM_STRING( "o:p:" ) ) ) != (system_integer_t) -1 )
-	{
-		switch( option )
-		{
-			case (system_integer_t) '?':
-			default:
-				fprintf(
-				 stderr,
-				 "Invalid argument: %" PRIs_SYSTEM ".\n",
-				 argv[ optind - 1 ] );
+	/* Initialize test
+	 */
+	result = libfsapfs_container_initialize(
+	          &container,
+	          &error );
 
-				return( EXIT_FAILURE );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-			case (system_integer_t) 'o':
-				option_offset = optarg;
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "container",
+	 container );
 
-				break;
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-			case (system_integer_t) 'p':
-				break;
-		}
-	}
-	if( optind < argc )
-	{
-		source = argv[ optind ];
-	}
-	if( option_offset != NULL )
-	{
-		string_length = system_string_length(
-		                 option_offset );
+	/* Test regular cases
+	 */
+	result = libfsapfs_container_set_lazy_volume_open(
+	          container,
+	          1,
+	          &error );
 
-		result = fsapfs_test_system_string_copy_from_64_bit_in_decimal(
-		          option_offset,
-		          string_length + 1,
-		          (uint64_t *) &volume_offset,
-		          &error );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		FSAPFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	        FSAPFS_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
-	}
-#if defined( HAVE_DEBUG_OUTPUT ) && defined( FSAPFS_TEST_CONTAINER_VERBOSE )
-	libfsapfs_notify_set_verbose(
+	result = libfsapfs_container_get_lazy_volume_open(
+	          container,
+	          &lazy_volume_open,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
 	 1 );
-	libfsapfs_notify_set_stream(
-	 stderr,
-	 NULL );
-#endif
 
-	FSAPFS_TEST_RUN(
-	 "libfsapfs_container_initialize",
-	 fsapfs_test_container_initialize );
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "lazy_volume_open",
+	 lazy_volume_open,
+	 1 );
 
-	FSAPFS_TEST_RUN(
-	 "libfsapfs_container_free",
-	 fsapfs_test_container_free );
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_container_set_lazy_volume_open(
+	          container,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_container_get_lazy_volume_open(
+	          container,
+	          &lazy_volume_open,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "lazy_volume_open",
+	 lazy_volume_open,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Any value other than 0 enables opening volumes lazily
+	 */
+	result = libfsapfs_container_set_lazy_volume_open(
+	          container,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_container_get_lazy_volume_open(
+	          container,
+	          &lazy_volume_open,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "lazy_volume_open",
+	 lazy_volume_open,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_container_set_lazy_volume_open(
+	          NULL,
+	          1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_container_free(
+	          &container,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "container",
+	 container );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( container != NULL )
+	{
+		libfsapfs_container_free(
+		 &container,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_container_get_number_of_volumes function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_container_get_number_of_volumes(
+     libfsapfs_container_t *container )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_volumes    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_container_get_number_of_volumes(
+	          container,
+	          &number_of_volumes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_container_get_number_of_volumes(
+	          NULL,
+	          &number_of_volumes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_container_get_number_of_volumes(
+	          container,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Writes a container superblock for the checkpoint descriptor area test data
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_container_write_superblock_data(
+     uint8_t *data,
+     uint64_t transaction_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "fsapfs_test_container_write_superblock_data";
+	uint64_t checksum     = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 16 ] ),
+	 transaction_identifier );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 24 ] ),
+	 0x80000001UL );
+
+	data[ 32 ] = (uint8_t) 'N';
+	data[ 33 ] = (uint8_t) 'X';
+	data[ 34 ] = (uint8_t) 'S';
+	data[ 35 ] = (uint8_t) 'B';
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 36 ] ),
+	 FSAPFS_TEST_CONTAINER_BLOCK_SIZE );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 40 ] ),
+	 (uint64_t) FSAPFS_TEST_CONTAINER_NUMBER_OF_BLOCKS );
+
+	/* The checkpoint descriptor area number of blocks excludes the last block of the area
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 104 ] ),
+	 FSAPFS_TEST_CONTAINER_NUMBER_OF_BLOCKS - 2 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 112 ] ),
+	 (uint64_t) 1 );
+
+	if( libfsapfs_checksum_calculate_fletcher64(
+	     &checksum,
+	     &( data[ 8 ] ),
+	     FSAPFS_TEST_CONTAINER_BLOCK_SIZE - 8,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate Fletcher-64 checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 0 ] ),
+	 checksum );
+
+	return( 1 );
+}
+
+/* Tests the libfsapfs_internal_container_read_checkpoint_descriptor_area function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_internal_container_read_checkpoint_descriptor_area(
+     void )
+{
+	libbfio_handle_t *file_io_handle                   = NULL;
+	libcerror_error_t *error                           = NULL;
+	libfsapfs_container_t *container                   = NULL;
+	libfsapfs_internal_container_t *internal_container = NULL;
+	uint8_t *container_data                            = NULL;
+	uint64_t checkpoint_map_block_number               = 0;
+	size_t container_data_size                         = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 * The checkpoint descriptor area starts at block 1 and is larger than
+	 * the number of blocks read at once. The most recent checkpoint map
+	 * is at the start of the second read and the most recent backup
+	 * container superblock is in the last block of the area.
+	 */
+	container_data_size = FSAPFS_TEST_CONTAINER_NUMBER_OF_BLOCKS * FSAPFS_TEST_CONTAINER_BLOCK_SIZE;
+
+	container_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * container_data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "container_data",
+	 container_data );
+
+	result = memory_set(
+	          container_data,
+	          0,
+	          container_data_size ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fsapfs_test_container_write_superblock_data(
+	          container_data,
+	          1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Checkpoint maps in the first block, the last block of the first read
+	 * and the first block of the second read
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 &( container_data[ ( 1 * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ) + 16 ] ),
+	 (uint64_t) 1 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( container_data[ ( 1 * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ) + 24 ] ),
+	 0x4000000cUL );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( container_data[ ( 256 * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ) + 16 ] ),
+	 (uint64_t) 2 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( container_data[ ( 256 * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ) + 24 ] ),
+	 0x4000000cUL );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( container_data[ ( 257 * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ) + 16 ] ),
+	 (uint64_t) 3 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( container_data[ ( 257 * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ) + 24 ] ),
+	 0x4000000cUL );
+
+	result = fsapfs_test_container_write_superblock_data(
+	          &( container_data[ ( FSAPFS_TEST_CONTAINER_NUMBER_OF_BLOCKS - 1 ) * FSAPFS_TEST_CONTAINER_BLOCK_SIZE ] ),
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          container_data,
+	          container_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_container_initialize(
+	          &container,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "container",
+	 container );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+	result = libfsapfs_container_superblock_initialize(
+	          &( internal_container->superblock ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_container_superblock_read_file_io_handle(
+	          internal_container->superblock,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_container->io_handle->block_size = internal_container->superblock->block_size;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_internal_container_read_checkpoint_descriptor_area(
+	          internal_container,
+	          file_io_handle,
+	          &checkpoint_map_block_number,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "checkpoint_map_block_number",
+	 checkpoint_map_block_number,
+	 (uint64_t) 257 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "internal_container->superblock->object_transaction_identifier",
+	 internal_container->superblock->object_transaction_identifier,
+	 (uint64_t) 4 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_internal_container_read_checkpoint_descriptor_area(
+	          NULL,
+	          file_io_handle,
+	          &checkpoint_map_block_number,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_internal_container_read_checkpoint_descriptor_area(
+	          internal_container,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a checkpoint descriptor area that extends beyond the end of the data
+	 */
+	internal_container->superblock->checkpoint_descriptor_area_number_of_blocks += 1;
+
+	result = libfsapfs_internal_container_read_checkpoint_descriptor_area(
+	          internal_container,
+	          file_io_handle,
+	          &checkpoint_map_block_number,
+	          &error );
+
+	internal_container->superblock->checkpoint_descriptor_area_number_of_blocks -= 1;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_container_superblock_free(
+	          &( internal_container->superblock ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_container_free(
+	          &container,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "container",
+	 container );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 container_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( internal_container != NULL )
+	{
+		if( internal_container->superblock != NULL )
+		{
+			libfsapfs_container_superblock_free(
+			 &( internal_container->superblock ),
+			 NULL );
+		}
+	}
+	if( container != NULL )
+	{
+		libfsapfs_container_free(
+		 &container,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( container_data != NULL )
+	{
+		memory_free(
+		 container_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle  = NULL;
+	libcerror_error_t *error          = NULL;
+	libfsapfs_container_t *container  = NULL;
+	system_character_t *option_offset = NULL;
+	system_character_t *source        = NULL;
+	system_integer_t option           = 0;
+	size_t string_length              = 0;
+	off64_t volume_offset             = 0;
+	int result                        = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "o:p:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'o':
+				option_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+	if( option_offset != NULL )
+	{
+		string_length = system_string_length(
+		                 option_offset );
+
+		result = fsapfs_test_system_string_copy_from_64_bit_in_decimal(
+		          option_offset,
+		          string_length + 1,
+		          (uint64_t *) &volume_offset,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        FSAPFS_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( FSAPFS_TEST_CONTAINER_VERBOSE )
+	libfsapfs_notify_set_verbose(
+	 1 );
+	libfsapfs_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_container_initialize",
+	 fsapfs_test_container_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_container_free",
+	 fsapfs_test_container_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_container_get_lazy_volume_open",
+	 fsapfs_test_container_get_lazy_volume_open );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_container_set_lazy_volume_open",
+	 fsapfs_test_container_set_lazy_volume_open );
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_container_read_checkpoint_descriptor_area",
+	 fsapfs_test_internal_container_read_checkpoint_descriptor_area );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
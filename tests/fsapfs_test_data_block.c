@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -780,6 +781,770 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_data_block_run_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_data_block_run_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libfsapfs_data_block_run_t *data_block_run = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 3;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_data_block_run_initialize(
+	          &data_block_run,
+	          512,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block_run",
+	 data_block_run );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_data_block_run_free(
+	          &data_block_run,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block_run",
+	 data_block_run );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_data_block_run_initialize(
+	          NULL,
+	          512,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_block_run = (libfsapfs_data_block_run_t *) 0x12345678UL;
+
+	result = libfsapfs_data_block_run_initialize(
+	          &data_block_run,
+	          512,
+	          2,
+	          &error );
+
+	data_block_run = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_initialize(
+	          &data_block_run,
+	          0,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_initialize(
+	          &data_block_run,
+	          512,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_data_block_run_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_data_block_run_initialize(
+		          &data_block_run,
+		          512,
+		          2,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( data_block_run != NULL )
+			{
+				libfsapfs_data_block_run_free(
+				 &data_block_run,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "data_block_run",
+			 data_block_run );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_data_block_run_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_data_block_run_initialize(
+		          &data_block_run,
+		          512,
+		          2,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( data_block_run != NULL )
+			{
+				libfsapfs_data_block_run_free(
+				 &data_block_run,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "data_block_run",
+			 data_block_run );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block_run != NULL )
+	{
+		libfsapfs_data_block_run_free(
+		 &data_block_run,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_data_block_run_get_data_block function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_data_block_run_get_data_block(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libfsapfs_data_block_t *data_block1        = NULL;
+	libfsapfs_data_block_t *data_block2        = NULL;
+	libfsapfs_data_block_run_t *data_block_run = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_data_block_run_initialize(
+	          &data_block_run,
+	          512,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block_run",
+	 data_block_run );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_data_block_run_get_data_block(
+	          data_block_run,
+	          0,
+	          &data_block1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block1",
+	 data_block1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "data_block1->data_size",
+	 data_block1->data_size,
+	 (size_t) 512 );
+
+	result = libfsapfs_data_block_run_get_data_block(
+	          data_block_run,
+	          1,
+	          &data_block2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block2",
+	 data_block2 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data blocks share the data of the run
+	 */
+	result = ( data_block2->data == &( data_block1->data[ 512 ] ) );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "data_block_run->number_of_references",
+	 data_block_run->number_of_references,
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_data_block_run_get_data_block(
+	          NULL,
+	          0,
+	          &data_block1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_get_data_block(
+	          data_block_run,
+	          -1,
+	          &data_block1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_get_data_block(
+	          data_block_run,
+	          2,
+	          &data_block1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_get_data_block(
+	          data_block_run,
+	          0,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 * The run is freed when its last data block is freed
+	 */
+	result = libfsapfs_data_block_run_free(
+	          &data_block_run,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block_run",
+	 data_block_run );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_data_block_free(
+	          &data_block1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block1",
+	 data_block1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "data_block2->data_block_run->number_of_references",
+	 data_block2->data_block_run->number_of_references,
+	 1 );
+
+	result = libfsapfs_data_block_free(
+	          &data_block2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block2",
+	 data_block2 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block2 != NULL )
+	{
+		libfsapfs_data_block_free(
+		 &data_block2,
+		 NULL );
+	}
+	if( data_block1 != NULL )
+	{
+		libfsapfs_data_block_free(
+		 &data_block1,
+		 NULL );
+	}
+	if( data_block_run != NULL )
+	{
+		libfsapfs_data_block_run_free(
+		 &data_block_run,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_data_block_run_read function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_data_block_run_read(
+     void )
+{
+	libbfio_handle_t *file_io_handle           = NULL;
+	libcerror_error_t *error                   = NULL;
+	libfsapfs_data_block_run_t *data_block_run = NULL;
+	libfsapfs_io_handle_t *io_handle           = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_data_block_run_initialize(
+	          &data_block_run,
+	          256,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block_run",
+	 data_block_run );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize file IO handle
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_data_block_data1,
+	          1024,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_data_block_run_read(
+	          data_block_run,
+	          io_handle,
+	          NULL,
+	          file_io_handle,
+	          256,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data_block_run->data_blocks[ 2 ].data,
+	          &( fsapfs_test_data_block_data1[ 768 ] ),
+	          256 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_data_block_run_read(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          file_io_handle,
+	          256,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_read(
+	          data_block_run,
+	          NULL,
+	          NULL,
+	          file_io_handle,
+	          256,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_data_block_run_read(
+	          data_block_run,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          256,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test reading beyond the end of the data
+	 */
+	result = libfsapfs_data_block_run_read(
+	          data_block_run,
+	          io_handle,
+	          NULL,
+	          file_io_handle,
+	          512,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO handle
+	 */
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_data_block_run_free(
+	          &data_block_run,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block_run",
+	 data_block_run );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data_block_run != NULL )
+	{
+		libfsapfs_data_block_run_free(
+		 &data_block_run,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -815,6 +1580,22 @@ int main(
 	 "libfsapfs_data_block_read",
 	 fsapfs_test_data_block_read );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_data_block_run_initialize",
+	 fsapfs_test_data_block_run_initialize );
+
+	/* TODO: add tests for libfsapfs_data_block_run_free */
+
+	/* TODO: add tests for libfsapfs_data_block_run_release */
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_data_block_run_get_data_block",
+	 fsapfs_test_data_block_run_get_data_block );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_data_block_run_read",
+	 fsapfs_test_data_block_run_read );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
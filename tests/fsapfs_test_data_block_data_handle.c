@@ -478,6 +478,7 @@ on_error:
 int fsapfs_test_data_block_data_handle_read_segment_data(
      void )
 {
+	uint8_t block_data[ 4096 ];
 	uint8_t segment_data[ 16 ];
 
 	uint8_t expected_segment_data[ 16 ] = {
@@ -740,6 +741,171 @@ int fsapfs_test_data_block_data_handle_read_segment_data(
 	 "error",
 	 error );
 
+	/* Read buffer of a full block, which is read using the data block cache
+	 */
+	offset = libfsapfs_data_block_data_handle_seek_segment_offset(
+	          data_block_data_handle,
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfsapfs_data_block_data_handle_read_segment_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              0,
+	              0,
+	              block_data,
+	              4096,
+	              0,
+	              0,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          block_data,
+	          &( data_block_data[ 4096 ] ),
+	          4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Read buffer of the same block again, which is read from the data block cache
+	 * hence a change of the underlying data is not visible
+	 */
+	data_block_data[ 4096 ] = 0xff;
+
+	offset = libfsapfs_data_block_data_handle_seek_segment_offset(
+	          data_block_data_handle,
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfsapfs_data_block_data_handle_read_segment_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              0,
+	              0,
+	              block_data,
+	              4096,
+	              0,
+	              0,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) 0x00 );
+
+	result = memory_compare(
+	          &( block_data[ 1 ] ),
+	          &( data_block_data[ 4096 + 1 ] ),
+	          4096 - 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Read buffer of a full block with the data block cache limited to a single entry,
+	 * which is read directly hence a change of the underlying data is visible
+	 */
+	data_block_data_handle->maximum_number_of_cache_entries = 1;
+
+	offset = libfsapfs_data_block_data_handle_seek_segment_offset(
+	          data_block_data_handle,
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfsapfs_data_block_data_handle_read_segment_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              0,
+	              0,
+	              block_data,
+	              4096,
+	              0,
+	              0,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) 0xff );
+
+	result = memory_compare(
+	          block_data,
+	          &( data_block_data[ 4096 ] ),
+	          4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	data_block_data[ 4096 ] = 0x00;
+
 	/* Clean up
 	 */
 	result = libfsapfs_data_block_data_handle_free(
@@ -1136,6 +1136,136 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_deflate_huffman_table_construct_lookup_table function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_deflate_huffman_table_construct_lookup_table(
+     void )
+{
+	uint16_t code_size_array[ 288 ];
+
+	libfsapfs_deflate_huffman_table_t table;
+
+	libcerror_error_t *error = NULL;
+	void *memset_result      = NULL;
+	uint16_t symbol          = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 &table,
+	                 0,
+	                 sizeof( libfsapfs_deflate_huffman_table_t ) );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	for( symbol = 0;
+	     symbol < 288;
+	     symbol++ )
+	{
+		if( symbol < 144 )
+		{
+			code_size_array[ symbol ] = 8;
+		}
+		else if( symbol < 256 )
+		{
+			code_size_array[ symbol ] = 9;
+		}
+		else if( symbol < 280 )
+		{
+			code_size_array[ symbol ] = 7;
+		}
+		else
+		{
+			code_size_array[ symbol ] = 8;
+		}
+	}
+	result = libfsapfs_deflate_huffman_table_construct(
+	          &table,
+	          code_size_array,
+	          288,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_deflate_huffman_table_construct_lookup_table(
+	          &table,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "table.has_lookup_table",
+	 table.has_lookup_table,
+	 1 );
+
+	/* Symbol 0 has the 8-bit code 0x30 that is stored bit-reversed
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "table.lookup_table[ 0x000c ]",
+	 table.lookup_table[ 0x000c ],
+	 (uint32_t) 0x00000008UL );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "table.lookup_table[ 0x010c ]",
+	 table.lookup_table[ 0x010c ],
+	 (uint32_t) 0x00000008UL );
+
+	/* Symbol 256 has the 7-bit code 0x00
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "table.lookup_table[ 0x0000 ]",
+	 table.lookup_table[ 0x0000 ],
+	 (uint32_t) 0x01000007UL );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_deflate_huffman_table_construct_lookup_table(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libfsapfs_deflate_bit_stream_get_huffman_encoded_value function
  * Returns 1 if successful or 0 if not
  */
@@ -2662,6 +2792,10 @@ int main(
 	 "libfsapfs_deflate_huffman_table_construct",
 	 fsapfs_test_deflate_huffman_table_construct );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_deflate_huffman_table_construct_lookup_table",
+	 fsapfs_test_deflate_huffman_table_construct_lookup_table );
+
 	FSAPFS_TEST_RUN(
 	 "libfsapfs_deflate_bit_stream_get_huffman_encoded_value",
 	 fsapfs_test_deflate_bit_stream_get_huffman_encoded_value );
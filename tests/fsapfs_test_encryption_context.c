@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,7 +34,9 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_definitions.h"
 #include "../libfsapfs/libfsapfs_encryption_context.h"
+#include "../libfsapfs/libfsapfs_worker_pool.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
@@ -75,6 +78,277 @@ on_error:
 	return( 0 );
 }
 
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+/* Tests the libfsapfs_encryption_context_crypt function using the worker pool
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_encryption_context_crypt_parallel(
+     void )
+{
+	uint8_t key[ 32 ];
+
+	libcerror_error_t *error                           = NULL;
+	libfsapfs_encryption_context_t *encryption_context = NULL;
+	libfsapfs_worker_pool_t *worker_pool               = NULL;
+	uint8_t *input_data                                = NULL;
+	uint8_t *output_data                               = NULL;
+	uint8_t *parallel_output_data                      = NULL;
+	size_t data_offset                                 = 0;
+	size_t data_size                                   = 512 * 1024;
+	int iteration                                      = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	input_data = (uint8_t *) memory_allocate(
+	                          data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "input_data",
+	 input_data );
+
+	output_data = (uint8_t *) memory_allocate(
+	                           data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "output_data",
+	 output_data );
+
+	parallel_output_data = (uint8_t *) memory_allocate(
+	                                    data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "parallel_output_data",
+	 parallel_output_data );
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		input_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	for( data_offset = 0;
+	     data_offset < 32;
+	     data_offset++ )
+	{
+		key[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = libfsapfs_encryption_context_initialize(
+	          &encryption_context,
+	          LIBFSAPFS_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "encryption_context",
+	 encryption_context );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_encryption_context_set_keys(
+	          encryption_context,
+	          key,
+	          16,
+	          &( key[ 16 ] ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_worker_pool_initialize(
+	          &worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "worker_pool",
+	 worker_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_encryption_context_crypt(
+	          encryption_context,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          data_size,
+	          output_data,
+	          data_size,
+	          0,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_encryption_context_set_number_of_threads(
+	          encryption_context,
+	          worker_pool,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The worker threads are reused by successive calls
+	 */
+	for( iteration = 0;
+	     iteration < 4;
+	     iteration++ )
+	{
+		result = libfsapfs_encryption_context_crypt(
+		          encryption_context,
+		          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          input_data,
+		          data_size,
+		          parallel_output_data,
+		          data_size,
+		          0,
+		          512,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          parallel_output_data,
+		          output_data,
+		          data_size );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "worker_pool->number_of_threads",
+		 worker_pool->number_of_threads,
+		 3 );
+	}
+	/* Clean up
+	 */
+	result = libfsapfs_encryption_context_free(
+	          &encryption_context,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "encryption_context",
+	 encryption_context );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_worker_pool_free(
+	          &worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "worker_pool",
+	 worker_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 parallel_output_data );
+
+	memory_free(
+	 output_data );
+
+	memory_free(
+	 input_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( encryption_context != NULL )
+	{
+		libfsapfs_encryption_context_free(
+		 &encryption_context,
+		 NULL );
+	}
+	if( worker_pool != NULL )
+	{
+		libfsapfs_worker_pool_free(
+		 &worker_pool,
+		 NULL );
+	}
+	if( parallel_output_data != NULL )
+	{
+		memory_free(
+		 parallel_output_data );
+	}
+	if( output_data != NULL )
+	{
+		memory_free(
+		 output_data );
+	}
+	if( input_data != NULL )
+	{
+		memory_free(
+		 input_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -104,6 +378,14 @@ int main(
 
 	/* TODO: add tests for libfsapfs_encryption_context_crypt */
 
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_encryption_context_crypt_parallel",
+	 fsapfs_test_encryption_context_crypt_parallel );
+
+#endif /* defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+
 	/* TODO: add tests for libfsapfs_encryption_aes_key_unwrap */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
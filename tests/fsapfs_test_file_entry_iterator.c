@@ -0,0 +1,878 @@
+/*
+ * Library file_entry_iterator type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_file_entry_iterator.h"
+#include "../libfsapfs/libfsapfs_file_system_btree.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_file_entry_iterator_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_entry_iterator_initialize(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_entry_iterator_t *file_entry_iterator = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree     = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 1;
+	int number_of_memset_fail_tests                      = 1;
+	int test_number                                      = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_entry_iterator_free(
+	          &file_entry_iterator,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_entry_iterator_initialize(
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          0xff,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_entry_iterator = (libfsapfs_file_entry_iterator_t *) 0x12345678UL;
+
+	result = libfsapfs_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+	          0,
+	          &error );
+
+	file_entry_iterator = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_entry_iterator_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_entry_iterator_initialize(
+		          &file_entry_iterator,
+		          NULL,
+		          NULL,
+		          NULL,
+		          file_system_btree,
+		          NULL,
+		          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+		          0,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( file_entry_iterator != NULL )
+			{
+				libfsapfs_file_entry_iterator_free(
+				 &file_entry_iterator,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_entry_iterator",
+			 file_entry_iterator );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_entry_iterator_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_entry_iterator_initialize(
+		          &file_entry_iterator,
+		          NULL,
+		          NULL,
+		          NULL,
+		          file_system_btree,
+		          NULL,
+		          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+		          0,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( file_entry_iterator != NULL )
+			{
+				libfsapfs_file_entry_iterator_free(
+				 &file_entry_iterator,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_entry_iterator",
+			 file_entry_iterator );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* Tests the libfsapfs_file_entry_iterator_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_entry_iterator_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_entry_iterator_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_entry_iterator_get_next_file_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_entry_iterator_get_next_file_entry(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libfsapfs_file_entry_t *file_entry = NULL;
+	int result                         = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_entry_iterator_get_next_file_entry(
+	          NULL,
+	          &file_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_internal_file_entry_iterator_get_next_file_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_internal_file_entry_iterator_get_next_file_entry(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_entry_iterator_t *file_entry_iterator = NULL;
+	libfsapfs_file_entry_t *file_entry                   = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree     = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_INODES,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_internal_file_entry_iterator_get_next_file_entry(
+	          NULL,
+	          &file_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_internal_file_entry_iterator_get_next_file_entry(
+	          (libfsapfs_internal_file_entry_iterator_t *) file_entry_iterator,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_entry = (libfsapfs_file_entry_t *) 0x12345678UL;
+
+	result = libfsapfs_internal_file_entry_iterator_get_next_file_entry(
+	          (libfsapfs_internal_file_entry_iterator_t *) file_entry_iterator,
+	          &file_entry,
+	          &error );
+
+	file_entry = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_entry_iterator_free(
+	          &file_entry_iterator,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_internal_file_entry_iterator_get_next_sub_file_entry(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_entry_iterator_t *file_entry_iterator = NULL;
+	libfsapfs_file_entry_t *file_entry                   = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree     = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          LIBFSAPFS_FILE_ENTRY_ITERATOR_TYPE_DIRECTORY_RECORDS,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry(
+	          NULL,
+	          &file_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry(
+	          (libfsapfs_internal_file_entry_iterator_t *) file_entry_iterator,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_entry = (libfsapfs_file_entry_t *) 0x12345678UL;
+
+	result = libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry(
+	          (libfsapfs_internal_file_entry_iterator_t *) file_entry_iterator,
+	          &file_entry,
+	          &error );
+
+	file_entry = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_entry_iterator_free(
+	          &file_entry_iterator,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry_iterator != NULL )
+	{
+		libfsapfs_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_entry_iterator_initialize",
+	 fsapfs_test_file_entry_iterator_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_entry_iterator_free",
+	 fsapfs_test_file_entry_iterator_free );
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	/* TODO: add tests for libfsapfs_internal_file_entry_iterator_get_node */
+
+	/* TODO: add tests for libfsapfs_internal_file_entry_iterator_seek_key */
+
+	/* TODO: add tests for libfsapfs_internal_file_entry_iterator_get_next_btree_entry */
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_file_entry_iterator_get_next_file_entry",
+	 fsapfs_test_internal_file_entry_iterator_get_next_file_entry );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_file_entry_iterator_get_next_sub_file_entry",
+	 fsapfs_test_internal_file_entry_iterator_get_next_sub_file_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_entry_iterator_get_next_file_entry",
+	 fsapfs_test_file_entry_iterator_get_next_file_entry );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1131 @@
+/*
+ * Library file_io_handle_pool type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_functions.h"
+#include "fsapfs_test_libbfio.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_file_io_handle_pool.h"
+
+uint8_t fsapfs_test_file_io_handle_pool_data1[ 16 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_file_io_handle_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_io_handle_pool_initialize(
+     void )
+{
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 3;
+	int number_of_memset_fail_tests                      = 3;
+	int test_number                                      = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_file_io_handle_pool_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          file_io_handle,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_io_handle_pool->number_of_handles",
+	 file_io_handle_pool->number_of_handles,
+	 3 );
+
+	/* The first file IO handle is the one of the container
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "file_io_handle_pool->handles[ 0 ]",
+	 (intptr_t) file_io_handle_pool->handles[ 0 ],
+	 (intptr_t) file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool->handles[ 1 ]",
+	 file_io_handle_pool->handles[ 1 ] );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool->handles[ 2 ]",
+	 file_io_handle_pool->handles[ 2 ] );
+
+	result = libbfio_handle_is_open(
+	          file_io_handle_pool->handles[ 2 ],
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_free(
+	          &file_io_handle_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          NULL,
+	          file_io_handle,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_io_handle_pool = (libfsapfs_file_io_handle_pool_t *) 0x12345678UL;
+
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          file_io_handle,
+	          3,
+	          &error );
+
+	file_io_handle_pool = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          NULL,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          file_io_handle,
+	          LIBFSAPFS_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES + 1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_io_handle_pool_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_io_handle_pool_initialize(
+		          &file_io_handle_pool,
+		          file_io_handle,
+		          3,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( file_io_handle_pool != NULL )
+			{
+				libfsapfs_file_io_handle_pool_free(
+				 &file_io_handle_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_io_handle_pool",
+			 file_io_handle_pool );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_io_handle_pool_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_io_handle_pool_initialize(
+		          &file_io_handle_pool,
+		          file_io_handle,
+		          3,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( file_io_handle_pool != NULL )
+			{
+				libfsapfs_file_io_handle_pool_free(
+				 &file_io_handle_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_io_handle_pool",
+			 file_io_handle_pool );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	/* Clean up file IO handle
+	 */
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libfsapfs_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_io_handle_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_io_handle_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_io_handle_pool_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_io_handle_pool_grab_handle and libfsapfs_file_io_handle_pool_release_handle functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_io_handle_pool_grab_and_release_handle(
+     void )
+{
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libbfio_handle_t *grabbed_file_io_handle             = NULL;
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	int handle_index                                     = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_file_io_handle_pool_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          file_io_handle,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          &grabbed_file_io_handle,
+	          &handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "handle_index",
+	 handle_index,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "grabbed_file_io_handle",
+	 (intptr_t) grabbed_file_io_handle,
+	 (intptr_t) file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A second reader is handed the file IO handle without readers
+	 */
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          &grabbed_file_io_handle,
+	          &handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "handle_index",
+	 handle_index,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "grabbed_file_io_handle",
+	 (intptr_t) grabbed_file_io_handle,
+	 (intptr_t) file_io_handle_pool->handles[ 1 ] );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file IO handle that was released is handed out again
+	 */
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          &grabbed_file_io_handle,
+	          &handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "handle_index",
+	 handle_index,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          NULL,
+	          &grabbed_file_io_handle,
+	          &handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          NULL,
+	          &handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          &grabbed_file_io_handle,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          NULL,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test releasing a file IO handle that was not grabbed
+	 */
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_io_handle_pool_free(
+	          &file_io_handle_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libfsapfs_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests reading the data of two file entries through the file IO handle pool
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_io_handle_pool_read_file_entries(
+     void )
+{
+	uint8_t buffer[ 4 ];
+
+	libbfio_handle_t *file_entry1_file_io_handle         = NULL;
+	libbfio_handle_t *file_entry2_file_io_handle         = NULL;
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	ssize_t read_count                                   = 0;
+	off64_t offset                                       = 0;
+	int file_entry1_handle_index                         = 0;
+	int file_entry2_handle_index                         = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_file_io_handle_pool_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          file_io_handle,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The data of the first file entry is stored at offset 0 and of the second at offset 8
+	 */
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          &file_entry1_file_io_handle,
+	          &file_entry1_handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_entry1_handle_index",
+	 file_entry1_handle_index,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libbfio_handle_seek_offset(
+	          file_entry1_file_io_handle,
+	          (off64_t) 0,
+	          SEEK_SET,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbfio_handle_read_buffer(
+	          file_entry1_file_io_handle,
+	          buffer,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( fsapfs_test_file_io_handle_pool_data1[ 0 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfsapfs_file_io_handle_pool_grab_handle(
+	          file_io_handle_pool,
+	          &file_entry2_file_io_handle,
+	          &file_entry2_handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_entry2_handle_index",
+	 file_entry2_handle_index,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "file_entry2_file_io_handle",
+	 (intptr_t) file_entry2_file_io_handle,
+	 (intptr_t) file_entry1_file_io_handle );
+
+	offset = libbfio_handle_seek_offset(
+	          file_entry2_file_io_handle,
+	          (off64_t) 8,
+	          SEEK_SET,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 8 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbfio_handle_read_buffer(
+	          file_entry2_file_io_handle,
+	          buffer,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( fsapfs_test_file_io_handle_pool_data1[ 8 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The reads of the second file entry do not affect the offset of the first
+	 */
+	read_count = libbfio_handle_read_buffer(
+	          file_entry1_file_io_handle,
+	          buffer,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( fsapfs_test_file_io_handle_pool_data1[ 4 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libbfio_handle_read_buffer(
+	          file_entry2_file_io_handle,
+	          buffer,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( fsapfs_test_file_io_handle_pool_data1[ 12 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          file_entry1_handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_io_handle_pool_release_handle(
+	          file_io_handle_pool,
+	          file_entry2_handle_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_io_handle_pool_free(
+	          &file_io_handle_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libfsapfs_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_io_handle_pool_initialize",
+	 fsapfs_test_file_io_handle_pool_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_io_handle_pool_free",
+	 fsapfs_test_file_io_handle_pool_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_io_handle_pool_grab_handle",
+	 fsapfs_test_file_io_handle_pool_grab_and_release_handle );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_io_handle_pool_read_file_entries",
+	 fsapfs_test_file_io_handle_pool_read_file_entries );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
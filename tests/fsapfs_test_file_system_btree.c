@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
 #include <types.h>
 
@@ -34,6 +35,8 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_btree_entry.h"
+#include "../libfsapfs/libfsapfs_btree_node.h"
 #include "../libfsapfs/libfsapfs_file_system_btree.h"
 
 uint8_t fsapfs_test_file_system_btree_data1[ 4096 ] = {
@@ -320,7 +323,9 @@ int fsapfs_test_file_system_btree_initialize(
 	          NULL,
 	          NULL,
 	          NULL,
+	          NULL,
 	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	          0,
 	          &error );
 
@@ -362,7 +367,9 @@ int fsapfs_test_file_system_btree_initialize(
 	          NULL,
 	          NULL,
 	          NULL,
+	          NULL,
 	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	          0,
 	          &error );
 
@@ -386,7 +393,9 @@ int fsapfs_test_file_system_btree_initialize(
 	          NULL,
 	          NULL,
 	          NULL,
+	          NULL,
 	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 	          0,
 	          &error );
 
@@ -420,7 +429,9 @@ int fsapfs_test_file_system_btree_initialize(
 		          NULL,
 		          NULL,
 		          NULL,
+		          NULL,
 		          0,
+		          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 		          0,
 		          &error );
 
@@ -468,7 +479,9 @@ int fsapfs_test_file_system_btree_initialize(
 		          NULL,
 		          NULL,
 		          NULL,
+		          NULL,
 		          0,
+		          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
 		          0,
 		          &error );
 
@@ -559,6 +572,359 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_file_system_btree_get_entry_from_node_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_get_entry_from_node_by_identifier(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfsapfs_btree_entry_t *btree_entry             = NULL;
+	libfsapfs_btree_node_t *btree_node               = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree = NULL;
+	uint64_t identifier                              = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          fsapfs_test_file_system_btree_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          17,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 btree_entry->key_data,
+	 identifier );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 identifier,
+	 (uint64_t) 0x3000000000000011UL );
+
+	/* Test the first of multiple entries with the same identifier and data type
+	 */
+	btree_entry = NULL;
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          16,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "btree_entry->key_data_size",
+	 btree_entry->key_data_size,
+	 (size_t) 27 );
+
+	/* Test the first and last entry in the node
+	 */
+	btree_entry = NULL;
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          1,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "btree_entry->key_data_size",
+	 btree_entry->key_data_size,
+	 (size_t) 24 );
+
+	btree_entry = NULL;
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          19,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 btree_entry->key_data,
+	 identifier );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 identifier,
+	 (uint64_t) 0x8000000000000013UL );
+
+	/* Test entries that are not in the node
+	 */
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          17,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          20,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          NULL,
+	          btree_node,
+	          17,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          NULL,
+	          17,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          17,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_btree_node_free(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &btree_node,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -590,7 +956,9 @@ int main(
 
 /* TODO add tests for libfsapfs_file_system_btree_get_sub_node */
 
-/* TODO add tests for libfsapfs_file_system_btree_get_entry_from_node_by_identifier */
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_get_entry_from_node_by_identifier",
+	 fsapfs_test_file_system_btree_get_entry_from_node_by_identifier );
 
 /* TODO add tests for libfsapfs_file_system_btree_get_directory_record_from_node_by_utf8_name */
 
@@ -0,0 +1,1151 @@
+/*
+ * Library file_system_btree_cursor type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcdata.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_file_system_btree.h"
+#include "../libfsapfs/libfsapfs_file_system_btree_cursor.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_inode1[ 8 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_inode2[ 8 ] = {
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_xattr1[ 12 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x02, 0x00, 0x61, 0x00 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_xattr2[ 13 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x03, 0x00, 0x61, 0x62, 0x00 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_file_extent1[ 16 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_file_extent2[ 16 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_directory_record1[ 14 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x02, 0x04, 0x00, 0x00, 0x62, 0x00 };
+
+uint8_t fsapfs_test_file_system_btree_cursor_key_data_directory_record2[ 14 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x02, 0x08, 0x00, 0x00, 0x61, 0x00 };
+
+/* Tests the libfsapfs_file_system_btree_cursor_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_cursor_initialize(
+     void )
+{
+	libcerror_error_t *error                                       = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree               = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	int result                                                     = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                                = 1;
+	int number_of_memset_fail_tests                                = 1;
+	int test_number                                                = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_initialize(
+	          &file_system_btree_cursor,
+	          file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree_cursor",
+	 file_system_btree_cursor );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_free(
+	          &file_system_btree_cursor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree_cursor",
+	 file_system_btree_cursor );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_initialize(
+	          NULL,
+	          file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_initialize(
+	          &file_system_btree_cursor,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_system_btree_cursor = (libfsapfs_file_system_btree_cursor_t *) 0x12345678UL;
+
+	result = libfsapfs_file_system_btree_cursor_initialize(
+	          &file_system_btree_cursor,
+	          file_system_btree,
+	          &error );
+
+	file_system_btree_cursor = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_system_btree_cursor_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_system_btree_cursor_initialize(
+		          &file_system_btree_cursor,
+		          file_system_btree,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( file_system_btree_cursor != NULL )
+			{
+				libfsapfs_file_system_btree_cursor_free(
+				 &file_system_btree_cursor,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_system_btree_cursor",
+			 file_system_btree_cursor );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_system_btree_cursor_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_system_btree_cursor_initialize(
+		          &file_system_btree_cursor,
+		          file_system_btree,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( file_system_btree_cursor != NULL )
+			{
+				libfsapfs_file_system_btree_cursor_free(
+				 &file_system_btree_cursor,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_system_btree_cursor",
+			 file_system_btree_cursor );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_cursor_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_cursor_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_cursor_get_node function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_cursor_get_node(
+     void )
+{
+	libcerror_error_t *error                                       = NULL;
+	libfsapfs_btree_node_t *node                                   = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree               = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	int result                                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_initialize(
+	          &file_system_btree_cursor,
+	          file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree_cursor",
+	 file_system_btree_cursor );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_get_node(
+	         NULL,
+	         NULL,
+	         0,
+	         &node,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node",
+	 node );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_get_node(
+	         file_system_btree_cursor,
+	         NULL,
+	         -1,
+	         &node,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node",
+	 node );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_get_node(
+	         file_system_btree_cursor,
+	         NULL,
+	         LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH + 1,
+	         &node,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node",
+	 node );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_cursor_free(
+	          &file_system_btree_cursor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree_cursor",
+	 file_system_btree_cursor );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_cursor_read_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_cursor_read_entry(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_read_entry(
+	         NULL,
+	         NULL,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_cursor_descend and libfsapfs_file_system_btree_cursor_skip functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_cursor_descend_and_skip(
+     void )
+{
+	libcerror_error_t *error                                       = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree               = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	int result                                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_initialize(
+	          &file_system_btree_cursor,
+	          file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree_cursor",
+	 file_system_btree_cursor );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_descend(
+	         NULL,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_descend(
+	         file_system_btree_cursor,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_skip(
+	         NULL,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_skip(
+	         file_system_btree_cursor,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test descend into the sub node of a branch node entry
+	 */
+	file_system_btree_cursor->is_started            = 1;
+	file_system_btree_cursor->depth                 = 1;
+	file_system_btree_cursor->entry_indexes[ 0 ]    = 3;
+	file_system_btree_cursor->entry_is_set          = 1;
+	file_system_btree_cursor->node_level            = 1;
+	file_system_btree_cursor->sub_node_block_number = 0x1234;
+
+	result = libfsapfs_file_system_btree_cursor_descend(
+	         file_system_btree_cursor,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_system_btree_cursor->depth",
+	 file_system_btree_cursor->depth,
+	 2 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "file_system_btree_cursor->node_block_numbers[ 1 ]",
+	 file_system_btree_cursor->node_block_numbers[ 1 ],
+	 (uint64_t) 0x1234 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_system_btree_cursor->entry_indexes[ 0 ]",
+	 file_system_btree_cursor->entry_indexes[ 0 ],
+	 3 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_system_btree_cursor->entry_indexes[ 1 ]",
+	 file_system_btree_cursor->entry_indexes[ 1 ],
+	 0 );
+
+	/* Test skip of a leaf node entry
+	 */
+	file_system_btree_cursor->entry_is_set = 1;
+	file_system_btree_cursor->node_level   = 0;
+
+	result = libfsapfs_file_system_btree_cursor_descend(
+	         file_system_btree_cursor,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_skip(
+	         file_system_btree_cursor,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "file_system_btree_cursor->entry_indexes[ 1 ]",
+	 file_system_btree_cursor->entry_indexes[ 1 ],
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "file_system_btree_cursor->entry_is_set",
+	 file_system_btree_cursor->entry_is_set,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_cursor_free(
+	          &file_system_btree_cursor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree_cursor",
+	 file_system_btree_cursor );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_cursor_compare_key_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_cursor_compare_key_data(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_inode1 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_inode1 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_EQUAL );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_inode1 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_inode2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_inode2 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_xattr1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_xattr1 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_inode1 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_GREATER );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_xattr1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_xattr1 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_xattr2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_xattr2 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_xattr2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_xattr2 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_xattr1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_xattr1 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_GREATER );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The logical address of a file extent is compared as an integer
+	 */
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_file_extent1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_file_extent1 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_file_extent2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_file_extent2 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The name hash of a directory record is compared before the name
+	 */
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_directory_record1,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_directory_record1 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_directory_record2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_directory_record2 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_directory_record2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_directory_record2 ),
+	         fsapfs_test_file_system_btree_cursor_key_data_inode2,
+	         sizeof( fsapfs_test_file_system_btree_cursor_key_data_inode2 ),
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         NULL,
+	         8,
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         8,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         4,
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         8,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         8,
+	         NULL,
+	         8,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_cursor_compare_key_data(
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         8,
+	         fsapfs_test_file_system_btree_cursor_key_data_inode1,
+	         (size_t) SSIZE_MAX + 1,
+	         &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_cursor_initialize",
+	 fsapfs_test_file_system_btree_cursor_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_cursor_free",
+	 fsapfs_test_file_system_btree_cursor_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_cursor_get_node",
+	 fsapfs_test_file_system_btree_cursor_get_node );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_cursor_read_entry",
+	 fsapfs_test_file_system_btree_cursor_read_entry );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_cursor_descend_and_skip",
+	 fsapfs_test_file_system_btree_cursor_descend_and_skip );
+
+	/* TODO: add tests for libfsapfs_file_system_btree_cursor_compare_name */
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_cursor_compare_key_data",
+	 fsapfs_test_file_system_btree_cursor_compare_key_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,19 +21,29 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "fsapfs_test_functions.h"
+#include "fsapfs_test_libbfio.h"
+#include "fsapfs_test_libcdata.h"
 #include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfcache.h"
+#include "fsapfs_test_libfdata.h"
 #include "fsapfs_test_libfsapfs.h"
 #include "fsapfs_test_macros.h"
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_data_block.h"
+#include "../libfsapfs/libfsapfs_data_block_vector.h"
+#include "../libfsapfs/libfsapfs_file_extent.h"
 #include "../libfsapfs/libfsapfs_file_system_data_handle.h"
+#include "../libfsapfs/libfsapfs_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
@@ -75,6 +85,530 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_file_system_data_handle_read_data_block_run function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_data_handle_read_data_block_run(
+     void )
+{
+	uint8_t data[ 5 * 512 ];
+
+	libbfio_handle_t *file_io_handle                             = NULL;
+	libcdata_array_t *file_extents                               = NULL;
+	libcerror_error_t *error                                     = NULL;
+	libfcache_cache_t *cache                                     = NULL;
+	libfdata_vector_t *data_block_vector                         = NULL;
+	libfsapfs_data_block_t *data_block                           = NULL;
+	libfsapfs_file_extent_t *file_extent                         = NULL;
+	libfsapfs_file_system_data_handle_t *file_system_data_handle = NULL;
+	libfsapfs_io_handle_t *io_handle                             = NULL;
+	int data_block_index                                         = 0;
+	int entry_index                                              = 0;
+	int result                                                   = 0;
+
+	/* Initialize test
+	 */
+	for( data_block_index = 0;
+	     data_block_index < 5;
+	     data_block_index++ )
+	{
+		result = ( memory_set(
+		            &( data[ data_block_index * 512 ] ),
+		            'A' + data_block_index,
+		            512 ) != NULL );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->block_size       = 512;
+	io_handle->bytes_per_sector = 512;
+
+	result = libcdata_array_initialize(
+	          &file_extents,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_extents",
+	 file_extents );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_extent_initialize(
+	          &file_extent,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_extent",
+	 file_extent );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file extent consists of the 4 data blocks that follow the first block
+	 */
+	file_extent->logical_offset        = 0;
+	file_extent->physical_block_number = 1;
+	file_extent->data_size             = 4 * 512;
+
+	result = libcdata_array_append_entry(
+	          file_extents,
+	          &entry_index,
+	          (intptr_t *) file_extent,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_extent = NULL;
+
+	result = libfsapfs_file_system_data_handle_initialize(
+	          &file_system_data_handle,
+	          io_handle,
+	          NULL,
+	          file_extents,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_data_handle",
+	 file_system_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_data_block_vector_initialize(
+	          &data_block_vector,
+	          io_handle,
+	          file_system_data_handle,
+	          file_extents,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block_vector",
+	 data_block_vector );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_initialize(
+	          &cache,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize file IO handle
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          5 * 512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_data_handle_read_data_block_run(
+	          file_system_data_handle,
+	          file_io_handle,
+	          data_block_vector,
+	          cache,
+	          0,
+	          512,
+	          512,
+	          4,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data blocks of the run are expected to be cached and to share the data of the run
+	 */
+	for( data_block_index = 0;
+	     data_block_index < 4;
+	     data_block_index++ )
+	{
+		data_block = NULL;
+
+		result = libfdata_vector_get_element_value_by_index(
+		          data_block_vector,
+		          (intptr_t *) file_io_handle,
+		          (libfdata_cache_t *) cache,
+		          data_block_index,
+		          (intptr_t **) &data_block,
+		          0,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "data_block",
+		 data_block );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "data_block->data_block_run",
+		 data_block->data_block_run );
+
+		FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+		 "data_block->data_size",
+		 data_block->data_size,
+		 (size_t) 512 );
+
+		result = memory_compare(
+		          data_block->data,
+		          &( data[ ( data_block_index + 1 ) * 512 ] ),
+		          512 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_data_handle_read_data_block_run(
+	          NULL,
+	          file_io_handle,
+	          data_block_vector,
+	          cache,
+	          0,
+	          512,
+	          512,
+	          4,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_data_handle_read_data_block_run(
+	          file_system_data_handle,
+	          file_io_handle,
+	          data_block_vector,
+	          cache,
+	          0,
+	          512,
+	          0,
+	          4,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_data_handle_read_data_block_run(
+	          file_system_data_handle,
+	          file_io_handle,
+	          data_block_vector,
+	          cache,
+	          0,
+	          512,
+	          512,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test reading beyond the end of the data
+	 */
+	result = libfsapfs_file_system_data_handle_read_data_block_run(
+	          file_system_data_handle,
+	          file_io_handle,
+	          data_block_vector,
+	          cache,
+	          0,
+	          512,
+	          512,
+	          5,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO handle
+	 */
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_free(
+	          &data_block_vector,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block_vector",
+	 data_block_vector );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_data_handle_free(
+	          &file_system_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_data_handle",
+	 file_system_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &file_extents,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_extents",
+	 file_extents );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( data_block_vector != NULL )
+	{
+		libfdata_vector_free(
+		 &data_block_vector,
+		 NULL );
+	}
+	if( file_system_data_handle != NULL )
+	{
+		libfsapfs_file_system_data_handle_free(
+		 &file_system_data_handle,
+		 NULL );
+	}
+	if( file_extent != NULL )
+	{
+		libfsapfs_file_extent_free(
+		 &file_extent,
+		 NULL );
+	}
+	if( file_extents != NULL )
+	{
+		libcdata_array_free(
+		 &file_extents,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -100,6 +634,10 @@ int main(
 	 "libfsapfs_file_system_data_handle_free",
 	 fsapfs_test_file_system_data_handle_free );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_data_handle_read_data_block_run",
+	 fsapfs_test_file_system_data_handle_read_data_block_run );
+
 	/* TODO: add tests for libfsapfs_file_system_data_handle_read_data_block */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
@@ -34,6 +34,7 @@
 #include "fsapfs_test_unused.h"
 
 #include "../libfsapfs/libfsapfs_io_handle.h"
+#include "../libfsapfs/libfsapfs_object_map_descriptor_cache.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
@@ -398,6 +399,566 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_io_handle_get_maximum_cache_size and libfsapfs_io_handle_set_maximum_cache_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_handle_maximum_cache_size(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfsapfs_io_handle_t *io_handle = NULL;
+	size64_t maximum_cache_size      = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_io_handle_set_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          1024 * 1024,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->maximum_number_of_cached_data_blocks",
+	 io_handle->maximum_number_of_cached_data_blocks,
+	 256 );
+
+	result = libfsapfs_io_handle_get_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          &maximum_cache_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 maximum_cache_size,
+	 (uint64_t) 1024 * 1024 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The compressed block cache uses entries of the compressed block size
+	 */
+	result = libfsapfs_io_handle_set_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_COMPRESSED_BLOCKS,
+	          1024 * 1024,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->maximum_number_of_cached_compressed_blocks",
+	 io_handle->maximum_number_of_cached_compressed_blocks,
+	 16 );
+
+	result = libfsapfs_io_handle_get_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_COMPRESSED_BLOCKS,
+	          &maximum_cache_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 maximum_cache_size,
+	 (uint64_t) 1024 * 1024 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The object map descriptor cache uses entries of the cache entry size
+	 */
+	result = libfsapfs_io_handle_set_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_OBJECT_MAP_DESCRIPTORS,
+	          1024 * sizeof( libfsapfs_object_map_descriptor_cache_entry_t ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->maximum_number_of_cached_object_map_descriptors",
+	 io_handle->maximum_number_of_cached_object_map_descriptors,
+	 1024 );
+
+	/* A cache contains at least 1 entry
+	 */
+	result = libfsapfs_io_handle_set_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->maximum_number_of_cached_btree_nodes",
+	 io_handle->maximum_number_of_cached_btree_nodes,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_handle_set_maximum_cache_size(
+	          NULL,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          1024 * 1024,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_set_maximum_cache_size(
+	          io_handle,
+	          -1,
+	          1024 * 1024,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_get_maximum_cache_size(
+	          NULL,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          &maximum_cache_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_get_maximum_cache_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_io_handle_reserve_cached_data_blocks and libfsapfs_io_handle_release_cached_data_blocks functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_handle_cached_data_blocks(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfsapfs_io_handle_t *io_handle = NULL;
+	int number_of_data_blocks        = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->maximum_number_of_cached_data_blocks = 24;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          io_handle,
+	          16,
+	          1,
+	          &number_of_data_blocks,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_data_blocks",
+	 number_of_data_blocks,
+	 16 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The reservation is limited by the entries still available
+	 */
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          io_handle,
+	          16,
+	          1,
+	          &number_of_data_blocks,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_data_blocks",
+	 number_of_data_blocks,
+	 8 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The minimum number of entries is always reserved
+	 */
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          io_handle,
+	          16,
+	          1,
+	          &number_of_data_blocks,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_data_blocks",
+	 number_of_data_blocks,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->number_of_cached_data_blocks",
+	 io_handle->number_of_cached_data_blocks,
+	 25 );
+
+	result = libfsapfs_io_handle_release_cached_data_blocks(
+	          io_handle,
+	          9,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->number_of_cached_data_blocks",
+	 io_handle->number_of_cached_data_blocks,
+	 16 );
+
+	result = libfsapfs_io_handle_release_cached_data_blocks(
+	          io_handle,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->number_of_cached_data_blocks",
+	 io_handle->number_of_cached_data_blocks,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          NULL,
+	          16,
+	          1,
+	          &number_of_data_blocks,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          io_handle,
+	          -1,
+	          0,
+	          &number_of_data_blocks,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          io_handle,
+	          1,
+	          16,
+	          &number_of_data_blocks,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_reserve_cached_data_blocks(
+	          io_handle,
+	          16,
+	          1,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_release_cached_data_blocks(
+	          NULL,
+	          1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_release_cached_data_blocks(
+	          io_handle,
+	          -1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -429,6 +990,14 @@ int main(
 	 "libfsapfs_io_handle_clear",
 	 fsapfs_test_io_handle_clear );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_handle_maximum_cache_size",
+	 fsapfs_test_io_handle_maximum_cache_size );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_handle_cached_data_blocks",
+	 fsapfs_test_io_handle_cached_data_blocks );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
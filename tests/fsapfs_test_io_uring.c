@@ -0,0 +1,1038 @@
+/*
+ * Library io_uring functions test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_functions.h"
+#include "fsapfs_test_libbfio.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_io_uring.h"
+
+uint8_t fsapfs_test_io_uring_data1[ 16 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_io_uring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_uring_initialize(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libfsapfs_io_uring_t *io_uring = NULL;
+	int result                     = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_uring_initialize(
+	          NULL,
+	          "test",
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_uring = (libfsapfs_io_uring_t *) 0x12345678UL;
+
+	result = libfsapfs_io_uring_initialize(
+	          &io_uring,
+	          "test",
+	          8,
+	          &error );
+
+	io_uring = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_uring_initialize(
+	          &io_uring,
+	          NULL,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_uring_initialize(
+	          &io_uring,
+	          "test",
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_uring_initialize(
+	          &io_uring,
+	          "test",
+	          LIBFSAPFS_MAXIMUM_IO_URING_QUEUE_DEPTH + 1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libfsapfs_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_io_uring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_uring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_uring_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_io_uring_read_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_uring_read_buffers(
+     void )
+{
+	libfsapfs_io_uring_read_t reads[ 3 ];
+
+	uint8_t buffer[ 12 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_io_uring_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases without an io_uring
+	 */
+	reads[ 0 ].buffer      = &( buffer[ 0 ] );
+	reads[ 0 ].buffer_size = 4;
+	reads[ 0 ].file_offset = 12;
+	reads[ 1 ].buffer      = &( buffer[ 4 ] );
+	reads[ 1 ].buffer_size = 4;
+	reads[ 1 ].file_offset = 0;
+	reads[ 2 ].buffer      = &( buffer[ 8 ] );
+	reads[ 2 ].buffer_size = 4;
+	reads[ 2 ].file_offset = 6;
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "reads[ 2 ].read_count",
+	 reads[ 2 ].read_count,
+	 (size_t) 4 );
+
+	result = memory_compare(
+	          buffer,
+	          &( fsapfs_test_io_uring_data1[ 12 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          &( buffer[ 4 ] ),
+	          &( fsapfs_test_io_uring_data1[ 0 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          &( buffer[ 8 ] ),
+	          &( fsapfs_test_io_uring_data1[ 6 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          NULL,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          -1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reads[ 1 ].buffer = NULL;
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          3,
+	          &error );
+
+	reads[ 1 ].buffer = &( buffer[ 4 ] );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reads[ 1 ].buffer_size = 0;
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          3,
+	          &error );
+
+	reads[ 1 ].buffer_size = 4;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reads[ 1 ].file_offset = -1;
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          3,
+	          &error );
+
+	reads[ 1 ].file_offset = 0;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test reading beyond the end of the data
+	 */
+	reads[ 2 ].file_offset = 14;
+
+	result = libfsapfs_io_uring_read_buffers(
+	          NULL,
+	          file_io_handle,
+	          reads,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+
+/* Creates a temporary file that contains test data
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_io_uring_create_temporary_file(
+     char *filename,
+     uint8_t *data,
+     size_t data_size )
+{
+	size_t data_offset  = 0;
+	ssize_t write_count = 0;
+	int file_descriptor = 0;
+
+	file_descriptor = mkstemp(
+	                   filename );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		write_count = write(
+		               file_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset );
+
+		if( write_count <= 0 )
+		{
+			close(
+			 file_descriptor );
+
+			unlink(
+			 filename );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		unlink(
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libfsapfs_io_uring_submit_reads function
+ * The test is skipped if the kernel does not support io_uring
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_uring_submit_reads(
+     void )
+{
+	libfsapfs_io_uring_read_t reads[ 6 ];
+
+	char filename[ 32 ]              = "/tmp/fsapfs_test_XXXXXX";
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libfsapfs_io_uring_t *io_uring   = NULL;
+	uint8_t *buffer                  = NULL;
+	uint8_t *data                    = NULL;
+	size_t data_offset               = 0;
+	int file_created                 = 0;
+	int read_index                   = 0;
+	int result                       = 0;
+	int ring_descriptor              = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 65536 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_offset = 0;
+	     data_offset < 65536;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + ( data_offset >> 8 ) );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * 6 * 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	result = fsapfs_test_io_uring_create_temporary_file(
+	          filename,
+	          data,
+	          65536 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_created = 1;
+
+	/* A queue depth of 2 is used so that more reads are pending than can be in flight
+	 */
+	result = libfsapfs_io_uring_initialize(
+	          &io_uring,
+	          filename,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		/* The kernel does not support io_uring or its use is not permitted
+		 */
+		goto on_skip;
+	}
+	/* Test submission and completion of more reads than the queue depth
+	 */
+	for( read_index = 0;
+	     read_index < 6;
+	     read_index++ )
+	{
+		reads[ read_index ].buffer      = &( buffer[ read_index * 4096 ] );
+		reads[ read_index ].buffer_size = 4096;
+		reads[ read_index ].file_offset = (off64_t) ( ( ( 5 - read_index ) * 8192 ) + 100 );
+		reads[ read_index ].read_count  = 0;
+	}
+	result = libfsapfs_io_uring_submit_reads(
+	          io_uring,
+	          reads,
+	          6,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_index = 0;
+	     read_index < 6;
+	     read_index++ )
+	{
+		FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+		 "reads[ read_index ].read_count",
+		 reads[ read_index ].read_count,
+		 (size_t) 4096 );
+
+		result = memory_compare(
+		          reads[ read_index ].buffer,
+		          &( data[ reads[ read_index ].file_offset ] ),
+		          4096 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test that a read continues at its read count, as it does after a short read
+	 */
+	result = memory_set(
+	          buffer,
+	          0xff,
+	          4096 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	reads[ 0 ].file_offset = 0;
+	reads[ 0 ].read_count  = 1000;
+	reads[ 1 ].file_offset = 4096;
+	reads[ 1 ].read_count  = 0;
+
+	result = libfsapfs_io_uring_submit_reads(
+	          io_uring,
+	          reads,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "reads[ 0 ].read_count",
+	 reads[ 0 ].read_count,
+	 (size_t) 4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 999 ]",
+	 buffer[ 999 ],
+	 (uint8_t) 0xff );
+
+	result = memory_compare(
+	          &( buffer[ 1000 ] ),
+	          &( data[ 1000 ] ),
+	          4096 - 1000 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a short read at the end of the file, which is submitted again
+	 * for the remaining data and then fails since the file has no more data
+	 */
+	reads[ 0 ].buffer_size = 8192;
+	reads[ 0 ].file_offset = 65536 - 4096;
+	reads[ 0 ].read_count  = 0;
+	reads[ 1 ].buffer      = &( buffer[ 8192 ] );
+	reads[ 1 ].file_offset = 0;
+	reads[ 1 ].read_count  = 0;
+
+	result = libfsapfs_io_uring_submit_reads(
+	          io_uring,
+	          reads,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "reads[ 0 ].read_count",
+	 reads[ 0 ].read_count,
+	 (size_t) 4096 );
+
+	/* The other read in flight was waited for
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "reads[ 1 ].read_count",
+	 reads[ 1 ].read_count,
+	 (size_t) 4096 );
+
+	reads[ 0 ].buffer_size = 4096;
+	reads[ 1 ].buffer      = &( buffer[ 4096 ] );
+
+	/* Test that failed reads in flight are drained from the ring
+	 */
+	io_uring->file_descriptor += 1000;
+
+	for( read_index = 0;
+	     read_index < 6;
+	     read_index++ )
+	{
+		reads[ read_index ].read_count = 0;
+	}
+	result = libfsapfs_io_uring_submit_reads(
+	          io_uring,
+	          reads,
+	          6,
+	          &error );
+
+	io_uring->file_descriptor -= 1000;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "completion_queue_head",
+	 *( io_uring->completion_queue_head ),
+	 *( io_uring->completion_queue_tail ) );
+
+	/* Test that entries are taken back when they cannot be submitted
+	 */
+	ring_descriptor = io_uring->ring_descriptor;
+
+	io_uring->ring_descriptor = io_uring->file_descriptor;
+
+	result = libfsapfs_io_uring_submit_reads(
+	          io_uring,
+	          reads,
+	          6,
+	          &error );
+
+	io_uring->ring_descriptor = ring_descriptor;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "submission_queue_tail",
+	 *( io_uring->submission_queue_tail ),
+	 *( io_uring->submission_queue_head ) );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "io_uring->is_unusable",
+	 io_uring->is_unusable,
+	 (uint8_t) 0 );
+
+	/* The ring is usable after the errors
+	 */
+	for( read_index = 0;
+	     read_index < 6;
+	     read_index++ )
+	{
+		reads[ read_index ].read_count = 0;
+	}
+	result = libfsapfs_io_uring_submit_reads(
+	          io_uring,
+	          reads,
+	          6,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_index = 0;
+	     read_index < 6;
+	     read_index++ )
+	{
+		result = memory_compare(
+		          reads[ read_index ].buffer,
+		          &( data[ reads[ read_index ].file_offset ] ),
+		          4096 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test that an unusable ring falls back to the file IO handle
+	 */
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_io_uring_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_uring->is_unusable = 1;
+
+	reads[ 0 ].buffer_size = 4;
+	reads[ 0 ].file_offset = 12;
+	reads[ 1 ].buffer_size = 4;
+	reads[ 1 ].file_offset = 0;
+
+	result = libfsapfs_io_uring_read_buffers(
+	          io_uring,
+	          file_io_handle,
+	          reads,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          reads[ 0 ].buffer,
+	          &( fsapfs_test_io_uring_data1[ 12 ] ),
+	          4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+on_skip:
+	unlink(
+	 filename );
+
+	memory_free(
+	 buffer );
+
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_uring != NULL )
+	{
+		libfsapfs_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	if( file_created != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_IO_URING ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_uring_initialize",
+	 fsapfs_test_io_uring_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_uring_free",
+	 fsapfs_test_io_uring_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_uring_read_buffers",
+	 fsapfs_test_io_uring_read_buffers );
+
+#if defined( HAVE_LIBFSAPFS_IO_URING )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_uring_submit_reads",
+	 fsapfs_test_io_uring_submit_reads );
+
+#endif
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,418 @@
+/*
+ * Library LZFSE decompression testing program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libcnotify.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_unused.h"
+#include "../libfsapfs/libfsapfs_lzfse.h"
+
+/* Define to make fsapfs_test_lzfse generate verbose output
+#define FSAPFS_TEST_LZFSE
+ */
+
+/* Compressed block (v2) with the string "My compressed file\n" repeated 3 times
+ */
+uint8_t fsapfs_test_lzfse_compressed_byte_stream[ 184 ] = {
+	0x62, 0x76, 0x78, 0x32, 0x39, 0x00, 0x00, 0x00, 0x14, 0x00, 0x30, 0x01, 0x00, 0x01, 0x00, 0x10,
+	0xd0, 0x3c, 0x0f, 0x87, 0x41, 0x0a, 0x00, 0x00, 0x97, 0x00, 0x00, 0x00, 0x1d, 0xf8, 0xb0, 0x0d,
+	0x00, 0x00, 0x00, 0x00, 0x8f, 0x02, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xa3, 0x00, 0x00, 0x00, 0x3c,
+	0x3a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x1b,
+	0x00, 0x00, 0xf0, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x06, 0xbf,
+	0xc1, 0x17, 0xf2, 0x1b, 0xc0, 0x6f, 0x00, 0xbf, 0xc1, 0x6f, 0xc0, 0x6f, 0xf0, 0x1b, 0xf0, 0x1b,
+	0xbc, 0x13, 0x00, 0xfc, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb8,
+	0xeb, 0x07, 0x06, 0xd5, 0x0a, 0x86, 0x75, 0xcd, 0x24, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xbb, 0x01, 0x62, 0x76, 0x78, 0x24 };
+
+uint8_t fsapfs_test_lzfse_uncompressed_byte_stream[ 57 ] = {
+	0x4d, 0x79, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x66, 0x69,
+	0x6c, 0x65, 0x0a, 0x4d, 0x79, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64,
+	0x20, 0x66, 0x69, 0x6c, 0x65, 0x0a, 0x4d, 0x79, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73,
+	0x73, 0x65, 0x64, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x0a };
+
+/* Uncompressed block with the string "abcde" followed by a LZVN compressed block
+ */
+uint8_t fsapfs_test_lzfse_lzvn_compressed_byte_stream[ 58 ] = {
+	0x62, 0x76, 0x78, 0x2d, 0x05, 0x00, 0x00, 0x00, 0x61, 0x62, 0x63, 0x64, 0x65, 0x62, 0x76, 0x78,
+	0x6e, 0x13, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x00, 0x00, 0xe0, 0x03, 0x4d, 0x79, 0x20, 0x63, 0x6f,
+	0x6d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x0a, 0x06, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x76, 0x78, 0x24 };
+
+uint8_t fsapfs_test_lzfse_lzvn_uncompressed_byte_stream[ 24 ] = {
+	0x61, 0x62, 0x63, 0x64, 0x65, 0x4d, 0x79, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73, 0x73,
+	0x65, 0x64, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x0a };
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_lzfse_decompress function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_lzfse_decompress(
+     void )
+{
+	uint8_t uncompressed_data[ 128 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 128;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          184,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 57 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          fsapfs_test_lzfse_uncompressed_byte_stream,
+	          57 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test decompression without slack in the uncompressed data
+	 */
+	uncompressed_data_size = 57;
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          184,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 57 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          fsapfs_test_lzfse_uncompressed_byte_stream,
+	          57 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_lzfse_decompress(
+	          NULL,
+	          184,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          (size_t) SSIZE_MAX + 1,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          184,
+	          NULL,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          184,
+	          uncompressed_data,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the uncompressed data is too small
+	 */
+	uncompressed_data_size = 48;
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          184,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the compressed data is truncated
+	 */
+	uncompressed_data_size = 128;
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_compressed_byte_stream,
+	          100,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_lzfse_decompress function with uncompressed and LZVN compressed blocks
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_lzfse_decompress_lzvn_blocks(
+     void )
+{
+	uint8_t uncompressed_data[ 64 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 64;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_lzvn_compressed_byte_stream,
+	          58,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 24 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          fsapfs_test_lzfse_lzvn_uncompressed_byte_stream,
+	          24 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error case where the uncompressed data is too small
+	 */
+	uncompressed_data_size = 16;
+
+	result = libfsapfs_lzfse_decompress(
+	          fsapfs_test_lzfse_lzvn_compressed_byte_stream,
+	          58,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( FSAPFS_TEST_LZFSE )
+	libcnotify_verbose_set(
+	 1 );
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_lzfse_decompress",
+	 fsapfs_test_lzfse_decompress );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_lzfse_decompress",
+	 fsapfs_test_lzfse_decompress_lzvn_blocks );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+}
+
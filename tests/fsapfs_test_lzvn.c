@@ -48,6 +48,18 @@ uint8_t fsapfs_test_lzvn_uncompressed_byte_stream[ 19 ] = {
 	0x4d, 0x79, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x66, 0x69,
 	0x6c, 0x65, 0x0a };
 
+/* Literal "abc" followed by overlapping matches with a distance of 3 and 1
+ */
+uint8_t fsapfs_test_lzvn_overlapping_compressed_byte_stream[ 20 ] = {
+	0xe3, 0x61, 0x62, 0x63, 0x38, 0x03, 0xf0, 0x18, 0xe1, 0x78, 0x38, 0x01, 0x06, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00 };
+
+uint8_t fsapfs_test_lzvn_overlapping_uncompressed_byte_stream[ 64 ] = {
+	0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61,
+	0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62,
+	0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63,
+	0x61, 0x62, 0x63, 0x61, 0x62, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78 };
+
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
 /* Tests the libfsapfs_lzvn_decompress function
@@ -186,6 +198,122 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_lzvn_decompress function with overlapping matches
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_lzvn_decompress_overlapping_matches(
+     void )
+{
+	uint8_t uncompressed_data[ 128 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 0;
+	int result                    = 0;
+
+	/* Test regular cases with slack in the uncompressed data
+	 */
+	uncompressed_data_size = 128;
+
+	result = libfsapfs_lzvn_decompress(
+	          fsapfs_test_lzvn_overlapping_compressed_byte_stream,
+	          20,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 64 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          fsapfs_test_lzvn_overlapping_uncompressed_byte_stream,
+	          64 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases without slack in the uncompressed data
+	 */
+	uncompressed_data_size = 64;
+
+	result = libfsapfs_lzvn_decompress(
+	          fsapfs_test_lzvn_overlapping_compressed_byte_stream,
+	          20,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 64 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          fsapfs_test_lzvn_overlapping_uncompressed_byte_stream,
+	          64 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	uncompressed_data_size = 48;
+
+	result = libfsapfs_lzvn_decompress(
+	          fsapfs_test_lzvn_overlapping_compressed_byte_stream,
+	          20,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -217,6 +345,10 @@ int main(
 	 "libfsapfs_lzvn_decompress",
 	 fsapfs_test_lzvn_decompress );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_lzvn_decompress",
+	 fsapfs_test_lzvn_decompress_overlapping_matches );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
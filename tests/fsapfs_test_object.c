@@ -34,6 +34,7 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_checksum.h"
 #include "../libfsapfs/libfsapfs_object.h"
 
 uint8_t fsapfs_test_object_data1[ 32 ] = {
@@ -666,6 +667,152 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_object_verify_checksum function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_verify_checksum(
+     void )
+{
+	uint8_t data[ 4096 ];
+
+	libcerror_error_t *error = NULL;
+	uint64_t checksum        = 0;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 8;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset * 7 );
+	}
+	result = libfsapfs_checksum_calculate_fletcher64(
+	          &checksum,
+	          &( data[ 8 ] ),
+	          4096 - 8,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 8;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( checksum >> ( data_offset * 8 ) );
+	}
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_verify_checksum(
+	          data,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_verify_checksum(
+	          NULL,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_verify_checksum(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_verify_checksum(
+	          data,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the data is corrupted
+	 */
+	data[ 2048 ] ^= 0x01;
+
+	result = libfsapfs_object_verify_checksum(
+	          data,
+	          4096,
+	          &error );
+
+	data[ 2048 ] ^= 0x01;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -701,6 +848,10 @@ int main(
 	 "libfsapfs_object_read_data",
 	 fsapfs_test_object_read_data );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_verify_checksum",
+	 fsapfs_test_object_verify_checksum );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,950 @@
+/*
+ * Library object_map_descriptor_cache type test program
+ *
+ * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_object_map_descriptor_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_object_map_descriptor_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_descriptor_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                                  = NULL;
+	libfsapfs_object_map_descriptor_cache_t *descriptor_cache = NULL;
+	int result                                                = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                           = 2;
+	int number_of_memset_fail_tests                           = 2;
+	int test_number                                           = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_initialize(
+	          &descriptor_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_cache",
+	 descriptor_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_descriptor_cache_free(
+	          &descriptor_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "descriptor_cache",
+	 descriptor_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	descriptor_cache = (libfsapfs_object_map_descriptor_cache_t *) 0x12345678UL;
+
+	result = libfsapfs_object_map_descriptor_cache_initialize(
+	          &descriptor_cache,
+	          4,
+	          &error );
+
+	descriptor_cache = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_initialize(
+	          &descriptor_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_object_map_descriptor_cache_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_object_map_descriptor_cache_initialize(
+		          &descriptor_cache,
+		          4,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( descriptor_cache != NULL )
+			{
+				libfsapfs_object_map_descriptor_cache_free(
+				 &descriptor_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "descriptor_cache",
+			 descriptor_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_object_map_descriptor_cache_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_object_map_descriptor_cache_initialize(
+		          &descriptor_cache,
+		          4,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( descriptor_cache != NULL )
+			{
+				libfsapfs_object_map_descriptor_cache_free(
+				 &descriptor_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "descriptor_cache",
+			 descriptor_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_cache != NULL )
+	{
+		libfsapfs_object_map_descriptor_cache_free(
+		 &descriptor_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_descriptor_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_descriptor_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_descriptor_cache_get_descriptor and libfsapfs_object_map_descriptor_cache_set_descriptor functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_descriptor_cache_get_and_set_descriptor(
+     void )
+{
+	libfsapfs_object_map_descriptor_t descriptor;
+
+	libcerror_error_t *error                                  = NULL;
+	libfsapfs_object_map_descriptor_cache_t *descriptor_cache = NULL;
+	uint64_t number_of_hits                                   = 0;
+	uint64_t number_of_misses                                 = 0;
+	uint64_t object_identifier                                = 0;
+	int result                                                = 0;
+
+	/* Initialize test
+	 */
+	result = memory_set(
+	          &descriptor,
+	          0,
+	          sizeof( libfsapfs_object_map_descriptor_t ) ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A cache of 4 entries consists of a single set
+	 */
+	result = libfsapfs_object_map_descriptor_cache_initialize(
+	          &descriptor_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_cache",
+	 descriptor_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	descriptor.identifier       = 1024;
+	descriptor.physical_address = 0x2000;
+
+	result = libfsapfs_object_map_descriptor_cache_set_descriptor(
+	          descriptor_cache,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	descriptor.physical_address = 0;
+
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "descriptor.identifier",
+	 descriptor.identifier,
+	 (uint64_t) 1024 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "descriptor.physical_address",
+	 descriptor.physical_address,
+	 (uint64_t) 0x2000 );
+
+	/* The descriptor is not available for another lookup transaction identifier
+	 */
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          5,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Fill the set and make the entry of object identifier 1024 the most recently used
+	 */
+	for( object_identifier = 1025;
+	     object_identifier < 1028;
+	     object_identifier++ )
+	{
+		descriptor.identifier       = object_identifier;
+		descriptor.physical_address = object_identifier * 2;
+
+		result = libfsapfs_object_map_descriptor_cache_set_descriptor(
+		          descriptor_cache,
+		          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+		          &descriptor,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The least recently used entry, of object identifier 1025, is replaced
+	 */
+	descriptor.identifier       = 1028;
+	descriptor.physical_address = 0x3000;
+
+	result = libfsapfs_object_map_descriptor_cache_set_descriptor(
+	          descriptor_cache,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1025,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1028,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "descriptor.physical_address",
+	 descriptor.physical_address,
+	 (uint64_t) 0x3000 );
+
+	result = libfsapfs_object_map_descriptor_cache_get_statistics(
+	          descriptor_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 4 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 3 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          NULL,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_set_descriptor(
+	          NULL,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_set_descriptor(
+	          descriptor_cache,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_statistics(
+	          descriptor_cache,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_get_statistics(
+	          descriptor_cache,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_object_map_descriptor_cache_free(
+	          &descriptor_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "descriptor_cache",
+	 descriptor_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_cache != NULL )
+	{
+		libfsapfs_object_map_descriptor_cache_free(
+		 &descriptor_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_descriptor_cache_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_descriptor_cache_resize(
+     void )
+{
+	libfsapfs_object_map_descriptor_t descriptor;
+
+	libcerror_error_t *error                                  = NULL;
+	libfsapfs_object_map_descriptor_cache_t *descriptor_cache = NULL;
+	int result                                                = 0;
+
+	/* Initialize test
+	 */
+	result = memory_set(
+	          &descriptor,
+	          0,
+	          sizeof( libfsapfs_object_map_descriptor_t ) ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsapfs_object_map_descriptor_cache_initialize(
+	          &descriptor_cache,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_cache",
+	 descriptor_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "descriptor_cache->number_of_sets",
+	 descriptor_cache->number_of_sets,
+	 1 );
+
+	descriptor.identifier       = 1024;
+	descriptor.physical_address = 0x2000;
+
+	result = libfsapfs_object_map_descriptor_cache_set_descriptor(
+	          descriptor_cache,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_resize(
+	          descriptor_cache,
+	          100,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The number of sets is rounded down to a power of 2
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "descriptor_cache->number_of_sets",
+	 descriptor_cache->number_of_sets,
+	 16 );
+
+	/* The cached entries are discarded
+	 */
+	result = libfsapfs_object_map_descriptor_cache_get_descriptor(
+	          descriptor_cache,
+	          1024,
+	          LIBFSAPFS_MAXIMUM_TRANSACTION_IDENTIFIER,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_descriptor_cache_resize(
+	          NULL,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_descriptor_cache_resize(
+	          descriptor_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_object_map_descriptor_cache_free(
+	          &descriptor_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "descriptor_cache",
+	 descriptor_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_cache != NULL )
+	{
+		libfsapfs_object_map_descriptor_cache_free(
+		 &descriptor_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_descriptor_cache_initialize",
+	 fsapfs_test_object_map_descriptor_cache_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_descriptor_cache_free",
+	 fsapfs_test_object_map_descriptor_cache_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_descriptor_cache_resize",
+	 fsapfs_test_object_map_descriptor_cache_resize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_descriptor_cache_get_and_set_descriptor",
+	 fsapfs_test_object_map_descriptor_cache_get_and_set_descriptor );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -35,6 +35,9 @@
 
 #include "../libfsapfs/libfsapfs_snapshot_metadata.h"
 
+uint8_t fsapfs_test_snapshot_metadata_btree_key_data1[ 8 ] = {
+	0xd2, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10 };
+
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
 /* Tests the libfsapfs_snapshot_metadata_initialize function
@@ -270,6 +273,149 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_snapshot_metadata_read_key_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_snapshot_metadata_read_key_data(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfsapfs_snapshot_metadata_t *snapshot_metadata = NULL;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_snapshot_metadata_initialize(
+	          &snapshot_metadata,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "snapshot_metadata",
+	 snapshot_metadata );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_snapshot_metadata_read_key_data(
+	          snapshot_metadata,
+	          fsapfs_test_snapshot_metadata_btree_key_data1,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "snapshot_metadata->transaction_identifier",
+	 snapshot_metadata->transaction_identifier,
+	 (uint64_t) 0x1d2 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_snapshot_metadata_read_key_data(
+	          NULL,
+	          fsapfs_test_snapshot_metadata_btree_key_data1,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_snapshot_metadata_read_key_data(
+	          snapshot_metadata,
+	          NULL,
+	          8,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_snapshot_metadata_read_key_data(
+	          snapshot_metadata,
+	          fsapfs_test_snapshot_metadata_btree_key_data1,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_snapshot_metadata_free(
+	          &snapshot_metadata,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "snapshot_metadata",
+	 snapshot_metadata );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( snapshot_metadata != NULL )
+	{
+		libfsapfs_snapshot_metadata_free(
+		 &snapshot_metadata,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libfsapfs_snapshot_metadata_get_utf8_name_size function
  * Returns 1 if successful or 0 if not
  */
@@ -857,7 +1003,9 @@ int main(
 	 "libfsapfs_snapshot_metadata_free",
 	 fsapfs_test_snapshot_metadata_free );
 
-	/* TODO: add tests for libfsapfs_snapshot_metadata_read_key_data */
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_snapshot_metadata_read_key_data",
+	 fsapfs_test_snapshot_metadata_read_key_data );
 
 	/* TODO: add tests for libfsapfs_snapshot_metadata_read_value_data */
 
@@ -39,7 +39,9 @@
 #include "fsapfs_test_macros.h"
 #include "fsapfs_test_memory.h"
 
+#include "../libfsapfs/libfsapfs_io_handle.h"
 #include "../libfsapfs/libfsapfs_volume.h"
+#include "../libfsapfs/libfsapfs_volume_superblock.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -58,6 +60,8 @@ int libfsapfs_check_volume_signature_file_io_handle(
 
 #endif /* !defined( LIBFSAPFS_HAVE_BFIO ) */
 
+uint8_t fsapfs_test_volume_data1[ 4096 ];
+
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
 /* Tests the libfsapfs_volume_initialize function
@@ -280,21 +284,120 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
-
-/* Tests the libfsapfs_volume_free function
+/* Tests the libfsapfs_internal_volume_read_snapshots function
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_volume_free(
+int fsapfs_test_internal_volume_read_snapshots(
      void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libbfio_handle_t *file_io_handle             = NULL;
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	libfsapfs_io_handle_t *io_handle             = NULL;
+	libfsapfs_volume_t *volume                   = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_volume_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_volume_initialize(
+	          &volume,
+	          io_handle,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	/* The volume superblock has no snapshot metadata tree
+	 */
+	result = libfsapfs_volume_superblock_initialize(
+	          &( internal_volume->superblock ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_internal_volume_read_snapshots(
+	          internal_volume,
+	          file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "internal_volume->snapshots_read",
+	 internal_volume->snapshots_read,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libfsapfs_volume_free(
+	result = libfsapfs_internal_volume_read_snapshots(
 	          NULL,
+	          file_io_handle,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -309,6 +412,76 @@ int fsapfs_test_volume_free(
 	libcerror_error_free(
 	 &error );
 
+	internal_volume->snapshot_metadata_tree = (libfsapfs_snapshot_metadata_tree_t *) 0x12345678UL;
+
+	result = libfsapfs_internal_volume_read_snapshots(
+	          internal_volume,
+	          file_io_handle,
+	          &error );
+
+	internal_volume->snapshot_metadata_tree = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_volume_free(
+	          &volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -317,96 +490,917 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libfsapfs_internal_volume_grab_snapshots_for_read function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc,
-     wchar_t * const argv[] )
-#else
-int main(
-     int argc,
-     char * const argv[] )
-#endif
+int fsapfs_test_internal_volume_grab_snapshots_for_read(
+     void )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libcerror_error_t *error            = NULL;
-	libfsapfs_volume_t *volume          = NULL;
-	system_character_t *option_offset   = NULL;
-	system_character_t *option_password = NULL;
-	system_character_t *source          = NULL;
-	system_integer_t option             = 0;
-	size_t string_length                = 0;
-	off64_t volume_offset               = 0;
-	int result                          = 0;
+	libbfio_handle_t *file_io_handle             = NULL;
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	libfsapfs_io_handle_t *io_handle             = NULL;
+	libfsapfs_volume_t *volume                   = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
 
-	while( ( option = fsapfs_test_getopt(
-	                   argc,
-	                   argv,
-	                   _SYSTEM_STRING( "o:p:" ) ) ) != (system_integer_t) -1 )
-	{
-		switch( option )
-		{
-			case (system_integer_t) '?':
-			default:
-				fprintf(
-				 stderr,
-				 "Invalid argument: %" PRIs_SYSTEM ".\n",
-				 argv[ optind - 1 ] );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-				return( EXIT_FAILURE );
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
 
-			case (system_integer_t) 'o':
-				option_offset = optarg;
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-				break;
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_volume_data1,
+	          4096,
+	          &error );
 
-			case (system_integer_t) 'p':
-				option_password = optarg;
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-				break;
-		}
-	}
-	if( optind < argc )
-	{
-		source = argv[ optind ];
-	}
-	if( option_offset != NULL )
-	{
-		string_length = system_string_length(
-		                 option_offset );
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
 
-		result = fsapfs_test_system_string_copy_from_64_bit_in_decimal(
-		          option_offset,
-		          string_length + 1,
-		          (uint64_t *) &volume_offset,
-		          &error );
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		FSAPFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	result = libfsapfs_volume_initialize(
+	          &volume,
+	          io_handle,
+	          file_io_handle,
+	          NULL,
+	          &error );
 
-	        FSAPFS_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
-	}
-#if defined( HAVE_DEBUG_OUTPUT ) && defined( FSAPFS_TEST_VOLUME_VERBOSE )
-	libfsapfs_notify_set_verbose(
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
 	 1 );
-	libfsapfs_notify_set_stream(
-	 stderr,
-	 NULL );
-#endif
 
-#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
 
-	FSAPFS_TEST_RUN(
-	 "libfsapfs_volume_initialize",
-	 fsapfs_test_volume_initialize );
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	/* The volume superblock has no snapshot metadata tree
+	 */
+	result = libfsapfs_volume_superblock_initialize(
+	          &( internal_volume->superblock ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The snapshots of a volume that was opened lazily are read on first use
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "internal_volume->snapshots_read",
+	 internal_volume->snapshots_read,
+	 0 );
+
+	result = libfsapfs_internal_volume_grab_snapshots_for_read(
+	          internal_volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "internal_volume->snapshots_read",
+	 internal_volume->snapshots_read,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	result = libcthreads_read_write_lock_release_for_read(
+	          internal_volume->read_write_lock,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif
+
+	/* The snapshots are not read again
+	 */
+	result = libfsapfs_internal_volume_grab_snapshots_for_read(
+	          internal_volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	result = libcthreads_read_write_lock_release_for_read(
+	          internal_volume->read_write_lock,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif
+
+	/* Test error cases
+	 */
+	result = libfsapfs_internal_volume_grab_snapshots_for_read(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_volume_free(
+	          &volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_internal_volume_read_key_bag function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_internal_volume_read_key_bag(
+     void )
+{
+	libbfio_handle_t *file_io_handle             = NULL;
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	libfsapfs_io_handle_t *io_handle             = NULL;
+	libfsapfs_io_handle_t *volume_io_handle      = NULL;
+	libfsapfs_volume_t *volume                   = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_volume_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_volume_initialize(
+	          &volume,
+	          io_handle,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	/* The volume superblock has no snapshot metadata tree
+	 */
+	result = libfsapfs_volume_superblock_initialize(
+	          &( internal_volume->superblock ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_internal_volume_read_key_bag(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	volume_io_handle           = internal_volume->io_handle;
+	internal_volume->io_handle = NULL;
+
+	result = libfsapfs_internal_volume_read_key_bag(
+	          internal_volume,
+	          file_io_handle,
+	          &error );
+
+	internal_volume->io_handle = volume_io_handle;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	internal_volume->key_bag = (libfsapfs_volume_key_bag_t *) 0x12345678UL;
+
+	result = libfsapfs_internal_volume_read_key_bag(
+	          internal_volume,
+	          file_io_handle,
+	          &error );
+
+	internal_volume->key_bag = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an invalid key bag extent
+	 */
+	result = libfsapfs_internal_volume_read_key_bag(
+	          internal_volume,
+	          file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a key bag extent beyond the end of the data
+	 */
+	internal_volume->key_bag_block_number     = 1;
+	internal_volume->key_bag_number_of_blocks = 1;
+
+	result = libfsapfs_internal_volume_read_key_bag(
+	          internal_volume,
+	          file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "internal_volume->key_bag",
+	 internal_volume->key_bag );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_volume_free(
+	          &volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_internal_volume_unlock function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_internal_volume_unlock(
+     void )
+{
+	libbfio_handle_t *file_io_handle             = NULL;
+	libcerror_error_t *error                     = NULL;
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	libfsapfs_io_handle_t *io_handle             = NULL;
+	libfsapfs_volume_t *volume                   = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fsapfs_test_volume_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_volume_initialize(
+	          &volume,
+	          io_handle,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	/* The volume superblock has no snapshot metadata tree
+	 */
+	result = libfsapfs_volume_superblock_initialize(
+	          &( internal_volume->superblock ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_internal_volume_unlock(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a volume without a key bag
+	 */
+	result = libfsapfs_internal_volume_unlock(
+	          internal_volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a volume that was opened lazily, where the key bag is read on unlock
+	 */
+	internal_volume->key_bag_block_number     = 1;
+	internal_volume->key_bag_number_of_blocks = 1;
+
+	result = libfsapfs_internal_volume_unlock(
+	          internal_volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "internal_volume->key_bag",
+	 internal_volume->key_bag );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "internal_volume->is_locked",
+	 internal_volume->is_locked,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_volume_free(
+	          &volume,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* Tests the libfsapfs_volume_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_volume_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_volume_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libcerror_error_t *error            = NULL;
+	libfsapfs_volume_t *volume          = NULL;
+	system_character_t *option_offset   = NULL;
+	system_character_t *option_password = NULL;
+	system_character_t *source          = NULL;
+	system_integer_t option             = 0;
+	size_t string_length                = 0;
+	off64_t volume_offset               = 0;
+	int result                          = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "o:p:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'o':
+				option_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_password = optarg;
+
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+	if( option_offset != NULL )
+	{
+		string_length = system_string_length(
+		                 option_offset );
+
+		result = fsapfs_test_system_string_copy_from_64_bit_in_decimal(
+		          option_offset,
+		          string_length + 1,
+		          (uint64_t *) &volume_offset,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        FSAPFS_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( FSAPFS_TEST_VOLUME_VERBOSE )
+	libfsapfs_notify_set_verbose(
+	 1 );
+	libfsapfs_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_volume_initialize",
+	 fsapfs_test_volume_initialize );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
@@ -414,6 +1408,26 @@ int main(
 	 "libfsapfs_volume_free",
 	 fsapfs_test_volume_free );
 
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_volume_read_snapshots",
+	 fsapfs_test_internal_volume_read_snapshots );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_volume_grab_snapshots_for_read",
+	 fsapfs_test_internal_volume_grab_snapshots_for_read );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_volume_read_key_bag",
+	 fsapfs_test_internal_volume_read_key_bag );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_internal_volume_unlock",
+	 fsapfs_test_internal_volume_unlock );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
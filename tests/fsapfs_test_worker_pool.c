@@ -1,5 +1,5 @@
 /*
- * Library btree_entry type test program
+ * Library worker_pool type test program
  *
  * Copyright (C) 2018-2022, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,26 +34,33 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
-#include "../libfsapfs/libfsapfs_btree_entry.h"
+#include "../libfsapfs/libfsapfs_worker_pool.h"
 
-uint8_t fsapfs_test_btree_entry_key_data1[ 23 ] = {
-	0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x0b, 0x14, 0xbe, 0x9c, 0x2e, 0x66, 0x73, 0x65,
-	0x76, 0x65, 0x6e, 0x74, 0x73, 0x64, 0x00 };
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 
-uint8_t fsapfs_test_btree_entry_value_data1[ 18 ] = {
-	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0xe3, 0x85, 0x4a, 0x54, 0x55, 0x52, 0x15,
-	0x04, 0x00 };
+/* Doubles the value the arguments point to
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_worker_pool_job_function(
+     int *value )
+{
+	if( value == NULL )
+	{
+		return( -1 );
+	}
+	*value *= 2;
 
-#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+	return( 1 );
+}
 
-/* Tests the libfsapfs_btree_entry_initialize function
+/* Tests the libfsapfs_worker_pool_initialize function
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_btree_entry_initialize(
+int fsapfs_test_worker_pool_initialize(
      void )
 {
 	libcerror_error_t *error             = NULL;
-	libfsapfs_btree_entry_t *btree_entry = NULL;
+	libfsapfs_worker_pool_t *worker_pool = NULL;
 	int result                           = 0;
 
 #if defined( HAVE_FSAPFS_TEST_MEMORY )
@@ -63,8 +71,8 @@ int fsapfs_test_btree_entry_initialize(
 
 	/* Test regular cases
 	 */
-	result = libfsapfs_btree_entry_initialize(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_initialize(
+	          &worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -73,15 +81,15 @@ int fsapfs_test_btree_entry_initialize(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "worker_pool",
+	 worker_pool );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libfsapfs_btree_entry_free(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_free(
+	          &worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -90,8 +98,8 @@ int fsapfs_test_btree_entry_initialize(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "worker_pool",
+	 worker_pool );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -99,7 +107,7 @@ int fsapfs_test_btree_entry_initialize(
 
 	/* Test error cases
 	 */
-	result = libfsapfs_btree_entry_initialize(
+	result = libfsapfs_worker_pool_initialize(
 	          NULL,
 	          &error );
 
@@ -115,13 +123,13 @@ int fsapfs_test_btree_entry_initialize(
 	libcerror_error_free(
 	 &error );
 
-	btree_entry = (libfsapfs_btree_entry_t *) 0x12345678UL;
+	worker_pool = (libfsapfs_worker_pool_t *) 0x12345678UL;
 
-	result = libfsapfs_btree_entry_initialize(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_initialize(
+	          &worker_pool,
 	          &error );
 
-	btree_entry = NULL;
+	worker_pool = NULL;
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -141,22 +149,22 @@ int fsapfs_test_btree_entry_initialize(
 	     test_number < number_of_malloc_fail_tests;
 	     test_number++ )
 	{
-		/* Test libfsapfs_btree_entry_initialize with malloc failing
+		/* Test libfsapfs_worker_pool_initialize with malloc failing
 		 */
 		fsapfs_test_malloc_attempts_before_fail = test_number;
 
-		result = libfsapfs_btree_entry_initialize(
-		          &btree_entry,
+		result = libfsapfs_worker_pool_initialize(
+		          &worker_pool,
 		          &error );
 
 		if( fsapfs_test_malloc_attempts_before_fail != -1 )
 		{
 			fsapfs_test_malloc_attempts_before_fail = -1;
 
-			if( btree_entry != NULL )
+			if( worker_pool != NULL )
 			{
-				libfsapfs_btree_entry_free(
-				 &btree_entry,
+				libfsapfs_worker_pool_free(
+				 &worker_pool,
 				 NULL );
 			}
 		}
@@ -168,8 +176,8 @@ int fsapfs_test_btree_entry_initialize(
 			 -1 );
 
 			FSAPFS_TEST_ASSERT_IS_NULL(
-			 "btree_entry",
-			 btree_entry );
+			 "worker_pool",
+			 worker_pool );
 
 			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
 			 "error",
@@ -183,22 +191,22 @@ int fsapfs_test_btree_entry_initialize(
 	     test_number < number_of_memset_fail_tests;
 	     test_number++ )
 	{
-		/* Test libfsapfs_btree_entry_initialize with memset failing
+		/* Test libfsapfs_worker_pool_initialize with memset failing
 		 */
 		fsapfs_test_memset_attempts_before_fail = test_number;
 
-		result = libfsapfs_btree_entry_initialize(
-		          &btree_entry,
+		result = libfsapfs_worker_pool_initialize(
+		          &worker_pool,
 		          &error );
 
 		if( fsapfs_test_memset_attempts_before_fail != -1 )
 		{
 			fsapfs_test_memset_attempts_before_fail = -1;
 
-			if( btree_entry != NULL )
+			if( worker_pool != NULL )
 			{
-				libfsapfs_btree_entry_free(
-				 &btree_entry,
+				libfsapfs_worker_pool_free(
+				 &worker_pool,
 				 NULL );
 			}
 		}
@@ -210,8 +218,8 @@ int fsapfs_test_btree_entry_initialize(
 			 -1 );
 
 			FSAPFS_TEST_ASSERT_IS_NULL(
-			 "btree_entry",
-			 btree_entry );
+			 "worker_pool",
+			 worker_pool );
 
 			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
 			 "error",
@@ -231,19 +239,19 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( btree_entry != NULL )
+	if( worker_pool != NULL )
 	{
-		libfsapfs_btree_entry_free(
-		 &btree_entry,
+		libfsapfs_worker_pool_free(
+		 &worker_pool,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libfsapfs_btree_entry_free function
+/* Tests the libfsapfs_worker_pool_free function
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_btree_entry_free(
+int fsapfs_test_worker_pool_free(
      void )
 {
 	libcerror_error_t *error = NULL;
@@ -251,7 +259,7 @@ int fsapfs_test_btree_entry_free(
 
 	/* Test error cases
 	 */
-	result = libfsapfs_btree_entry_free(
+	result = libfsapfs_worker_pool_free(
 	          NULL,
 	          &error );
 
@@ -278,20 +286,20 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfsapfs_btree_entry_set_key_data function
+/* Tests the libfsapfs_worker_pool_grab and libfsapfs_worker_pool_release functions
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_btree_entry_set_key_data(
+int fsapfs_test_worker_pool_grab_and_release(
      void )
 {
 	libcerror_error_t *error             = NULL;
-	libfsapfs_btree_entry_t *btree_entry = NULL;
+	libfsapfs_worker_pool_t *worker_pool = NULL;
 	int result                           = 0;
 
 	/* Initialize test
 	 */
-	result = libfsapfs_btree_entry_initialize(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_initialize(
+	          &worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -300,8 +308,8 @@ int fsapfs_test_btree_entry_set_key_data(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "worker_pool",
+	 worker_pool );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -309,10 +317,9 @@ int fsapfs_test_btree_entry_set_key_data(
 
 	/* Test regular cases
 	 */
-	result = libfsapfs_btree_entry_set_key_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_key_data1,
-	          23,
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          2,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -324,30 +331,45 @@ int fsapfs_test_btree_entry_set_key_data(
 	 "error",
 	 error );
 
-	/* Test error cases
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "worker_pool->number_of_threads",
+	 worker_pool->number_of_threads,
+	 2 );
+
+	/* The worker threads are in use
 	 */
-	result = libfsapfs_btree_entry_set_key_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_key_data1,
-	          23,
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          2,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
-	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libfsapfs_worker_pool_release(
+	          worker_pool,
+	          &error );
 
-	/* Clean up
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The worker threads are kept when fewer are needed
 	 */
-	result = libfsapfs_btree_entry_free(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          1,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -356,17 +378,32 @@ int fsapfs_test_btree_entry_set_key_data(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "worker_pool->number_of_threads",
+	 worker_pool->number_of_threads,
+	 2 );
+
+	result = libfsapfs_worker_pool_release(
+	          worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Initialize test
+	/* The worker threads are restarted when more are needed
 	 */
-	result = libfsapfs_btree_entry_initialize(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          4,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -374,9 +411,23 @@ int fsapfs_test_btree_entry_set_key_data(
 	 result,
 	 1 );
 
-	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-	 "btree_entry",
-	 btree_entry );
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "worker_pool->number_of_threads",
+	 worker_pool->number_of_threads,
+	 4 );
+
+	result = libfsapfs_worker_pool_release(
+	          worker_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -384,10 +435,9 @@ int fsapfs_test_btree_entry_set_key_data(
 
 	/* Test error cases
 	 */
-	result = libfsapfs_btree_entry_set_key_data(
+	result = libfsapfs_worker_pool_grab(
 	          NULL,
-	          fsapfs_test_btree_entry_key_data1,
-	          23,
+	          2,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -402,10 +452,9 @@ int fsapfs_test_btree_entry_set_key_data(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsapfs_btree_entry_set_key_data(
-	          btree_entry,
-	          NULL,
-	          23,
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          0,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -420,10 +469,8 @@ int fsapfs_test_btree_entry_set_key_data(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsapfs_btree_entry_set_key_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_key_data1,
-	          (size_t) SSIZE_MAX + 1,
+	result = libfsapfs_worker_pool_release(
+	          NULL,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -438,73 +485,10 @@ int fsapfs_test_btree_entry_set_key_data(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_FSAPFS_TEST_MEMORY )
-
-	/* Test libfsapfs_btree_entry_set_key_data with malloc failing
-	 */
-	fsapfs_test_malloc_attempts_before_fail = 0;
-
-	result = libfsapfs_btree_entry_set_key_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_key_data1,
-	          23,
-	          &error );
-
-	if( fsapfs_test_malloc_attempts_before_fail != -1 )
-	{
-		fsapfs_test_malloc_attempts_before_fail = -1;
-	}
-	else
-	{
-		FSAPFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-#if defined( OPTIMIZATION_DISABLED )
-
-	/* Test libfsapfs_btree_entry_set_key_data with memcpy failing
-	 */
-	fsapfs_test_memcpy_attempts_before_fail = 0;
-
-	result = libfsapfs_btree_entry_set_key_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_key_data1,
-	          23,
-	          &error );
-
-	if( fsapfs_test_memcpy_attempts_before_fail != -1 )
-	{
-		fsapfs_test_memcpy_attempts_before_fail = -1;
-	}
-	else
-	{
-		FSAPFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( OPTIMIZATION_DISABLED ) */
-#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
-
 	/* Clean up
 	 */
-	result = libfsapfs_btree_entry_free(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_free(
+	          &worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -513,8 +497,8 @@ int fsapfs_test_btree_entry_set_key_data(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "worker_pool",
+	 worker_pool );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -528,29 +512,34 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( btree_entry != NULL )
+	if( worker_pool != NULL )
 	{
-		libfsapfs_btree_entry_free(
-		 &btree_entry,
+		libfsapfs_worker_pool_free(
+		 &worker_pool,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libfsapfs_btree_entry_set_value_data function
+/* Tests the libfsapfs_worker_pool_push_job and libfsapfs_worker_pool_wait_for_jobs functions
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_btree_entry_set_value_data(
+int fsapfs_test_worker_pool_push_job(
      void )
 {
+	libfsapfs_worker_pool_job_t jobs[ 8 ];
+	int values[ 8 ];
+
 	libcerror_error_t *error             = NULL;
-	libfsapfs_btree_entry_t *btree_entry = NULL;
+	libfsapfs_worker_pool_t *worker_pool = NULL;
+	int iteration                        = 0;
+	int job_index                        = 0;
 	int result                           = 0;
 
 	/* Initialize test
 	 */
-	result = libfsapfs_btree_entry_initialize(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_initialize(
+	          &worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -559,54 +548,117 @@ int fsapfs_test_btree_entry_set_value_data(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "worker_pool",
+	 worker_pool );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	/* Test error cases
 	 */
-	result = libfsapfs_btree_entry_set_value_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_value_data1,
-	          18,
+	result = libfsapfs_worker_pool_push_job(
+	          worker_pool,
+	          &( jobs[ 0 ] ),
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	FSAPFS_TEST_ASSERT_IS_NULL(
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libfsapfs_btree_entry_set_value_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_value_data1,
-	          18,
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_worker_pool_grab(
+	          worker_pool,
+	          4,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	/* Test regular cases
+	 * The same worker threads are used for successive batches of jobs
+	 */
+	for( iteration = 0;
+	     iteration < 16;
+	     iteration++ )
+	{
+		for( job_index = 0;
+		     job_index < 8;
+		     job_index++ )
+		{
+			values[ job_index ] = job_index;
 
-	/* Clean up
+			jobs[ job_index ].function  = (int (*)(void *)) &fsapfs_test_worker_pool_job_function;
+			jobs[ job_index ].arguments = (void *) &( values[ job_index ] );
+
+			result = libfsapfs_worker_pool_push_job(
+			          worker_pool,
+			          &( jobs[ job_index ] ),
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libfsapfs_worker_pool_wait_for_jobs(
+		          worker_pool,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "worker_pool->number_of_pending_jobs",
+		 worker_pool->number_of_pending_jobs,
+		 0 );
+
+		for( job_index = 0;
+		     job_index < 8;
+		     job_index++ )
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "jobs[ job_index ].result",
+			 jobs[ job_index ].result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "values[ job_index ]",
+			 values[ job_index ],
+			 job_index * 2 );
+		}
+	}
+	/* The result of a job that failed is retained
 	 */
-	result = libfsapfs_btree_entry_free(
-	          &btree_entry,
+	jobs[ 0 ].function  = (int (*)(void *)) &fsapfs_test_worker_pool_job_function;
+	jobs[ 0 ].arguments = NULL;
+
+	result = libfsapfs_worker_pool_push_job(
+	          worker_pool,
+	          &( jobs[ 0 ] ),
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -614,18 +666,12 @@ int fsapfs_test_btree_entry_set_value_data(
 	 result,
 	 1 );
 
-	FSAPFS_TEST_ASSERT_IS_NULL(
-	 "btree_entry",
-	 btree_entry );
-
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Initialize test
-	 */
-	result = libfsapfs_btree_entry_initialize(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_wait_for_jobs(
+	          worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -633,20 +679,20 @@ int fsapfs_test_btree_entry_set_value_data(
 	 result,
 	 1 );
 
-	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-	 "btree_entry",
-	 btree_entry );
-
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "jobs[ 0 ].result",
+	 jobs[ 0 ].result,
+	 -1 );
+
 	/* Test error cases
 	 */
-	result = libfsapfs_btree_entry_set_value_data(
+	result = libfsapfs_worker_pool_push_job(
 	          NULL,
-	          fsapfs_test_btree_entry_value_data1,
-	          18,
+	          &( jobs[ 0 ] ),
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -661,10 +707,9 @@ int fsapfs_test_btree_entry_set_value_data(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsapfs_btree_entry_set_value_data(
-	          btree_entry,
+	result = libfsapfs_worker_pool_push_job(
+	          worker_pool,
 	          NULL,
-	          18,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -679,10 +724,8 @@ int fsapfs_test_btree_entry_set_value_data(
 	libcerror_error_free(
 	 &error );
 
-	result = libfsapfs_btree_entry_set_value_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_value_data1,
-	          (size_t) SSIZE_MAX + 1,
+	result = libfsapfs_worker_pool_wait_for_jobs(
+	          NULL,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -697,73 +740,23 @@ int fsapfs_test_btree_entry_set_value_data(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_FSAPFS_TEST_MEMORY )
-
-	/* Test libfsapfs_btree_entry_set_value_data with malloc failing
-	 */
-	fsapfs_test_malloc_attempts_before_fail = 0;
-
-	result = libfsapfs_btree_entry_set_value_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_value_data1,
-	          18,
-	          &error );
-
-	if( fsapfs_test_malloc_attempts_before_fail != -1 )
-	{
-		fsapfs_test_malloc_attempts_before_fail = -1;
-	}
-	else
-	{
-		FSAPFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-#if defined( OPTIMIZATION_DISABLED )
-
-	/* Test libfsapfs_btree_entry_set_value_data with memcpy failing
+	/* Clean up
 	 */
-	fsapfs_test_memcpy_attempts_before_fail = 0;
-
-	result = libfsapfs_btree_entry_set_value_data(
-	          btree_entry,
-	          fsapfs_test_btree_entry_value_data1,
-	          18,
+	result = libfsapfs_worker_pool_release(
+	          worker_pool,
 	          &error );
 
-	if( fsapfs_test_memcpy_attempts_before_fail != -1 )
-	{
-		fsapfs_test_memcpy_attempts_before_fail = -1;
-	}
-	else
-	{
-		FSAPFS_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( OPTIMIZATION_DISABLED ) */
-#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Clean up
-	 */
-	result = libfsapfs_btree_entry_free(
-	          &btree_entry,
+	result = libfsapfs_worker_pool_free(
+	          &worker_pool,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -772,8 +765,8 @@ int fsapfs_test_btree_entry_set_value_data(
 	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
-	 "btree_entry",
-	 btree_entry );
+	 "worker_pool",
+	 worker_pool );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -787,18 +780,19 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( btree_entry != NULL )
+	if( worker_pool != NULL )
 	{
-		libfsapfs_btree_entry_free(
-		 &btree_entry,
+		libfsapfs_worker_pool_free(
+		 &worker_pool,
 		 NULL );
 	}
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
 
 /* The main program
+ * Returns EXIT_SUCCESS if successful or EXIT_FAILURE if not
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 int wmain(
@@ -813,29 +807,35 @@ int main(
 	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
 	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
 
-#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 
 	FSAPFS_TEST_RUN(
-	 "libfsapfs_btree_entry_initialize",
-	 fsapfs_test_btree_entry_initialize );
+	 "libfsapfs_worker_pool_initialize",
+	 fsapfs_test_worker_pool_initialize );
 
 	FSAPFS_TEST_RUN(
-	 "libfsapfs_btree_entry_free",
-	 fsapfs_test_btree_entry_free );
+	 "libfsapfs_worker_pool_free",
+	 fsapfs_test_worker_pool_free );
 
 	FSAPFS_TEST_RUN(
-	 "libfsapfs_btree_entry_set_key_data",
-	 fsapfs_test_btree_entry_set_key_data );
+	 "libfsapfs_worker_pool_grab_and_release",
+	 fsapfs_test_worker_pool_grab_and_release );
 
 	FSAPFS_TEST_RUN(
-	 "libfsapfs_btree_entry_set_value_data",
-	 fsapfs_test_btree_entry_set_value_data );
+	 "libfsapfs_worker_pool_push_job",
+	 fsapfs_test_worker_pool_push_job );
 
-#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+	/* TODO: add tests for libfsapfs_worker_pool_run_job */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
 
 	return( EXIT_SUCCESS );
 
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+
 on_error:
 	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) && defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
 }
 
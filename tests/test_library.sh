@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="btree_entry btree_footer btree_node btree_node_header buffer_data_handle checkpoint_map checkpoint_map_entry checksum chunk_information_block container_data_handle container_key_bag container_reaper container_superblock compressed_data_handle compression data_block data_block_data_handle data_stream deflate directory_record encryption_context error extended_attribute extent_reference_tree file_extent file_system file_system_btree file_system_data_handle fusion_middle_tree inode io_handle key_bag_entry key_bag_header key_encrypted_key lzvn name name_hash notify object object_map object_map_btree object_map_descriptor profiler snapshot snapshot_metadata snapshot_metadata_tree space_manager volume volume_key_bag";
+LIBRARY_TESTS="aes_xts_context btree_footer btree_node btree_node_cache btree_node_header buffer_data_handle change_iterator checkpoint_map checkpoint_map_entry checksum chunk_information_block compressed_block_cache container_data_handle container_key_bag container_reaper container_superblock compressed_data_handle compression data_block data_block_data_handle data_stream deflate directory_record encryption_context error extended_attribute extent_reference_tree file_entry_iterator file_extent file_io_handle_pool file_system file_system_btree file_system_btree_cursor file_system_data_handle fusion_middle_tree inode io_handle io_uring key_bag_entry key_bag_header key_encrypted_key lzfse lzvn name name_hash notify object object_map object_map_btree object_map_descriptor object_map_descriptor_cache profiler snapshot snapshot_metadata snapshot_metadata_tree space_manager volume volume_key_bag worker_pool";
 LIBRARY_TESTS_WITH_INPUT="container support";
 OPTION_SETS="offset password";
 